@@ -0,0 +1,130 @@
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.Arrays;
+
+import edu.biu.protocols.yao.offlineOnline.primitives.BucketFile;
+import edu.biu.protocols.yao.offlineOnline.primitives.CommitmentBundle;
+import edu.biu.protocols.yao.offlineOnline.primitives.LimitedBundle;
+import edu.biu.scapi.circuits.garbledCircuit.JustGarbledGarbledTablesHolder;
+import edu.biu.scapi.interactiveMidProtocols.ByteArrayRandomValue;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashDecommitmentMessage;
+
+/**
+ * Compares the time of writing and reading a bucket of limited bundles with java serialization and with the bucket file format.
+ * The bundles are filled with random values in the sizes of the AES circuit, and the loaded garbled tables are checked against the written ones.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class BucketFileBenchmark {
+	private static final int BUCKET_SIZE = 8;
+	private static final int NUM_OF_GATES = 6800;
+	private static final int INPUT_SIZE = 128;
+	private static final int OUTPUT_SIZE = 128;
+	private static final int ITERATIONS = 5;
+	private static final SecureRandom random = new SecureRandom();
+
+	public static void main(String[] args) throws IOException, ClassNotFoundException {
+		int bucketSize = (args.length > 0) ? Integer.parseInt(args[0]) : BUCKET_SIZE;
+		String serializedFile = "benchmark.serialized.cbundle";
+		String bucketFile = "benchmark.cbundle";
+
+		ArrayList<LimitedBundle> bucket = new ArrayList<LimitedBundle>();
+		ArrayList<byte[]> tables = new ArrayList<byte[]>();
+		for (int i = 0; i < bucketSize; i++) {
+			byte[] garbledTables = randomBytes(NUM_OF_GATES * 3 * 16);
+			tables.add(garbledTables);
+			bucket.add(createBundle(garbledTables));
+		}
+
+		double serializedWrite = 0, serializedRead = 0, bucketWrite = 0, bucketRead = 0;
+		boolean correct = true;
+		for (int i = 0; i < ITERATIONS; i++) {
+			//The bundles release their garbled tables when they are written, so set them again before each write.
+			for (int j = 0; j < bucketSize; j++) {
+				bucket.set(j, createBundle(tables.get(j)));
+			}
+			long start = System.nanoTime();
+			ObjectOutputStream output = new ObjectOutputStream(new BufferedOutputStream(new FileOutputStream(serializedFile)));
+			output.writeObject(bucket);
+			output.close();
+			serializedWrite += (System.nanoTime() - start) / 1000000.0;
+
+			start = System.nanoTime();
+			ObjectInputStream input = new ObjectInputStream(new BufferedInputStream(new FileInputStream(serializedFile)));
+			input.readObject();
+			input.close();
+			serializedRead += (System.nanoTime() - start) / 1000000.0;
+
+			for (int j = 0; j < bucketSize; j++) {
+				bucket.set(j, createBundle(tables.get(j)));
+			}
+			start = System.nanoTime();
+			BucketFile.save(bucket, bucketFile);
+			bucketWrite += (System.nanoTime() - start) / 1000000.0;
+
+			start = System.nanoTime();
+			ArrayList<LimitedBundle> loaded = BucketFile.loadLimitedBundles(bucketFile);
+			bucketRead += (System.nanoTime() - start) / 1000000.0;
+
+			for (int j = 0; j < bucketSize; j++) {
+				correct &= Arrays.equals(tables.get(j), loaded.get(j).getGarbledTables().toDoubleByteArray()[0]);
+			}
+		}
+
+		System.out.println("bucket of " + bucketSize + " bundles, " + new File(serializedFile).length() + " bytes serialized, " +
+				new File(bucketFile).length() + " bytes in a bucket file");
+		System.out.println(String.format("serialization: write %.3f ms, read %.3f ms", serializedWrite / ITERATIONS, serializedRead / ITERATIONS));
+		System.out.println(String.format("bucket file:   write %.3f ms, read %.3f ms, %s", bucketWrite / ITERATIONS, bucketRead / ITERATIONS,
+				correct ? "correct" : "WRONG TABLES"));
+
+		new File(serializedFile).delete();
+		new File(bucketFile).delete();
+	}
+
+	private static LimitedBundle createBundle(byte[] garbledTables) {
+		CommitmentBundle commitmentsX = createCommitments(INPUT_SIZE);
+		CommitmentBundle commitmentsY1Extended = createCommitments(INPUT_SIZE);
+		CommitmentBundle commitmentsY2 = createCommitments(INPUT_SIZE);
+		CmtSimpleHashCommitmentMessage commitment = new CmtSimpleHashCommitmentMessage(randomBytes(20), 0);
+		CmtSimpleHashDecommitmentMessage decommitment = new CmtSimpleHashDecommitmentMessage(new ByteArrayRandomValue(randomBytes(20)),
+				randomBytes(OUTPUT_SIZE * 2 * 16));
+
+		return new LimitedBundle.Builder()
+				.circuit(new JustGarbledGarbledTablesHolder(garbledTables), randomBytes(OUTPUT_SIZE), null)
+				.labels(labels(INPUT_SIZE), labels(INPUT_SIZE), labels(INPUT_SIZE), labels(OUTPUT_SIZE))
+				.commitments(commitmentsX, commitmentsY1Extended, commitmentsY2, commitment, decommitment, null)
+				.build();
+	}
+
+	private static CommitmentBundle createCommitments(int numWires) {
+		long[] ids = new long[2 * numWires];
+		for (int i = 0; i < ids.length; i++) {
+			ids[i] = i;
+		}
+		return new CommitmentBundle(randomBytes(2 * numWires * 20), ids, randomBytes(2 * numWires * 16), randomBytes(2 * numWires * 20));
+	}
+
+	private static int[] labels(int size) {
+		int[] labels = new int[size];
+		for (int i = 0; i < size; i++) {
+			labels[i] = i + 1;
+		}
+		return labels;
+	}
+
+	private static byte[] randomBytes(int size) {
+		byte[] bytes = new byte[size];
+		random.nextBytes(bytes);
+		return bytes;
+	}
+}
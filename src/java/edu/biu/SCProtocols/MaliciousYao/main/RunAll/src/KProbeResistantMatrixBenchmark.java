@@ -0,0 +1,64 @@
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+import edu.biu.protocols.yao.primitives.KProbeResistantMatrix;
+import edu.biu.protocols.yao.primitives.KProbeResistantMatrixBuilder;
+import edu.biu.scapi.circuits.encryption.AESFixedKeyMultiKeyEncryption;
+import edu.biu.scapi.circuits.encryption.MultiKeyEncryptionScheme;
+
+/**
+ * Measures the time of the key transform and the key restore of the K probe-resistant matrix for a few input sizes,
+ * and checks that restoring the keys chosen by a random input gives the keys of the original input. 
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class KProbeResistantMatrixBenchmark {
+	private static final int SECURITY_PARAMETER = 40;
+	private static final int ITERATIONS = 20;
+	
+	public static void main(String[] args) {
+		int[] inputSizes = (args.length > 0) ? new int[]{Integer.parseInt(args[0])} : new int[]{128, 1024, 4096};
+		MultiKeyEncryptionScheme mes = new AESFixedKeyMultiKeyEncryption();
+		SecureRandom random = new SecureRandom();
+		
+		for (int n : inputSizes) {
+			KProbeResistantMatrix matrix = new KProbeResistantMatrixBuilder(n, SECURITY_PARAMETER).build();
+			int m = matrix.getProbeResistantInputSize();
+			
+			byte[] originalKeys = new byte[n * 2 * 16];
+			random.nextBytes(originalKeys);
+			
+			//The first call also packs the matrix.
+			byte[] probeResistantKeys = matrix.transformKeys(originalKeys, mes);
+			long start = System.nanoTime();
+			for (int i = 0; i < ITERATIONS; i++) {
+				probeResistantKeys = matrix.transformKeys(originalKeys, mes);
+			}
+			double transformMillis = (System.nanoTime() - start) / 1000000.0 / ITERATIONS;
+			
+			//Choose one key of each column, as the evaluator gets in the oblivious transfer.
+			byte[] receivedKeys = new byte[m * 16];
+			for (int j = 0; j < m; j++) {
+				System.arraycopy(probeResistantKeys, (2 * j + random.nextInt(2)) * 16, receivedKeys, j * 16, 16);
+			}
+			byte[] restoredKeys = matrix.restoreKeys(receivedKeys);
+			start = System.nanoTime();
+			for (int i = 0; i < ITERATIONS; i++) {
+				restoredKeys = matrix.restoreKeys(receivedKeys);
+			}
+			double restoreMillis = (System.nanoTime() - start) / 1000000.0 / ITERATIONS;
+			
+			//Each restored key should be one of the two original keys of its row.
+			boolean correct = true;
+			for (int i = 0; i < n; i++) {
+				byte[] key = Arrays.copyOfRange(restoredKeys, i * 16, (i + 1) * 16);
+				correct &= Arrays.equals(key, Arrays.copyOfRange(originalKeys, 2 * i * 16, (2 * i + 1) * 16)) || 
+						   Arrays.equals(key, Arrays.copyOfRange(originalKeys, (2 * i + 1) * 16, (2 * i + 2) * 16));
+			}
+			
+			System.out.println("n = " + n + ", m = " + m + ": transform " + String.format("%.3f", transformMillis) + " ms, restore " + 
+					String.format("%.3f", restoreMillis) + " ms, " + (correct ? "correct" : "WRONG KEYS"));
+		}
+	}
+}
@@ -0,0 +1,92 @@
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
+
+/**
+ * Measures the latency of one parallel step of the online protocol (for example, computing the circuits of a bucket) for small circuits,
+ * once with new threads in each execution, as the subroutines did before, and once with the long-lived ParallelExecutor. <p>
+ *
+ * The work on each circuit is simulated by hashing a buffer of the size of its garbled tables.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ParallelExecutorBenchmark {
+	private static final int NUM_OF_THREADS = 4;
+	private static final int BUCKET_SIZE = 8;
+	private static final int EXECUTIONS = 2000;
+
+	public static void main(String[] args) throws InterruptedException {
+		int numOfThreads = (args.length > 0) ? Integer.parseInt(args[0]) : NUM_OF_THREADS;
+		//The sizes of the garbled tables of circuits of 100, 1000 and 10000 gates.
+		int[] circuitSizes = (args.length > 1) ? new int[]{Integer.parseInt(args[1])} : new int[]{4800, 48000, 480000};
+		ParallelExecutor executor = new ParallelExecutor(numOfThreads);
+
+		for (int size : circuitSizes) {
+			final byte[][] circuits = new byte[BUCKET_SIZE][size];
+
+			//Warm up both versions.
+			runWithThreads(circuits, numOfThreads);
+			runWithExecutor(circuits, executor);
+
+			long start = System.nanoTime();
+			for (int i = 0; i < EXECUTIONS; i++) {
+				runWithThreads(circuits, numOfThreads);
+			}
+			double threadsMicros = (System.nanoTime() - start) / 1000.0 / EXECUTIONS;
+
+			start = System.nanoTime();
+			for (int i = 0; i < EXECUTIONS; i++) {
+				runWithExecutor(circuits, executor);
+			}
+			double executorMicros = (System.nanoTime() - start) / 1000.0 / EXECUTIONS;
+
+			System.out.println("circuit of " + size + " bytes: new threads " + String.format("%.1f", threadsMicros) + " us, executor " +
+					String.format("%.1f", executorMicros) + " us per execution");
+		}
+		executor.shutdown();
+	}
+
+	/**
+	 * Creates the threads, splits the circuits statically between them and waits for them, as in the earlier versions.
+	 */
+	private static void runWithThreads(final byte[][] circuits, int numOfThreads) throws InterruptedException {
+		int threadCount = (numOfThreads < circuits.length) ? numOfThreads : circuits.length;
+		Thread[] threads = new Thread[threadCount];
+		int numOfCircuits = circuits.length / threadCount;
+		for (int j = 0; j < threadCount; j++) {
+			final int from = j * numOfCircuits;
+			final int to = (j < threadCount - 1) ? (j + 1) * numOfCircuits : circuits.length;
+			threads[j] = new Thread() {
+				public void run() {
+					work(circuits, from, to);
+				}
+			};
+			threads[j].start();
+		}
+		for (int j = 0; j < threadCount; j++) {
+			threads[j].join();
+		}
+	}
+
+	private static void runWithExecutor(final byte[][] circuits, ParallelExecutor executor) {
+		executor.forRange(circuits.length, new ParallelExecutor.RangeTask() {
+			public void run(int from, int to) {
+				work(circuits, from, to);
+			}
+		});
+	}
+
+	private static void work(byte[][] circuits, int from, int to) {
+		try {
+			MessageDigest sha = MessageDigest.getInstance("SHA-1");
+			for (int i = from; i < to; i++) {
+				sha.update(circuits[i]);
+				circuits[i][0] = sha.digest()[0];
+			}
+		} catch (NoSuchAlgorithmException e) {
+			throw new IllegalStateException(e);
+		}
+	}
+}
@@ -76,6 +76,21 @@ public class SC implements Serializable {
 		this(committer, x, id, s, new SecureRandom());
 	}
 	
+	/**
+	 * A constructor that sets already computed commitments. Used to restore the object from a bucket file.
+	 * @param r The random values used in the commitments, one for each commitment pair.
+	 * @param commitments The commitment pairs.
+	 * @param nextCommitmentId The next available id for the next commitments.
+	 */
+	public SC(byte[][] r, SCom[] commitments, long nextCommitmentId) {
+		//A bundle may have no commitments, in which case the size of the random values is unknown.
+		this.n = (r.length == 0) ? 0 : r[0].length;
+		this.s = r.length;
+		this.r = r;
+		this.commitments = commitments;
+		this.commitmentId = nextCommitmentId;
+	}
+	
 	/**
 	 * Returns random array where each cell contains 0/1 value.
 	 * @param n The size of the required array.
@@ -147,7 +162,7 @@ public class SC implements Serializable {
 	 */
 	public byte[] getR() {
 		//Allocate enough space for all random values.
-		int size = r[0].length;
+		int size = (r.length == 0) ? 0 : r[0].length;
 		byte[] allR = new byte[r.length*size];
 		
 		//Copy each random value to the big array.
@@ -60,6 +60,16 @@ public class SCom implements Serializable {
 		d1 = committer.generateDecommitmentMsg(c1.getId());
 	}
 	
+	/**
+	 * A constructor that sets already computed commitment and decommitment messages. Used to restore the object from a bucket file.
+	 */
+	public SCom(CmtCCommitmentMsg c0, CmtCCommitmentMsg c1, CmtCDecommitmentMessage d0, CmtCDecommitmentMessage d1) {
+		this.c0 = c0;
+		this.c1 = c1;
+		this.d0 = d0;
+		this.d1 = d1;
+	}
+	
 	/**
 	 * Returns the commitment message of x^r.
 	 */
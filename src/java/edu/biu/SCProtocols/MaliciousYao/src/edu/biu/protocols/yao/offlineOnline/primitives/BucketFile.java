@@ -0,0 +1,633 @@
+package edu.biu.protocols.yao.offlineOnline.primitives;
+
+import java.io.DataInputStream;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.channels.FileChannel.MapMode;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import edu.biu.scapi.circuits.garbledCircuit.BasicGarbledTablesHolder;
+import edu.biu.scapi.circuits.garbledCircuit.ExtendedGarbledTablesHolder;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledTablesHolder;
+import edu.biu.scapi.circuits.garbledCircuit.JustGarbledGarbledTablesHolder;
+import edu.biu.scapi.interactiveMidProtocols.ByteArrayRandomValue;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCCommitmentMsg;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCDecommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashDecommitmentMessage;
+
+/**
+ * A flat binary file that holds one bucket of Bundles or LimitedBundles. <p>
+ *
+ * This format replaces the java serialization of the buckets: the fields of each bundle are written one after the other with
+ * no per-object headers, and the whole file is loaded with a single memory mapping. <p>
+ *
+ * All numbers are little endian so that the native code can use a mapped file as is. The layout of version 1 is:
+ * <pre>
+ * header:  int magic ("SCBK"), int version, int bundle type (1 = Bundle, 2 = LimitedBundle), int number of bundles (n),
+ *          int number of fields in each bundle (f), int reserved,
+ *          n longs - the offset of each bundle from the beginning of the file.
+ * bundle:  f pairs of (int offset of the field from the beginning of the bundle, int length of the field in bytes),
+ *          followed by the fields. A null field has length -1. Every field begins at a multiple of 8 bytes.
+ * </pre>
+ * The index of each field is fixed (see the field constants of {@link Bundle} and {@link LimitedBundle}), so any field can be read
+ * without parsing the fields before it. Arrays of ints and longs are written as their elements. An array of messages of the same
+ * size (commitments, decommitments, random values) is written as the concatenation of the messages. <p>
+ *
+ * Garbled tables take three fields: the structure of the holder as ints (0 = null, 1 = JustGarbled, 2 = Basic followed by the number
+ * of tables, 3 = Extended followed by the structures of the input, output and internal tables), the length of each table and the
+ * concatenation of the tables. The tables of a JustGarbled holder are therefore one contiguous block of the file.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class BucketFile {
+
+	private static final int MAGIC = 0x4B424353;		// "SCBK" in little endian.
+	private static final int VERSION = 1;
+	private static final int HEADER_SIZE = 24;
+	private static final byte[] PADDING = new byte[8];
+
+	//The types of the bundles in the file.
+	private static final int BUNDLE = 1;
+	private static final int LIMITED_BUNDLE = 2;
+
+	//The structure values of the garbled tables holders.
+	private static final int NULL_TABLES = 0;
+	private static final int JUST_GARBLED_TABLES = 1;
+	private static final int BASIC_TABLES = 2;
+	private static final int EXTENDED_TABLES = 3;
+
+	/**
+	 * Writes the given bucket to a file.
+	 * @param bucket A list of Bundles or of LimitedBundles.
+	 * @param filename The name of the file to write.
+	 * @throws IOException
+	 * @throws IllegalArgumentException if the bucket contains other objects.
+	 */
+	public static void save(List<?> bucket, String filename) throws IOException {
+		int type = 0;
+		int numFields = 0;
+
+		//Gather the fields of all the bundles. The arrays of the bundles are not copied, they are written directly to the file.
+		ArrayList<ByteBuffer> records = new ArrayList<ByteBuffer>();
+		long[] sizes = new long[bucket.size()];
+		for (int i = 0; i < sizes.length; i++) {
+			Object item = bucket.get(i);
+			RecordWriter record;
+			if (item instanceof Bundle && type != LIMITED_BUNDLE) {
+				type = BUNDLE;
+				numFields = Bundle.NUM_OF_FIELDS;
+				record = new RecordWriter(numFields);
+				((Bundle) item).writeTo(record);
+			} else if (item instanceof LimitedBundle && type != BUNDLE) {
+				type = LIMITED_BUNDLE;
+				numFields = LimitedBundle.NUM_OF_FIELDS;
+				record = new RecordWriter(numFields);
+				((LimitedBundle) item).writeTo(record);
+			} else {
+				throw new IllegalArgumentException("a bucket file holds either Bundles or LimitedBundles");
+			}
+			sizes[i] = record.finish(records);
+		}
+
+		ByteBuffer header = ByteBuffer.allocate(HEADER_SIZE + 8 * sizes.length).order(ByteOrder.LITTLE_ENDIAN);
+		header.putInt(MAGIC).putInt(VERSION).putInt(type).putInt(sizes.length).putInt(numFields).putInt(0);
+		long offset = header.capacity();
+		for (int i = 0; i < sizes.length; i++) {
+			header.putLong(offset);
+			offset += sizes[i];
+		}
+		header.flip();
+		records.add(0, header);
+
+		//Write everything with a single gathering write.
+		ByteBuffer[] buffers = records.toArray(new ByteBuffer[records.size()]);
+		FileOutputStream output = new FileOutputStream(filename);
+		try {
+			FileChannel channel = output.getChannel();
+			long remaining = offset;
+			while (remaining > 0) {
+				remaining -= channel.write(buffers);
+			}
+		} finally {
+			output.close();
+		}
+	}
+
+	/**
+	 * Loads a bucket of Bundles from the given file.
+	 * @throws IOException if the file cannot be read or is not a bucket file of Bundles.
+	 */
+	public static ArrayList<Bundle> loadBundles(String filename) throws IOException {
+		ByteBuffer file = map(filename, BUNDLE, Bundle.NUM_OF_FIELDS);
+		int numBundles = file.getInt(12);
+
+		ArrayList<Bundle> bucket = new ArrayList<Bundle>(numBundles);
+		for (int i = 0; i < numBundles; i++) {
+			bucket.add(Bundle.readFrom(getRecord(file, i, numBundles)));
+		}
+		return bucket;
+	}
+
+	/**
+	 * Loads a bucket of LimitedBundles from the given file.
+	 * @throws IOException if the file cannot be read or is not a bucket file of LimitedBundles.
+	 */
+	public static ArrayList<LimitedBundle> loadLimitedBundles(String filename) throws IOException {
+		ByteBuffer file = map(filename, LIMITED_BUNDLE, LimitedBundle.NUM_OF_FIELDS);
+		int numBundles = file.getInt(12);
+
+		ArrayList<LimitedBundle> bucket = new ArrayList<LimitedBundle>(numBundles);
+		for (int i = 0; i < numBundles; i++) {
+			bucket.add(LimitedBundle.readFrom(getRecord(file, i, numBundles)));
+		}
+		return bucket;
+	}
+
+	/**
+	 * Returns true if the given file begins with the magic number of this format.
+	 * Files that were written by java serialization (the format of earlier versions) return false.
+	 */
+	public static boolean isBucketFile(String filename) throws IOException {
+		DataInputStream input = new DataInputStream(new FileInputStream(filename));
+		try {
+			return Integer.reverseBytes(input.readInt()) == MAGIC;
+		} catch (IOException e) {
+			//A file shorter than the magic number.
+			return false;
+		} finally {
+			input.close();
+		}
+	}
+
+	/**
+	 * Maps the given file to memory and checks its header.
+	 */
+	private static ByteBuffer map(String filename, int type, int numFields) throws IOException {
+		RandomAccessFile file = new RandomAccessFile(filename, "r");
+		try {
+			FileChannel channel = file.getChannel();
+			ByteBuffer buffer = channel.map(MapMode.READ_ONLY, 0, channel.size()).order(ByteOrder.LITTLE_ENDIAN);
+
+			if (buffer.limit() < HEADER_SIZE || buffer.getInt(0) != MAGIC) {
+				throw new IOException(filename + " is not a bucket file");
+			}
+			if (buffer.getInt(4) != VERSION) {
+				throw new IOException(filename + " has an unsupported bucket file version " + buffer.getInt(4));
+			}
+			//An empty bucket has no type.
+			int numBundles = buffer.getInt(12);
+			if (numBundles > 0 && (buffer.getInt(8) != type || buffer.getInt(16) != numFields)) {
+				throw new IOException(filename + " does not contain the requested type of bundles");
+			}
+			if (buffer.limit() < HEADER_SIZE + 8L * numBundles) {
+				throw new IOException(filename + " is truncated");
+			}
+			return buffer;
+		} finally {
+			//The mapping stays valid after the file is closed.
+			file.close();
+		}
+	}
+
+	/**
+	 * Returns the bytes of the i-th bundle of the given mapped file.
+	 */
+	private static Record getRecord(ByteBuffer file, int i, int numBundles) throws IOException {
+		long begin = file.getLong(HEADER_SIZE + 8 * i);
+		long end = (i + 1 < numBundles) ? file.getLong(HEADER_SIZE + 8 * (i + 1)) : file.limit();
+		if (begin < 0 || begin > end || end > file.limit()) {
+			throw new IOException("the bucket file is corrupted");
+		}
+		ByteBuffer record = file.duplicate();
+		record.limit((int) end);
+		record.position((int) begin);
+		return new Record(record.slice().order(ByteOrder.LITTLE_ENDIAN));
+	}
+
+	/**
+	 * Builds the fields of one bundle. <p>
+	 * Each put function writes the next field(s), the given field index is checked against the position of the writer so
+	 * the fields are always written according to their fixed indices.
+	 */
+	static class RecordWriter {
+		private final ByteBuffer directory;								// The offset and length of each field.
+		private final ArrayList<ByteBuffer> segments = new ArrayList<ByteBuffer>();
+		private int size;												// The size of the record so far.
+		private int nextField;
+
+		RecordWriter(int numFields) {
+			directory = ByteBuffer.allocate(8 * numFields).order(ByteOrder.LITTLE_ENDIAN);
+			size = directory.capacity();
+		}
+
+		/**
+		 * Adds a field made of the given parts. A null parts array is a null field.
+		 */
+		private void addField(int field, ByteBuffer... parts) {
+			if (field != nextField) {
+				throw new IllegalStateException("field " + field + " was written instead of field " + nextField);
+			}
+			nextField++;
+
+			if (parts == null) {
+				directory.putInt(0).putInt(-1);
+				return;
+			}
+			int length = 0;
+			for (ByteBuffer part : parts) {
+				length += part.remaining();
+				segments.add(part);
+			}
+			directory.putInt(size).putInt(length);
+			size += length;
+
+			//Align the next field to 8 bytes.
+			int padding = (8 - size % 8) % 8;
+			if (padding > 0) {
+				segments.add(ByteBuffer.wrap(PADDING, 0, padding));
+				size += padding;
+			}
+		}
+
+		void putBytes(int field, byte[] data) {
+			addField(field, (data == null) ? null : new ByteBuffer[]{ ByteBuffer.wrap(data) });
+		}
+
+		void putInts(int field, int[] data) {
+			if (data == null) {
+				addField(field, (ByteBuffer[]) null);
+				return;
+			}
+			ByteBuffer buffer = ByteBuffer.allocate(4 * data.length).order(ByteOrder.LITTLE_ENDIAN);
+			buffer.asIntBuffer().put(data);
+			addField(field, buffer);
+		}
+
+		void putLongs(int field, long[] data) {
+			if (data == null) {
+				addField(field, (ByteBuffer[]) null);
+				return;
+			}
+			ByteBuffer buffer = ByteBuffer.allocate(8 * data.length).order(ByteOrder.LITTLE_ENDIAN);
+			buffer.asLongBuffer().put(data);
+			addField(field, buffer);
+		}
+
+		void putLong(int field, long value) {
+			putLongs(field, new long[]{ value });
+		}
+
+		void putInt(int field, int value) {
+			putInts(field, new int[]{ value });
+		}
+
+		/**
+		 * Writes the concatenation of the given arrays, that should all have the same size.
+		 */
+		void putArrays(int field, byte[][] arrays) {
+			if (arrays == null) {
+				addField(field, (ByteBuffer[]) null);
+				return;
+			}
+			ByteBuffer[] parts = new ByteBuffer[arrays.length];
+			for (int i = 0; i < arrays.length; i++) {
+				parts[i] = ByteBuffer.wrap(arrays[i]);
+			}
+			addField(field, parts);
+		}
+
+		/**
+		 * Writes a simple hash commitment to two fields: the commitment and its id.
+		 */
+		void putCommitment(int field, CmtCCommitmentMsg commitment) {
+			putCommitments(field, (commitment == null) ? null : new CmtCCommitmentMsg[]{ commitment });
+		}
+
+		/**
+		 * Writes simple hash commitments to two fields: the concatenation of the commitments and their ids.
+		 */
+		void putCommitments(int field, CmtCCommitmentMsg[] commitments) {
+			if (commitments == null) {
+				putArrays(field, null);
+				putLongs(field + 1, null);
+				return;
+			}
+			byte[][] values = new byte[commitments.length][];
+			long[] ids = new long[commitments.length];
+			for (int i = 0; i < commitments.length; i++) {
+				values[i] = ((CmtSimpleHashCommitmentMessage) commitments[i]).getCommitment();
+				ids[i] = commitments[i].getId();
+			}
+			putArrays(field, values);
+			putLongs(field + 1, ids);
+		}
+
+		/**
+		 * Writes a simple hash decommitment to two fields: the random value and the committed value.
+		 */
+		void putDecommitment(int field, CmtCDecommitmentMessage decommitment) {
+			putDecommitments(field, (decommitment == null) ? null : new CmtCDecommitmentMessage[]{ decommitment });
+		}
+
+		/**
+		 * Writes simple hash decommitments to two fields: the concatenation of the random values and of the committed values.
+		 */
+		void putDecommitments(int field, CmtCDecommitmentMessage[] decommitments) {
+			if (decommitments == null) {
+				putArrays(field, null);
+				putArrays(field + 1, null);
+				return;
+			}
+			byte[][] r = new byte[decommitments.length][];
+			byte[][] x = new byte[decommitments.length][];
+			for (int i = 0; i < decommitments.length; i++) {
+				r[i] = ((CmtSimpleHashDecommitmentMessage) decommitments[i]).getR().getR();
+				x[i] = ((CmtSimpleHashDecommitmentMessage) decommitments[i]).getX();
+			}
+			putArrays(field, r);
+			putArrays(field + 1, x);
+		}
+
+		/**
+		 * Writes a secret key to two fields: the encoded key and the name of its algorithm.
+		 */
+		void putSecretKey(int field, SecretKey key) {
+			putBytes(field, (key == null) ? null : key.getEncoded());
+			putBytes(field + 1, (key == null) ? null : key.getAlgorithm().getBytes(StandardCharsets.UTF_8));
+		}
+
+		/**
+		 * Writes a commitment bundle to four fields: the commitments, their ids, the decommitted values and the decommitment randoms.
+		 */
+		void putCommitmentBundle(int field, CommitmentBundle bundle) {
+			putBytes(field, (bundle == null) ? null : bundle.getCommitments());
+			putLongs(field + 1, (bundle == null) ? null : bundle.getCommitmentsIds());
+			putBytes(field + 2, (bundle == null) ? null : bundle.getDecommitmentValues());
+			putBytes(field + 3, (bundle == null) ? null : bundle.getDecommitmentRandoms());
+		}
+
+		/**
+		 * Writes garbled tables to three fields: the structure of the holder, the length of each table and the tables.
+		 */
+		void putGarbledTables(int field, GarbledTablesHolder tables) {
+			if (tables == null) {
+				putInts(field, null);
+				putInts(field + 1, null);
+				addField(field + 2, (ByteBuffer[]) null);
+				return;
+			}
+			ArrayList<Integer> structure = new ArrayList<Integer>();
+			ArrayList<byte[]> arrays = new ArrayList<byte[]>();
+			flatten(tables, structure, arrays);
+
+			int[] structureArray = new int[structure.size()];
+			for (int i = 0; i < structureArray.length; i++) {
+				structureArray[i] = structure.get(i);
+			}
+			int[] lengths = new int[arrays.size()];
+			ArrayList<ByteBuffer> parts = new ArrayList<ByteBuffer>();
+			for (int i = 0; i < lengths.length; i++) {
+				byte[] array = arrays.get(i);
+				lengths[i] = (array == null) ? -1 : array.length;
+				if (array != null) {
+					parts.add(ByteBuffer.wrap(array));
+				}
+			}
+			putInts(field, structureArray);
+			putInts(field + 1, lengths);
+			addField(field + 2, parts.toArray(new ByteBuffer[parts.size()]));
+		}
+
+		private static void flatten(GarbledTablesHolder tables, ArrayList<Integer> structure, ArrayList<byte[]> arrays) {
+			if (tables == null) {
+				structure.add(NULL_TABLES);
+			} else if (tables instanceof JustGarbledGarbledTablesHolder) {
+				structure.add(JUST_GARBLED_TABLES);
+				arrays.add(tables.toDoubleByteArray()[0]);
+			} else if (tables instanceof BasicGarbledTablesHolder) {
+				byte[][] basicTables = tables.toDoubleByteArray();
+				structure.add(BASIC_TABLES);
+				structure.add((basicTables == null) ? -1 : basicTables.length);
+				if (basicTables != null) {
+					for (byte[] table : basicTables) {
+						arrays.add(table);
+					}
+				}
+			} else if (tables instanceof ExtendedGarbledTablesHolder) {
+				ExtendedGarbledTablesHolder extended = (ExtendedGarbledTablesHolder) tables;
+				structure.add(EXTENDED_TABLES);
+				flatten(extended.getInputGarbledTables(), structure, arrays);
+				flatten(extended.getOutputGarbledTables(), structure, arrays);
+				flatten(extended.getInternalGarbledTables(), structure, arrays);
+			} else {
+				throw new IllegalArgumentException("garbled tables of type " + tables.getClass().getName() + " cannot be written to a bucket file");
+			}
+		}
+
+		/**
+		 * Adds the directory and the fields of the record to the given list of buffers.
+		 * @return the size of the record in bytes.
+		 */
+		long finish(List<ByteBuffer> buffers) {
+			if (directory.hasRemaining()) {
+				throw new IllegalStateException("only " + nextField + " fields of the bundle were written");
+			}
+			directory.flip();
+			buffers.add(directory);
+			buffers.addAll(segments);
+			return size;
+		}
+	}
+
+	/**
+	 * Reads the fields of one bundle from a mapped bucket file.
+	 */
+	static class Record {
+		private final ByteBuffer buffer;
+
+		Record(ByteBuffer buffer) {
+			this.buffer = buffer;
+		}
+
+		/**
+		 * Returns the bytes of the given field, or null if it is a null field.
+		 */
+		private ByteBuffer field(int field) {
+			int offset = buffer.getInt(8 * field);
+			int length = buffer.getInt(8 * field + 4);
+			if (length < 0) {
+				return null;
+			}
+			ByteBuffer data = buffer.duplicate();
+			data.limit(offset + length);
+			data.position(offset);
+			return data.slice().order(ByteOrder.LITTLE_ENDIAN);
+		}
+
+		boolean isNull(int field) {
+			return buffer.getInt(8 * field + 4) < 0;
+		}
+
+		byte[] getBytes(int field) {
+			ByteBuffer data = field(field);
+			if (data == null) {
+				return null;
+			}
+			byte[] bytes = new byte[data.remaining()];
+			data.get(bytes);
+			return bytes;
+		}
+
+		int[] getInts(int field) {
+			ByteBuffer data = field(field);
+			if (data == null) {
+				return null;
+			}
+			int[] ints = new int[data.remaining() / 4];
+			data.asIntBuffer().get(ints);
+			return ints;
+		}
+
+		long[] getLongs(int field) {
+			ByteBuffer data = field(field);
+			if (data == null) {
+				return null;
+			}
+			long[] longs = new long[data.remaining() / 8];
+			data.asLongBuffer().get(longs);
+			return longs;
+		}
+
+		long getLong(int field) {
+			return field(field).getLong(0);
+		}
+
+		int getInt(int field) {
+			return field(field).getInt(0);
+		}
+
+		/**
+		 * Splits the given field into count arrays of the same size.
+		 */
+		byte[][] getArrays(int field, int count) {
+			ByteBuffer data = field(field);
+			if (data == null) {
+				return null;
+			}
+			int size = (count == 0) ? 0 : data.remaining() / count;
+			byte[][] arrays = new byte[count][size];
+			for (int i = 0; i < count; i++) {
+				data.get(arrays[i]);
+			}
+			return arrays;
+		}
+
+		CmtCCommitmentMsg getCommitment(int field) {
+			CmtCCommitmentMsg[] commitments = getCommitments(field);
+			return (commitments == null) ? null : commitments[0];
+		}
+
+		CmtCCommitmentMsg[] getCommitments(int field) {
+			long[] ids = getLongs(field + 1);
+			if (ids == null) {
+				return null;
+			}
+			byte[][] values = getArrays(field, ids.length);
+			CmtCCommitmentMsg[] commitments = new CmtCCommitmentMsg[ids.length];
+			for (int i = 0; i < ids.length; i++) {
+				commitments[i] = new CmtSimpleHashCommitmentMessage(values[i], ids[i]);
+			}
+			return commitments;
+		}
+
+		CmtCDecommitmentMessage getDecommitment(int field) {
+			CmtCDecommitmentMessage[] decommitments = getDecommitments(field, 1);
+			return (decommitments == null) ? null : decommitments[0];
+		}
+
+		CmtCDecommitmentMessage[] getDecommitments(int field, int count) {
+			byte[][] r = getArrays(field, count);
+			byte[][] x = getArrays(field + 1, count);
+			if (r == null) {
+				return null;
+			}
+			CmtCDecommitmentMessage[] decommitments = new CmtCDecommitmentMessage[count];
+			for (int i = 0; i < count; i++) {
+				decommitments[i] = new CmtSimpleHashDecommitmentMessage(new ByteArrayRandomValue(r[i]), x[i]);
+			}
+			return decommitments;
+		}
+
+		SecretKey getSecretKey(int field) {
+			byte[] key = getBytes(field);
+			if (key == null) {
+				return null;
+			}
+			return new SecretKeySpec(key, new String(getBytes(field + 1), StandardCharsets.UTF_8));
+		}
+
+		CommitmentBundle getCommitmentBundle(int field) {
+			if (isNull(field) && isNull(field + 1)) {
+				return null;
+			}
+			return new CommitmentBundle(getBytes(field), getLongs(field + 1), getBytes(field + 2), getBytes(field + 3));
+		}
+
+		GarbledTablesHolder getGarbledTables(int field) {
+			int[] structure = getInts(field);
+			if (structure == null) {
+				return null;
+			}
+			int[] lengths = getInts(field + 1);
+			ByteBuffer data = field(field + 2);
+			//The positions in the structure and in the lengths arrays.
+			int[] position = new int[2];
+			return unflatten(structure, lengths, data, position);
+		}
+
+		private static GarbledTablesHolder unflatten(int[] structure, int[] lengths, ByteBuffer data, int[] position) {
+			switch (structure[position[0]++]) {
+			case NULL_TABLES:
+				return null;
+			case JUST_GARBLED_TABLES:
+				return new JustGarbledGarbledTablesHolder(nextTable(lengths, data, position));
+			case BASIC_TABLES:
+				int count = structure[position[0]++];
+				byte[][] tables = (count < 0) ? null : new byte[count][];
+				for (int i = 0; i < count; i++) {
+					tables[i] = nextTable(lengths, data, position);
+				}
+				return new BasicGarbledTablesHolder(tables);
+			case EXTENDED_TABLES:
+				BasicGarbledTablesHolder input = (BasicGarbledTablesHolder) unflatten(structure, lengths, data, position);
+				BasicGarbledTablesHolder output = (BasicGarbledTablesHolder) unflatten(structure, lengths, data, position);
+				GarbledTablesHolder internal = unflatten(structure, lengths, data, position);
+				return new ExtendedGarbledTablesHolder(input, output, internal);
+			default:
+				throw new IllegalStateException("the bucket file contains an unknown type of garbled tables");
+			}
+		}
+
+		private static byte[] nextTable(int[] lengths, ByteBuffer data, int[] position) {
+			int length = lengths[position[1]++];
+			if (length < 0) {
+				return null;
+			}
+			byte[] table = new byte[length];
+			data.get(table);
+			return table;
+		}
+	}
+}
@@ -1,15 +1,11 @@
 package edu.biu.protocols.yao.offlineOnline.primitives;
 
 import java.io.BufferedInputStream;
-import java.io.BufferedOutputStream;
 import java.io.FileInputStream;
 import java.io.FileNotFoundException;
-import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.ObjectInput;
 import java.io.ObjectInputStream;
-import java.io.ObjectOutput;
-import java.io.ObjectOutputStream;
 import java.util.ArrayList;
 
 import edu.biu.protocols.yao.common.Preconditions;
@@ -89,7 +85,7 @@ public class BucketList<T>  {
 	}
 	
 	/**
-	 * Prints the buckets to files. Each bucket is printed to a different file.
+	 * Prints the buckets to files. Each bucket is printed to a different file, in the format of {@link BucketFile}.
 	 * @param prefix The prefix of the files names.
 	 * @throws FileNotFoundException
 	 * @throws IOException
@@ -99,15 +95,14 @@ public class BucketList<T>  {
 		for (int j = 0; j < numBuckets; j++) {
 			//The name of the file is the given prefix along with the number of the bucket.
 			String filename = String.format("%s.%d.cbundle", prefix, j);
-			ObjectOutput output = new ObjectOutputStream(new BufferedOutputStream(new FileOutputStream(filename)));
-			//Write the entire array of items to the file and close it.
-			output.writeObject(items.get(j));
-			output.close();
+			//Write the entire array of items to the file.
+			BucketFile.save(items.get(j), filename);
 		}
 	}
 	
 	/**
-	 * Loads a bucket of Bundles from a file. (This actually reads one bucket in each function call).
+	 * Loads a bucket of Bundles from a file. (This actually reads one bucket in each function call).<p>
+	 * Both bucket files and files of earlier versions, that were written by java serialization, can be read.
 	 * @param filename The name of the file to read from.
 	 * @return The created array filled with items. 
 	 * @throws FileNotFoundException
@@ -115,7 +110,11 @@ public class BucketList<T>  {
 	 * @throws ClassNotFoundException
 	 */
 	public static ArrayList<Bundle> loadBucketFromFile(String filename) throws FileNotFoundException, IOException, ClassNotFoundException {
-		//Open the file.
+		if (BucketFile.isBucketFile(filename)) {
+			return BucketFile.loadBundles(filename);
+		}
+		
+		//The file was written by java serialization. Open the file.
 		ObjectInput input = new ObjectInputStream(new BufferedInputStream(new FileInputStream(filename)));
 		@SuppressWarnings("unchecked")
 		//Read the bucket and return it.
@@ -125,7 +124,8 @@ public class BucketList<T>  {
 	}
 	
 	/**
-	 * Loads a bucket of LimitedBundles from a file. (This actually reads one bucket in each function call).
+	 * Loads a bucket of LimitedBundles from a file. (This actually reads one bucket in each function call).<p>
+	 * Both bucket files and files of earlier versions, that were written by java serialization, can be read.
 	 * @param filename The name of the file to read from.
 	 * @return The created array filled with items. 
 	 * @throws FileNotFoundException
@@ -133,7 +133,11 @@ public class BucketList<T>  {
 	 * @throws ClassNotFoundException
 	 */
 	public static ArrayList<LimitedBundle> loadLimitedBucketFromFile(String filename) throws FileNotFoundException, IOException, ClassNotFoundException {
-		//Open the file.
+		if (BucketFile.isBucketFile(filename)) {
+			return BucketFile.loadLimitedBundles(filename);
+		}
+		
+		//The file was written by java serialization. Open the file.
 		ObjectInput input = new ObjectInputStream(new BufferedInputStream(new FileInputStream(filename)));
 		@SuppressWarnings("unchecked")
 		//Read the bucket and return it.
@@ -9,6 +9,8 @@ import javax.crypto.SecretKey;
 import javax.crypto.spec.SecretKeySpec;
 
 import edu.biu.protocols.CommitmentWithZkProofOfDifference.DifferenceCommitmentCommitterBundle;
+import edu.biu.protocols.CommitmentWithZkProofOfDifference.SC;
+import edu.biu.protocols.CommitmentWithZkProofOfDifference.SCom;
 import edu.biu.protocols.yao.common.Preconditions;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
@@ -29,6 +31,30 @@ import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCDecommitmentMe
 public class Bundle implements Serializable {
 	private static final long serialVersionUID = -6856276544764216868L;
 	
+	//The indices of the fields of a bundle in a bucket file (see BucketFile).
+	static final int SEED = 0;
+	static final int PLACEMENT_MASK = 1;
+	static final int COMMITMENT_MASK = 2;
+	static final int INPUT_LABELS_X = 3;
+	static final int INPUT_LABELS_Y1_EXTENDED = 4;
+	static final int INPUT_LABELS_Y2 = 5;
+	static final int OUTPUT_LABELS = 6;
+	static final int OUTPUT_WIRES = 7;
+	static final int COMMITMENTS_X = 8;					// 4 fields.
+	static final int COMMITMENTS_Y1_EXTENDED = 12;		// 4 fields.
+	static final int COMMITMENTS_Y2 = 16;				// 4 fields.
+	static final int OUTPUT_COMMITMENT = 20;			// 2 fields.
+	static final int OUTPUT_DECOMMITMENT = 22;			// 2 fields.
+	static final int SECRET = 24;						// 2 fields.
+	static final int DIFF_X = 26;
+	static final int DIFF_W_COMMITMENT = 27;			// 2 fields.
+	static final int DIFF_R = 29;
+	static final int DIFF_COMMITMENTS = 30;				// 2 fields.
+	static final int DIFF_DECOMMITMENTS = 32;			// 2 fields.
+	static final int DIFF_NEXT_ID = 34;
+	static final int KEY_SIZE = 35;
+	static final int NUM_OF_FIELDS = 36;
+	
 	/**
 	 * This is an inner class that builds the Bundle.
 	 * 
@@ -191,8 +217,13 @@ public class Bundle implements Serializable {
 	private Bundle(Builder builder) {
 		this.seed = builder.seed;
 		
-		this.garbledTables = builder.garbledCircuit.getGarbledTables();
-		this.translationTable = builder.garbledCircuit.getTranslationTable();
+		//A bundle of a circuit that was garbled outside the garbled circuit object (see BundleBuilder) has no garbled tables.
+		if (builder.garbledCircuit != null) {
+			this.garbledTables = builder.garbledCircuit.getGarbledTables();
+			this.translationTable = builder.garbledCircuit.getTranslationTable();
+		} else {
+			this.translationTable = builder.wireValues.getTranslationTable();
+		}
 
 		this.placementMask = builder.placementMask;
 		this.commitmentMask = builder.commitmentMask;
@@ -218,6 +249,52 @@ public class Bundle implements Serializable {
 		this.keySize = builder.keySize;
 	}
 	
+	/**
+	 * A constructor that reads the members that are written to file from the given record of a bucket file.
+	 * Like in readObject, the garbled tables, translation table and input wires are not restored.
+	 */
+	private Bundle(BucketFile.Record record) {
+		this.seed = record.getBytes(SEED);
+		this.garbledTables = null;
+		this.translationTable = null;
+		
+		this.placementMask = record.getBytes(PLACEMENT_MASK);
+		this.commitmentMask = record.getBytes(COMMITMENT_MASK);
+		
+		this.inputLabelsX = record.getInts(INPUT_LABELS_X);
+		this.inputLabelsY1Extended = record.getInts(INPUT_LABELS_Y1_EXTENDED);
+		this.inputLabelsY2 = record.getInts(INPUT_LABELS_Y2);
+		this.outputLabels = record.getInts(OUTPUT_LABELS);
+		
+		this.inputWiresX = null;
+		this.inputWiresY1Extended = null;
+		this.inputWiresY2 = null;
+		this.outputWires = record.getBytes(OUTPUT_WIRES);
+		
+		this.commitmentsX = record.getCommitmentBundle(COMMITMENTS_X);
+		this.commitmentsY1Extended = record.getCommitmentBundle(COMMITMENTS_Y1_EXTENDED);
+		this.commitmentsY2 = record.getCommitmentBundle(COMMITMENTS_Y2);
+		this.commitment = record.getCommitment(OUTPUT_COMMITMENT);
+		this.decommit = record.getDecommitment(OUTPUT_DECOMMITMENT);
+		
+		this.secret = record.getSecretKey(SECRET);
+		
+		//Rebuild the difference commitments from their pairs of commitments.
+		if (!record.isNull(DIFF_X)) {
+			CmtCCommitmentMsg[] commitments = record.getCommitments(DIFF_COMMITMENTS);
+			int s = commitments.length / 2;
+			CmtCDecommitmentMessage[] decommitments = record.getDecommitments(DIFF_DECOMMITMENTS, 2*s);
+			SCom[] pairs = new SCom[s];
+			for (int i = 0; i < s; i++) {
+				pairs[i] = new SCom(commitments[2*i], commitments[2*i+1], decommitments[2*i], decommitments[2*i+1]);
+			}
+			SC c = new SC(record.getArrays(DIFF_R, s), pairs, record.getLong(DIFF_NEXT_ID));
+			this.diffCommitments = new DifferenceCommitmentCommitterBundle(record.getBytes(DIFF_X), c, record.getCommitment(DIFF_W_COMMITMENT));
+		}
+		
+		this.keySize = record.getInt(KEY_SIZE);
+	}
+	
 	public byte[] getSeed() {
 		return seed;
 	}
@@ -383,4 +460,59 @@ public class Bundle implements Serializable {
 		keySize = in.readInt();
 	}
 	
+	/**
+	 * Writes the members that are written by writeObject to the given record of a bucket file.
+	 */
+	void writeTo(BucketFile.RecordWriter record) {
+		record.putBytes(SEED, seed);
+		record.putBytes(PLACEMENT_MASK, placementMask);
+		record.putBytes(COMMITMENT_MASK, commitmentMask);
+		
+		record.putInts(INPUT_LABELS_X, inputLabelsX);
+		record.putInts(INPUT_LABELS_Y1_EXTENDED, inputLabelsY1Extended);
+		record.putInts(INPUT_LABELS_Y2, inputLabelsY2);
+		record.putInts(OUTPUT_LABELS, outputLabels);
+		
+		record.putBytes(OUTPUT_WIRES, outputWires);
+		
+		record.putCommitmentBundle(COMMITMENTS_X, commitmentsX);
+		record.putCommitmentBundle(COMMITMENTS_Y1_EXTENDED, commitmentsY1Extended);
+		record.putCommitmentBundle(COMMITMENTS_Y2, commitmentsY2);
+		record.putCommitment(OUTPUT_COMMITMENT, commitment);
+		record.putDecommitment(OUTPUT_DECOMMITMENT, decommit);
+		
+		record.putSecretKey(SECRET, secret);
+		
+		if (diffCommitments == null) {
+			record.putBytes(DIFF_X, null);
+			record.putCommitment(DIFF_W_COMMITMENT, null);
+			record.putArrays(DIFF_R, null);
+			record.putCommitments(DIFF_COMMITMENTS, null);
+			record.putDecommitments(DIFF_DECOMMITMENTS, null);
+			record.putLongs(DIFF_NEXT_ID, null);
+		} else {
+			SC c = diffCommitments.getC();
+			CmtCCommitmentMsg[] commitments = c.getCommitments();
+			byte[][] r = new byte[commitments.length / 2][];
+			for (int i = 0; i < r.length; i++) {
+				r[i] = c.getR(i);
+			}
+			record.putBytes(DIFF_X, diffCommitments.getX());
+			record.putCommitment(DIFF_W_COMMITMENT, diffCommitments.getCommitmentToW());
+			record.putArrays(DIFF_R, r);
+			record.putCommitments(DIFF_COMMITMENTS, commitments);
+			record.putDecommitments(DIFF_DECOMMITMENTS, c.getDecommitments());
+			record.putLong(DIFF_NEXT_ID, c.getNextAvailableCommitmentId());
+		}
+		
+		record.putInt(KEY_SIZE, keySize);
+	}
+	
+	/**
+	 * Reads a bundle from the given record of a bucket file.
+	 */
+	static Bundle readFrom(BucketFile.Record record) {
+		return new Bundle(record);
+	}
+	
 }
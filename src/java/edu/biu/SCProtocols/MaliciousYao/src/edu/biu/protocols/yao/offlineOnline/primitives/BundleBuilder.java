@@ -71,6 +71,9 @@ public class BundleBuilder {
 	
 	private CmtCCommitmentMsg commitment;
 	private CmtCDecommitmentMessage decommit;
+	
+	private FastCircuitCreationValues garbledValues;	//The output of a garbling that was already done with the garbling seed, or null.
+	
 	/**
 	 * A constructor that sets the parameters.
 	 * @param gbc The garbled circuit to use in the bundle.
@@ -109,9 +112,22 @@ public class BundleBuilder {
 	 * @return The created Bundle.
 	 */
 	public Bundle build(byte[] seed) {
+		return build(seed, null);
+	}
+	
+	/**
+	 * Builds the Bundle using the given seed, where the circuit was already garbled with the garbling seed of this seed 
+	 * (see {@link #getGarblingSeed(byte[])}), for example by the batch verification of the checked circuits. <p>
+	 * The circuit is not garbled again. The created Bundle has no garbled tables, and its translation table is the one in the given values.
+	 * @param seed To use in the build process.
+	 * @param garbledValues The output of the garbling, or null in order to garble the circuit.
+	 * @return The created Bundle.
+	 */
+	public Bundle build(byte[] seed, FastCircuitCreationValues garbledValues) {
 	
 		//Initialize the random sources with the given seed.
 		initRandomness(seed);
+		this.garbledValues = garbledValues;
 	
 		//Get the input and output wire's indices.
 		try {
@@ -145,7 +161,7 @@ public class BundleBuilder {
 		
 		//Create and return a new Bundle with the built data.
 		return new Bundle.Builder(seed, keySize)
-		.circuit(gbc, wireValues)
+		.circuit((garbledValues == null) ? gbc : null, wireValues)
 		.masks(placementMask, commitmentMask)
 		.labels(inputLabelsX, inputLabelsY1Extended, inputLabelsY2, outputLabels)
 		.wires(inputWiresX, inputWiresY1Extended, inputWiresY2)
@@ -192,6 +208,30 @@ public class BundleBuilder {
 		return placementMask;
 	}
 
+	/**
+	 * Returns the seed that the circuit is garbled with when the Bundle is built from the given seed.
+	 * @param seed The seed of the Bundle.
+	 * @return The 16 bytes garbling seed.
+	 */
+	public static byte[] getGarblingSeed(byte[] seed) {
+		byte[] garblingSeed = new byte[16];
+		new SeededRandomnessProvider(seed).getGarblingSecureRandom().nextBytes(garblingSeed);
+		return garblingSeed;
+	}
+	
+	/**
+	 * Garbles the circuit using the given seed, unless the output of this garbling was given to the build function.
+	 * @param seed Used to generate the keys of the circuit.
+	 * @return The output of the garble function.
+	 * @throws InvalidKeyException In case the seed is not in the right size.
+	 */
+	protected FastCircuitCreationValues garbleCircuit(byte[] seed) throws InvalidKeyException {
+		if (garbledValues != null) {
+			return garbledValues;
+		}
+		return gbc.garble(seed);
+	}
+	
 	/**
 	 * Initializes some random sources that are used in the build process.
 	 * @param seed To use in order to initialize the random object.
@@ -221,7 +261,7 @@ public class BundleBuilder {
 		FastCircuitCreationValues values = null;
 		// garble the circuit.
 		try {
-			values = gbc.garble(seed);
+			values = garbleCircuit(seed);
 			
 		} catch (InvalidKeyException e) {
 			e.printStackTrace();
@@ -48,7 +48,7 @@ public class CheatingRecoveryBundleBuilder extends BundleBuilder {
 			
 		// garble the circuit.
 		try {
-			wireValues = gbc.garble(seed);
+			wireValues = garbleCircuit(seed);
 		} catch (InvalidKeyException e) {
 			// Should not occur since the seed is in the right size.
 			throw new IllegalStateException();
@@ -115,7 +115,21 @@ public class CommitmentBundle implements Serializable {
 	public long[] getCommitmentsIds(){
 		return commitmentIds;
 	}
-	
+
+	/**
+	 * Returns the committed values of all wires' keys, or null if this bundle holds only the commitments.
+	 */
+	byte[] getDecommitmentValues() {
+		return decommitments;
+	}
+
+	/**
+	 * Returns the randoms of the decommitments of all wires' keys, or null if this bundle holds only the commitments.
+	 */
+	byte[] getDecommitmentRandoms() {
+		return decommitmentRandoms;
+	}
+
 	/**
 	 * Set the commitments of the given wires' indices.
 	 * @param commitmentsArr two- dimensions array that holds each commitment of each wire's key.
@@ -29,6 +29,31 @@ import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimp
  */
 public class LimitedBundle implements Serializable {
 	private static final long serialVersionUID = 8986229088379999867L;
+	
+	//The indices of the fields of a limited bundle in a bucket file (see BucketFile).
+	static final int GARBLED_TABLES = 0;				// 3 fields.
+	static final int TRANSLATION_TABLE = 3;
+	static final int INPUT_LABELS_X = 4;
+	static final int INPUT_LABELS_Y1_EXTENDED = 5;
+	static final int INPUT_LABELS_Y2 = 6;
+	static final int OUTPUT_LABELS = 7;
+	static final int COMMITMENTS_X = 8;					// 4 fields.
+	static final int COMMITMENTS_Y1_EXTENDED = 12;		// 4 fields.
+	static final int COMMITMENTS_Y2 = 16;				// 4 fields.
+	static final int COMMITMENTS_OUTPUT = 20;
+	static final int COMMITMENTS_OUTPUT_ID = 21;
+	static final int DECOMMITMENTS_OUTPUT = 22;			// 2 fields.
+	static final int DIFF_W = 24;
+	static final int DIFF_W_DECOMMITMENT = 25;			// 2 fields.
+	static final int DIFF_C = 27;						// 2 fields.
+	static final int Y1_INPUT = 29;
+	static final int Y1_LABELS = 30;
+	static final int INPUT_KEYS_X = 31;
+	static final int INPUT_KEYS_Y = 32;
+	static final int INPUT_KEYS_Y1_EXTENDED = 33;
+	static final int PLACEMENT_MASK_DIFFERENCE = 34;
+	static final int COMMITMENT_MASK = 35;
+	static final int NUM_OF_FIELDS = 36;
 
 	/**
 	 * This is an inner class that builds the LimitedBundle.
@@ -160,6 +185,40 @@ public class LimitedBundle implements Serializable {
 		this.tablesFile = builder.tablesFile;
 	}
 	
+	/**
+	 * A constructor that reads the members that are written to file from the given record of a bucket file.
+	 */
+	private LimitedBundle(BucketFile.Record record) {
+		this.garbledTables = record.getGarbledTables(GARBLED_TABLES);
+		this.translationTable = record.getBytes(TRANSLATION_TABLE);
+		
+		this.inputLabelsX = record.getInts(INPUT_LABELS_X);
+		this.inputLabelsY1Extended = record.getInts(INPUT_LABELS_Y1_EXTENDED);
+		this.inputLabelsY2 = record.getInts(INPUT_LABELS_Y2);
+		this.outputLabels = record.getInts(OUTPUT_LABELS);
+		
+		this.commitmentsX = record.getCommitmentBundle(COMMITMENTS_X);
+		this.commitmentsY1Extended = record.getCommitmentBundle(COMMITMENTS_Y1_EXTENDED);
+		this.commitmentsY2 = record.getCommitmentBundle(COMMITMENTS_Y2);
+		this.commitmentsOutput = record.getBytes(COMMITMENTS_OUTPUT);
+		this.commitmentsOutputId = record.getLong(COMMITMENTS_OUTPUT_ID);
+		this.decommitmentsOutput = record.getDecommitment(DECOMMITMENTS_OUTPUT);
+		if (!record.isNull(DIFF_W)) {
+			this.diffCommitments = new DifferenceCommitmentReceiverBundle(record.getBytes(DIFF_W), 
+					record.getDecommitment(DIFF_W_DECOMMITMENT), record.getCommitments(DIFF_C));
+		}
+		
+		if (!record.isNull(Y1_INPUT)) {
+			this.y1 = new CircuitInput(record.getBytes(Y1_INPUT), record.getInts(Y1_LABELS));
+		}
+		this.inputKeysX = record.getBytes(INPUT_KEYS_X);
+		this.inputKeysY = record.getBytes(INPUT_KEYS_Y);
+		this.inputKeysY1Extended = record.getBytes(INPUT_KEYS_Y1_EXTENDED);
+		
+		this.placementMaskDifference = record.getBytes(PLACEMENT_MASK_DIFFERENCE);
+		this.commitmentMask = record.getBytes(COMMITMENT_MASK);
+	}
+	
 	/*
 	 * Getters and setters.
 	 */
@@ -262,13 +321,9 @@ public class LimitedBundle implements Serializable {
 	}
 	
 	/**
-	 * This function overrides the function from the Serializable interface because we want only part of the 
-	 * members to be written to file.
-	 * @param out
-	 * @throws IOException
+	 * Reads the garbled tables from the temporary file they were stored in, if there is one, and deletes the file.
 	 */
-	private void writeObject(ObjectOutputStream out) throws IOException{
-		
+	private void loadGarbledTables() throws IOException {
 		if (tablesFile != null){
 		
 			//Open the file.
@@ -282,7 +337,19 @@ public class LimitedBundle implements Serializable {
 			} catch (ClassNotFoundException e) {
 				// Should not occur since the file contains GarbledTablesHolder.
 			}
+			tablesFile = null;
 		}
+	}
+	
+	/**
+	 * This function overrides the function from the Serializable interface because we want only part of the 
+	 * members to be written to file.
+	 * @param out
+	 * @throws IOException
+	 */
+	private void writeObject(ObjectOutputStream out) throws IOException{
+		
+		loadGarbledTables();
 		
 		out.writeObject(garbledTables);
 		garbledTables = null;
@@ -351,4 +418,51 @@ public class LimitedBundle implements Serializable {
 		commitmentMask = (byte[]) in.readObject();
 	}
 	
+	/**
+	 * Writes the members that are written by writeObject to the given record of a bucket file. <p>
+	 * Like writeObject, the garbled tables are released after they are written.
+	 */
+	void writeTo(BucketFile.RecordWriter record) throws IOException {
+		loadGarbledTables();
+		
+		record.putGarbledTables(GARBLED_TABLES, garbledTables);
+		record.putBytes(TRANSLATION_TABLE, translationTable);
+		
+		//Wires' indices.
+		record.putInts(INPUT_LABELS_X, inputLabelsX);
+		record.putInts(INPUT_LABELS_Y1_EXTENDED, inputLabelsY1Extended);
+		record.putInts(INPUT_LABELS_Y2, inputLabelsY2);
+		record.putInts(OUTPUT_LABELS, outputLabels);
+		
+		//Commitments on the keys.
+		record.putCommitmentBundle(COMMITMENTS_X, commitmentsX);
+		record.putCommitmentBundle(COMMITMENTS_Y1_EXTENDED, commitmentsY1Extended);
+		record.putCommitmentBundle(COMMITMENTS_Y2, commitmentsY2);
+		record.putBytes(COMMITMENTS_OUTPUT, commitmentsOutput);
+		record.putLong(COMMITMENTS_OUTPUT_ID, commitmentsOutputId);
+		record.putDecommitment(DECOMMITMENTS_OUTPUT, decommitmentsOutput);
+		record.putBytes(DIFF_W, (diffCommitments == null) ? null : diffCommitments.getW());
+		record.putDecommitment(DIFF_W_DECOMMITMENT, (diffCommitments == null) ? null : diffCommitments.getDecommitmentToW());
+		record.putCommitments(DIFF_C, (diffCommitments == null) ? null : diffCommitments.getC());
+		
+		//Input for the circuit.
+		record.putBytes(Y1_INPUT, (y1 == null) ? null : y1.asByteArray());
+		record.putInts(Y1_LABELS, (y1 == null) ? null : y1.getLabels());
+		record.putBytes(INPUT_KEYS_X, inputKeysX);
+		record.putBytes(INPUT_KEYS_Y, inputKeysY);
+		record.putBytes(INPUT_KEYS_Y1_EXTENDED, inputKeysY1Extended);
+		
+		//Masks.
+		record.putBytes(PLACEMENT_MASK_DIFFERENCE, placementMaskDifference);
+		record.putBytes(COMMITMENT_MASK, commitmentMask);
+		
+		garbledTables = null;
+	}
+	
+	/**
+	 * Reads a limited bundle from the given record of a bucket file.
+	 */
+	static LimitedBundle readFrom(BucketFile.Record record) {
+		return new LimitedBundle(record);
+	}
 }
@@ -28,6 +28,7 @@ import edu.biu.protocols.yao.primitives.CutAndChooseSelection;
 import edu.biu.protocols.yao.primitives.EvaluateAllSelectionBuilder;
 import edu.biu.protocols.yao.primitives.Expector;
 import edu.biu.protocols.yao.primitives.KProbeResistantMatrix;
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
 import edu.biu.scapi.circuits.circuit.BooleanCircuit;
 import edu.biu.scapi.circuits.circuit.Wire;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
@@ -112,13 +113,15 @@ public class OnlineProtocolP2 implements Protocol {
 	private native void xorKeys(byte[] keys1, byte[] keys2, byte[] output, int size); 
 	
 	/**
-	 * Checks that the given random values and committed values are indeed lead to the commitments values.
+	 * Checks that the given random values and committed values are indeed lead to the commitments values.<p>
+	 * The decommitments are hashed together using multi-buffer SHA-1, split between the given number of native threads.
 	 * @param comm The commitments values.
 	 * @param r The random values used to commit.
 	 * @param x The values to commit on.
-	 * @return true if the commitments match the values and randoms; false, otherwise.
+	 * @param numThreads The number of threads to use. Values smaller than 2 verify all the decommitments in the calling thread.
+	 * @return the result of each decommitment. Index i is true if the i'th commitment matches the i'th value and random; false, otherwise.
 	 */
-	private native boolean verifyDecommitment(byte[] comm, byte[] r, byte[] x);
+	private native boolean[] verifyDecommitments(byte[] comm, byte[] r, byte[] x, int numThreads);
 		
 	/**
 	 * Constructor that sets the parameters. 
@@ -320,49 +323,20 @@ public class OnlineProtocolP2 implements Protocol {
 	/**
 	 * Verifies that the received decommitments on the input keys are correct.
 	 * In case they are, extract the keys and sets them in the circuits.
-	 * In case the user enable threads, this function is split into the number of threads as the user requested.
+	 * In case the user enable threads, the circuits are verified by the threads of the executor.
 	 * @param bucket The bucket to work on.
 	 * @param evaluationPackage The message that was received from p1.
 	 * @param matrix The probe resistant matrix to use in order to restore the original keys from the extended keys.
 	 * @param y2 The boolean input for the circuit.
 	 */
-	private void receiveAndVerifyY2InputKeys(ArrayList<LimitedBundle> bucket, EvaluationPackage evaluationPackage, KProbeResistantMatrix matrix, byte[] y2) {
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
-		if (primitives.getNumOfThreads() > 0){
-			//In case the number of thread is less than the number of circuits in the bucket, there is no point to create all the threads.
-			//In this case, create only number of threads as the bucket size and assign one circuit to each thread.
-			int threadCount = (primitives.getNumOfThreads() < bucket.size()) ? primitives.getNumOfThreads() : bucket.size();
-			VerifyY2InputKeysThread[] threads = new VerifyY2InputKeysThread[threadCount];
-			
-			//Calculate the number of circuit in each thread and the remainder.
-			int remain = bucket.size() % threadCount;
-			int numOfCircuits =  bucket.size() / threadCount;
-			
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j = 0; j < threadCount; j++) {
-				if ((j < (threadCount - 1)) || (remain == 0) ){
-					threads[j] = new VerifyY2InputKeysThread(bucket, matrix, evaluationPackage, y2, j*numOfCircuits, (j+1)*numOfCircuits);
-				} else {
-					threads[j] = new VerifyY2InputKeysThread(bucket, matrix, evaluationPackage, y2, j*numOfCircuits, bucket.size());
-				}
-				//Start all threads.
-				threads[j].start();
-			}
-			
-			//Wait until all threads finish their job.
-			for (int j = 0; j < threadCount; j++) {
-				try {
-					threads[j].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
-				}
+	private void receiveAndVerifyY2InputKeys(final ArrayList<LimitedBundle> bucket, final EvaluationPackage evaluationPackage, 
+			final KProbeResistantMatrix matrix, final byte[] y2) {
+		//Verify the circuits on the threads of the executor. The idle threads take circuits from the busy ones.
+		primitives.getExecutor().forRange(bucket.size(), new ParallelExecutor.RangeTask() {
+			public void run(int from, int to) {
+				verifyY2InputKeys(bucket, evaluationPackage, matrix, y2, from, to);
 			}
-			
-		//In case no thread should be created, verify all the circuits input directly.
-		} else {
-			verifyY2InputKeys(bucket, evaluationPackage, matrix, y2, 0, bucket.size());
-		}
+		});
 	}
 	
 	/**
@@ -414,12 +388,11 @@ public class OnlineProtocolP2 implements Protocol {
 			}
 				
 			//Checks that the random values and committed values are indeed lead to the commitments values.
-			boolean valid = verifyDecommitment(commitments, randoms, values);
+			//This method already runs in one of the threads, so the decommitments of the circuit are verified in this thread.
+			boolean[] valid = verifyDecommitments(commitments, randoms, values, 1);
 				
 			//If the verify failed, there is a cheating. Throw an exception.
-			if (valid == false) {
-				throw new CheatAttemptException("incorrect decommitment!");
-			}
+			checkDecommitments(valid, inputLabelsY2.length, k);
 		
 			//Xor the keys with the commitment mask to get the y2 keys.
 			xorKeysWithMask(values, commitmentMask, inputLabelsY2.length);
@@ -434,48 +407,6 @@ public class OnlineProtocolP2 implements Protocol {
 		}
 	}
 	
-	/**
-	 * Inner thread class that verifies that the received decommitments on the input keys are correct.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya farbstein)
-	 *
-	 */
-	private class VerifyY2InputKeysThread extends Thread{
-		private ArrayList<LimitedBundle> bucket;		//The bucket to work on.
-		private KProbeResistantMatrix matrix;			//The probe resistant matrix to use in order to restore the original keys from the extended keys.
-		private EvaluationPackage evaluationPackage;	//The message that was received from p1.
-		private byte[] y2;								//The boolean input for the circuit.
-		private int from;								//The starting index in the bucket that point on the first circuit to work on.
-		private int to;									//The last index in the bucket that point on the last circuit to work on.
-		
-		/**
-		 * A constructor that sets the given parameters.
-		 * @param bucket The bucket to work on.
-		 * @param matrix The probe resistant matrix to use in order to restore the original keys from the extended keys.
-		 * @param evaluationPackage The message that was received from p1.
-		 * @param y2 The boolean input for the circuit.
-		 * @param from The starting index in the bucket that point on the first circuit to work on.
-		 * @param to The last index in the bucket that point on the last circuit to work on.
-		 */
-		public VerifyY2InputKeysThread(ArrayList<LimitedBundle> bucket, KProbeResistantMatrix matrix, 
-				EvaluationPackage evaluationPackage, byte[] y2, int from, int to){
-			this.bucket = bucket;
-			this.matrix = matrix;
-			this.evaluationPackage = evaluationPackage;
-			this.y2 = y2;
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Verifies that the received decommitments on the input keys are correct.
-		 */
-		public void run() {
-			//Call the function that does the verification with the parameters.
-			verifyY2InputKeys(bucket, evaluationPackage, matrix, y2, from, to);
-		}
-	}
-	
 	/**
 	 * verifies that the received decommitments on the d2 input keys are correct.
 	 * @param bucket The bucket to work on.
@@ -550,42 +481,61 @@ public class OnlineProtocolP2 implements Protocol {
 		int size = input.size();
 		int hashSize = primitives.getCryptographicHash().getHashedMsgSize();
 		
-		//For each circuit, verify the decommitment on the input keys.
+		int numKeys = inputLabelsP1.length;
+		
+		//Copy the commitments, values and random values of all the circuits to a one dimension array, 
+		//so that all the decommitments of the bucket are verified in one native call.
+		byte[] commitmentsArray = new byte[bucket.size()*numKeys*hashSize];
+		byte[] randoms = new byte[bucket.size()*numKeys*hashSize];
+		byte[] values = new byte[bucket.size()*numKeys*keyLength];
+		byte[] placementMask = evaluationPackage.getPlacementMask();
+		
 		for (int j = 0; j < bucket.size(); j++) {
-			//Get the circuit, commitment mask and commitments on the keys.
-			LimitedBundle circuitBundle = bucket.get(j);
-			byte[] observedMask = new byte[size];
-			System.arraycopy(evaluationPackage.getPlacementMask(), j*size, observedMask, 0, size);
-			byte[] commitmentMask = circuitBundle.getCommitmentMask();
-			CommitmentBundle commitments = circuitBundle.getCommitmentsX();
-			
-			//Copy the commitments, values and random values to a one dimension array in order to get better performance in the native implementation.
-			byte[] commitmentsArray = new byte[inputLabelsP1.length*hashSize];
-			byte[] randoms = new byte[inputLabelsP1.length*hashSize];
-			byte[] values = new byte[inputLabelsP1.length*keyLength];
+			//Get the commitments on the keys of the circuit.
+			CommitmentBundle commitments = bucket.get(j).getCommitmentsX();
 			
-			for (int i = 0; i < inputLabelsP1.length; i++) {
-				CmtCCommitmentMsg com = commitments.getCommitment(i, observedMask[i]);
-				CmtCDecommitmentMessage decom = evaluationPackage.getDecommitmentToXInputKey(j, i, inputLabelsP1.length, keyLength, hashSize);
+			for (int i = 0; i < numKeys; i++) {
+				CmtCCommitmentMsg com = commitments.getCommitment(i, placementMask[j*size + i]);
+				CmtCDecommitmentMessage decom = evaluationPackage.getDecommitmentToXInputKey(j, i, numKeys, keyLength, hashSize);
+				int index = j*numKeys + i;
 				
-				System.arraycopy((byte[])com.getCommitment(), 0, commitmentsArray , i*hashSize, hashSize);
-				System.arraycopy(((CmtSimpleHashDecommitmentMessage) decom).getR().getR(), 0, randoms , i*hashSize, hashSize);
-				System.arraycopy((byte[])decom.getX(), 0, values , i*keyLength, keyLength);
-			}
-			
-			//Checks that the random values and committed values are indeed lead to the commitments values.
-			boolean valid = verifyDecommitment(commitmentsArray, randoms, values);
-			
-			//If the verify failed, there is a cheating. Throw an exception.
-			if (valid == false) {
-				throw new CheatAttemptException("incorrect decommitment!");
+				System.arraycopy((byte[])com.getCommitment(), 0, commitmentsArray , index*hashSize, hashSize);
+				System.arraycopy(((CmtSimpleHashDecommitmentMessage) decom).getR().getR(), 0, randoms , index*hashSize, hashSize);
+				System.arraycopy((byte[])decom.getX(), 0, values , index*keyLength, keyLength);
 			}
+		}
+		
+		//Checks that the random values and committed values are indeed lead to the commitments values.
+		boolean[] valid = verifyDecommitments(commitmentsArray, randoms, values, primitives.getNumOfThreads());
+		
+		//If the verify failed, there is a cheating. Throw an exception.
+		checkDecommitments(valid, numKeys, 0);
+		
+		for (int j = 0; j < bucket.size(); j++) {
+			LimitedBundle circuitBundle = bucket.get(j);
+			byte[] xKeys = new byte[numKeys*keyLength];
+			System.arraycopy(values, j*numKeys*keyLength, xKeys, 0, xKeys.length);
 			
 			//Xor the keys with the commitment mask to get the x keys.
-			xorKeysWithMask(values, commitmentMask, inputLabelsP1.length);
+			xorKeysWithMask(xKeys, circuitBundle.getCommitmentMask(), numKeys);
 			
 			//Set x keys to the circuit.
-			circuitBundle.setXInputKeys(values);
+			circuitBundle.setXInputKeys(xKeys);
+		}
+	}
+	
+	/**
+	 * Checks the results of verifyDecommitments on the keys of consecutive circuits.
+	 * @param valid The result of each decommitment, numKeys results for each circuit.
+	 * @param numKeys The number of decommitted keys of each circuit.
+	 * @param firstCircuit The index in the bucket of the circuit of the first result.
+	 * @throws CheatAttemptException with the index of the circuit and key that failed, if one of the decommitments is incorrect.
+	 */
+	private void checkDecommitments(boolean[] valid, int numKeys, int firstCircuit) {
+		for (int i = 0; i < valid.length; i++) {
+			if (valid[i] == false) {
+				throw new CheatAttemptException("incorrect decommitment! circuit " + (firstCircuit + i / numKeys) + ", key " + (i % numKeys));
+			}
 		}
 	}
 	
@@ -17,6 +17,7 @@ import edu.biu.protocols.yao.offlineOnline.primitives.DecommitmentsPackage;
 import edu.biu.protocols.yao.offlineOnline.primitives.ExecutionParameters;
 import edu.biu.protocols.yao.primitives.CryptoPrimitives;
 import edu.biu.protocols.yao.primitives.CutAndChooseSelection;
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
 import edu.biu.scapi.comm.Channel;
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.exceptions.CommitValueException;
@@ -160,81 +161,15 @@ public class CutAndChooseProver {
 	 * @throws IOException 
 	 */
 	private void constructGarbledCircuitBundles() throws IOException {
-		//Get the number of threads to use in the protocol.
-		int numOfThreads = primitives.getNumOfThreads();
-//		System.out.println("building garbled circuit bundle for " + numCircuits + " circuits...");
-		
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
-		if (numOfThreads > 0){
-			
-			ConstructThread[] threads = new ConstructThread[numOfThreads];
-			//Calculate the number of circuit in each thread and the remaining.
-			int numCircuitsPerThread = numCircuits / numOfThreads;
-			int remain = numCircuits % numOfThreads;
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j = 0; j < numOfThreads; j++) {
-				if ((j != numOfThreads-1) || (remain == 0)){
-					threads[j] = new ConstructThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread);
-				} else{
-					threads[j] = new ConstructThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread + remain);
+		//Garble the circuits of each channel in a different thread of the executor. 
+		//Each part uses its own bundle builder and channel, and the verifier expects the circuits of each part on the channel of this part.
+		primitives.getExecutor().forPartitions(numCircuits, new ParallelExecutor.PartitionTask() {
+			public void run(int partition, int from, int to) throws IOException {
+				for (int j = from; j < to; j++) {
+					buildCircuit(j, partition);
 				}
-				//Start all threads.
-				threads[j].start();
-			}
-			//Wait until all threads finish their job.
-			for (int j = 0; j < numOfThreads; j++) {
-				try {
-					threads[j].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
-				}
-			}
-		//In case no thread should be created, build all the circuits directly.
-		} else {
-			for (int j = 0; j < numCircuits; j++) {
-				buildCircuit(j, 0);
 			}
-		}
-	}
-	
-	/**
-	 * Inner thread class that construct the circuits in a separate thread.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Asaf Cohen)
-	 *
-	 */
-	private class ConstructThread extends Thread{
-		
-		private int from;	// The first circuit in the circuit list that should be created.
-		private int to;		// The last circuit in the circuit list that should be created.
-		private int i;		// The index of the thread.
-		
-		/**
-		 * Constructor that sets the parameters.
-		 * @param i The index of the thread.
-		 * @param from The first circuit in the circuit list that should be created.
-		 * @param to The last circuit in the circuit list that should be created.
-		 */
-		ConstructThread(int i, int from, int to){
-			this.i = i;
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Builds the circuits from the start point to the end point in the circuit list.
-		 */
-		public void run(){
-			for (int j = from; j < to; j++) {
-				try {
-					buildCircuit(j, i);
-				} catch (IOException e) {
-					// TODO Auto-generated catch block
-					e.printStackTrace();
-				}	
-			}
-		}
+		});
 	}
 	
 	/**
@@ -34,7 +34,10 @@ import edu.biu.protocols.yao.primitives.CryptoPrimitives;
 import edu.biu.protocols.yao.primitives.CutAndChooseSelection;
 import edu.biu.protocols.yao.primitives.Expector;
 import edu.biu.protocols.yao.primitives.KProbeResistantMatrix;
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
 import edu.biu.scapi.circuits.garbledCircuit.GarbledTablesHolder;
 import edu.biu.scapi.comm.Channel;
 import edu.biu.scapi.exceptions.CheatAttemptException;
@@ -314,81 +317,15 @@ public class CutAndChooseVerifier {
 		}
 		translationTables = new byte[numCircuits][];
 				
-		//Get the number of threads to use in the protocol.
-		int numOfThreads = primitives.getNumOfThreads();
-//		System.out.println("building garbled circuit bundle for " + numCircuits + " circuits...");
-		
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
-		if (numOfThreads > 0){
-			
-			ReceiveThread[] threads = new ReceiveThread[numOfThreads];
-			//Calculate the number of circuit in each thread and the remaining.
-			int numCircuitsPerThread = numCircuits / numOfThreads;
-			int remain = numCircuits % numOfThreads;
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j = 0; j < numOfThreads; j++) {
-				if ((j != numOfThreads-1) || (remain == 0)){
-					threads[j] = new ReceiveThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread);
-				} else{
-					threads[j] = new ReceiveThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread + remain);
-				}
-				//Start all threads.
-				threads[j].start();
-			}
-			//Wait until all threads finish their job.
-			for (int j = 0; j < numOfThreads; j++) {
-				try {
-					threads[j].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
+		//Receive the circuits of each channel in a different thread of the executor. 
+		//The prover sends the circuits of each part on the channel of this part, so the parts are fixed.
+		primitives.getExecutor().forPartitions(numCircuits, new ParallelExecutor.PartitionTask() {
+			public void run(int partition, int from, int to) throws IOException {
+				for (int j = from; j < to; j++) {
+					receiveCircuit(j, partition);
 				}
 			}
-		//In case no thread should be created, build all the circuits directly.
-		} else {
-			for (int j = 0; j < numCircuits; j++) {
-				receiveCircuit(j, 0);
-			}
-		}
-		
-	}
-	
-	/**
-	 * Inner thread class that construct the circuits in a separate thread.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Asaf Cohen)
-	 *
-	 */
-	private class ReceiveThread extends Thread{
-		
-		private int from;	// The first circuit in the circuit list that should be created.
-		private int to;		// The last circuit in the circuit list that should be created.
-		private int i;		// The index of the thread.
-		/**
-		 * Constructor that sets the parameters.
-		 * @param i The index of the thread.
-		 * @param from The first circuit in the circuit list that should be created.
-		 * @param to The last circuit in the circuit list that should be created.
-		 */
-		ReceiveThread(int i, int from, int to){
-			this.i = i;
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Builds the circuits from the start point to the end point in the circuit list.
-		 */
-		public void run(){
-			for (int j = from; j < to; j++) {
-				try {
-					receiveCircuit(j, i);
-				} catch (IOException e) {
-					// TODO Auto-generated catch block
-					e.printStackTrace();
-				}	
-			}
-		}
+		});
 	}
 	
 	private void receiveCircuit(int j, int i) throws IOException {
@@ -468,41 +405,42 @@ public class CutAndChooseVerifier {
 		//Receive the decommitments.
 		Expector expector = new Expector(channels[0], DecommitmentsPackage.class);
 		DecommitmentsPackage decommitments = (DecommitmentsPackage) expector.receive();
+		
+		int[] checkCircuits = new int[selection.checkCircuits().size()];
 		int counter = 0;
-		//For each checked circuit:
 		for (int j : selection.checkCircuits()) {
+			checkCircuits[counter++] = j;
+		}
+		
+		//Verify the seed and commitment mask of each checked circuit.
+		byte[][] seeds = new byte[checkCircuits.length][];
+		byte[][] commitmentMasks = new byte[checkCircuits.length][];
+		for (int i = 0; i < checkCircuits.length; i++) {
+			int j = checkCircuits[i];
+			seeds[i] = cmtReceiver.generateBytesFromCommitValue(cmtReceiver.verifyDecommitment(commitmentToSeed[j], decommitments.getIdDecommitment(i)));
+			commitmentMasks[i] = cmtReceiver.generateBytesFromCommitValue(cmtReceiver.verifyDecommitment(commitmentToCommitmentMask[j], decommitments.getMaskDecommitment(i)));
+		}
+		
+		//Garble all the checked circuits using the verified seeds and compare them to the received tables.
+		FastCircuitCreationValues[] wireValues = verifyGarbledTables(checkCircuits, seeds);
+		
+		for (int i = 0; i < checkCircuits.length; i++) {
+			int j = checkCircuits[i];
 			
-			//Verify the seed and commitment mask.
-			byte[] seed = cmtReceiver.generateBytesFromCommitValue(cmtReceiver.verifyDecommitment(commitmentToSeed[j], decommitments.getIdDecommitment(counter)));
-			byte[] commitmentMask = cmtReceiver.generateBytesFromCommitValue(cmtReceiver.verifyDecommitment(commitmentToCommitmentMask[j], decommitments.getMaskDecommitment(counter)));
-			
-			//Build the circuit using the verified seed.
-			Bundle circuitBundle = bundleBuilder.build(seed);
+			//Build the circuit using the verified seed. If the circuit was already garbled above, it is not garbled again.
+			Bundle circuitBundle = bundleBuilder.build(seeds[i], wireValues[i]);
 			
 			//Check that the verified mask is equal to the generated mask.
-			if (!Arrays.equals(circuitBundle.getCommitmentMask(), commitmentMask)) {
+			if (!Arrays.equals(circuitBundle.getCommitmentMask(), commitmentMasks[i])) {
 				throw new CheatAttemptException("decommitment of commitmentMask does not match the decommitted seed!");
 			}
 			
-			GarbledTablesHolder garbledTable = null;
-			if (filePrefix == null){
-				garbledTable = garbledTables[j];
-			} else{
-				//Open the file.
-				File file = new File(filePrefix + "GarbledTables."+j+".txt");
-				ObjectInput garbledTableFile = new ObjectInputStream(new BufferedInputStream(new FileInputStream(file)));
-				try {
-					garbledTable = (GarbledTablesHolder) garbledTableFile.readObject();
-					garbledTableFile.close();
-					file.delete();
-				} catch (ClassNotFoundException e) {
-					// Should not occur since the file contains GarbledTablesHolder.
+			if (wireValues[i] == null) {
+				GarbledTablesHolder garbledTable = getReceivedGarbledTables(j);
+				if (!checkEquality(circuitBundle.getGarbledTables().toDoubleByteArray(), (garbledTable.toDoubleByteArray()))) {
+					throw new CheatAttemptException("garbled tables does not match the decommitted seed!");
 				}
 			}
-			if (!checkEquality(circuitBundle.getGarbledTables().toDoubleByteArray(), (garbledTable.toDoubleByteArray()))) {
-				throw new CheatAttemptException("garbled tables does not match the decommitted seed!");
-			}
-			
 			
 			if (!Arrays.equals(circuitBundle.getTranslationTable(), translationTables[j])) {
 				throw new CheatAttemptException("translation tables does not match the decommitted seed!");
@@ -518,10 +456,80 @@ public class CutAndChooseVerifier {
 			verifyCommitmentsAreEqual(commitmentsOutput[j], circuitBundle.getCommitmentsOutputKeys());
 			
 			//Receive decommitments of the difference protocol.
-			diffProtocol.receiveDecommitment(j, counter, decommitments);
+			diffProtocol.receiveDecommitment(j, i, decommitments);
+		}
+	}
+	
+	/**
+	 * Garbles the checked circuits using their seeds and compares them to the received garbled and translation tables. <p>
+	 * When the circuits of the execution are native circuits, this is done in native batches, where the circuits of the execution 
+	 * (one for each thread) garble the seeds in parallel and there is a single call to the native code for the whole batch. 
+	 * There is a single batch, unless the garbled tables are kept in files; in that case each batch has a circuit for each thread,
+	 * so that only a few garbled tables are in the memory at once.<p>
+	 * Otherwise, nothing is done here and each circuit is garbled and compared when its bundle is built.
+	 * @param checkCircuits The indices of the checked circuits.
+	 * @param seeds The verified seed of each checked circuit.
+	 * @return The output of the garbling of each checked circuit, or an array of nulls if the circuits were not garbled here.
+	 * @throws CheatAttemptException If the tables of one of the circuits do not match its seed.
+	 */
+	private FastCircuitCreationValues[] verifyGarbledTables(int[] checkCircuits, byte[][] seeds) throws IOException, CheatAttemptException {
+		FastCircuitCreationValues[] wireValues = new FastCircuitCreationValues[checkCircuits.length];
+		
+		FastGarbledBooleanCircuit[] circuits = execution.getCircuits();
+		ScNativeGarbledBooleanCircuit[] nativeCircuits = new ScNativeGarbledBooleanCircuit[circuits.length];
+		for (int i = 0; i < circuits.length; i++) {
+			if (!(circuits[i] instanceof ScNativeGarbledBooleanCircuit)) {
+				return wireValues;
+			}
+			nativeCircuits[i] = (ScNativeGarbledBooleanCircuit) circuits[i];
+		}
+		
+		int batchSize = (filePrefix == null) ? checkCircuits.length : nativeCircuits.length;
+		for (int from = 0; from < checkCircuits.length; from += batchSize) {
+			int size = Math.min(batchSize, checkCircuits.length - from);
+			byte[][] garblingSeeds = new byte[size][];
+			GarbledTablesHolder[] receivedTables = new GarbledTablesHolder[size];
+			byte[][] translation = new byte[size][];
+			FastCircuitCreationValues[] values = new FastCircuitCreationValues[size];
+			for (int k = 0; k < size; k++) {
+				int j = checkCircuits[from + k];
+				garblingSeeds[k] = BundleBuilder.getGarblingSeed(seeds[from + k]);
+				receivedTables[k] = getReceivedGarbledTables(j);
+				translation[k] = translationTables[j];
+			}
 			
-			counter++;
+			boolean[] verified = ScNativeGarbledBooleanCircuit.verifyGarbledCircuits(nativeCircuits, garblingSeeds, receivedTables, translation, values);
+			for (int k = 0; k < size; k++) {
+				if (!verified[k]) {
+					throw new CheatAttemptException("garbled tables does not match the decommitted seed!");
+				}
+				wireValues[from + k] = values[k];
+			}
+		}
+		return wireValues;
+	}
+	
+	/**
+	 * Returns the received garbled tables of the given circuit. If the tables are kept in a file, the file is read and deleted.
+	 * @param j The index of the circuit.
+	 */
+	private GarbledTablesHolder getReceivedGarbledTables(int j) throws IOException {
+		if (filePrefix == null){
+			return garbledTables[j];
+		}
+		
+		//Open the file.
+		File file = new File(filePrefix + "GarbledTables."+j+".txt");
+		ObjectInput garbledTableFile = new ObjectInputStream(new BufferedInputStream(new FileInputStream(file)));
+		GarbledTablesHolder garbledTable = null;
+		try {
+			garbledTable = (GarbledTablesHolder) garbledTableFile.readObject();
+			garbledTableFile.close();
+			file.delete();
+		} catch (ClassNotFoundException e) {
+			// Should not occur since the file contains GarbledTablesHolder.
 		}
+		return garbledTable;
 	}
 	
 	private boolean checkEquality(byte[][] array1, byte[][] array2) {
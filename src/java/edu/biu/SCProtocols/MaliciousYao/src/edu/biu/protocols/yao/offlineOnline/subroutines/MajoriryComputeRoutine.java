@@ -5,6 +5,7 @@ import java.util.HashMap;
 import edu.biu.protocols.yao.primitives.CircuitEvaluationResult;
 import edu.biu.protocols.yao.primitives.CryptoPrimitives;
 import edu.biu.protocols.yao.primitives.CutAndChooseSelection;
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.exceptions.NotAllInputsSetException;
@@ -22,7 +23,7 @@ public class MajoriryComputeRoutine implements ComputeCircuitsRoutine {
 	private final FastGarbledBooleanCircuit[] garbledCircuits;		// The circuits to work on. There is one circuit per thread.
 	private HashMap<Integer, byte[]> allOutputs;					// Contains the output of each circuit.
 	private byte[] majorityOutput;									// The output of majority of the circuits.
-	private int numOfThreads;										// Number of threads to use while computing the circuits.
+	private final ParallelExecutor executor;						// Runs the computation of the circuits on its threads.
 
 	/**
 	 * A constructor that sets the given parameters.
@@ -35,78 +36,17 @@ public class MajoriryComputeRoutine implements ComputeCircuitsRoutine {
 		this.garbledCircuits = garbledCircuits;
 		this.allOutputs = new HashMap<Integer, byte[]>();
 		this.majorityOutput = null;
-		this.numOfThreads = primitives.getNumOfThreads();
+		this.executor = primitives.getExecutor();
 	}
 	
 	@Override
 	public void computeCircuits() throws CheatAttemptException {
-		int sizeOfEvalCircuits = selection.evalCircuits().size();
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
-		if (numOfThreads >0){
-			
-			//In case the number of thread is less than the number of eval circuits, there is no point to create all the threads.
-			//In this case, create only number of threads as the number of eval circuits and assign one circuit to each thread.
-			int threadCount = (numOfThreads < sizeOfEvalCircuits) ? numOfThreads : sizeOfEvalCircuits;
-			ComputeThread[] threads = new ComputeThread[threadCount];
-			
-			//Calculate the number of circuit in each thread and the remaining.
-			int remain = sizeOfEvalCircuits % threadCount;
-			int numOfCircuits =  sizeOfEvalCircuits / threadCount;
-			
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j=0; j<threadCount; j++){
-				if ((j < (threadCount - 1)) || (remain == 0) ){
-					threads[j] = new ComputeThread(j*numOfCircuits, (j+1)*numOfCircuits);
-				} else {
-					threads[j] = new ComputeThread(j*numOfCircuits, sizeOfEvalCircuits);
-				}
-				//Start all threads.
-				threads[j].start();
-			}
-			
-			//Wait until all threads finish their job.
-			for (int i=0; i<threadCount; i++) {
-				
-				try {
-					threads[i].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
-				}
+		//Compute the circuits on the threads of the executor. The idle threads take circuits from the busy ones.
+		executor.forRange(selection.evalCircuits().size(), new ParallelExecutor.RangeTask() {
+			public void run(int from, int to) {
+				computeCircuit(from, to);
 			}
-		} else {
-			//In case no thread should be created, compute all the circuits directly.
-			computeCircuit(0, sizeOfEvalCircuits);
-		}
-	}
-	
-	/**
-	 * Inner thread class that compute the circuits in a separate thread.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Asaf Cohen)
-	 *
-	 */
-	public class ComputeThread extends Thread{
-		
-		private int from;				// The first circuit in the circuit list that should be computed.
-		private int to;					// The last circuit in the circuit list that should be computed.
-		
-		/**
-		 * Constructor that sets the parameters.
-		 * @param from The first circuit in the circuit list that should be computed.
-		 * @param to The last circuit in the circuit list that should be computed.
-		 */
-		public ComputeThread(int from, int to){
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Computes the circuits from the start point to the end point in the circuit list.
-		 */
-		public void run() {
-			computeCircuit(from, to);
-		}
+		});
 	}
 	
 	/**
@@ -128,7 +68,9 @@ public class MajoriryComputeRoutine implements ComputeCircuitsRoutine {
 				//Translate the garbled output.
 				byte[] output =  circuit.translate(garbledOutput);
 				//Save the boolean output in the outputs map.
-				allOutputs.put((Integer) indices[i], output);
+				synchronized (allOutputs) {
+					allOutputs.put((Integer) indices[i], output);
+				}
 			} catch (NotAllInputsSetException e) {
 				throw new IllegalStateException();
 			} catch (IllegalArgumentException e) {
@@ -9,6 +9,7 @@ import javax.crypto.spec.SecretKeySpec;
 import edu.biu.protocols.yao.common.KeyUtils;
 import edu.biu.protocols.yao.primitives.CircuitEvaluationResult;
 import edu.biu.protocols.yao.primitives.CryptoPrimitives;
+import edu.biu.protocols.yao.primitives.ParallelExecutor;
 import edu.biu.scapi.circuits.encryption.MultiKeyEncryptionScheme;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
 import edu.biu.scapi.exceptions.InvalidInputException;
@@ -33,7 +34,7 @@ public class OnlineComputeRoutine implements ComputeCircuitsRoutine {
 	private final KeyDerivationFunction kdf;
 	private final MultiKeyEncryptionScheme mes;
 	private final int keyLength;
-	private int numOfThreads;
+	private final ParallelExecutor executor;		// Runs the computation of the circuits on its threads.
 	
 	// The proof of cheating in case no all the circuits output the same result.
 	private final byte[][][][] proofCiphers;
@@ -70,76 +71,17 @@ public class OnlineComputeRoutine implements ComputeCircuitsRoutine {
 		this.computedOutputWires = new HashMap<Integer, byte[]>();
 		this.translations = new HashMap<Integer, byte[]>();
 		this.proofOfCheating = null;
-		this.numOfThreads = primitives.getNumOfThreads();
+		this.executor = primitives.getExecutor();
 	}
 	
 	@Override
 	public void computeCircuits() {
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
-		if (numOfThreads > 0){
-			//In case the number of thread is less than the number of eval circuits, there is no point to create all the threads.
-			//In this case, create only number of threads as the number of eval circuits and assign one circuit to each thread.
-			int threadCount = (numOfThreads < garbledCircuits.length) ? numOfThreads : garbledCircuits.length;
-			ComputeThread[] threads = new ComputeThread[threadCount];
-			
-			//Calculate the number of circuit in each thread and the remainder.
-			int remain = garbledCircuits.length % threadCount;
-			int numOfCircuits =  garbledCircuits.length / threadCount;
-			
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j = 0; j < threadCount; j++) {
-				if ((j < (threadCount - 1)) || (remain == 0) ){
-					threads[j] = new ComputeThread(j*numOfCircuits, (j+1)*numOfCircuits);
-				} else {
-					threads[j] = new ComputeThread(j*numOfCircuits, garbledCircuits.length);
-				}
-				//Start all threads.
-				threads[j].start();
+		//Compute the circuits on the threads of the executor. The idle threads take circuits from the busy ones.
+		executor.forRange(garbledCircuits.length, new ParallelExecutor.RangeTask() {
+			public void run(int from, int to) {
+				computeCircuit(from, to);
 			}
-			
-			//Wait until all threads finish their job.
-			for (int j = 0; j < threadCount; j++) {
-				try {
-					threads[j].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
-				}
-			}
-			
-		//In case no thread should be created, compute all the circuits directly.
-		} else{
-			computeCircuit(0, garbledCircuits.length);
-		}
-	}
-	
-	/**
-	 * Inner thread class that compute the circuits in a separate thread.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya farbstein)
-	 *
-	 */
-	public class ComputeThread extends Thread{
-		
-		private int from;				// The first circuit in the circuit list that should be computed.
-		private int to;					// The last circuit in the circuit list that should be computed.
-		
-		/**
-		 * Constructor that sets the parameters.
-		 * @param from The first circuit in the circuit list that should be computed.
-		 * @param to The last circuit in the circuit list that should be computed.
-		 */
-		public ComputeThread(int from, int to){
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Computes the circuits from the start point to the end point in the circuit list.
-		 */
-		public void run() {
-			computeCircuit(from, to);
-		}
+		});
 	}
 	
 	/**
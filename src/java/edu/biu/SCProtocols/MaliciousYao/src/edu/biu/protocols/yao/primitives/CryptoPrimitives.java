@@ -36,6 +36,7 @@ public class CryptoPrimitives {
 	private final SecureRandom random;
 	private final int statisticalParameter;
 	private final int numOfThreads;
+	private final ParallelExecutor executor;
 	
 	/**
 	 * A constructor that gets a builder and sets the initial members.
@@ -50,6 +51,8 @@ public class CryptoPrimitives {
 		this.random = builder.random;
 		this.statisticalParameter = builder.statisticalParameter;
 		this.numOfThreads = builder.numOfThreads;
+		//The threads are created once, and used by all the executions of the protocol that use these primitives.
+		this.executor = (builder.executor != null) ? builder.executor : new ParallelExecutor(builder.numOfThreads);
 	}
 	
 	/**
@@ -100,6 +103,13 @@ public class CryptoPrimitives {
 	public int getNumOfThreads() {
 		return numOfThreads;
 	}
+	
+	/**
+	 * Returns the executor that runs the parallel parts of the protocol, using getNumOfThreads() threads.
+	 */
+	public ParallelExecutor getExecutor() {
+		return executor;
+	}
 
 	/**
 	 * Inner class that builds the default primitives.
@@ -115,6 +125,7 @@ public class CryptoPrimitives {
 		private SecureRandom random = null;
 		private int statisticalParameter = 0;
 		private int numOfThreads;
+		private ParallelExecutor executor = null;
 
 		/**
 		 * Sets the given Dlog group.
@@ -172,6 +183,16 @@ public class CryptoPrimitives {
 			return this;
 		}
 
+		/**
+		 * Sets an existing executor, so that the threads are shared with other CryptoPrimitives objects. <p>
+		 * The executor should have the number of threads that is given to numOfThreads. 
+		 * If no executor is set, a new one is created.
+		 */
+		public Builder executor(ParallelExecutor executor) {
+			this.executor = executor;
+			return this;
+		}
+
 		/**
 		 * Created a CryptoPrimitives object using this builder instance.
 		 */
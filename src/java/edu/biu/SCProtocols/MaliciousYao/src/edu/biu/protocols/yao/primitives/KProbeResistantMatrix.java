@@ -25,30 +25,43 @@ import edu.biu.scapi.circuits.encryption.MultiKeyEncryptionScheme;
 public class KProbeResistantMatrix implements Serializable {
 	
 	/**
-	 * Native function that restore the original keys using the matrix from the given keys.
-	 * @param receivedKeys the transformed keys.
-	 * @param matrix The K probe-resistant matrix to use in order to restore the keys.
+	 * Native function that packs the matrix to a bit per entry. The packed matrix is used by all the following calls.
+	 * @param matrix The K probe-resistant matrix.
 	 * @param n matrix's rows.
 	 * @param m matrix's columns.
+	 * @return a pointer to the native packed matrix.
+	 */
+	private native long createMatrix(byte[][] matrix, int n, int m);
+	
+	/**
+	 * Native function that deletes the packed matrix.
+	 */
+	private native void deleteMatrix(long nativeMatrix);
+	
+	/**
+	 * Native function that restore the original keys using the matrix from the given keys.
+	 * @param nativeMatrix The packed K probe-resistant matrix to use in order to restore the keys.
+	 * @param receivedKeys the transformed keys, one after the other.
 	 * @param retoredKeys The result keys of the function.
 	 */
-	private native void restoreKeys(byte[] receivedKeys, byte[][] matrix, int n, int m, byte[] retoredKeys);
+	private native void restoreKeys(long nativeMatrix, byte[] receivedKeys, byte[] retoredKeys);
 	
 	/**
 	 * Native function that transform the original keys into the extended keys using the matrix.
-	 * @param originalKeys the keys to transform.
+	 * @param nativeMatrix The packed K probe-resistant matrix to use in order to transform the keys.
+	 * @param originalKeys the keys to transform, two for each row one after the other.
 	 * @param probeResistantKeys the transformed keys. Will be filled during the function execution.
-	 * @param n matrix's rows.
-	 * @param m matrix's columns.
-	 * @param matrix The K probe-resistant matrix to use in order to restore the keys.
+	 * @param seed used to generate the new keys.
+	 * @return false if a row of the matrix had no unallocated column, that is, the matrix is not K probe-resistant.
 	 */
-	private native void transformKeys(byte[] originalKeys, byte[] probeResistantKeys, byte[] seed, int n, int m, byte[][] matrix);
+	private native boolean transformKeys(long nativeMatrix, byte[] originalKeys, byte[] probeResistantKeys, byte[] seed);
 	
 	private static final long serialVersionUID = 5332169146342967655L;
 	
 	private final byte[][] matrix; 	//The K probe-resistant matrix.
 	private final int n;			//Number of matrix's rows.
 	private final int m;			//Number of matrix's columns.
+	private transient long nativeMatrix;	//The native packed matrix. Created on first use, also after the matrix is read from a file.
 	
 	/**
 	 * A constructor that sets the given matrix.
@@ -98,7 +111,9 @@ public class KProbeResistantMatrix implements Serializable {
 		byte[] seed = mes.generateKey().getEncoded();
 		
 		//Call the native function that transform the keys.
-		transformKeys(originalKeys, probeResistantKeys, seed, n, m, matrix);
+		if (!transformKeys(getNativeMatrix(), originalKeys, probeResistantKeys, seed)) {
+			throw new IllegalStateException("this is not a k-probe resistant matrix: could not transform keys!");
+		}
 		
 		//Return the new transformed keys.
 		return probeResistantKeys;
@@ -176,11 +191,31 @@ public class KProbeResistantMatrix implements Serializable {
 		byte[] restoredKeysArray = new byte[16*n];
 
 		//Call the native function that computes the restoring.
-		restoreKeys(receivedKeys, matrix, n, m, restoredKeysArray);
+		restoreKeys(getNativeMatrix(), receivedKeys, restoredKeysArray);
 		
 		return restoredKeysArray;
 	}
 	
+	/**
+	 * Returns the native packed matrix, packing the matrix on the first call.
+	 */
+	private synchronized long getNativeMatrix() {
+		if (nativeMatrix == 0) {
+			nativeMatrix = createMatrix(matrix, n, m);
+		}
+		return nativeMatrix;
+	}
+	
+	/**
+	 * Deletes the native packed matrix.
+	 */
+	protected void finalize() throws Throwable {
+		if (nativeMatrix != 0) {
+			deleteMatrix(nativeMatrix);
+		}
+		super.finalize();
+	}
+	
 	/**
 	 * Saves the matrix to a file.
 	 * @param matrix The matrix to write to the file.
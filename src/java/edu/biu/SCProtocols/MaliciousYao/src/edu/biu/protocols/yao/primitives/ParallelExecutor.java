@@ -0,0 +1,177 @@
+package edu.biu.protocols.yao.primitives;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+import java.util.concurrent.RecursiveAction;
+
+/**
+ * This class runs the parallel parts of the protocol (garbling, receiving and computing the circuits, verifying the
+ * input keys, etc.) on a single pool of threads that lives as long as the protocol objects. <p>
+ *
+ * Earlier, every subroutine created its own threads in each execution and split the circuits statically between them.
+ * When the protocol runs many executions with small circuits, creating and joining these threads takes a large part of
+ * the execution. Here the threads are created once and reused by all the subroutines and executions. <P>
+ *
+ * There are two kinds of parallel loops: <P>
+ * 1. {@link #forRange} - for work that only uses the CPU. The range is split recursively and the idle threads steal
+ * the parts of the busy ones, so circuits of different costs are balanced between the threads. <P>
+ * 2. {@link #forPartitions} - for work that uses the channels. Each channel carries the messages of a fixed part of the
+ * circuits in order, so the partition must be the same in both parties. It is the partition that was used by the threads
+ * of the earlier versions: numOfThreads parts of equal size where the last part gets also the remaining circuits. <p>
+ *
+ * An executor with zero threads runs all the work in the calling thread.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ParallelExecutor {
+	private final int numOfThreads;			// The number of threads in the pool. Zero means no pool.
+	private final ForkJoinPool pool;		// The worker threads.
+
+	/**
+	 * An interface for a loop body that works on a range of indices.
+	 */
+	public interface RangeTask {
+		/**
+		 * Works on the indices from (inclusive) to to (exclusive).
+		 */
+		void run(int from, int to);
+	}
+
+	/**
+	 * An interface for a loop body that works on a fixed part of the indices, using the channel of that part.
+	 */
+	public interface PartitionTask {
+		/**
+		 * Works on the indices from (inclusive) to to (exclusive), which are the indices of the given part.
+		 * @throws IOException In case of a problem during the communication.
+		 */
+		void run(int partition, int from, int to) throws IOException;
+	}
+
+	/**
+	 * A constructor that creates the threads of the executor.
+	 * @param numOfThreads The number of threads to use. In case of zero, all the work is done in the calling thread.
+	 */
+	public ParallelExecutor(int numOfThreads) {
+		this.numOfThreads = numOfThreads;
+		this.pool = (numOfThreads > 0) ? new ForkJoinPool(numOfThreads) : null;
+	}
+
+	/**
+	 * Returns the number of threads of the executor.
+	 */
+	public int getNumOfThreads() {
+		return numOfThreads;
+	}
+
+	/**
+	 * Runs the given task on all the indices in [0, size), using all the threads.
+	 * @param size The number of indices.
+	 * @param task The loop body.
+	 */
+	public void forRange(int size, RangeTask task) {
+		if (pool == null || size <= 1) {
+			task.run(0, size);
+			return;
+		}
+
+		//Split the range into parts that are small enough to be stolen by idle threads.
+		int grain = Math.max(1, size / (4 * numOfThreads));
+		pool.invoke(new RangeAction(task, 0, size, grain));
+	}
+
+	/**
+	 * Runs the given task on each part of the indices in [0, size). <p>
+	 * There are numOfThreads parts (or one part in case of zero threads). As long as the executor does not run other work
+	 * at the same time, all the parts run at the same time, so the order of the messages between the channels does not matter.
+	 * @param size The number of indices.
+	 * @param task The loop body.
+	 * @throws IOException In case one of the parts threw an IOException.
+	 */
+	public void forPartitions(int size, final PartitionTask task) throws IOException {
+		if (pool == null) {
+			task.run(0, 0, size);
+			return;
+		}
+
+		//Calculate the number of indices in each part and the remaining.
+		int sizeOfPart = size / numOfThreads;
+		int remain = size % numOfThreads;
+		List<Callable<Void>> parts = new ArrayList<Callable<Void>>(numOfThreads);
+		for (int j = 0; j < numOfThreads; j++) {
+			final int partition = j;
+			final int from = j * sizeOfPart;
+			//The last part gets also the remaining indices.
+			final int to = (j != numOfThreads - 1) ? (j + 1) * sizeOfPart : (j + 1) * sizeOfPart + remain;
+			parts.add(new Callable<Void>() {
+				public Void call() throws IOException {
+					task.run(partition, from, to);
+					return null;
+				}
+			});
+		}
+
+		//Wait until all parts finish their job and throw the first failure, if there is one.
+		List<Future<Void>> results = pool.invokeAll(parts);
+		for (Future<Void> result : results) {
+			try {
+				result.get();
+			} catch (InterruptedException e) {
+				throw new IllegalStateException(e);
+			} catch (ExecutionException e) {
+				Throwable cause = e.getCause();
+				if (cause instanceof IOException) {
+					throw (IOException) cause;
+				} else if (cause instanceof RuntimeException) {
+					throw (RuntimeException) cause;
+				} else if (cause instanceof Error) {
+					throw (Error) cause;
+				}
+				throw new IllegalStateException(cause);
+			}
+		}
+	}
+
+	/**
+	 * Stops the threads of the executor. The executor should not be used after this call.
+	 */
+	public void shutdown() {
+		if (pool != null) {
+			pool.shutdown();
+		}
+	}
+
+	/**
+	 * Splits a range in halves until it is not larger than the grain, and runs the task on each part.
+	 */
+	private static class RangeAction extends RecursiveAction {
+		private static final long serialVersionUID = 2907215563427340372L;
+		private final RangeTask task;
+		private final int from;
+		private final int to;
+		private final int grain;
+
+		RangeAction(RangeTask task, int from, int to, int grain) {
+			this.task = task;
+			this.from = from;
+			this.to = to;
+			this.grain = grain;
+		}
+
+		@Override
+		protected void compute() {
+			if (to - from <= grain) {
+				task.run(from, to);
+			} else {
+				int middle = (from + to) >>> 1;
+				invokeAll(new RangeAction(task, from, middle, grain), new RangeAction(task, middle, to, grain));
+			}
+		}
+	}
+}
@@ -0,0 +1,170 @@
+package edu.biu.SCProtocols.NativeSemiHonestYao;
+
+import java.util.Arrays;
+
+import edu.biu.scapi.comm.Protocol;
+import edu.biu.scapi.comm.ProtocolInput;
+import edu.biu.scapi.comm.ProtocolOutput;
+
+/**
+ * Runs many iterations of the native semi honest Yao protocol in a pipeline. <p>
+ *
+ * The native YaoParty runs the iterations one after the other: each iteration garbles the circuit, runs the OT, sends the circuit
+ * and evaluates it before the next iteration begins, so the CPU is idle while waiting for the network and the network is idle
+ * while garbling. <p>
+ *
+ * This class holds a number of native parties (the pipeline depth), each one with its own config file and therefore its own channel,
+ * and runs them at the same time. Iteration i is executed by the party i mod depth, so while one party runs the OT and the
+ * evaluation of iteration i, the next party already garbles iteration i+1. Both parties of the protocol should use the same depth
+ * and the same order of config files. <p>
+ *
+ * The time of each iteration and the throughput of all the iterations are available after the run.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class PipelinedYaoParty implements Protocol {
+
+	private YaoParty[] parties;			//The native party of each stage in the pipeline.
+	private YaoProtocolOutput output;	//The output of the last iteration.
+	private double[] iterationMillis;	//The time from the beginning to the end of each iteration.
+	private double totalMillis;			//The time of all the iterations.
+
+	/**
+	 * Creates the native parties. The input should contain a config file for each stage of the pipeline.
+	 */
+	@Override
+	public void start(ProtocolInput protocolInput) {
+		if (!(protocolInput instanceof PipelinedYaoProtocolInput)){
+			throw new IllegalArgumentException("The givan input should be an instance of PipelinedYaoProtocolInput");
+		}
+
+		PipelinedYaoProtocolInput input = (PipelinedYaoProtocolInput) protocolInput;
+		String[] configFiles = input.getConfigFileNames();
+		parties = new YaoParty[configFiles.length];
+		for (int i = 0; i < parties.length; i++) {
+			parties[i] = new YaoParty();
+			parties[i].start(new YaoProtocolInput(input.getID(), configFiles[i]));
+		}
+	}
+
+	/**
+	 * Runs the number of iterations given in the first config file.
+	 */
+	@Override
+	public void run() {
+		final int numOfIterations = parties[0].getNumberOfIterations();
+		final long[] startTimes = new long[numOfIterations];
+		final long[] endTimes = new long[numOfIterations];
+		final YaoProtocolOutput[] lastOutput = new YaoProtocolOutput[1];
+		final Throwable[] failure = new Throwable[1];
+
+		Thread[] stages = new Thread[parties.length];
+		long start = System.nanoTime();
+		for (int j = 0; j < parties.length; j++) {
+			final int stage = j;
+			stages[j] = new Thread() {
+				public void run() {
+					try {
+						//Each stage executes its iterations in order, so that both parties execute the same iteration on each channel.
+						for (int i = stage; i < numOfIterations; i += parties.length) {
+							startTimes[i] = System.nanoTime();
+							YaoProtocolOutput iterationOutput = parties[stage].runIteration();
+							endTimes[i] = System.nanoTime();
+							if (i == numOfIterations - 1) {
+								lastOutput[0] = iterationOutput;
+							}
+						}
+					} catch (Throwable e) {
+						synchronized (failure) {
+							failure[0] = e;
+						}
+					}
+				}
+			};
+			stages[j].start();
+		}
+
+		//Wait until all stages finish their iterations.
+		for (int j = 0; j < stages.length; j++) {
+			try {
+				stages[j].join();
+			} catch (InterruptedException e) {
+				throw new IllegalStateException(e);
+			}
+		}
+		totalMillis = (System.nanoTime() - start) / 1000000.0;
+		if (failure[0] != null) {
+			throw new IllegalStateException("a stage of the pipeline failed", failure[0]);
+		}
+
+		iterationMillis = new double[numOfIterations];
+		for (int i = 0; i < numOfIterations; i++) {
+			iterationMillis[i] = (endTimes[i] - startTimes[i]) / 1000000.0;
+		}
+		output = lastOutput[0];
+	}
+
+	/**
+	 * Returns the output of the last iteration.
+	 */
+	@Override
+	public ProtocolOutput getOutput() {
+		return output;
+	}
+
+	/**
+	 * Returns the time of each iteration in milliseconds.
+	 */
+	public double[] getIterationMillis() {
+		return iterationMillis;
+	}
+
+	/**
+	 * Returns the time of all the iterations in milliseconds.
+	 */
+	public double getTotalMillis() {
+		return totalMillis;
+	}
+
+	/**
+	 * Returns the number of iterations that were executed in a second.
+	 */
+	public double getThroughput() {
+		return iterationMillis.length * 1000.0 / totalMillis;
+	}
+
+	/**
+	 * Prints the average, median, minimum and maximum time of the iterations and the throughput.
+	 * @param iterationMillis The time of each iteration.
+	 * @param totalMillis The time of all the iterations.
+	 */
+	public static void printStatistics(double[] iterationMillis, double totalMillis) {
+		if (iterationMillis.length == 0) {
+			return;
+		}
+		double[] sorted = iterationMillis.clone();
+		Arrays.sort(sorted);
+		double sum = 0;
+		for (double millis : sorted) {
+			sum += millis;
+		}
+		System.out.println(String.format("%d iterations: average %.3f ms, median %.3f ms, min %.3f ms, max %.3f ms per iteration",
+				sorted.length, sum / sorted.length, sorted[sorted.length / 2], sorted[0], sorted[sorted.length - 1]));
+		System.out.println(String.format("throughput: %.2f iterations per second", sorted.length * 1000.0 / totalMillis));
+	}
+
+	public static void main(String[] args) {
+		int id = new Integer(args[0]);
+		String[] configFiles = Arrays.copyOfRange(args, 1, args.length);
+
+		PipelinedYaoParty party = new PipelinedYaoParty();
+		party.start(new PipelinedYaoProtocolInput(id, configFiles));
+		party.run();
+		System.out.println("pipeline of depth " + configFiles.length + " took " + (long) party.getTotalMillis() + " millis.");
+		printStatistics(party.getIterationMillis(), party.getTotalMillis());
+
+		byte[] outputBytes = ((YaoProtocolOutput) party.getOutput()).getOutput();
+		System.out.println("output lentgh = " + outputBytes.length);
+	}
+}
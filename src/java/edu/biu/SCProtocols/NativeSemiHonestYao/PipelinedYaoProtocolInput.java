@@ -0,0 +1,36 @@
+package edu.biu.SCProtocols.NativeSemiHonestYao;
+
+import edu.biu.scapi.comm.ProtocolInput;
+
+/**
+ * This class manage the input for the pipelined Yao protocol. <p>
+ * The input are the id of the party and the names of the config files, one for each stage of the pipeline. <p>
+ * The parties of each stage communicate on their own channel, so each config file should set different ports.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class PipelinedYaoProtocolInput implements ProtocolInput {
+
+	private int id;
+	private String[] configFileNames;	//The config file of each stage. The number of files is the depth of the pipeline.
+
+	public PipelinedYaoProtocolInput(int id, String[] configFileNames){
+		if (id < 1 || id > 2){
+			throw new IllegalArgumentException("Party id should be 1 or 2");
+		}
+		if (configFileNames.length == 0){
+			throw new IllegalArgumentException("At least one config file should be given");
+		}
+		this.id = id;
+		this.configFileNames = configFileNames;
+	}
+
+	public int getID(){
+		return id;
+	}
+
+	public String[] getConfigFileNames(){
+		return configFileNames;
+	}
+}
@@ -21,6 +21,9 @@ public class YaoParty implements Protocol{
 	private native long createYaoParty(int id, String configFileName);
 	private native byte[] runProtocol(int id, long nativeParty);
 	private native void deleteYao(int id, long nativeParty);
+	private native byte[] runIteration(int id, long nativeParty);
+	private native int getNumberOfIterations(int id, long nativeParty);
+	private native double[] getIterationMillis(long nativeParty);
 	
 	@Override
 	public void start(ProtocolInput protocolInput) {
@@ -29,7 +32,12 @@ public class YaoParty implements Protocol{
 		}
 		
 		YaoProtocolInput input = (YaoProtocolInput) protocolInput;
-		nativeParty = createYaoParty(input.getID(), input.getConfigFileName());
+		long party = createYaoParty(input.getID(), input.getConfigFileName());
+		//The native code does not create a party for an id other than 1 or 2.
+		if (party == 0){
+			throw new IllegalArgumentException("The party id should be 1 or 2");
+		}
+		nativeParty = party;
 		id = input.getID();
 	}
 
@@ -39,11 +47,36 @@ public class YaoParty implements Protocol{
 		output = new YaoProtocolOutput(nativeOutput);
 	}
 
+	/**
+	 * Runs a single iteration of the protocol. <p>
+	 * The other party should also run a single iteration.
+	 * @return the output of the iteration.
+	 */
+	public YaoProtocolOutput runIteration() {
+		output = new YaoProtocolOutput(runIteration(id, nativeParty));
+		return output;
+	}
+
 	@Override
 	public ProtocolOutput getOutput() {
 		return output;
 	}
 	
+	/**
+	 * Returns the number of iterations that is given in the config file. This is the number of iterations executed by run().
+	 */
+	public int getNumberOfIterations() {
+		return getNumberOfIterations(id, nativeParty);
+	}
+	
+	/**
+	 * Returns the time of each iteration in milliseconds, as measured by the native party.<p>
+	 * The times are of the iterations of the last call to run(), followed by the iterations of the calls to runIteration() since then.
+	 */
+	public double[] getIterationMillis() {
+		return getIterationMillis(nativeParty);
+	}
+	
 	/**
 	 * deletes the related Yao object
 	 */
@@ -72,6 +105,7 @@ public class YaoParty implements Protocol{
 		long end = System.nanoTime();
 		long time =(end - start) / 1000000;
 		System.out.println("yao protocol took " + time + " millis.");
+		PipelinedYaoParty.printStatistics(party.getIterationMillis(), time);
 		YaoProtocolOutput output = (YaoProtocolOutput) party.getOutput();
 		byte[] outputBytes = output.getOutput();
 		System.out.println("output lentgh = " + outputBytes.length);
@@ -5,14 +5,29 @@ import edu.biu.scapi.comm.Protocol;
 import edu.biu.scapi.comm.ProtocolInput;
 import edu.biu.scapi.comm.ProtocolOutput;
 
+/**
+ * This is a wrapper to the native implementation of the Yao protocol in the single execution setting. <p>
+ *
+ * The same party can run many executions of the protocol, each one with an offline phase and then an online phase (or run(), which
+ * executes both). The inputs of the next execution can be changed using setInputs, including the first one. 
+ * The native party of an execution is created (and connects to the other party) when the execution begins, so start returns without 
+ * waiting for the other party. <p>
+ * The circuit is converted to the format of the native implementation once, and the converted circuit is shared by all the
+ * executions and by all the parties that use the same circuit.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
 public class YaoSEParty implements Protocol {
 
 	private long nativeParty;			//A pointer to the native implementation
 	private YaoProtocolOutput output;	//The output of the protocol
+	private boolean offlineDone;		//Indicates that the offline phase of the current execution was executed
 	
 	//JNI functions that call the native implementation
 	private native long createYaoSEParty(int id, String circuitFileName, String ip, int port, 
 			String inputsFileName);
+	private native void setInputs(long nativeParty, String inputsFileName);
 	private native byte[] runProtocol(long nativeParty);
 	private native void runOfflineProtocol(long nativeParty);
 	private native byte[] runOnlineProtocol(long nativeParty);
@@ -32,17 +47,40 @@ public class YaoSEParty implements Protocol {
 
 	@Override
 	public void run() {
+		if (offlineDone) {
+			throw new IllegalStateException("runOnline should be called after runOffline");
+		}
 		//Executes the native protocol
 		byte[] nativeOutput = runProtocol(nativeParty);
 		output = new YaoProtocolOutput(nativeOutput);
 	}
 	
+	/**
+	 * Sets the inputs file of the next execution. 
+	 * Should be called before the offline phase (or run) of the execution, since the inputs are read when it begins.
+	 * @param inputsFileName The new inputs file.
+	 */
+	public void setInputs(String inputsFileName){
+		if (offlineDone) {
+			throw new IllegalStateException("the inputs can not be changed between the offline and the online phases");
+		}
+		setInputs(nativeParty, inputsFileName);
+	}
+	
 	public void runOffline(){
+		if (offlineDone) {
+			throw new IllegalStateException("runOnline should be called after runOffline");
+		}
 		//Executes the offline phase protocol
 		runOfflineProtocol(nativeParty);
+		offlineDone = true;
 	}
 	
 	public void runOnline(){
+		if (!offlineDone) {
+			throw new IllegalStateException("runOffline should be called before each call to runOnline");
+		}
+		offlineDone = false;
 		//Executes the online phase protocol
 		byte[] nativeOutput = runOnlineProtocol(nativeParty);
 		output = new YaoProtocolOutput(nativeOutput);
@@ -54,11 +92,11 @@ public class YaoSEParty implements Protocol {
 	}
 	
 	/**
-	 * deletes the related GMW object
+	 * deletes the related Yao object
 	 */
 	protected void finalize() throws Throwable {
 
-		// delete the dynamic allocation of GMW party pointer.
+		// delete the dynamic allocation of Yao party pointer.
 		deleteYaoSE(nativeParty);
 
 		super.finalize();
@@ -76,15 +114,23 @@ public class YaoSEParty implements Protocol {
 		String ip = args[2];
 		int port = new Integer(args[3]); 
 		String inputsFile = args[4];
+		//The number of executions and optionally a different inputs file for each of them.
+		int numOfExecutions = (args.length > 5) ? new Integer(args[5]) : 1;
 		
 		YaoSEProtocolInput input = new YaoSEProtocolInput(id, circuitFile, ip, port, inputsFile);
 		YaoSEParty party = new YaoSEParty();
 		party.start(input);
-		long start = System.nanoTime();
-		party.run();
-		long end = System.nanoTime();
-		long time =(end - start) / 1000000;
-		System.out.println("yao single execution protocol took " + time + " millis.");
+		for (int i = 0; i < numOfExecutions; i++) {
+			if (args.length > 6 + i) {
+				party.setInputs(args[6 + i]);
+			}
+			long start = System.nanoTime();
+			party.runOffline();
+			long offline = System.nanoTime();
+			party.runOnline();
+			long end = System.nanoTime();
+			System.out.println("execution " + i + ": offline took " + (offline - start) / 1000000 + " millis, online took " + (end - offline) / 1000000 + " millis.");
+		}
 		System.out.println("protocol output:");
 		YaoProtocolOutput output = (YaoProtocolOutput) party.getOutput();
 		byte[] outputBytes = output.getOutput();
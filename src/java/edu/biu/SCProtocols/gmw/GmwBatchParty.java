@@ -0,0 +1,195 @@
+package edu.biu.SCProtocols.gmw;
+
+import edu.biu.scapi.comm.Protocol;
+import edu.biu.scapi.comm.ProtocolInput;
+import edu.biu.scapi.comm.ProtocolOutput;
+
+/**
+ * Evaluates the same circuit many times, with the offline phases of K executions done in one batch ahead of time. <p>
+ *
+ * The offline phase of GMW generates the multiplication triples of the circuit.
+ * Running it ahead of the online phase takes it off the critical path, so the latency of each execution is only its online phase. <p>
+ *
+ * The native party keeps the triples of a single execution, so the batch holds K native parties, each one with its own
+ * communication file (and therefore its own ports) and its own inputs file. runOffline generates the triples of all the parties that were used, 
+ * at the same time, and each call to runOnline consumes the triples of the next party. All the parties of the protocol consume the executions 
+ * in the same order. <p>
+ *
+ * The native party reads its inputs file when it is created, so the inputs of the execution can not be changed afterwards.
+ * Once the online phase of an execution ran, running its offline phase again prepares the same execution (with the same inputs) once more;
+ * evaluating the circuit on further inputs requires a new batch.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwBatchParty implements Protocol {
+
+	private GmwParty[] parties;			//The native party of each execution in the batch.
+	private boolean[] ready;			//Indicates for each party that its offline phase was executed and its online phase was not.
+	private int next;					//The party of the next online phase.
+	private GmwProtocolOutput output;	//The output of the last online phase.
+
+	/**
+	 * Creates the native parties. The input should contain a communication file and an inputs file for each execution in the batch.
+	 */
+	@Override
+	public void start(ProtocolInput protocolInput) {
+		if (!(protocolInput instanceof GmwBatchProtocolInput)){
+			throw new IllegalArgumentException("The givan input should be an instance of GmwBatchProtocolInput");
+		}
+
+		GmwBatchProtocolInput input = (GmwBatchProtocolInput) protocolInput;
+		String[] partiesFiles = input.getPartiesFileNames();
+		String[] inputsFiles = input.getInputsFileNames();
+		parties = new GmwParty[partiesFiles.length];
+		ready = new boolean[partiesFiles.length];
+		for (int i = 0; i < parties.length; i++) {
+			parties[i] = new GmwParty();
+			parties[i].start(new GmwProtocolInput(input.getID(), input.getCircuitFileName(), partiesFiles[i],
+					inputsFiles[i], input.getNumOfThreads()));
+		}
+	}
+
+	/**
+	 * Runs the offline phases of all the executions whose triples were consumed (or not generated yet), at the same time.
+	 */
+	public void runOffline() {
+		Thread[] threads = new Thread[parties.length];
+		final Throwable[] failure = new Throwable[1];
+		for (int i = 0; i < parties.length; i++) {
+			if (ready[i]) {
+				continue;
+			}
+			final GmwParty party = parties[i];
+			threads[i] = new Thread() {
+				public void run() {
+					try {
+						party.runOffline();
+					} catch (Throwable e) {
+						synchronized (failure) {
+							failure[0] = e;
+						}
+					}
+				}
+			};
+			threads[i].start();
+		}
+
+		//Wait until all the offline phases are done.
+		for (int i = 0; i < parties.length; i++) {
+			if (threads[i] == null) {
+				continue;
+			}
+			try {
+				threads[i].join();
+			} catch (InterruptedException e) {
+				throw new IllegalStateException(e);
+			}
+			ready[i] = true;
+		}
+		if (failure[0] != null) {
+			throw new IllegalStateException("the offline phase failed", failure[0]);
+		}
+	}
+
+	/**
+	 * Runs the online phase of the next execution, using its triples from the last call to runOffline.
+	 * @return the output of the execution.
+	 * @throws IllegalStateException if all the triples were consumed.
+	 */
+	public GmwProtocolOutput runOnline() {
+		if (!ready[next]) {
+			throw new IllegalStateException("the triples of all the executions were consumed, runOffline should be called");
+		}
+		ready[next] = false;
+		output = parties[next].runOnline();
+		next = (next + 1) % parties.length;
+		return output;
+	}
+
+	/**
+	 * Returns the number of executions whose online phase can run without calling runOffline.
+	 */
+	public int getNumOfAvailableExecutions() {
+		int available = 0;
+		for (boolean isReady : ready) {
+			if (isReady) {
+				available++;
+			}
+		}
+		return available;
+	}
+
+	/**
+	 * Runs the offline phase of all the executions in the batch and then their online phases.
+	 */
+	@Override
+	public void run() {
+		runOffline();
+		for (int i = 0; i < parties.length; i++) {
+			runOnline();
+		}
+	}
+
+	/**
+	 * Returns the output of the last online phase.
+	 */
+	@Override
+	public ProtocolOutput getOutput() {
+		return output;
+	}
+
+	/**
+	 * Compares the cost of K executions of the protocol, each one with its offline and online phases,
+	 * to the cost of a batch of K offline phases followed by K online phases. <p>
+	 * Arguments: party id, circuit file, number of threads and then a communication file and an inputs file for each execution in the batch.
+	 */
+	public static void main(String[] args) {
+		int id = new Integer(args[0]);
+		String circuitFile = args[1];
+		int numThreads = new Integer(args[2]);
+		int k = (args.length - 3) / 2;
+		String[] partiesFiles = new String[k];
+		String[] inputsFiles = new String[k];
+		for (int i = 0; i < k; i++) {
+			partiesFiles[i] = args[3 + 2*i];
+			inputsFiles[i] = args[4 + 2*i];
+		}
+
+		GmwBatchParty batch = new GmwBatchParty();
+		batch.start(new GmwBatchProtocolInput(id, circuitFile, partiesFiles, inputsFiles, numThreads));
+
+		//K executions, each one runs its offline phase and then its online phase.
+		long start = System.nanoTime();
+		for (int i = 0; i < k; i++) {
+			batch.parties[i].run();
+		}
+		double sequentialMillis = (System.nanoTime() - start) / 1000000.0;
+
+		//A batch of K offline phases, then K online phases.
+		start = System.nanoTime();
+		batch.runOffline();
+		double offlineMillis = (System.nanoTime() - start) / 1000000.0;
+		double[] onlineMillis = new double[k];
+		for (int i = 0; i < k; i++) {
+			long onlineStart = System.nanoTime();
+			batch.runOnline();
+			onlineMillis[i] = (System.nanoTime() - onlineStart) / 1000000.0;
+		}
+
+		double totalOnline = 0;
+		for (double millis : onlineMillis) {
+			totalOnline += millis;
+		}
+		System.out.println(String.format("%d executions of offline and online: %.3f ms per execution", k, sequentialMillis / k));
+		System.out.println(String.format("batch offline of %d executions: %.3f ms, %.3f ms per execution", k, offlineMillis, offlineMillis / k));
+		System.out.println(String.format("online: %.3f ms per execution (amortised)", totalOnline / k));
+
+		System.out.println("protocol output:");
+		byte[] outputBytes = ((GmwProtocolOutput) batch.getOutput()).getOutput();
+		for (int i=0; i<outputBytes.length; i++){
+			System.out.print(outputBytes[i] + " ");
+		}
+		System.out.println();
+	}
+}
@@ -0,0 +1,60 @@
+package edu.biu.SCProtocols.gmw;
+
+import edu.biu.scapi.comm.ProtocolInput;
+
+/**
+ * This class manage the input for a batch of executions of the GMW protocol. <p>
+ * The input are the id of the party, the circuit file, a communication file and an inputs file for each execution in the batch
+ * and the number of threads to use in the protocol. <p>
+ * Each execution in the batch has its own channels, so the ports in the communication files should not overlap.
+ * The inputs of each execution are read from its own file, so each execution in the batch evaluates the circuit on different inputs.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwBatchProtocolInput implements ProtocolInput {
+
+	private int id;
+	private String circuitFileName;
+	private String[] partiesFileNames;	//The communication file of each execution. The number of files is the size of the batch.
+	private String[] inputsFileNames;	//The inputs file of each execution.
+	private int numOfThreads;
+
+	/**
+	 * @param partiesFileNames The communication file of each execution in the batch.
+	 * @param inputsFileNames The inputs file of each execution in the batch, in the same order as the communication files.
+	 */
+	public GmwBatchProtocolInput(int id, String circuitFileName, String[] partiesFileNames, String[] inputsFileNames, int numOfThreads){
+		if (partiesFileNames.length == 0){
+			throw new IllegalArgumentException("At least one communication file should be given");
+		}
+		if (inputsFileNames.length != partiesFileNames.length){
+			throw new IllegalArgumentException("There should be an inputs file for each communication file");
+		}
+		this.circuitFileName = circuitFileName;
+		this.partiesFileNames = partiesFileNames;
+		this.inputsFileNames = inputsFileNames;
+		this.id = id;
+		this.numOfThreads = numOfThreads;
+	}
+
+	public int getID(){
+		return id;
+	}
+
+	public String getCircuitFileName(){
+		return circuitFileName;
+	}
+
+	public String[] getPartiesFileNames(){
+		return partiesFileNames;
+	}
+
+	public String[] getInputsFileNames(){
+		return inputsFileNames;
+	}
+
+	public int getNumOfThreads(){
+		return numOfThreads;
+	}
+}
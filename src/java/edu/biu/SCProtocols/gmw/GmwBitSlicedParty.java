@@ -0,0 +1,561 @@
+package edu.biu.SCProtocols.gmw;
+
+import java.io.BufferedReader;
+import java.io.FileInputStream;
+import java.io.FileReader;
+import java.io.IOException;
+import java.io.StreamTokenizer;
+import java.net.InetAddress;
+import java.nio.ByteBuffer;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Properties;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.Party;
+import edu.biu.scapi.comm.Protocol;
+import edu.biu.scapi.comm.ProtocolInput;
+import edu.biu.scapi.comm.ProtocolOutput;
+import edu.biu.scapi.comm.multiPartyComm.SocketMultipartyCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.PartyData;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+import edu.biu.scapi.interactiveMidProtocols.ot.OTOnByteArrayROutput;
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension.OTExtensionCorrelatedRInput;
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension.OTExtensionCorrelatedSInput;
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension.OTExtensionSOutput;
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension.OTSemiHonestExtensionReceiver;
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension.OTSemiHonestExtensionSender;
+
+/**
+ * A bit sliced implementation of the semi honest GMW protocol, that evaluates 64 to 512 independent instances of the same circuit together. <p>
+ *
+ * The value of a wire in all the instances is packed into machine words, one bit for each instance, so each gate is computed on all
+ * the instances by a few word operations. The gates are evaluated layer by layer (see {@link GmwCircuit}); the linear gates are computed
+ * locally and all the multiplications of a layer are computed together using Beaver's multiplication triples, with a single message
+ * to each other party in each layer. <p>
+ *
+ * The offline phase generates the triples of all the instances, using a correlated OT extension between each pair of parties. <p>
+ *
+ * The parties are given in the same communication file as the native GMW protocol. Each party uses the ports that follow the
+ * 2*(numberOfParties - 1) ports of the native implementation: the first one for the channels to the other parties, and then one port
+ * for the OT extension towards each party id j (the port that follows it by 1 + j), 3*numberOfParties - 1 ports in total.
+ * Thus, both implementations can use the same file at the same time.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwBitSlicedParty implements Protocol {
+
+	private static final long TIMEOUT = 600000;		//The time to wait for the other parties to connect, in milliseconds.
+
+	private int id;									//The zero based id of this party.
+	private int numOfParties;
+	private GmwCircuit circuit;
+	private int numOfInstances;
+	private int numOfWords;							//The number of words that hold the instances of a single wire.
+	private long[] inputs;							//The inputs of this party, numOfWords for each input wire.
+
+	private Channel[] channels;						//The channel to each other party.
+	private OTSemiHonestExtensionSender[] otSenders;		//The OT extension towards each other party, where this party is the sender.
+	private OTSemiHonestExtensionReceiver[] otReceivers;	//The OT extension towards each other party, where this party is the receiver.
+	private SecureRandom random = new SecureRandom();
+
+	//The shares of this party in the multiplication triples of the next online phase, numOfWords for each multiplication gate.
+	private long[] a, b, c;
+	private boolean offlineDone;
+	private GmwProtocolOutput output;
+
+	/*
+	 * A task that is executed for each other party, in its own thread.
+	 */
+	private interface PartyTask {
+		void run(int party) throws Exception;
+	}
+
+	/**
+	 * Reads the circuit and the inputs and connects to the other parties. The base OTs of the OT extension are executed here.
+	 */
+	@Override
+	public void start(ProtocolInput protocolInput) {
+		if (!(protocolInput instanceof GmwBitSlicedProtocolInput)){
+			throw new IllegalArgumentException("The givan input should be an instance of GmwBitSlicedProtocolInput");
+		}
+
+		GmwBitSlicedProtocolInput input = (GmwBitSlicedProtocolInput) protocolInput;
+		id = input.getID();
+		numOfInstances = input.getNumOfInstances();
+		numOfWords = numOfInstances / 64;
+		try {
+			circuit = new GmwCircuit(input.getCircuitFileName());
+			numOfParties = circuit.getNumOfParties();
+			if (id < 0 || id >= numOfParties) {
+				throw new IllegalArgumentException("Party id should be between 0 and " + (numOfParties - 1));
+			}
+			inputs = readInputs(input.getInputsFileName());
+			connect(input.getPartiesFileName(), input.getNumOfThreads());
+		} catch (IOException e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	/*
+	 * Reads the inputs of this party. The file holds a bit for each input wire, of a single instance or of all the instances.
+	 */
+	private long[] readInputs(String fileName) throws IOException {
+		int numOfInputs = circuit.getInputWires(id).length;
+		long[] packed = new long[numOfInputs * numOfWords];
+		if (numOfInputs == 0) {
+			return packed;
+		}
+
+		ArrayList<Integer> bits = new ArrayList<Integer>();
+		BufferedReader reader = new BufferedReader(new FileReader(fileName));
+		try {
+			StreamTokenizer tokens = new StreamTokenizer(reader);
+			while (tokens.nextToken() == StreamTokenizer.TT_NUMBER) {
+				bits.add((int) tokens.nval);
+			}
+		} finally {
+			reader.close();
+		}
+		if (bits.size() != numOfInputs && bits.size() != numOfInputs * numOfInstances) {
+			throw new IllegalArgumentException("The inputs file should contain " + numOfInputs + " or " + numOfInputs * numOfInstances + " bits");
+		}
+
+		for (int instance = 0; instance < numOfInstances; instance++) {
+			int first = (bits.size() == numOfInputs) ? 0 : instance * numOfInputs;
+			for (int i = 0; i < numOfInputs; i++) {
+				packed[i * numOfWords + instance / 64] |= (long) (bits.get(first + i) & 1) << (instance % 64);
+			}
+		}
+		return packed;
+	}
+
+	/*
+	 * Creates the channels and the OT extensions between this party and each other party.
+	 */
+	private void connect(String partiesFileName, final int numOfThreads) throws IOException {
+		Properties file = new Properties();
+		FileInputStream stream = new FileInputStream(partiesFileName);
+		try {
+			file.load(stream);
+		} finally {
+			stream.close();
+		}
+
+		//The native implementation uses the first 2*(numOfParties - 1) ports of each party.
+		final InetAddress[] ips = new InetAddress[numOfParties];
+		final int[] ports = new int[numOfParties];
+		List<PartyData> parties = new ArrayList<PartyData>();
+		for (int i = 0; i < numOfParties; i++) {
+			ips[i] = InetAddress.getByName(file.getProperty("party_" + i + "_ip").trim());
+			ports[i] = Integer.parseInt(file.getProperty("party_" + i + "_port").trim()) + 2 * (numOfParties - 1);
+		}
+		//The first party in the list should be this party.
+		PartyData[] partiesData = new PartyData[numOfParties];
+		for (int i = 0; i < numOfParties; i++) {
+			partiesData[i] = new SocketPartyData(ips[i], ports[i]);
+		}
+		parties.add(partiesData[id]);
+		Map<PartyData, Object> connectionsPerParty = new HashMap<PartyData, Object>();
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != id) {
+				parties.add(partiesData[i]);
+				connectionsPerParty.put(partiesData[i], 1);
+			}
+		}
+
+		SocketMultipartyCommunicationSetup commSetup = new SocketMultipartyCommunicationSetup(parties);
+		Map<PartyData, Map<String, Channel>> connections;
+		try {
+			connections = commSetup.prepareForCommunication(connectionsPerParty, TIMEOUT);
+		} catch (java.util.concurrent.TimeoutException e) {
+			throw new IOException("timeout while connecting to the other parties", e);
+		}
+		channels = new Channel[numOfParties];
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != id) {
+				channels[i] = connections.get(partiesData[i]).values().iterator().next();
+			}
+		}
+
+		//The OT extension from party i to party j uses port ports[i] + 1 + j of party i.
+		//The party with the smaller id creates its sender first, so that the constructors of each pair match.
+		otSenders = new OTSemiHonestExtensionSender[numOfParties];
+		otReceivers = new OTSemiHonestExtensionReceiver[numOfParties];
+		forEachParty(new PartyTask() {
+			public void run(int party) {
+				for (int k = 0; k < 2; k++) {
+					if ((k == 0) == (id < party)) {
+						otSenders[party] = new OTSemiHonestExtensionSender(new Party(ips[id], ports[id] + 1 + party), 163, numOfThreads);
+					} else {
+						otReceivers[party] = new OTSemiHonestExtensionReceiver(new Party(ips[party], ports[party] + 1 + id), 163, numOfThreads);
+					}
+				}
+			}
+		});
+	}
+
+	/**
+	 * Runs the offline phase of the protocol, which generates the multiplication triples of all the instances for the next online phase. <p>
+	 *
+	 * Each party chooses random shares a_i and b_i of each triple. The product (a_1^...^a_n)(b_1^...^b_n) is the xor of the local
+	 * products a_i*b_i and the cross products a_i*b_j, which are shared between the parties i and j by a correlated OT where party i
+	 * is the sender with delta a_i and party j is the receiver with choice b_j.
+	 */
+	public void runOffline() {
+		int numOfTriples = circuit.getNumOfAndGates() * numOfWords;
+		a = randomWords(numOfTriples);
+		b = randomWords(numOfTriples);
+		c = new long[numOfTriples];
+		for (int i = 0; i < numOfTriples; i++) {
+			c[i] = a[i] & b[i];
+		}
+
+		final int numOfOts = numOfTriples * 64;
+		final byte[] aBits = unpack(a);
+		final byte[] bBits = unpack(b);
+		forEachParty(new PartyTask() {
+			public void run(int party) {
+				long[] sent = null, received = null;
+				//The party with the smaller id is the sender first, so that the transfers of each pair match.
+				for (int k = 0; k < 2; k++) {
+					if ((k == 0) == (id < party)) {
+						OTExtensionSOutput out = (OTExtensionSOutput) otSenders[party].transfer(null, new OTExtensionCorrelatedSInput(aBits, numOfOts));
+						sent = pack(out.getX0Arr());
+					} else {
+						OTOnByteArrayROutput out = (OTOnByteArrayROutput) otReceivers[party].transfer(null, new OTExtensionCorrelatedRInput(bBits, 8));
+						received = pack(out.getXSigma());
+					}
+				}
+				synchronized (c) {
+					for (int i = 0; i < c.length; i++) {
+						c[i] ^= sent[i] ^ received[i];
+					}
+				}
+			}
+		});
+		offlineDone = true;
+	}
+
+	/**
+	 * Runs the online phase of the protocol on all the instances, using the multiplication triples of the last offline phase.
+	 * @return the output of the protocol. The output of instance i is given in the bytes
+	 * [i*numOfOutputs, (i+1)*numOfOutputs), one byte for each output wire of this party.
+	 * @throws IllegalStateException if the offline phase was not executed since the last online phase.
+	 */
+	public GmwProtocolOutput runOnline() {
+		if (!offlineDone) {
+			throw new IllegalStateException("runOffline should be called before each call to runOnline");
+		}
+		offlineDone = false;
+
+		long[] wires = new long[circuit.getNumOfWires() * numOfWords];
+		shareInputs(wires);
+
+		int triple = 0;
+		for (int layer = 0; layer < circuit.getNumOfLayers(); layer++) {
+			for (int gate : circuit.getLinearGates(layer)) {
+				computeLinear(wires, gate);
+			}
+			int[] gates = circuit.getAndGates(layer);
+			if (gates.length > 0) {
+				computeAnd(wires, gates, triple);
+				triple += gates.length;
+			}
+		}
+
+		output = new GmwProtocolOutput(revealOutputs(wires));
+		return output;
+	}
+
+	/*
+	 * Computes the share of a linear gate in all the instances.
+	 */
+	private void computeLinear(long[] wires, int gate) {
+		int form = circuit.getForm(gate);
+		int x = circuit.getFirstInput(gate) * numOfWords;
+		int y = circuit.getSecondInput(gate) * numOfWords;
+		int z = circuit.getOutputWire(gate) * numOfWords;
+		long constant = ((form & GmwCircuit.CONSTANT) != 0 && id == 0) ? -1L : 0;
+		long xMask = ((form & GmwCircuit.X) != 0) ? -1L : 0;
+		long yMask = ((form & GmwCircuit.Y) != 0) ? -1L : 0;
+		for (int w = 0; w < numOfWords; w++) {
+			wires[z + w] = constant ^ (wires[x + w] & xMask) ^ ((y < 0) ? 0 : wires[y + w] & yMask);
+		}
+	}
+
+	/*
+	 * Computes all the multiplication gates of a layer in all the instances, with a single message to each other party.
+	 * For each gate, the parties open d = x^a and e = y^b, and then z = c ^ d*b ^ e*a ^ d*e is a sharing of x*y. (d*e is added by party 0)
+	 */
+	private void computeAnd(long[] wires, int[] gates, int firstTriple) {
+		long[] opened = new long[2 * gates.length * numOfWords];
+		for (int i = 0; i < gates.length; i++) {
+			int x = circuit.getFirstInput(gates[i]) * numOfWords;
+			int y = circuit.getSecondInput(gates[i]) * numOfWords;
+			int t = (firstTriple + i) * numOfWords;
+			int d = 2 * i * numOfWords;
+			int e = d + numOfWords;
+			for (int w = 0; w < numOfWords; w++) {
+				opened[d + w] = wires[x + w] ^ a[t + w];
+				opened[e + w] = wires[y + w] ^ b[t + w];
+			}
+		}
+
+		long[][] messages = new long[numOfParties][];
+		for (int i = 0; i < numOfParties; i++) {
+			messages[i] = opened;
+		}
+		long[][] received = exchange(messages);
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != id) {
+				xor(opened, received[i]);
+			}
+		}
+
+		for (int i = 0; i < gates.length; i++) {
+			int gate = gates[i];
+			int form = circuit.getForm(gate);
+			int x = circuit.getFirstInput(gate) * numOfWords;
+			int y = circuit.getSecondInput(gate) * numOfWords;
+			int z = circuit.getOutputWire(gate) * numOfWords;
+			int t = (firstTriple + i) * numOfWords;
+			int d = 2 * i * numOfWords;
+			int e = d + numOfWords;
+			long constant = ((form & GmwCircuit.CONSTANT) != 0 && id == 0) ? -1L : 0;
+			long xMask = ((form & GmwCircuit.X) != 0) ? -1L : 0;
+			long yMask = ((form & GmwCircuit.Y) != 0) ? -1L : 0;
+			long deMask = (id == 0) ? -1L : 0;
+			for (int w = 0; w < numOfWords; w++) {
+				long product = c[t + w] ^ (opened[d + w] & b[t + w]) ^ (opened[e + w] & a[t + w]) ^ (opened[d + w] & opened[e + w] & deMask);
+				wires[z + w] = product ^ constant ^ (wires[x + w] & xMask) ^ (wires[y + w] & yMask);
+			}
+		}
+	}
+
+	/*
+	 * Shares the inputs of each party between all the parties. The party sends a random share to each other party and keeps the xor
+	 * of the inputs with all the shares.
+	 */
+	private void shareInputs(long[] wires) {
+		long[] own = inputs.clone();
+		long[][] shares = new long[numOfParties][];
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != id) {
+				shares[i] = randomWords(own.length);
+				xor(own, shares[i]);
+			}
+		}
+		long[][] received = exchange(shares);
+		received[id] = own;
+
+		for (int party = 0; party < numOfParties; party++) {
+			int[] inputWires = circuit.getInputWires(party);
+			for (int i = 0; i < inputWires.length; i++) {
+				System.arraycopy(received[party], i * numOfWords, wires, inputWires[i] * numOfWords, numOfWords);
+			}
+		}
+	}
+
+	/*
+	 * Sends to each party the shares of its output wires and reconstructs the outputs of this party.
+	 */
+	private byte[] revealOutputs(long[] wires) {
+		long[][] shares = new long[numOfParties][];
+		for (int party = 0; party < numOfParties; party++) {
+			shares[party] = gather(wires, circuit.getOutputWires(party));
+		}
+		long[] values = shares[id];
+		long[][] received = exchange(shares);
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != id) {
+				xor(values, received[i]);
+			}
+		}
+
+		int numOfOutputs = circuit.getOutputWires(id).length;
+		byte[] outputBytes = new byte[numOfInstances * numOfOutputs];
+		for (int instance = 0; instance < numOfInstances; instance++) {
+			for (int i = 0; i < numOfOutputs; i++) {
+				outputBytes[instance * numOfOutputs + i] = (byte) ((values[i * numOfWords + instance / 64] >>> (instance % 64)) & 1);
+			}
+		}
+		return outputBytes;
+	}
+
+	private long[] gather(long[] wires, int[] indices) {
+		long[] values = new long[indices.length * numOfWords];
+		for (int i = 0; i < indices.length; i++) {
+			System.arraycopy(wires, indices[i] * numOfWords, values, i * numOfWords, numOfWords);
+		}
+		return values;
+	}
+
+	/*
+	 * Sends messages[i] to each other party i and returns the message received from each other party.
+	 * The sending and the receiving are done in separate threads, so large messages do not block each other.
+	 */
+	private long[][] exchange(final long[][] messages) {
+		final long[][] received = new long[numOfParties][];
+		forEachParty(new PartyTask() {
+			public void run(int party) throws Exception {
+				channels[party].send(toBytes(messages[party]));
+			}
+		}, new PartyTask() {
+			public void run(int party) throws Exception {
+				received[party] = toLongs((byte[]) channels[party].receive());
+			}
+		});
+		return received;
+	}
+
+	/*
+	 * Runs each of the given tasks for each other party, each one in its own thread, and waits until all of them are done.
+	 */
+	private void forEachParty(PartyTask... tasks) {
+		final Throwable[] failure = new Throwable[1];
+		ArrayList<Thread> threads = new ArrayList<Thread>();
+		for (final PartyTask task : tasks) {
+			for (int i = 0; i < numOfParties; i++) {
+				if (i == id) {
+					continue;
+				}
+				final int party = i;
+				Thread thread = new Thread() {
+					public void run() {
+						try {
+							task.run(party);
+						} catch (Throwable e) {
+							synchronized (failure) {
+								failure[0] = e;
+							}
+						}
+					}
+				};
+				thread.start();
+				threads.add(thread);
+			}
+		}
+
+		for (Thread thread : threads) {
+			try {
+				thread.join();
+			} catch (InterruptedException e) {
+				throw new IllegalStateException(e);
+			}
+		}
+		if (failure[0] != null) {
+			throw new IllegalStateException("the communication with another party failed", failure[0]);
+		}
+	}
+
+	private long[] randomWords(int size) {
+		long[] words = new long[size];
+		for (int i = 0; i < size; i++) {
+			words[i] = random.nextLong();
+		}
+		return words;
+	}
+
+	private static void xor(long[] target, long[] other) {
+		for (int i = 0; i < target.length; i++) {
+			target[i] ^= other[i];
+		}
+	}
+
+	/*
+	 * Converts packed bits to a byte for each bit, as needed by the OT extension.
+	 */
+	private static byte[] unpack(long[] words) {
+		byte[] bits = new byte[words.length * 64];
+		for (int i = 0; i < bits.length; i++) {
+			bits[i] = (byte) ((words[i / 64] >>> (i % 64)) & 1);
+		}
+		return bits;
+	}
+
+	/*
+	 * Packs the lowest bit of each byte, which is the bit of the OT output.
+	 */
+	private static long[] pack(byte[] bits) {
+		long[] words = new long[bits.length / 64];
+		for (int i = 0; i < bits.length; i++) {
+			words[i / 64] |= (long) (bits[i] & 1) << (i % 64);
+		}
+		return words;
+	}
+
+	private static byte[] toBytes(long[] words) {
+		ByteBuffer buffer = ByteBuffer.allocate(words.length * 8);
+		buffer.asLongBuffer().put(words);
+		return buffer.array();
+	}
+
+	private static long[] toLongs(byte[] bytes) {
+		long[] words = new long[bytes.length / 8];
+		ByteBuffer.wrap(bytes).asLongBuffer().get(words);
+		return words;
+	}
+
+	/**
+	 * Runs the offline phase and then the online phase.
+	 */
+	@Override
+	public void run() {
+		runOffline();
+		runOnline();
+	}
+
+	@Override
+	public ProtocolOutput getOutput() {
+		return output;
+	}
+
+	/**
+	 * Compares the bit sliced protocol to single instance executions of the native GMW protocol on the same circuit. <p>
+	 * Arguments: party id, circuit file, communication file, inputs file, number of instances, number of threads
+	 * and optionally the number of single instance executions of the native protocol.
+	 */
+	public static void main(String[] args) {
+		int id = new Integer(args[0]);
+		String circuitFile = args[1];
+		String partiesFile = args[2];
+		String inputsFile = args[3];
+		int numOfInstances = new Integer(args[4]);
+		int numThreads = new Integer(args[5]);
+		int numOfNativeRuns = (args.length > 6) ? new Integer(args[6]) : 0;
+
+		GmwBitSlicedParty party = new GmwBitSlicedParty();
+		party.start(new GmwBitSlicedProtocolInput(id, circuitFile, partiesFile, inputsFile, numOfInstances, numThreads));
+		long start = System.nanoTime();
+		party.runOffline();
+		double offlineMillis = (System.nanoTime() - start) / 1000000.0;
+		start = System.nanoTime();
+		byte[] outputBytes = party.runOnline().getOutput();
+		double onlineMillis = (System.nanoTime() - start) / 1000000.0;
+		System.out.println(String.format("bit sliced gmw of %d instances: offline %.3f ms, online %.3f ms", numOfInstances, offlineMillis, onlineMillis));
+		System.out.println(String.format("per instance: offline %.3f ms, online %.3f ms", offlineMillis / numOfInstances, onlineMillis / numOfInstances));
+
+		if (numOfNativeRuns > 0) {
+			GmwParty nativeParty = new GmwParty();
+			nativeParty.start(new GmwProtocolInput(id, circuitFile, partiesFile, inputsFile, numThreads));
+			start = System.nanoTime();
+			for (int i = 0; i < numOfNativeRuns; i++) {
+				nativeParty.run();
+			}
+			double nativeMillis = (System.nanoTime() - start) / 1000000.0;
+			System.out.println(String.format("native gmw: %.3f ms per instance", nativeMillis / numOfNativeRuns));
+		}
+
+		System.out.println("output of the first instance:");
+		int numOfOutputs = outputBytes.length / numOfInstances;
+		for (int i=0; i<numOfOutputs; i++){
+			System.out.print(outputBytes[i] + " ");
+		}
+		System.out.println();
+	}
+}
@@ -0,0 +1,61 @@
+package edu.biu.SCProtocols.gmw;
+
+import edu.biu.scapi.comm.ProtocolInput;
+
+/**
+ * This class manage the input for the bit sliced GMW protocol. <p>
+ * The input are the id of the party, the files contain the 1. circuit 2. parties data 3. inputs, the number of instances of the
+ * circuit that are evaluated together and the number of threads to use in the OT extension. <p>
+ * The number of instances should be a multiple of 64 between 64 and 512.
+ * The inputs file contains either the inputs of a single instance, which are then used by all the instances, or the inputs of
+ * all the instances one after the other.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwBitSlicedProtocolInput implements ProtocolInput {
+
+	private int id;
+	private String circuitFileName;
+	private String partiesFileName;
+	private String inputsFileName;
+	private int numOfInstances;
+	private int numOfThreads;
+
+	public GmwBitSlicedProtocolInput(int id, String circuitFileName, String partiesFileName, String inputsFileName,
+			int numOfInstances, int numOfThreads){
+		if (numOfInstances < 64 || numOfInstances > 512 || numOfInstances % 64 != 0){
+			throw new IllegalArgumentException("The number of instances should be a multiple of 64 between 64 and 512");
+		}
+		this.circuitFileName = circuitFileName;
+		this.partiesFileName = partiesFileName;
+		this.inputsFileName = inputsFileName;
+		this.id = id;
+		this.numOfInstances = numOfInstances;
+		this.numOfThreads = numOfThreads;
+	}
+
+	public int getID(){
+		return id;
+	}
+
+	public String getCircuitFileName(){
+		return circuitFileName;
+	}
+
+	public String getPartiesFileName(){
+		return partiesFileName;
+	}
+
+	public String getInputsFileName(){
+		return inputsFileName;
+	}
+
+	public int getNumOfInstances(){
+		return numOfInstances;
+	}
+
+	public int getNumOfThreads(){
+		return numOfThreads;
+	}
+}
@@ -0,0 +1,254 @@
+package edu.biu.SCProtocols.gmw;
+
+import java.io.BufferedReader;
+import java.io.FileReader;
+import java.io.IOException;
+import java.io.StreamTokenizer;
+import java.util.ArrayList;
+import java.util.Arrays;
+
+/**
+ * A boolean circuit in the format of the native GMW protocol (for example NigelAes3Parties.txt). <p>
+ *
+ * The file begins with the number of gates and the number of parties. Then, for each party, its (one based) id, its number of
+ * input wires and their indices; then the same for the output wires of each party. Each gate is given by its number of inputs,
+ * its number of outputs, the input wires, the output wire and the truth table. <p>
+ *
+ * Each gate is kept in the algebraic normal form of its truth table, z = c ^ cx*x ^ cy*y ^ cxy*x*y, so XOR, NOT and XNOR are linear
+ * and every gate with cxy = 1 (AND, OR, NAND, ...) needs a single multiplication. <p>
+ *
+ * The gates are arranged in layers according to their multiplicative depth. Layer i contains the linear gates whose output depth is i
+ * and the multiplications whose input depth is i, so all the multiplications of a layer can be computed together with a single round
+ * of communication.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwCircuit {
+
+	//The algebraic normal form coefficients of a gate, kept as bits of its form.
+	static final int CONSTANT = 1;
+	static final int X = 2;
+	static final int Y = 4;
+	static final int XY = 8;
+
+	private int numOfParties;
+	private int numOfWires;
+	private int[][] inputWires;		//The input wires of each party.
+	private int[][] outputWires;	//The output wires of each party.
+
+	private int[] firstInput;		//The first input wire of each gate.
+	private int[] secondInput;		//The second input wire of each gate, or -1 for a gate with a single input.
+	private int[] outputWire;		//The output wire of each gate.
+	private int[] form;				//The algebraic normal form of each gate.
+
+	private int[][] linearLayers;	//The indices of the linear gates of each layer.
+	private int[][] andLayers;		//The indices of the multiplication gates of each layer.
+	private int numOfAndGates;
+
+	/**
+	 * Reads the circuit from the given file and arranges its gates in layers.
+	 * @param fileName The name of the circuit file.
+	 * @throws IOException if the file could not be read.
+	 * @throws IllegalArgumentException if the file is not a valid circuit.
+	 */
+	public GmwCircuit(String fileName) throws IOException {
+		BufferedReader reader = new BufferedReader(new FileReader(fileName));
+		StreamTokenizer tokens = new StreamTokenizer(reader);
+		tokens.resetSyntax();
+		tokens.wordChars('0', '9');
+		tokens.whitespaceChars(0, ' ');
+
+		try {
+			int numOfGates = nextInt(tokens);
+			numOfParties = nextInt(tokens);
+			inputWires = readPartiesWires(tokens);
+			outputWires = readPartiesWires(tokens);
+
+			firstInput = new int[numOfGates];
+			secondInput = new int[numOfGates];
+			outputWire = new int[numOfGates];
+			form = new int[numOfGates];
+			for (int i = 0; i < numOfGates; i++) {
+				int numOfInputs = nextInt(tokens);
+				nextInt(tokens); //The number of outputs is always one.
+				firstInput[i] = nextInt(tokens);
+				secondInput[i] = (numOfInputs == 2) ? nextInt(tokens) : -1;
+				outputWire[i] = nextInt(tokens);
+				form[i] = toNormalForm(nextWord(tokens), numOfInputs);
+				numOfWires = Math.max(numOfWires, outputWire[i] + 1);
+			}
+		} finally {
+			reader.close();
+		}
+		createLayers();
+	}
+
+	/*
+	 * Reads the (one based) party id, the number of wires and the wires of each party.
+	 */
+	private int[][] readPartiesWires(StreamTokenizer tokens) throws IOException {
+		int[][] wires = new int[numOfParties][];
+		for (int i = 0; i < numOfParties; i++) {
+			int party = nextInt(tokens) - 1;
+			if (party < 0 || party >= numOfParties) {
+				throw new IllegalArgumentException("invalid party id " + (party + 1));
+			}
+			wires[party] = new int[nextInt(tokens)];
+			for (int j = 0; j < wires[party].length; j++) {
+				wires[party][j] = nextInt(tokens);
+				numOfWires = Math.max(numOfWires, wires[party][j] + 1);
+			}
+		}
+		return wires;
+	}
+
+	/*
+	 * Converts a truth table to the algebraic normal form. The table holds the output for the inputs 00, 01, 10, 11 (or 0, 1 for a single input).
+	 */
+	private static int toNormalForm(String table, int numOfInputs) {
+		if (table.length() != (1 << numOfInputs)) {
+			throw new IllegalArgumentException("invalid truth table " + table);
+		}
+		int t0 = table.charAt(0) - '0';
+		int t1 = table.charAt(1) - '0';
+		if (numOfInputs == 1) {
+			return t0 * CONSTANT | (t0 ^ t1) * X;
+		}
+		int t2 = table.charAt(2) - '0';
+		int t3 = table.charAt(3) - '0';
+		return t0 * CONSTANT | (t0 ^ t2) * X | (t0 ^ t1) * Y | (t0 ^ t1 ^ t2 ^ t3) * XY;
+	}
+
+	private static int nextInt(StreamTokenizer tokens) throws IOException {
+		return Integer.parseInt(nextWord(tokens));
+	}
+
+	private static String nextWord(StreamTokenizer tokens) throws IOException {
+		if (tokens.nextToken() != StreamTokenizer.TT_WORD) {
+			throw new IllegalArgumentException("unexpected end of the circuit file");
+		}
+		return tokens.sval;
+	}
+
+	/*
+	 * Computes the multiplicative depth of each wire and arranges the gates in layers.
+	 * The gates should be given in a topological order.
+	 */
+	private void createLayers() {
+		int[] depth = new int[numOfWires];
+		Arrays.fill(depth, -1);
+		for (int[] wires : inputWires) {
+			for (int wire : wires) {
+				depth[wire] = 0;
+			}
+		}
+
+		ArrayList<ArrayList<Integer>> linear = new ArrayList<ArrayList<Integer>>();
+		ArrayList<ArrayList<Integer>> and = new ArrayList<ArrayList<Integer>>();
+		for (int i = 0; i < form.length; i++) {
+			int inputDepth = depth(depth, firstInput[i]);
+			if (secondInput[i] != -1) {
+				inputDepth = Math.max(inputDepth, depth(depth, secondInput[i]));
+			}
+			if ((form[i] & XY) != 0) {
+				getLayer(and, inputDepth).add(i);
+				numOfAndGates++;
+				depth[outputWire[i]] = inputDepth + 1;
+			} else {
+				getLayer(linear, inputDepth).add(i);
+				depth[outputWire[i]] = inputDepth;
+			}
+		}
+
+		int numOfLayers = Math.max(linear.size(), and.size());
+		linearLayers = toArrays(linear, numOfLayers);
+		andLayers = toArrays(and, numOfLayers);
+	}
+
+	private static int depth(int[] depth, int wire) {
+		if (depth[wire] == -1) {
+			throw new IllegalArgumentException("wire " + wire + " is used before it is computed");
+		}
+		return depth[wire];
+	}
+
+	private static ArrayList<Integer> getLayer(ArrayList<ArrayList<Integer>> layers, int layer) {
+		while (layers.size() <= layer) {
+			layers.add(new ArrayList<Integer>());
+		}
+		return layers.get(layer);
+	}
+
+	private static int[][] toArrays(ArrayList<ArrayList<Integer>> layers, int numOfLayers) {
+		int[][] arrays = new int[numOfLayers][];
+		for (int i = 0; i < numOfLayers; i++) {
+			ArrayList<Integer> layer = (i < layers.size()) ? layers.get(i) : new ArrayList<Integer>();
+			arrays[i] = new int[layer.size()];
+			for (int j = 0; j < arrays[i].length; j++) {
+				arrays[i][j] = layer.get(j);
+			}
+		}
+		return arrays;
+	}
+
+	public int getNumOfParties() {
+		return numOfParties;
+	}
+
+	public int getNumOfWires() {
+		return numOfWires;
+	}
+
+	/**
+	 * Returns the input wires of the given (zero based) party.
+	 */
+	public int[] getInputWires(int party) {
+		return inputWires[party];
+	}
+
+	/**
+	 * Returns the output wires of the given (zero based) party.
+	 */
+	public int[] getOutputWires(int party) {
+		return outputWires[party];
+	}
+
+	public int getNumOfAndGates() {
+		return numOfAndGates;
+	}
+
+	public int getNumOfLayers() {
+		return andLayers.length;
+	}
+
+	/**
+	 * Returns the linear gates of the given layer, in a topological order.
+	 */
+	public int[] getLinearGates(int layer) {
+		return linearLayers[layer];
+	}
+
+	/**
+	 * Returns the multiplication gates of the given layer. Their inputs are computed by the previous layers and by the linear gates of this layer.
+	 */
+	public int[] getAndGates(int layer) {
+		return andLayers[layer];
+	}
+
+	int getFirstInput(int gate) {
+		return firstInput[gate];
+	}
+
+	int getSecondInput(int gate) {
+		return secondInput[gate];
+	}
+
+	int getOutputWire(int gate) {
+		return outputWire[gate];
+	}
+
+	int getForm(int gate) {
+		return form[gate];
+	}
+}
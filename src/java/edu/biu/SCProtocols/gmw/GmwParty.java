@@ -18,12 +18,15 @@ public class GmwParty implements Protocol{
 
 	private long nativeParty;			//A pointer to the native implementation
 	private GmwProtocolOutput output;	//The output of the protocol
+	private boolean offlineDone;		//Indicates that the multiplication triples of the next online phase were generated
 	
 	//JNI functions that call the native implementation
 	private native long createGMWParty(int id, String circuitFileName, String partiesFileName, 
 			String inputsFileName, int numOfThreads);
 	private native byte[] runProtocol(long nativeParty);
 	private native void deleteGMW(long nativeParty);
+	private native void runOffline(long nativeParty);
+	private native byte[] runOnline(long nativeParty);
 	
 	@Override
 	public void start(ProtocolInput protocolInput) {
@@ -44,6 +47,31 @@ public class GmwParty implements Protocol{
 		output = new GmwProtocolOutput(nativeOutput);
 	}
 
+	/**
+	 * Runs the offline phase of the protocol, which generates the multiplication triples of the next online phase. <p>
+	 * The offline phase can run ahead of time, off the critical path of the online phase. 
+	 * Note that the native party reads its inputs file when it is created in {@link #start(ProtocolInput)}, 
+	 * so the inputs must be known at construction, before the offline phase runs, and cannot be changed between the phases.
+	 */
+	public void runOffline() {
+		runOffline(nativeParty);
+		offlineDone = true;
+	}
+	
+	/**
+	 * Runs the online phase of the protocol, using the multiplication triples of the last offline phase.
+	 * @return the output of the protocol.
+	 * @throws IllegalStateException if the offline phase was not executed since the last online phase.
+	 */
+	public GmwProtocolOutput runOnline() {
+		if (!offlineDone) {
+			throw new IllegalStateException("runOffline should be called before each call to runOnline");
+		}
+		offlineDone = false;
+		output = new GmwProtocolOutput(runOnline(nativeParty));
+		return output;
+	}
+	
 	@Override
 	public ProtocolOutput getOutput() {
 		return output;
@@ -99,6 +99,8 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 	private native byte[] verifyTranslate(long ptr, byte[] singleoutputKeys, byte []bothOutputKeys);
 	private native boolean verifyTranslationTable(long ptr, byte []bothOutputKeys);
 	private native void deleteCircuit(long ptr);//Deletes the memory of the circuit in the dll.
+	private static native boolean[] verifyGarbledCircuits(long[] ptrs, byte[][] seeds, byte[][] garbledTables, byte[][] translationTables, 
+			byte[][] allInputWireValues, byte[][] allOutputWireValues);//Garbles a batch of seeds on several threads and compares the results to the given tables.
 	
 	
 	
@@ -429,6 +431,74 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 		return SCAPI_NATIVE_KEY_SIZE;
 	}
 
+	/**
+	 * Verifies a batch of garbled circuits in a single native call, as done for the checked circuits of the cut and choose. <p>
+	 * For each seed, the circuit is garbled using the seed and the generated garbled tables and translation table are compared 
+	 * to the given (received) tables of this seed. The seeds are divided between native threads, one for each of the given circuits, 
+	 * so all the circuits should be built from the same circuit file and none of them should be used by another thread during the call.
+	 * The garbled tables of the given circuits are overwritten. 
+	 * @param circuits the circuits to garble with. Their number is the number of threads.
+	 * @param seeds the seeds to garble with (16 bytes each, as in {@link #garble(byte[])}).
+	 * @param garbledTables the garbled tables that should match each seed.
+	 * @param translationTables the translation tables that should match each seed.
+	 * @param wireValues an array in the size of the seeds that is filled with the keys and translation table generated from each seed.
+	 * The entry of a seed whose tables are missing or have a wrong size is left null.
+	 * @return for each seed, true if the given tables match it; false otherwise (also if the tables are missing or have a wrong size).
+	 */
+	public static boolean[] verifyGarbledCircuits(ScNativeGarbledBooleanCircuit[] circuits, byte[][] seeds, GarbledTablesHolder[] garbledTables, 
+			byte[][] translationTables, FastCircuitCreationValues[] wireValues) {
+		if (garbledTables.length != seeds.length || translationTables.length != seeds.length || wireValues.length != seeds.length){
+			throw new IllegalArgumentException("there should be garbled tables, translation table and place for the keys for each seed");
+		}
+		
+		long[] ptrs = new long[circuits.length];
+		for (int i = 0; i < circuits.length; i++) {
+			ptrs[i] = circuits[i].garbledCircuitPtr;
+		}
+		
+		//The received tables may come from a cheating party. Missing or malformed tables fail here, since the native code 
+		//reads the arrays without checking them. Only the other seeds are passed to the native code.
+		boolean[] verified = new boolean[seeds.length];
+		int[] indices = new int[seeds.length];
+		byte[][] receivedTables = new byte[seeds.length][];
+		int count = 0;
+		for (int i = 0; i < seeds.length; i++) {
+			if (seeds[i].length != 16){
+				throw new IllegalArgumentException("seed length should be 16 bytes");
+			}
+			byte[][] tables = (garbledTables[i] == null) ? null : garbledTables[i].toDoubleByteArray();
+			if (tables != null && tables.length == 1 && tables[0] != null && translationTables[i] != null 
+					&& translationTables[i].length == circuits[0].outputWireIndices.length){
+				receivedTables[i] = tables[0];
+				indices[count++] = i;
+			}
+		}
+		
+		byte[][] batchSeeds = new byte[count][];
+		byte[][] batchTables = new byte[count][];
+		byte[][] batchTranslationTables = new byte[count][];
+		byte[][] allInputWireValues = new byte[count][];
+		byte[][] allOutputWireValues = new byte[count][];
+		for (int k = 0; k < count; k++) {
+			int i = indices[k];
+			batchSeeds[k] = seeds[i];
+			batchTables[k] = receivedTables[i];
+			batchTranslationTables[k] = translationTables[i];
+			allInputWireValues[k] = new byte[circuits[0].inputsIndices.length*SCAPI_NATIVE_KEY_SIZE*2];
+			allOutputWireValues[k] = new byte[circuits[0].outputWireIndices.length*SCAPI_NATIVE_KEY_SIZE*2];
+		}
+		
+		boolean[] batchVerified = (count == 0) ? new boolean[0] : 
+			verifyGarbledCircuits(ptrs, batchSeeds, batchTables, batchTranslationTables, allInputWireValues, allOutputWireValues);
+		
+		for (int k = 0; k < count; k++) {
+			int i = indices[k];
+			verified[i] = batchVerified[k];
+			wireValues[i] = new FastCircuitCreationValues(allInputWireValues[k], allOutputWireValues[k], translationTables[i]);
+		}
+		return verified;
+	}
+	
 	@Override
 	protected void finalize() throws Throwable {
 		deleteCircuit(garbledCircuitPtr);
@@ -42,6 +42,7 @@ import javax.crypto.SecretKey;
 import edu.biu.scapi.exceptions.SecurityLevelException;
 import edu.biu.scapi.midLayer.ciphertext.SymmetricCiphertext;
 import edu.biu.scapi.midLayer.plaintext.ByteArrayPlaintext;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLGCMEnc;
 import edu.biu.scapi.midLayer.symmetricCrypto.encryption.SymmetricEnc;
 import edu.biu.scapi.securityLevel.Cpa;
 
@@ -50,7 +51,9 @@ import edu.biu.scapi.securityLevel.Cpa;
  * the encryption scheme is initialized with a suitable key. Then, every message sent via this channel is encrypted and decrypted using the underlying encryption scheme.<p>
  * The user needs not to worry about any of the encryption or decryption tasks. The owner of this channel can rest assure that when an object gets sent over this channel 
  * it gets encrypted with the defined encryption scheme. In the same way, when receiving a message sent over this channel (which was encrypted by the other party) 
- * the owner of the channel receives an already decrypted object. 
+ * the owner of the channel receives an already decrypted object. <p>
+ * If the encryption scheme is {@link OpenSSLGCMEnc}, every message is encrypted and authenticated in a single native call and sent as one array 
+ * that holds the IV, the ciphertext and the tag, instead of a serialized ciphertext object. Both parties must use the same encryption scheme.
  *    
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Yael Ejgenberg)
  */
@@ -133,13 +136,23 @@ public class EncryptedChannel extends ChannelDecorator {
 		
 		//Get the message from the channel
 		Serializable rcvMsg = (Serializable)  channel.receive(); 
-		SymmetricCiphertext cipher = (SymmetricCiphertext)rcvMsg;
-		//Decrypt the encrypted message
-		ByteArrayPlaintext msg = (ByteArrayPlaintext) encScheme.decrypt(cipher);
+		byte[] text;
+		if (encScheme instanceof OpenSSLGCMEnc){
+			//The message is the IV, the ciphertext and the tag. Verify and decrypt it in one call.
+			text = ((OpenSSLGCMEnc) encScheme).open((byte[]) rcvMsg);
+			if (text == null){
+				throw new IOException("the received message failed authentication");
+			}
+		} else {
+			SymmetricCiphertext cipher = (SymmetricCiphertext)rcvMsg;
+			//Decrypt the encrypted message
+			ByteArrayPlaintext msg = (ByteArrayPlaintext) encScheme.decrypt(cipher);
+			text = msg.getText();
+		}
 		
 		//Deserialize the object. The caller of this function doesn't need to know anything about encryption, therefore he should get
 		//the plain object that was sent by the sender.
-		ByteArrayInputStream bStream = new ByteArrayInputStream(msg.getText());
+		ByteArrayInputStream bStream = new ByteArrayInputStream(text);
 		ObjectInputStream ois = new ObjectInputStream(bStream);
 				
 		return  (Serializable) ois.readObject();
@@ -163,6 +176,12 @@ public class EncryptedChannel extends ChannelDecorator {
 		//Now retrieve "serialized" msg from bos:
 		byte[] serializedMsg = bos.toByteArray();
 		
+		if (encScheme instanceof OpenSSLGCMEnc){
+			//Encrypt and authenticate in one call and send the IV, the ciphertext and the tag as one array.
+			channel.send(((OpenSSLGCMEnc) encScheme).seal(serializedMsg, 0, serializedMsg.length));
+			return;
+		}
+		
 		//Generate a suitable Plaintext object from the "serialized" message to be sent.
 		ByteArrayPlaintext plainText = new ByteArrayPlaintext(serializedMsg);
 		//Encrypt the plaintext and send ciphertext obtained. (On the other side of the channel, an encrypted message or ciphertext will be received by the channel, 
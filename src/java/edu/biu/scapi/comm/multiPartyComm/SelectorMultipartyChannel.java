@@ -0,0 +1,563 @@
+package edu.biu.scapi.comm.multiPartyComm;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.io.Serializable;
+import java.net.ConnectException;
+import java.net.InetSocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.channels.SelectionKey;
+import java.nio.channels.Selector;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+import java.util.ArrayDeque;
+import java.util.Iterator;
+import java.util.List;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.TimeoutException;
+import java.util.logging.Level;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.twoPartyComm.PartyData;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+import edu.biu.scapi.generals.Logging;
+
+/**
+ * This class implements a communication between multiple parties using non blocking TCP sockets that are multiplexed on a single selector thread.<p>
+ *
+ * {@link SocketMultipartyCommunicationSetup} creates two blocking sockets for each other party, and a protocol that talks to all the parties
+ * at the same time needs a thread for each party. Here there is a single full duplex socket for each other party, and all the sockets
+ * are served by one thread:
+ * <ul>
+ * <li>A message is written to the socket directly by the sending thread, as much as the socket accepts without blocking.
+ * The rest of the message (if any) is written by the selector thread when the socket becomes writable, so the sender never waits for the other party.</li>
+ * <li>The selector thread reads the incoming messages of all the parties and queues them for each party until they are received.</li>
+ * </ul>
+ * Thus, {@link #broadcast(Serializable)} writes the message once to each socket without waiting for any party, and {@link #gather()}
+ * receives a message from each party in any order they arrive. <p>
+ *
+ * The messages are framed as in {@link edu.biu.scapi.comm.twoPartyComm.PlainTCPSocketChannel}: a byte array is written as is after its length,
+ * and any other object is serialized first. <p>
+ *
+ * The parties are given by their indices in the list of parties given in the constructor, where index 0 is the current party.
+ * A channel to a single party, that can be used by any protocol that works with {@link Channel}, is returned by {@link #getChannel(int)}.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class SelectorMultipartyChannel {
+
+	private static final byte BYTES_FRAME = 0;	//The payload is a byte array message.
+	private static final byte OBJECT_FRAME = 1;	//The payload is the serialization of any other message.
+	private static final int HEADER_SIZE = 5;	//The type of the frame and the length of the payload.
+
+	private SocketPartyData[] parties;			//The data of all parties. The first one is the current party.
+	private Peer[] peers;						//The connection to each other party. peers[0] is null.
+	private Selector selector;
+	private Thread selectorThread;
+	private ConcurrentLinkedQueue<Peer> writeRequests = new ConcurrentLinkedQueue<Peer>();	//Parties that have pending bytes to write.
+	private volatile boolean closed = false;
+	private boolean enableNagle = false;
+
+	/*
+	 * An incoming message that has not been received yet.
+	 * In case the connection failed, the failure is queued instead of the message in order to wake up the receiver.
+	 */
+	private static class Frame {
+		final byte type;
+		final byte[] data;
+		final IOException failure;
+
+		Frame(byte type, byte[] data, IOException failure){
+			this.type = type;
+			this.data = data;
+			this.failure = failure;
+		}
+	}
+
+	/*
+	 * The connection to another party.
+	 */
+	private class Peer {
+		final SocketChannel socket;
+		SelectionKey key;
+
+		//Outgoing buffers that were not written yet. Guarded by the peer.
+		final ArrayDeque<ByteBuffer> pending = new ArrayDeque<ByteBuffer>();
+		IOException failure;
+
+		//The incoming frame. Used only by the selector thread.
+		final ByteBuffer header = ByteBuffer.allocate(HEADER_SIZE);
+		ByteBuffer body;
+		byte type;
+		final LinkedBlockingQueue<Frame> received = new LinkedBlockingQueue<Frame>();
+
+		Peer(SocketChannel socket){
+			this.socket = socket;
+		}
+	}
+
+	/**
+	 * A constructor that sets the parties to communicate with. The connections are created by {@link #connect(long)}.
+	 * @param parties List of all the parties. The first party should be the current party.
+	 * @throws IllegalArgumentException if any of the parties is not a SocketPartyData.
+	 */
+	public SelectorMultipartyChannel(List<PartyData> parties){
+		this.parties = new SocketPartyData[parties.size()];
+		for (int i = 0; i < this.parties.length; i++){
+			if (!(parties.get(i) instanceof SocketPartyData)){
+				throw new IllegalArgumentException("all parties should be instances of SocketPartyData");
+			}
+			this.parties[i] = (SocketPartyData) parties.get(i);
+		}
+	}
+
+	/**
+	 * Enables to use Nagle algrithm in the communication. Should be called before connect. <p>
+	 * By default Nagle algorithm is disabled since it is much better for cryptographic algorithms.
+	 */
+	public void enableNagle(){
+		enableNagle = true;
+	}
+
+	/**
+	 * Creates a connection to each other party and starts the selector thread. <p>
+	 * The party with the larger address (see {@link SocketPartyData#compareTo(SocketPartyData)}) of each pair connects to the other
+	 * party and sends its port, and the other party accepts the connection on its own address.
+	 * @param timeOut the maximum amount of time in milliseconds we allow for the connection stage.
+	 * @throws TimeoutException in case a timeout has occurred before all the parties have been connected.
+	 * @throws IOException in case of a problem in the connection.
+	 */
+	public void connect(long timeOut) throws TimeoutException, IOException {
+		long deadline = System.currentTimeMillis() + timeOut;
+		SocketPartyData me = parties[0];
+		peers = new Peer[parties.length];
+
+		ServerSocketChannel server = ServerSocketChannel.open();
+		try {
+			server.socket().setReuseAddress(true);
+			server.socket().bind(new InetSocketAddress(me.getIpAddress(), me.getPort()));
+
+			//Connect to the smaller parties. The connection completes as soon as the other party listens, even before it accepts.
+			int numToAccept = 0;
+			for (int i = 1; i < parties.length; i++){
+				if (me.compareTo(parties[i]) > 0){
+					peers[i] = new Peer(connectTo(parties[i], deadline));
+				} else {
+					numToAccept++;
+				}
+			}
+			acceptFrom(server, numToAccept, deadline);
+		} finally {
+			server.close();
+		}
+
+		selector = Selector.open();
+		for (int i = 1; i < peers.length; i++){
+			peers[i].socket.socket().setTcpNoDelay(!enableNagle);
+			peers[i].socket.configureBlocking(false);
+			peers[i].key = peers[i].socket.register(selector, SelectionKey.OP_READ, peers[i]);
+		}
+		selectorThread = new Thread("SelectorMultipartyChannel " + me.getPort()){
+			public void run(){
+				select();
+			}
+		};
+		selectorThread.setDaemon(true);
+		selectorThread.start();
+	}
+
+	/*
+	 * Connects to the given party, retrying until it listens or the deadline has passed, and sends it the port of this party.
+	 */
+	private SocketChannel connectTo(SocketPartyData party, long deadline) throws TimeoutException, IOException {
+		while (true){
+			try {
+				SocketChannel socket = SocketChannel.open(new InetSocketAddress(party.getIpAddress(), party.getPort()));
+				ByteBuffer port = ByteBuffer.allocate(4).putInt(parties[0].getPort());
+				port.flip();
+				while (port.hasRemaining()){
+					socket.write(port);
+				}
+				return socket;
+			} catch (ConnectException e){
+				if (System.currentTimeMillis() > deadline){
+					throw new TimeoutException("timeout has occurred");
+				}
+				try {
+					Thread.sleep(100);
+				} catch (InterruptedException ie) {
+					throw new InterruptedIOException();
+				}
+			}
+		}
+	}
+
+	/*
+	 * Accepts the given number of connections from the larger parties. Each accepted party is identified by its ip address and the
+	 * port it sends. Connections from unknown parties are closed.
+	 */
+	private void acceptFrom(ServerSocketChannel server, int numToAccept, long deadline) throws TimeoutException, IOException {
+		server.configureBlocking(false);
+		Selector acceptSelector = Selector.open();
+		try {
+			server.register(acceptSelector, SelectionKey.OP_ACCEPT);
+			while (numToAccept > 0){
+				long remaining = deadline - System.currentTimeMillis();
+				if (remaining <= 0){
+					throw new TimeoutException("timeout has occurred");
+				}
+				acceptSelector.select(remaining);
+				acceptSelector.selectedKeys().clear();
+
+				SocketChannel socket;
+				while (numToAccept > 0 && (socket = server.accept()) != null){
+					socket.configureBlocking(true);
+					ByteBuffer port = ByteBuffer.allocate(4);
+					while (port.hasRemaining()){
+						if (socket.read(port) < 0){
+							throw new EOFException("the connection was closed before the port was sent");
+						}
+					}
+					port.flip();
+					int index = indexOf(socket, port.getInt());
+					if (index == -1 || peers[index] != null){
+						Logging.getLogger().log(Level.WARNING, "unexpected connection from " + socket.socket().getRemoteSocketAddress());
+						socket.close();
+					} else {
+						peers[index] = new Peer(socket);
+						numToAccept--;
+					}
+				}
+			}
+		} finally {
+			acceptSelector.close();
+		}
+	}
+
+	private int indexOf(SocketChannel socket, int port){
+		for (int i = 1; i < parties.length; i++){
+			if (parties[i].getPort() == port && parties[i].getIpAddress().equals(socket.socket().getInetAddress())){
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Returns the number of parties, including the current party.
+	 */
+	public int getNumOfParties(){
+		return parties.length;
+	}
+
+	/**
+	 * Sends the given message to the given party. <p>
+	 * The function does not wait for the other party; the part of the message that could not be written immediately is copied and written 
+	 * by the selector thread, so a byte array message may be changed as soon as the function returns.
+	 * @param party The index of the party.
+	 * @param msg The message to send.
+	 * @throws IOException in case the connection to the party failed.
+	 */
+	public void send(int party, Serializable msg) throws IOException {
+		byte type = (msg instanceof byte[]) ? BYTES_FRAME : OBJECT_FRAME;
+		write(peers[party], type, toBytes(msg));
+	}
+
+	/**
+	 * Sends the given message to all the other parties. An object that is not a byte array is serialized once for all the parties.
+	 * @param msg The message to send.
+	 * @throws IOException in case the connection to any party failed.
+	 */
+	public void broadcast(Serializable msg) throws IOException {
+		byte type = (msg instanceof byte[]) ? BYTES_FRAME : OBJECT_FRAME;
+		byte[] data = toBytes(msg);
+		for (int i = 1; i < peers.length; i++){
+			write(peers[i], type, data);
+		}
+	}
+
+	/**
+	 * Receives the next message of the given party. Blocks until the message arrives.
+	 * @param party The index of the party.
+	 * @return the received message. A message that was sent as a byte array is returned as a byte array.
+	 * @throws ClassNotFoundException  The Class of the serialized object cannot be found.
+	 * @throws IOException in case the connection to the party failed.
+	 */
+	public Serializable receive(int party) throws ClassNotFoundException, IOException {
+		Frame frame;
+		try {
+			frame = peers[party].received.take();
+		} catch (InterruptedException e) {
+			throw new InterruptedIOException();
+		}
+		if (frame.failure != null){
+			//Keep the failure for the next calls.
+			peers[party].received.add(frame);
+			throw frame.failure;
+		}
+		if (frame.type == BYTES_FRAME){
+			return frame.data;
+		}
+		ObjectInputStream ois = new ObjectInputStream(new ByteArrayInputStream(frame.data));
+		return (Serializable) ois.readObject();
+	}
+
+	/**
+	 * Receives the next message of each other party.
+	 * @return an array that holds the message of each party in its index. The first entry (the current party) is null.
+	 * @throws ClassNotFoundException  The Class of a serialized object cannot be found.
+	 * @throws IOException in case the connection to any party failed.
+	 */
+	public Serializable[] gather() throws ClassNotFoundException, IOException {
+		Serializable[] messages = new Serializable[peers.length];
+		for (int i = 1; i < peers.length; i++){
+			messages[i] = receive(i);
+		}
+		return messages;
+	}
+
+	/**
+	 * Returns a channel to the given party, that sends and receives its messages through this object.
+	 * @param party The index of the party.
+	 */
+	public Channel getChannel(final int party){
+		return new Channel(){
+			public void send(Serializable data) throws IOException {
+				SelectorMultipartyChannel.this.send(party, data);
+			}
+			public Serializable receive() throws ClassNotFoundException, IOException {
+				return SelectorMultipartyChannel.this.receive(party);
+			}
+			//Closes the connections to all the parties.
+			public void close() {
+				SelectorMultipartyChannel.this.close();
+			}
+			public boolean isClosed() {
+				return closed;
+			}
+		};
+	}
+
+	/**
+	 * Waits until the messages that were sent are written to the sockets, and then closes the selector thread and the connections to all the parties.
+	 */
+	public void close(){
+		if (closed){
+			return;
+		}
+		if (selector != null){
+			for (int i = 1; i < peers.length; i++){
+				synchronized (peers[i]){
+					while (!peers[i].pending.isEmpty() && peers[i].failure == null){
+						try {
+							peers[i].wait();
+						} catch (InterruptedException e) {
+							Thread.currentThread().interrupt();
+							break;
+						}
+					}
+				}
+			}
+		}
+		closed = true;
+		if (selector != null){
+			selector.wakeup();
+			try {
+				selectorThread.join();
+			} catch (InterruptedException e) {
+				Thread.currentThread().interrupt();
+			}
+		}
+		if (peers != null){
+			for (int i = 1; i < peers.length; i++){
+				if (peers[i] != null){
+					try {
+						peers[i].socket.close();
+					} catch (IOException e) {
+						Logging.getLogger().log(Level.WARNING, e.toString());
+					}
+				}
+			}
+		}
+	}
+
+	private static byte[] toBytes(Serializable msg) throws IOException {
+		if (msg instanceof byte[]){
+			return (byte[]) msg;
+		}
+		ByteArrayOutputStream serialization = new ByteArrayOutputStream();
+		ObjectOutputStream oOut = new ObjectOutputStream(serialization);
+		oOut.writeObject(msg);
+		oOut.close();
+		return serialization.toByteArray();
+	}
+
+	/*
+	 * Writes a frame to the party without blocking. If the socket does not accept the whole frame, the rest of it is queued
+	 * and the selector thread is asked to write it.
+	 * The queued part of the data is copied, so the caller may reuse its array as soon as this function returns, 
+	 * as it can after the blocking send of PlainTCPSocketChannel.
+	 */
+	private void write(Peer peer, byte type, byte[] data) throws IOException {
+		ByteBuffer header = ByteBuffer.allocate(HEADER_SIZE);
+		header.put(type).putInt(data.length);
+		header.flip();
+		ByteBuffer[] frame = {header, ByteBuffer.wrap(data)};
+
+		synchronized (peer){
+			if (peer.failure != null){
+				throw peer.failure;
+			}
+			//Keep the order of the frames; write directly only if no earlier frame is waiting.
+			if (peer.pending.isEmpty()){
+				try {
+					peer.socket.write(frame);
+				} catch (IOException e) {
+					peer.failure = e;
+					throw e;
+				}
+				if (!header.hasRemaining() && !frame[1].hasRemaining()){
+					return;
+				}
+				if (header.hasRemaining()){
+					peer.pending.add(header);
+				}
+				if (frame[1].hasRemaining()){
+					peer.pending.add(copyRemaining(frame[1]));
+				}
+				writeRequests.add(peer);
+				selector.wakeup();
+			} else {
+				peer.pending.add(header);
+				peer.pending.add(copyRemaining(frame[1]));
+			}
+		}
+	}
+
+	/*
+	 * Returns a new buffer with the remaining bytes of the given buffer.
+	 */
+	private static ByteBuffer copyRemaining(ByteBuffer buffer){
+		ByteBuffer copy = ByteBuffer.allocate(buffer.remaining());
+		copy.put(buffer);
+		copy.flip();
+		return copy;
+	}
+
+	/*
+	 * The loop of the selector thread. Reads the incoming frames of all the parties and writes their pending frames.
+	 */
+	private void select(){
+		try {
+			while (!closed){
+				selector.select();
+				Peer peer;
+				while ((peer = writeRequests.poll()) != null){
+					if (peer.key.isValid()){
+						peer.key.interestOps(peer.key.interestOps() | SelectionKey.OP_WRITE);
+					}
+				}
+
+				Iterator<SelectionKey> keys = selector.selectedKeys().iterator();
+				while (keys.hasNext()){
+					SelectionKey key = keys.next();
+					keys.remove();
+					peer = (Peer) key.attachment();
+					try {
+						if (key.isReadable()){
+							read(peer);
+						}
+						if (key.isValid() && key.isWritable()){
+							flush(peer);
+						}
+					} catch (IOException e) {
+						fail(peer, e);
+					}
+				}
+			}
+		} catch (IOException e) {
+			Logging.getLogger().log(Level.WARNING, e.toString());
+			for (int i = 1; i < peers.length; i++){
+				fail(peers[i], e);
+			}
+		} finally {
+			try {
+				selector.close();
+			} catch (IOException e) {
+				Logging.getLogger().log(Level.WARNING, e.toString());
+			}
+		}
+	}
+
+	/*
+	 * Reads all the available bytes of the party and queues its complete frames.
+	 */
+	private void read(Peer peer) throws IOException {
+		while (true){
+			if (peer.body == null){
+				if (peer.socket.read(peer.header) < 0){
+					throw new EOFException("the connection was closed by the other party");
+				}
+				if (peer.header.hasRemaining()){
+					return;
+				}
+				peer.header.flip();
+				peer.type = peer.header.get();
+				int length = peer.header.getInt();
+				peer.header.clear();
+				if (length < 0 || (peer.type != BYTES_FRAME && peer.type != OBJECT_FRAME)){
+					throw new IOException("invalid message header");
+				}
+				peer.body = ByteBuffer.allocate(length);
+			}
+			if (peer.body.hasRemaining() && peer.socket.read(peer.body) < 0){
+				throw new EOFException("the connection was closed by the other party");
+			}
+			if (peer.body.hasRemaining()){
+				return;
+			}
+			peer.received.add(new Frame(peer.type, peer.body.array(), null));
+			peer.body = null;
+		}
+	}
+
+	/*
+	 * Writes the pending frames of the party as much as the socket accepts. Stops waiting for the socket to be writable when all are written.
+	 */
+	private void flush(Peer peer) throws IOException {
+		synchronized (peer){
+			while (!peer.pending.isEmpty()){
+				ByteBuffer buffer = peer.pending.peek();
+				peer.socket.write(buffer);
+				if (buffer.hasRemaining()){
+					return;
+				}
+				peer.pending.poll();
+			}
+			peer.key.interestOps(peer.key.interestOps() & ~SelectionKey.OP_WRITE);
+			//Wake up close, that waits for the pending frames.
+			peer.notifyAll();
+		}
+	}
+
+	/*
+	 * Marks the connection to the party as failed, and wakes up the threads that wait for its messages.
+	 */
+	private void fail(Peer peer, IOException e){
+		synchronized (peer){
+			if (peer.failure == null){
+				peer.failure = e;
+			}
+			peer.notifyAll();
+		}
+		peer.key.cancel();
+		peer.received.add(new Frame(BYTES_FRAME, null, e));
+	}
+}
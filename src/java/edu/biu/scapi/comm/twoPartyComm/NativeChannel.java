@@ -6,6 +6,7 @@ import java.io.IOException;
 import java.io.ObjectInputStream;
 import java.io.ObjectOutputStream;
 import java.io.Serializable;
+import java.nio.ByteBuffer;
 import java.util.logging.Level;
 
 import edu.biu.scapi.comm.Channel;
@@ -38,6 +39,8 @@ public class NativeChannel implements Channel{
 	private native long initSendSocket(String address, int port);
 	private native void send(long sendSocketPtr, byte[] data);
 	private native byte[] receive(long receiveSocketPtr);
+	private native void sendMany(long sendSocketPtr, byte[][] messages);
+	private native int receiveDirect(long receiveSocketPtr, ByteBuffer buffer, int offset, int capacity);
 	private native boolean closeSockets(long sendSocketPtr, long receiveSocketPtr);
 	private native void enableNagle(long sendSocketPtr, long receiveSocketPtr);
 	
@@ -71,6 +74,64 @@ public class NativeChannel implements Channel{
 		return (Serializable) ois.readObject();
 	}
 
+	/**
+	 * Sends the given bytes as a single message, without serializing them. <p>
+	 * Small messages are sent together with their size in a single system call, without allocating memory.
+	 * The other side should receive the message using {@link #receiveBytes()} or {@link #receive(ByteBuffer)}.
+	 * @param data the message to send.
+	 */
+	public void sendBytes(byte[] data) {
+		send(sendSocketPtr, data);
+	}
+	
+	/**
+	 * Sends the given messages one after the other. <p>
+	 * Consecutive small messages are gathered and sent in a single system call, 
+	 * which is much faster than sending each one of them for protocols that send many small messages.
+	 * The other side receives each message separately, using {@link #receiveBytes()} or {@link #receive(ByteBuffer)}.
+	 * @param messages the messages to send.
+	 * @throws NullPointerException if one of the messages is null. In this case nothing is sent.
+	 */
+	public void sendMany(byte[][] messages) {
+		//A null message would crash the native code, so check all the messages before anything is sent.
+		for (int i = 0; i < messages.length; i++) {
+			if (messages[i] == null){
+				throw new NullPointerException("message " + i + " is null");
+			}
+		}
+		sendMany(sendSocketPtr, messages);
+	}
+	
+	/**
+	 * Receives a message that was sent by {@link #sendBytes(byte[])} or {@link #sendMany(byte[][])}, without deserializing it.<p>
+	 * The message is read into a reusable native buffer, so the only allocation is of the returned array.
+	 * @return the received message.
+	 */
+	public byte[] receiveBytes() {
+		return receive(receiveSocketPtr);
+	}
+	
+	/**
+	 * Receives a message that was sent by {@link #sendBytes(byte[])} or {@link #sendMany(byte[][])} directly into the given buffer, 
+	 * starting at its position. The position of the buffer is advanced by the size of the message.<p>
+	 * If the message does not fit in the remaining space of the buffer, nothing is written and the buffer is not changed. 
+	 * In this case the message is kept by the channel and the next call to this function (or to {@link #receiveBytes()}) returns it.
+	 * @param buffer a direct byte buffer to receive the message into.
+	 * @return the size of the message if it was written to the buffer, or minus the size of the message if the buffer was too small.
+	 * @throws IllegalArgumentException if the buffer is not direct.
+	 */
+	public int receive(ByteBuffer buffer) {
+		if (!buffer.isDirect()){
+			throw new IllegalArgumentException("the buffer should be a direct byte buffer");
+		}
+		
+		int size = receiveDirect(receiveSocketPtr, buffer, buffer.position(), buffer.remaining());
+		if (size >= 0){
+			buffer.position(buffer.position() + size);
+		}
+		return size;
+	}
+
 	@Override
 	public void close() {
 		isClosed = closeSockets(sendSocketPtr, receiveSocketPtr);
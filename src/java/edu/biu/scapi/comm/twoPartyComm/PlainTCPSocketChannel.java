@@ -25,8 +25,12 @@
 
 package edu.biu.scapi.comm.twoPartyComm;
 
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
 import java.io.ByteArrayInputStream;
 import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
 import java.io.IOException;
 import java.io.ObjectInputStream;
 import java.io.ObjectOutputStream;
@@ -51,7 +55,11 @@ import edu.biu.scapi.generals.Logging;
  *  
  * The difference between this implementation to the {@link PlainTCPChannel} is that here there are two sockets: 
  * one used to receive messages and one used to send messages. The other {@link PlainTCPChannel} has one socket used 
- * both to send and receive. 
+ * both to send and receive. <p>
+ * 
+ * Each message is written to the socket as one frame: a type byte, the length of the payload and the payload.
+ * Byte arrays, which are most of the traffic of the OT and garbled circuit protocols, are written as is with no serialization
+ * and are received as byte arrays. Any other Serializable object is serialized into the payload of its frame.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
@@ -81,14 +89,17 @@ public class PlainTCPSocketChannel extends PlainChannel{
 //	private State state;						// The state of the channel.
 	protected Socket sendSocket;				//A socket used to send messages.
 	private Socket receiveSocket;				//A socket used to receive messages.
-	protected ObjectOutputStream outStream;		//Used to send a message
-	private ObjectInputStream inStream;			//Used to receive a message.
+	protected DataOutputStream outStream;		//Used to send a message
+	private DataInputStream inStream;			//Used to receive a message.
 	protected InetSocketAddress socketAddress;	//The address of the other party.
-	private Message intermediate;
-	private Message msgObj;
-	private byte[] msgBytes;
+	private ByteArrayOutputStream serializationBuffer = new ByteArrayOutputStream();	//Reused to serialize the messages that are not byte arrays.
 	private SocketPartyData me;					//Used to send the identity if needed.
 	protected boolean checkIdentity;			//Indicated if there is a need to verify identity.
+	
+	//The types of the frames written to the socket.
+	private static final byte BYTES_FRAME = 0;	//The payload is a byte array message.
+	private static final byte OBJECT_FRAME = 1;	//The payload is the serialization of any other message.
+	private static final int BUFFER_SIZE = 64 * 1024;
 
 	/**
 	 * A constructor that set the state of this channel to not ready.
@@ -118,44 +129,59 @@ public class PlainTCPSocketChannel extends PlainChannel{
 	}
 
 	/** 
-	 * Sends the message to the other user of the channel with TCP protocol.
+	 * Sends the message to the other user of the channel with TCP protocol.<p>
+	 * A byte array is written straight to the socket after its length. Any other object is serialized first, with a new 
+	 * ObjectOutputStream for each message so that no back references are kept between messages.
 	 *  
 	 * @param msg the object to send.
 	 * @throws IOException Any of the usual Input/Output related exceptions.  
 	 */
 	public void send(Serializable msg) throws IOException {
-		//For some reason it turns out that writing complex objects first to a byte array message is faster than using the stream
-		//of the socket to write the object. Thus we create here a Message object and translate it back to the actual object in the receive method
-		//The use of a local stream that does the writeObject is faster than the writeObject of outStream member variable of this class
-				
-		ByteArrayOutputStream bOut = new ByteArrayOutputStream();  
-	    ObjectOutputStream oOut  = new ObjectOutputStream(bOut);
-		oOut.writeObject(msg);  
-		oOut.close();
-		
-		msgBytes = bOut.toByteArray();
-		msgObj = new Message(null);
-		msgObj.setData(msgBytes);
-		outStream.writeObject(msgObj);
-		outStream.reset();
-		
+		if (msg instanceof byte[]){
+			byte[] data = (byte[]) msg;
+			outStream.writeByte(BYTES_FRAME);
+			outStream.writeInt(data.length);
+			outStream.write(data);
+			
+		} else {
+			serializationBuffer.reset();
+			ObjectOutputStream oOut = new ObjectOutputStream(serializationBuffer);
+			oOut.writeObject(msg);
+			oOut.close();
+			
+			outStream.writeByte(OBJECT_FRAME);
+			outStream.writeInt(serializationBuffer.size());
+			serializationBuffer.writeTo(outStream);
+		}
+		outStream.flush();
 	}
 
 	/** 
 	 * Receives the message sent by the other user of the channel. 
+	 * A message that was sent as a byte array is returned as a byte array.
 	 * 
 	 * @throws ClassNotFoundException  The Class of the serialized object cannot be found.
 	 * @throws IOException Any of the usual Input/Output related exceptions.
 	 */
 	public Serializable receive() throws ClassNotFoundException, IOException {
+		byte type = inStream.readByte();
+		int length = inStream.readInt();
+		if (length < 0){
+			throw new IOException("invalid message length " + length);
+		}
+		byte[] data = new byte[length];
+		inStream.readFully(data);
 		
-		//We actually received a message of class Message. We translate it back to the original object that was sent by the user and return this object. 
-		intermediate =   (Message) inStream.readObject();
-		ByteArrayInputStream iInput = new ByteArrayInputStream(intermediate.getData());
-		ObjectInputStream ois = new ObjectInputStream(iInput);
+		if (type == BYTES_FRAME){
+			return data;
+		}
+		if (type != OBJECT_FRAME){
+			throw new IOException("invalid message type " + type);
+		}
 		
+		//Translate the payload back to the original object that was sent by the user. 
+		ObjectInputStream ois = new ObjectInputStream(new ByteArrayInputStream(data));
 		return (Serializable) ois.readObject();
-		
 	}
 
 	/**
@@ -214,7 +240,7 @@ public class PlainTCPSocketChannel extends PlainChannel{
 				}
 				
 				Logging.getLogger().log(Level.INFO, "Socket connected");
-				outStream = new ObjectOutputStream(sendSocket.getOutputStream());
+				outStream = createOutputStream(sendSocket);
 					
 				//After the send socket is connected, need to check if the receive socket is also connected.
 				//If so, set the channel state to READY.
@@ -228,6 +254,13 @@ public class PlainTCPSocketChannel extends PlainChannel{
 		return true;
 	}
 
+	/**
+	 * Creates the stream that writes the frames of the messages to the given send socket.
+	 */
+	protected static DataOutputStream createOutputStream(Socket socket) throws IOException {
+		return new DataOutputStream(new BufferedOutputStream(socket.getOutputStream(), BUFFER_SIZE));
+	}
+	
 	protected void sendIdentity() throws IOException {
 		byte[] port = ByteBuffer.allocate(4).putInt(me.getPort()).array();
 		sendSocket.getOutputStream().write(port, 0, port.length);
@@ -260,7 +293,7 @@ public class PlainTCPSocketChannel extends PlainChannel{
 		
 		try {
 			//set the input and output streams
-			inStream = new ObjectInputStream(socket.getInputStream());
+			inStream = new DataInputStream(new BufferedInputStream(socket.getInputStream(), BUFFER_SIZE));
 			//After the receive socket is connected, need to check if the send socket is also connected.
 			//If so, set the channel state to READY.
 			setReady();
@@ -26,7 +26,6 @@
 package edu.biu.scapi.comm.twoPartyComm;
 
 import java.io.IOException;
-import java.io.ObjectOutputStream;
 import java.net.InetAddress;
 import java.net.InetSocketAddress;
 import java.util.logging.Level;
@@ -134,14 +133,14 @@ public class SSLSocketChannel extends PlainTCPSocketChannel{
 		}
 		
 		/**
-		 * After the send socket has been created, set its outputStream to this ObjectOutputStream and call setReady().
+		 * After the send socket has been created, set its output stream to the channel and call setReady().
 		 */
 		@Override
 		public void handshakeCompleted(HandshakeCompletedEvent arg0) {
 			
 			Logging.getLogger().log(Level.INFO, "Socket connected");
 			try {
-				channel.outStream = new ObjectOutputStream(arg0.getSocket().getOutputStream());
+				channel.outStream = createOutputStream(arg0.getSocket());
 				
 			} catch (IOException e) {
 				
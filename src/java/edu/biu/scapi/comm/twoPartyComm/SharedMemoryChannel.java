@@ -0,0 +1,164 @@
+package edu.biu.scapi.comm.twoPartyComm;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.io.Serializable;
+import java.util.logging.Level;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.generals.Logging;
+
+/**
+ * A channel between two parties that run on the same host, over a shared memory segment instead of a TCP connection. <p>
+ * The segment holds a ring buffer for each direction. A message is copied from the java array of the sender straight into the ring
+ * and from the ring straight into the java array of the receiver, so it does not pass through the kernel and there is no system call
+ * as long as both parties keep up. A party that waits for the other one sleeps on a futex in the segment. <p>
+ * Like {@link PlainTCPSocketChannel}, a byte array is sent as is and any other object is serialized first. <p>
+ * The native code of the channel (SharedMemoryConnection) has the Send and Receive functions of the sockets of the OT extension,
+ * so native code that runs on the same host can use the same transport. <p>
+ * The channels are created by {@link SharedMemoryCommunicationSetup}.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class SharedMemoryChannel implements Channel{
+
+	private static final byte BYTES_FRAME = 0;	//The payload is a byte array message.
+	private static final byte OBJECT_FRAME = 1;	//The payload is the serialization of any other message.
+
+	private String name;						//The name of the shared memory segment.
+	private boolean creator;					//Indicates if this party creates the segment or opens it.
+	private long capacity;						//The size of each ring, in bytes.
+	private long connectionPtr;					//Pointer to the native connection.
+	private boolean isClosed;
+
+	private ByteArrayOutputStream serializationBuffer = new ByteArrayOutputStream();	//Reused to serialize the messages that are not byte arrays.
+
+	private native long createSegment(String name, long capacity, long timeOut);
+	private native long openSegment(String name, long timeOut);
+	private native boolean send(long connectionPtr, byte type, byte[] data);
+	private native long receiveHeader(long connectionPtr);
+	private native boolean receiveBody(long connectionPtr, byte[] data);
+	private native void closeSegment(long connectionPtr);
+	private native void deleteSegment(long connectionPtr);
+
+	/**
+	 * @param name the name of the shared memory segment. Both parties should use the same name.
+	 * @param creator true if this party creates the segment; Exactly one of the parties should create it.
+	 * @param capacity the size of each ring in bytes. Used only by the party that creates the segment.
+	 */
+	SharedMemoryChannel(String name, boolean creator, long capacity) {
+		this.name = name;
+		this.creator = creator;
+		this.capacity = capacity;
+	}
+
+	/**
+	 * Creates or opens the segment and waits for the other party.
+	 * @param timeOut the maximum time in milliseconds to wait for the other party.
+	 * @return true if the channel is connected; false if the timeout has occurred.
+	 */
+	boolean connect(long timeOut) {
+		Logging.getLogger().log(Level.INFO, (creator ? "Creating" : "Opening") + " the shared memory segment " + name);
+
+		connectionPtr = creator ? createSegment(name, capacity, timeOut) : openSegment(name, timeOut);
+		isClosed = (connectionPtr == 0);
+		return !isClosed;
+	}
+
+	/**
+	 * Sends the message to the other party. A byte array is sent as is. Any other object is serialized first.
+	 * @param msg the object to send.
+	 * @throws IOException if the channel was closed.
+	 */
+	@Override
+	public void send(Serializable msg) throws IOException {
+		checkConnected();
+		boolean sent;
+		if (msg instanceof byte[]){
+			sent = send(connectionPtr, BYTES_FRAME, (byte[]) msg);
+		} else {
+			serializationBuffer.reset();
+			ObjectOutputStream oOut = new ObjectOutputStream(serializationBuffer);
+			oOut.writeObject(msg);
+			oOut.close();
+			sent = send(connectionPtr, OBJECT_FRAME, serializationBuffer.toByteArray());
+		}
+		if (!sent){
+			throw new IOException("the shared memory channel was closed");
+		}
+	}
+
+	/**
+	 * Receives the message sent by the other party. A message that was sent as a byte array is returned as a byte array.
+	 * @throws ClassNotFoundException The Class of the serialized object cannot be found.
+	 * @throws IOException if the channel was closed.
+	 */
+	@Override
+	public Serializable receive() throws ClassNotFoundException, IOException {
+		checkConnected();
+		long header = receiveHeader(connectionPtr);
+		if (header == -1){
+			throw new IOException("the shared memory channel was closed");
+		}
+		byte type = (byte) (header >>> 32);
+		int length = (int) header;
+		if (length < 0){
+			throw new IOException("invalid message length " + length);
+		}
+
+		byte[] data = new byte[length];
+		if (!receiveBody(connectionPtr, data)){
+			throw new IOException("the shared memory channel was closed");
+		}
+
+		if (type == BYTES_FRAME){
+			return data;
+		}
+		if (type != OBJECT_FRAME){
+			throw new IOException("invalid message type " + type);
+		}
+		ObjectInputStream ois = new ObjectInputStream(new ByteArrayInputStream(data));
+		return (Serializable) ois.readObject();
+	}
+
+	private void checkConnected() {
+		if (connectionPtr == 0){
+			throw new IllegalStateException("the channel is not connected");
+		}
+	}
+
+	/**
+	 * Closes the channel. A party that waits for a message from this channel is woken and gets an IOException.<p>
+	 * The shared memory is released when the channel is garbage collected, so that a thread that still uses the channel
+	 * does not access memory that was unmapped.
+	 */
+	@Override
+	public void close() {
+		if (connectionPtr != 0 && !isClosed){
+			closeSegment(connectionPtr);
+		}
+		isClosed = true;
+	}
+
+	@Override
+	public boolean isClosed() {
+		return isClosed;
+	}
+
+	@Override
+	protected void finalize() throws Throwable {
+		if (connectionPtr != 0){
+			deleteSegment(connectionPtr);
+			connectionPtr = 0;
+		}
+		super.finalize();
+	}
+
+	static {
+		 System.loadLibrary("CommJavaInterface");
+	}
+}
@@ -0,0 +1,119 @@
+package edu.biu.scapi.comm.twoPartyComm;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.TimeoutException;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.exceptions.DuplicatePartyException;
+
+/**
+ * Creates {@link SharedMemoryChannel}s between two parties that run on the same host. <p>
+ * The parties are given as SocketPartyData, as for the other two party setups, but no socket is opened. The name of the shared
+ * memory segment of each connection is derived from the ports of the two parties and the id of the connection, and the party with
+ * the smaller address creates the segment while the other party opens it. So both parties should use the same ids, and the ports
+ * should identify the pair of parties among the parties that run on the host.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class SharedMemoryCommunicationSetup implements TwoPartyCommunicationSetup{
+
+	private SocketPartyData me;				//The data of the current application.
+	private SocketPartyData other;			//The data of the other application to communicate with.
+	private long capacity;					//The size of each ring of the created channels.
+	private int connectionsNumber;			//Holds the number of created connections.
+
+	/**
+	 * A constructor that set the given parties. The rings of the channels have the default size of 32 MB.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application to communicate with.
+	 * @throws DuplicatePartyException if both parties have the same address and port.
+	 */
+	public SharedMemoryCommunicationSetup(PartyData me, PartyData party) throws DuplicatePartyException{
+		this(me, party, 32 * 1024 * 1024);
+	}
+
+	/**
+	 * A constructor that set the given parties and the size of the rings. <p>
+	 * Larger rings let the sender of a long stream of messages (garbled tables, for example) run further ahead of the receiver.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application to communicate with.
+	 * @param capacity the size in bytes of each ring (one for each direction) of the created channels.
+	 * @throws DuplicatePartyException if both parties have the same address and port.
+	 */
+	public SharedMemoryCommunicationSetup(PartyData me, PartyData party, long capacity) throws DuplicatePartyException{
+		//Both parties should be instances of SocketPArty.
+		if (!(me instanceof SocketPartyData) || !(party instanceof SocketPartyData)){
+			throw new IllegalArgumentException("both parties should be instances of SocketParty");
+		}
+		if (capacity <= 0){
+			throw new IllegalArgumentException("the capacity should be positive");
+		}
+		this.me = (SocketPartyData) me;
+		this.other = (SocketPartyData) party;
+		this.capacity = capacity;
+
+		//Compare the two given parties. If they are the same, throw exception.
+		if(this.me.compareTo(other) == 0){
+			throw new DuplicatePartyException("Another party with the same ip address and port");
+		}
+		connectionsNumber = 0;
+	}
+
+	/**
+	 * Creates the shared memory channels with the given ids, one after the other.
+	 * @throws TimeoutException in case a timeout has occurred before all channels have been connected.
+	 */
+	@Override
+	public Map<String, Channel> prepareForCommunication(String[] connectionsIds, long timeOut) throws TimeoutException {
+		long deadline = System.currentTimeMillis() + timeOut;
+		boolean creator = me.compareTo(other) < 0;
+		int lowPort = Math.min(me.getPort(), other.getPort());
+		int highPort = Math.max(me.getPort(), other.getPort());
+
+		Map<String, Channel> connectionsMap = new HashMap<String, Channel>();
+		for (String id : connectionsIds) {
+			//Posix shared memory names may contain only one slash, at their beginning.
+			String name = "/scapi_shm_" + lowPort + "_" + highPort + "_" + id.replaceAll("[^A-Za-z0-9]", "_");
+			SharedMemoryChannel channel = new SharedMemoryChannel(name, creator, capacity);
+
+			if (!channel.connect(Math.max(deadline - System.currentTimeMillis(), 0))){
+				for (Channel connected : connectionsMap.values()) {
+					connected.close();
+				}
+				throw new TimeoutException("timeout has occurred");
+			}
+			connectionsMap.put(id, channel);
+			connectionsNumber++;
+		}
+		return connectionsMap;
+	}
+
+	/**
+	 * Creates the given number of shared memory channels. The ids of the channels are "1", "2" and so on.
+	 * @throws TimeoutException in case a timeout has occurred before all channels have been connected.
+	 */
+	@Override
+	public Map<String, Channel> prepareForCommunication(int connectionsNum, long timeOut) throws TimeoutException {
+		String[] names = new String[connectionsNum];
+		for (int i = 0; i < connectionsNum; i++) {
+			names[i] = Integer.toString(connectionsNumber + i + 1);
+		}
+		return prepareForCommunication(names, timeOut);
+	}
+
+	/**
+	 * There is no Nagle algorithm in shared memory; A message is visible to the other party as soon as it is written.
+	 */
+	@Override
+	public void enableNagle() {
+	}
+
+	/**
+	 * The channels are closed by the user. There is nothing else to close.
+	 */
+	@Override
+	public void close() {
+	}
+}
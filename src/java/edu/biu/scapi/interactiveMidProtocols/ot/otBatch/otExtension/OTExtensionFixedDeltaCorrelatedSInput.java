@@ -0,0 +1,44 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSInput;
+
+/**
+ * A concrete class for OT extension input for the sender. <p>
+ * In the fixed delta correlated OT extension scenario the sender inputs a single delta that is used in all the OTs, 
+ * and gets as an output x0 such that x1 = x0^delta. <p>
+ * This is the case of the input transfer in Free-XOR garbled circuits, where all the wires share the same global offset. 
+ * Unlike {@link OTExtensionCorrelatedSInput}, there is no need to create a delta array of numOfOts elements.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionFixedDeltaCorrelatedSInput implements OTBatchSInput{
+
+	private byte[] delta;	// The delta shared by all the OTs. The size of each element in the OT is delta.length.
+	
+	private int numOfOts;	//number of ot's in the OT extension.
+	
+	/**
+	 * Constructor that sets the delta and the number of OTs.
+	 * @param delta The delta shared by all the OTs (for example, the 16 bytes global offset of Free-XOR).
+	 * @param numOfOts The number of OT's in the OT extension.
+	 */
+	public OTExtensionFixedDeltaCorrelatedSInput(byte[] delta, int numOfOts){
+		this.delta = delta;
+		this.numOfOts = numOfOts;
+	}
+	
+	/**
+	 * @return the delta.
+	 */
+	public byte[] getDelta(){
+		return delta;
+	}
+	
+	/**
+	 * @return the number of elements in the OT.
+	 */
+	public int getNumOfOts(){
+		return numOfOts;
+	}
+}
@@ -0,0 +1,55 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSOutput;
+
+/**
+ * Concrete implementation of batch OT sender's output in the fixed delta correlated OT extension.<p>
+ * The output contains only x0 that the OT has generated. Each x1 is implied by x1 = x0^delta, 
+ * so it is computed only on demand.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionFixedDeltaSOutput implements OTBatchSOutput {
+	
+	private byte[] x0Arr;	// An array that holds all x0 for all the senders serially. 
+							// The size of each element is delta.length.
+	
+	private byte[] delta;	// The delta shared by all the OTs.
+	
+	/**
+	 * Constructor that sets all x0 for all senders and the shared delta.
+	 * @param x0Arr holds all x0 for all the senders serially
+	 * @param delta the delta shared by all the OTs
+	 */
+	public OTExtensionFixedDeltaSOutput(byte[] x0Arr, byte[] delta){
+		this.x0Arr = x0Arr;
+		this.delta = delta;
+	}
+	
+	/**
+	 * @return the array that holds all x0 for all the senders serially. 
+	 */
+	public byte[] getX0Arr(){
+		return x0Arr;
+	}
+	
+	/**
+	 * @return the delta shared by all the OTs.
+	 */
+	public byte[] getDelta(){
+		return delta;
+	}
+	
+	/**
+	 * Computes the array that holds all x1 for all the senders serially, where each x1 = x0^delta.
+	 * @return the array that holds all x1.
+	 */
+	public byte[] getX1Arr(){
+		byte[] x1Arr = new byte[x0Arr.length];
+		for (int i = 0; i < x0Arr.length; i++){
+			x1Arr[i] = (byte) (x0Arr[i] ^ delta[i % delta.length]);
+		}
+		return x1Arr;
+	}
+}
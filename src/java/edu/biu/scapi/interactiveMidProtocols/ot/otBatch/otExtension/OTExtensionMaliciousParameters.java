@@ -0,0 +1,122 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+/**
+ * Holds the security parameters of the malicious OT extension and the consistency check that it runs. <P>
+ * 
+ * There are two ways to check that the receiver used the same choice bits in all the base OTs: <p>
+ * PAIRWISE_CHECKS is the check of Asharov, Lindell, Schneider and Zohner (ALSZ15). It compares numOfChecks pairs of base OTs, 
+ * and its cost grows with the number of checks.<p>
+ * SINGLE_LINEAR_COMBINATION is the check of Keller, Orsini and Scholl (KOS15). The receiver proves the consistency of the whole 
+ * extension matrix with one random linear combination over GF(2^128) of its rows. 
+ * It costs k + s extra OTs and 32 bytes of communication, regardless of the number of OTs, and uses 128 base OTs.
+ * This check requires symmetric security of 128 bits and ignores numOfChecks and the number of base OTs given to the OT extension.<p>
+ * 
+ * The default parameters are the ones that were used before these parameters were configurable: 
+ * 380 pairwise checks, 128 bits of symmetric security and 40 bits of statistical security.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionMaliciousParameters {
+	
+	/**
+	 * The consistency checks that the malicious OT extension can run.
+	 * The ordinal of each value is the one used by the native code.
+	 */
+	public enum CheckMode {
+		PAIRWISE_CHECKS,
+		SINGLE_LINEAR_COMBINATION
+	}
+	
+	public static final int DEFAULT_NUM_OF_CHECKS = 380;
+	public static final int DEFAULT_SYMMETRIC_SECURITY = 128;
+	public static final int DEFAULT_STATISTICAL_SECURITY = 40;
+	
+	private int numOfChecks;
+	private int symmetricSecurity;
+	private int statisticalSecurity;
+	private CheckMode checkMode;
+	
+	/**
+	 * Constructor that sets the default parameters, using the pairwise checks.
+	 */
+	public OTExtensionMaliciousParameters(){
+		this(DEFAULT_NUM_OF_CHECKS, DEFAULT_SYMMETRIC_SECURITY, DEFAULT_STATISTICAL_SECURITY, CheckMode.PAIRWISE_CHECKS);
+	}
+	
+	/**
+	 * Constructor that sets the default security parameters and the given check mode.
+	 * @param checkMode The consistency check to run.
+	 */
+	public OTExtensionMaliciousParameters(CheckMode checkMode){
+		this(DEFAULT_NUM_OF_CHECKS, DEFAULT_SYMMETRIC_SECURITY, DEFAULT_STATISTICAL_SECURITY, checkMode);
+	}
+	
+	/**
+	 * Constructor that sets the given parameters.
+	 * @param numOfChecks The number of pairs of base OTs that are checked. Used only in the PAIRWISE_CHECKS mode.
+	 * @param symmetricSecurity The symmetric security parameter in bits. One of 80, 112, 128, 192 or 256.
+	 * @param statisticalSecurity The statistical security parameter in bits.
+	 * @param checkMode The consistency check to run.
+	 * @throws IllegalArgumentException if one of the parameters is not valid.
+	 */
+	public OTExtensionMaliciousParameters(int numOfChecks, int symmetricSecurity, int statisticalSecurity, CheckMode checkMode){
+		if (numOfChecks <= 0){
+			throw new IllegalArgumentException("the number of checks should be positive");
+		}
+		if (symmetricSecurity != 80 && symmetricSecurity != 112 && symmetricSecurity != 128 && symmetricSecurity != 192 && symmetricSecurity != 256){
+			throw new IllegalArgumentException("the symmetric security should be one of 80, 112, 128, 192 or 256");
+		}
+		if (statisticalSecurity <= 0 || statisticalSecurity > 128){
+			throw new IllegalArgumentException("the statistical security should be between 1 and 128");
+		}
+		if (checkMode == CheckMode.SINGLE_LINEAR_COMBINATION && symmetricSecurity != 128){
+			throw new IllegalArgumentException("the single linear combination check supports only 128 bits of symmetric security");
+		}
+		
+		this.numOfChecks = numOfChecks;
+		this.symmetricSecurity = symmetricSecurity;
+		this.statisticalSecurity = statisticalSecurity;
+		this.checkMode = checkMode;
+	}
+	
+	public int getNumOfChecks(){
+		return numOfChecks;
+	}
+	
+	public int getSymmetricSecurity(){
+		return symmetricSecurity;
+	}
+	
+	public int getStatisticalSecurity(){
+		return statisticalSecurity;
+	}
+	
+	public CheckMode getCheckMode(){
+		return checkMode;
+	}
+}
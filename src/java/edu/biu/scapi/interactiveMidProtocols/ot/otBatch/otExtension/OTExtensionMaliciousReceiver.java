@@ -61,7 +61,8 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 	
 	// This function initializes the receiver. It creates sockets to communicate with the sender and attaches these sockets to the receiver object.
 	// It outputs the receiver object with communication abilities built in. 
-	private native long initOtReceiver(String ipAddress, int port, int numOfThreads, int numBaseOts, int numOts);
+	private native long initOtReceiver(String ipAddress, int port, int numOfThreads, int numBaseOts, int numOts, 
+			int numOfChecks, int symmetricSecurity, int statisticalSecurity, int checkMode);
 	/*
 	 * The native code that runs the OT extension as the receiver.
 	 * @param receiverPtr The pointer initialized via the function initOtReceiver
@@ -71,8 +72,9 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 	 * @param output The output of all the OTs. This is provided as a one dimensional array that gets all the data serially one after the other. The 
 	 * 				 array is given empty and the native code fills it with the result of the multiple OT results.
 	 * @param version The particular OT type to run.
+	 * @return false if the OT extension failed.
 	 */
-	private native void runOtAsReceiver(long receiverPtr, byte[] sigma, int numOfOts, int bitLength, byte[] output, String version);
+	private native boolean runOtAsReceiver(long receiverPtr, byte[] sigma, int numOfOts, int bitLength, byte[] output, String version);
 	//Deletes the native object.
 	private native void deleteReceiver(long receiverPtr);
 	
@@ -87,9 +89,22 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 	 * 	      
 	 */
 	public OTExtensionMaliciousReceiver(String serverAddress, int serverPort, int numOfThreads, int numBaseOts, int numOts){
+		this(serverAddress, serverPort, numOfThreads, numBaseOts, numOts, new OTExtensionMaliciousParameters());
+	}
+	
+	/**
+	 * A constructor that creates the native receiver with the given security parameters and consistency check.<p>
+	 * The construction runs the base OT phase. Further calls to transfer function will be optimized and fast, no matter how much OTs there are.
+	 * @param serverAddress the ip of the other sender
+	 * @param serverPort the port of the other sender
+	 * @param numBaseOts to use in the ot protocol 
+	 * @param numOts to do in parallel.
+	 * @param params the security parameters and the consistency check of the ot extension. Must match the sender's parameters.
+	 */
+	public OTExtensionMaliciousReceiver(String serverAddress, int serverPort, int numOfThreads, int numBaseOts, int numOts, OTExtensionMaliciousParameters params){
 		// Create the receiver by passing the local host address.
-		receiverPtr = initOtReceiver(serverAddress, serverPort, numOfThreads, numBaseOts, numOts);
-		
+		receiverPtr = initOtReceiver(serverAddress, serverPort, numOfThreads, numBaseOts, numOts, params.getNumOfChecks(), 
+				params.getSymmetricSecurity(), params.getStatisticalSecurity(), params.getCheckMode().ordinal());
 	}
 	
 	/**
@@ -101,8 +116,7 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 	 */
 	public OTExtensionMaliciousReceiver(String serverAddress, int serverPort, int numOts){
 		
-		// Create the receiver by passing the local host address.
-		receiverPtr = initOtReceiver(serverAddress, serverPort, 1, 190, numOts);
+		this(serverAddress, serverPort, 1, 190, numOts);
 	}
 
 	/**
@@ -111,6 +125,7 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 	 * @param channel Disregarded. This is ignored since the connection is done in the c++ code.
 	 * @param input The input for the receiver specifying the version of the OT extension to run. 
 	 * Every call to the transfer function can run a different OT extension version.
+	 * @throws IllegalStateException if the OT extension failed, for example if the sender aborted it since the consistency check failed.
 	 */
 	public OTBatchROutput transfer(Channel channel, OTBatchRInput input) {
 		
@@ -139,7 +154,9 @@ public class OTExtensionMaliciousReceiver implements Malicious, OTBatchReceiver{
 		byte[] outputBytes = new byte[numOfOts*elementSize/8];
 		
 		//Run the protocol using the native code in the dll.
-		runOtAsReceiver(receiverPtr, sigmaArr, numOfOts, elementSize, outputBytes, version);
+		if (!runOtAsReceiver(receiverPtr, sigmaArr, numOfOts, elementSize, outputBytes, version)){
+			throw new IllegalStateException("the malicious OT extension failed or was aborted by the sender");
+		}
 		
 		return new OTOnByteArrayROutput(outputBytes);
 	}
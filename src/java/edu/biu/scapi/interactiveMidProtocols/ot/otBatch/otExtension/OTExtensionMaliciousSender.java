@@ -26,6 +26,7 @@ package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
 
 import edu.biu.scapi.comm.Channel;
 import edu.biu.scapi.comm.Party;
+import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSInput;
 import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSOutput;
 import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSender;
@@ -59,7 +60,8 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 	
 	// This function initializes the sender. It creates sockets to communicate with the sender and attaches these sockets to the receiver object.
 	// It outputs the receiver object with communication abilities built in. 
-	private native long initOtSender(String ipAddress, int port, int numOfThreads, int numBaseOts, int numOts);
+	private native long initOtSender(String ipAddress, int port, int numOfThreads, int numBaseOts, int numOts, 
+			int numOfChecks, int symmetricSecurity, int statisticalSecurity, int checkMode);
 	
 	/*
 	 * The native code that runs the OT extension as the sender.
@@ -70,8 +72,9 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 	 * @param numOfOts The number of OTs that the protocol runs (how many strings are inside x0?)
 	 * @param bitLength The length (in bits) of each item in the OT. can be derived from |x0|, |x1|, numOfOts
 	 * @param version the OT extension version the user wants to use.
+	 * @return false if the receiver failed the consistency check.
 	 */
-	private native void runOtAsSender(long senderPtr, byte[] x0, byte[]x1, byte[] delta, int numOfOts, int bitLength, String version);
+	private native boolean runOtAsSender(long senderPtr, byte[] x0, byte[]x1, byte[] delta, int numOfOts, int bitLength, String version);
 	
 	//Deletes the native sender.
 	private native void deleteSender(long senderPtr);
@@ -86,9 +89,24 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 	 * @param numOts number of ots to do in parallel
 	 */
 	public OTExtensionMaliciousSender(String bindAddress, int listeningPort, int numOfThreads, int numBaseOts, int numOts){
+		this(bindAddress, listeningPort, numOfThreads, numBaseOts, numOts, new OTExtensionMaliciousParameters());
+	}
+	
+	/**
+	 * A constructor that creates the native sender with the given security parameters and consistency check.<p>
+	 * The construction runs the base OT phase. Further calls to transfer function will be optimized and fast, no matter how much OTs there are.
+	 * THE SENDER ACTS AS THE SERVER!!!
+	 * @param bindAddress the ip of this party.
+	 * @param listeningPort the port of this party.
+	 * @param numBaseOts base ots in the ot extension
+	 * @param numOts number of ots to do in parallel
+	 * @param params the security parameters and the consistency check of the ot extension. Must match the receiver's parameters.
+	 */
+	public OTExtensionMaliciousSender(String bindAddress, int listeningPort, int numOfThreads, int numBaseOts, int numOts, OTExtensionMaliciousParameters params){
 	
 		// Create the sender by passing the local host address.
-		senderPtr = initOtSender(bindAddress, listeningPort, numOfThreads, numBaseOts, numOts);
+		senderPtr = initOtSender(bindAddress, listeningPort, numOfThreads, numBaseOts, numOts, params.getNumOfChecks(), 
+				params.getSymmetricSecurity(), params.getStatisticalSecurity(), params.getCheckMode().ordinal());
 	}
 	
 	/**
@@ -99,8 +117,7 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 	 * @param numOts the number of ots to do in parallel
 	 */
 	public OTExtensionMaliciousSender(String bindAddress, int listeningPort, int numOts){
-		// Create the sender by passing the local host address.
-		senderPtr = initOtSender(bindAddress, listeningPort, 1, 190, numOts);
+		this(bindAddress, listeningPort, 1, 190, numOts);
 	}
 
 	/**
@@ -125,7 +142,7 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 			
 			//Call the native function.
 			int bitLength = (x0.length/numOfOts)*8;
-			runOtAsSender(senderPtr, x0, x1, null, numOfOts, bitLength, OT_EXTENSION_TYPE_GENERAL);
+			checkResult(runOtAsSender(senderPtr, x0, x1, null, numOfOts, bitLength, OT_EXTENSION_TYPE_GENERAL));
 		
 			//This version has no output. Return null.
 			return null;
@@ -142,7 +159,7 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 			numOfOts = ((OTExtensionCorrelatedSInput) input).getNumOfOts();
 			
 			//Call the native function. It will fill x0 and x1.
-			runOtAsSender(senderPtr, x0, x1, delta, numOfOts, delta.length/numOfOts*8, OT_EXTENSION_TYPE_CORRELATED);
+			checkResult(runOtAsSender(senderPtr, x0, x1, delta, numOfOts, delta.length/numOfOts*8, OT_EXTENSION_TYPE_CORRELATED));
 			
 			//Return output contains x0, x1.
 			return new OTExtensionSOutput(x0,x1);
@@ -158,7 +175,7 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 			byte[] x1 = new byte[numOfOts * bitLength/8];
 			
 			//Call the native function. It will fill x0 and x1.
-			runOtAsSender(senderPtr, x0, x1, null, numOfOts, bitLength, OT_EXTENSION_TYPE_RANDOM);
+			checkResult(runOtAsSender(senderPtr, x0, x1, null, numOfOts, bitLength, OT_EXTENSION_TYPE_RANDOM));
 			
 			//Return output contains x0, x1.
 			return new OTExtensionSOutput(x0,x1);
@@ -169,6 +186,15 @@ public class OTExtensionMaliciousSender  implements Malicious, OTBatchSender{
 		}
 	}
 
+	/*
+	 * Throws CheatAttemptException if the native OT extension reported that the receiver failed the consistency check.
+	 */
+	private void checkResult(boolean success){
+		if (!success){
+			throw new CheatAttemptException("the receiver failed the consistency check of the OT extension");
+		}
+	}
+
 	/**
 	 * Deletes the native OT object.
 	 * This function MUST be called after the OT is finished!!!
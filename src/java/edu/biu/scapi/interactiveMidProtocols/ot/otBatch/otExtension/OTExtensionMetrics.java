@@ -0,0 +1,202 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+/**
+ * A snapshot of the runtime metrics of a native OT extension session. <P>
+ * 
+ * The metrics accumulate over all the calls to the transfer function since the OT extension was created or since the metrics were last reset,
+ * and tell where the time of the OT goes: the base OTs, the extension itself, copying the inputs and outputs between java and the native code,
+ * and the inner phases of the extension (matrix transpose, PRG expansion, hashing and waiting on the network).<p>
+ * 
+ * The inner phases are measured only by the OT extensions that are implemented in the native interface itself (the 1-out-of-N OT extension).
+ * The 1-out-of-2 OT extension is implemented by the OTExtension library that does not report its phases, so for it only the base OT, 
+ * extension and copy times are measured and the inner phases stay zero. Its bytes per thread are not counted on the socket but estimated 
+ * from the sizes of the messages of the protocol, so they are approximate figures (see {@link #areBytesEstimated()}).<p>
+ * 
+ * A large network wait time compared to the extension time means the OT is bound by the bandwidth, 
+ * large transpose, PRG or hash times mean it is bound by the CPU and may gain from more threads.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionMetrics {
+	
+	//The indices of the values in the array returned from the native code. Must match the fields of OTMetrics in OtExtensionMetrics.h.
+	private static final int BASE_OT_MILLIS = 0;
+	private static final int EXTENSION_MILLIS = 1;
+	private static final int COPY_MILLIS = 2;
+	private static final int TRANSPOSE_MILLIS = 3;
+	private static final int PRG_MILLIS = 4;
+	private static final int HASH_MILLIS = 5;
+	private static final int NETWORK_WAIT_MILLIS = 6;
+	private static final int NUM_OF_OTS = 7;
+	private static final int NUM_OF_CALLS = 8;
+	private static final int NUM_OF_THREADS = 9;
+	private static final int BYTES_ESTIMATED = 10;
+	private static final int NUM_OF_FIELDS = 11;
+	
+	private double[] values;
+	
+	/**
+	 * Constructs the metrics from the array returned by the native code.
+	 * @param values The fields of the native metrics, followed by the bytes sent and the bytes received by each thread.
+	 */
+	OTExtensionMetrics(double[] values){
+		this.values = values;
+	}
+	
+	/**
+	 * @return the time of the base OTs, in milliseconds.
+	 */
+	public double getBaseOtMillis(){
+		return values[BASE_OT_MILLIS];
+	}
+	
+	/**
+	 * @return the total time of the OT extension calls, in milliseconds.
+	 */
+	public double getExtensionMillis(){
+		return values[EXTENSION_MILLIS];
+	}
+	
+	/**
+	 * @return the time of copying the inputs and outputs between java and the native code, in milliseconds.
+	 */
+	public double getCopyMillis(){
+		return values[COPY_MILLIS];
+	}
+	
+	/**
+	 * @return the time of transposing the extension matrix, in milliseconds. Measured only by the 1-out-of-N OT extension.
+	 */
+	public double getTransposeMillis(){
+		return values[TRANSPOSE_MILLIS];
+	}
+	
+	/**
+	 * @return the time of expanding the base OT keys by the PRG, in milliseconds. Measured only by the 1-out-of-N OT extension.
+	 */
+	public double getPrgMillis(){
+		return values[PRG_MILLIS];
+	}
+	
+	/**
+	 * @return the time of hashing the rows of the extension matrix, in milliseconds. Measured only by the 1-out-of-N OT extension.
+	 */
+	public double getHashMillis(){
+		return values[HASH_MILLIS];
+	}
+	
+	/**
+	 * @return the time spent sending and receiving on the network, in milliseconds. Measured only by the 1-out-of-N OT extension.
+	 */
+	public double getNetworkWaitMillis(){
+		return values[NETWORK_WAIT_MILLIS];
+	}
+	
+	/**
+	 * @return the total number of OTs executed.
+	 */
+	public long getNumOfOts(){
+		return (long) values[NUM_OF_OTS];
+	}
+	
+	/**
+	 * @return the number of calls to the OT extension.
+	 */
+	public long getNumOfCalls(){
+		return (long) values[NUM_OF_CALLS];
+	}
+	
+	/**
+	 * @return the number of threads of the OT extension.
+	 */
+	public int getNumOfThreads(){
+		return (int) values[NUM_OF_THREADS];
+	}
+	
+	/**
+	 * @return true if the bytes of the threads were estimated from the sizes of the messages of the protocol (the 1-out-of-2 OT extension);
+	 * false if they were counted on the socket.
+	 */
+	public boolean areBytesEstimated(){
+		return values[BYTES_ESTIMATED] != 0;
+	}
+	
+	/**
+	 * @param thread The index of the thread.
+	 * @return the number of bytes sent by the given thread. Approximate if {@link #areBytesEstimated()} returns true.
+	 */
+	public long getBytesSent(int thread){
+		checkThread(thread);
+		return (long) values[NUM_OF_FIELDS + thread];
+	}
+	
+	/**
+	 * @param thread The index of the thread.
+	 * @return the number of bytes received by the given thread. Approximate if {@link #areBytesEstimated()} returns true.
+	 */
+	public long getBytesReceived(int thread){
+		checkThread(thread);
+		return (long) values[NUM_OF_FIELDS + getNumOfThreads() + thread];
+	}
+	
+	/**
+	 * @return the number of bytes sent by all the threads.
+	 */
+	public long getTotalBytesSent(){
+		long sum = 0;
+		for (int i = 0; i < getNumOfThreads(); i++){
+			sum += getBytesSent(i);
+		}
+		return sum;
+	}
+	
+	/**
+	 * @return the number of bytes received by all the threads.
+	 */
+	public long getTotalBytesReceived(){
+		long sum = 0;
+		for (int i = 0; i < getNumOfThreads(); i++){
+			sum += getBytesReceived(i);
+		}
+		return sum;
+	}
+	
+	private void checkThread(int thread){
+		if (thread < 0 || thread >= getNumOfThreads()){
+			throw new IllegalArgumentException("there is no thread " + thread);
+		}
+	}
+	
+	@Override
+	public String toString(){
+		String bytes = areBytesEstimated() ? "B (estimated)" : "B";
+		return "OTExtensionMetrics [ots=" + getNumOfOts() + ", calls=" + getNumOfCalls() + ", baseOt=" + getBaseOtMillis() + "ms, extension=" + getExtensionMillis() + 
+				"ms, copy=" + getCopyMillis() + "ms, transpose=" + getTransposeMillis() + "ms, prg=" + getPrgMillis() + "ms, hash=" + getHashMillis() + 
+				"ms, networkWait=" + getNetworkWaitMillis() + "ms, sent=" + getTotalBytesSent() + bytes + ", received=" + getTotalBytesReceived() + bytes + "]";
+	}
+}
@@ -0,0 +1,54 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSInput;
+
+/**
+ * A concrete class for 1-out-of-N OT extension input for the sender. <p>
+ * In the general 1-out-of-N OT extension scenario the sender gets n values x0,...,x(n-1) for each OT and the receiver learns one of them.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionOneOutOfNGeneralSInput implements OTBatchSInput{
+
+	private byte[] xArr;	// An array that holds all the n values of all the OTs serially. 
+							// The n values of the first OT are followed by the n values of the second OT and so on.
+							// The size of each element can be calculated by xArr.length/(numOfOts*n).
+	
+	private int numOfOts;	// Number of OTs in the OT extension.
+	
+	private int n;			// Number of values in each OT.
+	
+	/**
+	 * Constructor that sets the values of each OT, the number of OTs and the number of values in each OT.
+	 * @param xArr holds all the n values of all the OTs serially.
+	 * @param numOfOts Number of OTs in the OT extension.
+	 * @param n Number of values in each OT. Must be between 2 and 256.
+	 */
+	public OTExtensionOneOutOfNGeneralSInput(byte[] xArr, int numOfOts, int n){
+		this.xArr = xArr;
+		this.numOfOts = numOfOts;
+		this.n = n;
+	}
+	
+	/**
+	 * @return the array that holds all the n values of all the OTs serially.
+	 */
+	public byte[] getXArr(){
+		return xArr;
+	}
+	
+	/**
+	 * @return the number of OT elements.
+	 */
+	public int getNumOfOts(){
+		return numOfOts;
+	}
+	
+	/**
+	 * @return the number of values in each OT.
+	 */
+	public int getN(){
+		return n;
+	}
+}
@@ -0,0 +1,33 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+/**
+ * An abstract 1-out-of-N OT receiver input.<P>
+ * 
+ * Unlike the 1-out-of-2 inputs, each byte of the sigma array holds a value in [0, n) (as an unsigned byte) for each OT, 
+ * which is the index of the value that the receiver wants to learn.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+abstract public class OTExtensionOneOutOfNRInput extends OTExtensionRInput{
+	
+	private int n;	// Number of values in each OT.
+	
+	/**
+	 * Constructor that sets the sigma array, the size of each element and the number of values in each OT.
+	 * @param sigmaArr An array of sigma for each OT, where each sigma is in [0, n).
+	 * @param elementSize The size of each element in the OT extension, in bits. 
+	 * @param n Number of values in each OT. Must be between 2 and 256.
+	 */
+	public OTExtensionOneOutOfNRInput(byte[] sigmaArr, int elementSize, int n){
+		super(sigmaArr, elementSize);
+		this.n = n;
+	}
+	
+	/**
+	 * @return the number of values in each OT.
+	 */
+	public int getN(){
+		return n;
+	}
+}
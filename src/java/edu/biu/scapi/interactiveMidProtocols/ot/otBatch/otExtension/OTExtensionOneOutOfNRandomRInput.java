@@ -0,0 +1,22 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+/**
+ * A concrete class for 1-out-of-N OT extension input for the receiver. <p>
+ * The name of the class determines the version of the OT extension we wish to run, this case is the random case.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionOneOutOfNRandomRInput extends OTExtensionOneOutOfNRInput {
+
+	/**
+	 * Constructor that sets the sigma array, the size of each element and the number of values in each OT.
+	 * @param sigmaArr An array of sigma for each OT, where each sigma is in [0, n).
+	 * @param elementSize The size of each element in the OT extension, in bits. 
+	 * @param n Number of values in each OT. Must be between 2 and 256.
+	 */
+	public OTExtensionOneOutOfNRandomRInput(byte[] sigmaArr, int elementSize, int n) {
+		super(sigmaArr, elementSize, n);
+	}
+
+}
@@ -0,0 +1,54 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSInput;
+
+/**
+ * A concrete class for 1-out-of-N OT extension input for the sender. <p>
+ * In the random 1-out-of-N OT extension scenario the sender does not send x0,...,x(n-1), rather it gets them as an output.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionOneOutOfNRandomSInput implements OTBatchSInput{
+
+	private int bitLength;	// Since there is no input we need to send the size of each OT so that the OT extension can generate the values with the right size.
+	
+	private int numOfOts;	// Number of OTs in the OT extension.
+	
+	private int n;			// Number of values in each OT.
+	
+	/**
+	 * Constructor that sets the number of OTs, the number of values in each OT and the size of each value.
+	 * @param numOfOts number of OTs in the OT extension.
+	 * @param n Number of values in each OT. Must be between 2 and 256.
+	 * @param bitLength The size of each element in the OT extension, in bits. 
+	 */
+	public OTExtensionOneOutOfNRandomSInput(int numOfOts, int n, int bitLength){
+
+		this.numOfOts = numOfOts;
+		this.n = n;
+		this.bitLength = bitLength;
+	}
+	
+	/**
+	 * @return the number of OT elements.
+	 */
+	public int getNumOfOts(){
+		return numOfOts;
+	}
+	
+	/**
+	 * @return the number of values in each OT.
+	 */
+	public int getN(){
+		return n;
+	}
+	
+	/**
+	 * @return the size of each OT.
+	 */
+	public int getBitLength(){
+		
+		return bitLength;
+	}
+}
@@ -0,0 +1,41 @@
+package edu.biu.scapi.interactiveMidProtocols.ot.otBatch.otExtension;
+
+import edu.biu.scapi.interactiveMidProtocols.ot.otBatch.OTBatchSOutput;
+
+/**
+ * Concrete implementation of batch 1-out-of-N OT sender's output.<p>
+ * In the random 1-out-of-N OT extension there is an output for the sender which is the n values of each OT that the OT has generated. 
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OTExtensionOneOutOfNSOutput implements OTBatchSOutput {
+	
+	private byte[] xArr;	// An array that holds all the n values of all the OTs serially. 
+	
+	private int n;			// Number of values in each OT.
+	
+	/**
+	 * Constructor that sets the values of all the OTs.
+	 * @param xArr holds all the n values of all the OTs serially
+	 * @param n number of values in each OT
+	 */
+	public OTExtensionOneOutOfNSOutput(byte[] xArr, int n){
+		this.xArr = xArr;
+		this.n = n;
+	}
+	
+	/**
+	 * @return the array that holds all the n values of all the OTs serially. 
+	 */
+	public byte[] getXArr(){
+		return xArr;
+	}
+	
+	/**
+	 * @return the number of values in each OT.
+	 */
+	public int getN(){
+		return n;
+	}
+}
@@ -51,6 +51,8 @@ import edu.biu.scapi.securityLevel.SemiHonest;
  * For example, if the user gave as input an instance of OTExtensionRandomRInput than the random OT Extension will be execute.<p>
  * 
  * NOTE: Unlike a regular implementation, the connection is done via the native code and thus the channel provided in the transfer function is ignored.  
+ * Each object has its own native sockets, base OTs and metrics, so several senders and receivers (for example one to each of the
+ * other parties) can be created and used in the same process, also from different threads.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Meital Levy)
  *
@@ -74,9 +76,26 @@ public class OTSemiHonestExtensionReceiver implements SemiHonest, OTBatchReceive
 	 * @param version The particular OT type to run.
 	 */
 	private native void runOtAsReceiver(long receiverPtr, byte[] sigma, int numOfOts, int bitLength, byte[] output, String version);
+	/*
+	 * The native code that runs the 1-out-of-N OT extension as the receiver.
+	 * @param receiverPtr The pointer initialized via the function initOtReceiver
+	 * @param sigma An array holding the input of the receiver, that is, the index in [0, n) of the chosen value for each OT.
+	 * @param numOfOts The number or OTs that the protocol runs.
+	 * @param n The number of values in each OT.
+	 * @param bitLength The length of each item in the OT.
+	 * @param output The output of all the OTs, filled by the native code.
+	 * @param version The particular OT type to run ("general" or "random").
+	 */
+	private native void runOneOutOfNOtAsReceiver(long receiverPtr, byte[] sigma, int numOfOts, int n, int bitLength, byte[] output, String version);
 	//Deletes the native object.
 	private native void deleteReceiver(long receiverPtr);
 	
+	//Returns the metrics accumulated by the native OT extension.
+	private native double[] getMetrics(long receiverPtr);
+	
+	//Resets the metrics of the native OT extension.
+	private native void resetMetrics(long receiverPtr);
+	
 	/**
 	 * A constructor that creates the native receiver with communication abilities. <p>
 	 * It uses the ip address and port given in the party object.<p>
@@ -123,6 +142,11 @@ public class OTSemiHonestExtensionReceiver implements SemiHonest, OTBatchReceive
 			throw new IllegalArgumentException("input should be an instance of OTExtensionRInput.");
 		}
 		
+		//In case of 1-out-of-N input, run the 1-out-of-N OT extension.
+		if(input instanceof OTExtensionOneOutOfNRInput){
+			return transferOneOutOfN((OTExtensionOneOutOfNRInput) input);
+		}
+		
 		//If the user gave correlated input, change the version of the OT to correlated.
 		if(input instanceof OTExtensionCorrelatedRInput){
 			version = "correlated";
@@ -146,6 +170,51 @@ public class OTSemiHonestExtensionReceiver implements SemiHonest, OTBatchReceive
 	}
 	
 	
+	/*
+	 * Runs the 1-out-of-N OT extension using the native code.
+	 */
+	private OTBatchROutput transferOneOutOfN(OTExtensionOneOutOfNRInput input){
+		
+		String version = (input instanceof OTExtensionOneOutOfNRandomRInput) ? "random" : "general";
+		
+		byte[] sigmaArr = input.getSigmaArr();
+		int numOfOts = sigmaArr.length;
+		int elementSize = input.getElementSize();
+		int n = input.getN();
+		
+		if (n < 2 || n > 256){
+			throw new IllegalArgumentException("the number of values in each OT should be between 2 and 256");
+		}
+		for (int i = 0; i < numOfOts; i++){
+			if ((sigmaArr[i] & 0xFF) >= n){
+				throw new IllegalArgumentException("each sigma should be between 0 and n-1");
+			}
+		}
+		
+		byte[] outputBytes = new byte[numOfOts*elementSize/8];
+		
+		//Run the protocol using the native code in the dll.
+		runOneOutOfNOtAsReceiver(receiverPtr, sigmaArr, numOfOts, n, elementSize, outputBytes, version);
+		
+		return new OTOnByteArrayROutput(outputBytes);
+	}
+	
+	/**
+	 * Returns the runtime metrics of the OT extension, accumulated since its creation or since the last call to resetMetrics.
+	 * The metrics include the time of the base OTs that were executed by the constructor.
+	 * @return a snapshot of the metrics.
+	 */
+	public OTExtensionMetrics getMetrics(){
+		return new OTExtensionMetrics(getMetrics(receiverPtr));
+	}
+	
+	/**
+	 * Clears the runtime metrics of the OT extension.
+	 */
+	public void resetMetrics(){
+		resetMetrics(receiverPtr);
+	}
+
 	/**
 	 * Deletes the native OT object.
 	 */
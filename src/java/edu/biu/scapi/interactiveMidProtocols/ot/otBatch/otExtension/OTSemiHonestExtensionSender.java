@@ -43,12 +43,19 @@ import edu.biu.scapi.securityLevel.SemiHonest;
  * There are three versions of OT extension: General, Correlated and Random. The difference between them is the way of getting the inputs: <p>
  * In general OT extension both x0 and x1 are given by the user.<p>
  * In Correlated OT extension the user gives a delta array and x0, x1 arrays are chosen such that x0 = delta^x1.<p>
+ * In fixed delta correlated OT extension the user gives a single delta that is used in all the OTs (as in Free-XOR garbling), 
+ * and only x0 is returned since x1 = x0^delta.<p>
  * In random OT extension both x0 and x1 are chosen randomly.<p>
+ * In addition, 1-out-of-N OT extension (N <= 256) is supported via the OTExtensionOneOutOfN inputs, following 
+ * "V. Kolesnikov and R. Kumaresan. Improved OT Extension for Transferring Short Secrets. CRYPTO 2013". 
+ * This is much cheaper than log(N) 1-out-of-2 OTs for each symbol of a small domain.<p>
  * To allow the user decide which OT extension's version he wants, each option has a corresponding input class. <p>
  * The particular OT extension version is executed according to the given input instance; 
  * For example, if the user gave as input an instance of OTExtensionRandomSInput than the random OT Extension will be execute.<p>
  * 
  * NOTE: Unlike a regular implementation the connection is done via the native code and thus the channel provided in the transfer function is ignored.  
+ * Each object has its own native sockets, base OTs and metrics, so several senders and receivers (for example one to each of the
+ * other parties) can be created and used in the same process, also from different threads.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Meital Levy)
  *
@@ -73,9 +80,36 @@ public class OTSemiHonestExtensionSender  implements SemiHonest, OTBatchSender{
 	 */
 	private native void runOtAsSender(long senderPtr, byte[] x0, byte[]x1, byte[] delta, int numOfOts, int bitLength, String version);
 	
+	/*
+	 * The native code that runs the correlated OT extension as the sender, where all the OTs share a single delta.
+	 * @param senderPtr The pointer initialized via the function initOtSender.
+	 * @param x0 An empty array that will be filled with all the x0 values for each of the OT's serially. x1 = x0^delta is not returned.
+	 * @param delta The single delta shared by all the OTs. Its size is bitLength/8 bytes.
+	 * @param numOfOts The number of OTs that the protocol runs.
+	 * @param bitLength The length of each item in the OT.
+	 */
+	private native void runFixedDeltaOtAsSender(long senderPtr, byte[] x0, byte[] delta, int numOfOts, int bitLength);
+	
+	/*
+	 * The native code that runs the 1-out-of-N OT extension as the sender.
+	 * @param senderPtr The pointer initialized via the function initOtSender.
+	 * @param x An array that holds the n values of each of the OT's serially. In the random version it is filled by the native code.
+	 * @param numOfOts The number of OTs that the protocol runs.
+	 * @param n The number of values in each OT.
+	 * @param bitLength The length of each item in the OT.
+	 * @param version the OT extension version the user wants to use ("general" or "random").
+	 */
+	private native void runOneOutOfNOtAsSender(long senderPtr, byte[] x, int numOfOts, int n, int bitLength, String version);
+	
 	//Deletes the native sender.
 	private native void deleteSender(long senderPtr);
 	
+	//Returns the metrics accumulated by the native OT extension.
+	private native double[] getMetrics(long senderPtr);
+	
+	//Resets the metrics of the native OT extension.
+	private native void resetMetrics(long senderPtr);
+	
 	/**
 	 * A constructor that creates the native sender with communication abilities. It uses the ip address and port given in the party object.<p>
 	 * The construction runs the base OT phase. Further calls to transfer function will be optimized and fast, no matter how much OTs there are.
@@ -142,6 +176,21 @@ public class OTSemiHonestExtensionSender  implements SemiHonest, OTBatchSender{
 			//Return output contains x0, x1.
 			return new OTExtensionSOutput(x0,x1);
 		
+		//In case the given input is correlated input with a single delta for all the OTs.
+		} else if(input instanceof OTExtensionFixedDeltaCorrelatedSInput){
+			
+			byte[] delta = ((OTExtensionFixedDeltaCorrelatedSInput) input).getDelta();
+			numOfOts = ((OTExtensionFixedDeltaCorrelatedSInput) input).getNumOfOts();
+			
+			// Prepare empty x0 for the output. x1 is implied by x0 and delta.
+			byte[] x0 = new byte[numOfOts * delta.length];
+			
+			//Call the native function. It will fill x0.
+			runFixedDeltaOtAsSender(senderPtr, x0, delta, numOfOts, delta.length*8);
+			
+			//Return output contains x0 and delta.
+			return new OTExtensionFixedDeltaSOutput(x0, delta);
+		
 		//In case the given input is random input.
 		} else if(input instanceof OTExtensionRandomSInput){
 			 
@@ -158,11 +207,67 @@ public class OTSemiHonestExtensionSender  implements SemiHonest, OTBatchSender{
 			//Return output contains x0, x1.
 			return new OTExtensionSOutput(x0,x1);
 		
+		//In case the given input is 1-out-of-N general input.
+		} else if(input instanceof OTExtensionOneOutOfNGeneralSInput){
+			
+			byte[] x = ((OTExtensionOneOutOfNGeneralSInput) input).getXArr();
+			numOfOts = ((OTExtensionOneOutOfNGeneralSInput) input).getNumOfOts();
+			int n = ((OTExtensionOneOutOfNGeneralSInput) input).getN();
+			checkN(n);
+			
+			//Call the native function.
+			runOneOutOfNOtAsSender(senderPtr, x, numOfOts, n, x.length/(numOfOts*n)*8, "general");
+			
+			//This version has no output. Return null.
+			return null;
+			
+		//In case the given input is 1-out-of-N random input.
+		} else if(input instanceof OTExtensionOneOutOfNRandomSInput){
+			
+			numOfOts = ((OTExtensionOneOutOfNRandomSInput) input).getNumOfOts();
+			int n = ((OTExtensionOneOutOfNRandomSInput) input).getN();
+			int bitLength = ((OTExtensionOneOutOfNRandomSInput) input).getBitLength();
+			checkN(n);
+			
+			//Prepare empty array for the output.
+			byte[] x = new byte[numOfOts * n * bitLength/8];
+			
+			//Call the native function. It will fill x.
+			runOneOutOfNOtAsSender(senderPtr, x, numOfOts, n, bitLength, "random");
+			
+			//Return output contains the n values of each OT.
+			return new OTExtensionOneOutOfNSOutput(x, n);
+		
 		//If input is not instance of the above inputs, throw Exception.
 		} else {
-			throw new IllegalArgumentException("input should be an instance of OTExtensionGeneralSInput or OTExtensionCorrelatedSInput or OTExtensionRandomSInput.");
+			throw new IllegalArgumentException("input should be an instance of OTExtensionGeneralSInput or OTExtensionCorrelatedSInput or OTExtensionFixedDeltaCorrelatedSInput or OTExtensionRandomSInput or OTExtensionOneOutOfNGeneralSInput or OTExtensionOneOutOfNRandomSInput.");
 		}
 	}
+	
+	/*
+	 * The native 1-out-of-N OT extension encodes each choice by a Walsh-Hadamard codeword of length 256, so n is limited to 256.
+	 */
+	private void checkN(int n){
+		if (n < 2 || n > 256){
+			throw new IllegalArgumentException("the number of values in each OT should be between 2 and 256");
+		}
+	}
+
+	/**
+	 * Returns the runtime metrics of the OT extension, accumulated since its creation or since the last call to resetMetrics.
+	 * The metrics include the time of the base OTs that were executed by the constructor.
+	 * @return a snapshot of the metrics.
+	 */
+	public OTExtensionMetrics getMetrics(){
+		return new OTExtensionMetrics(getMetrics(senderPtr));
+	}
+	
+	/**
+	 * Clears the runtime metrics of the OT extension.
+	 */
+	public void resetMetrics(){
+		resetMetrics(senderPtr);
+	}
 
 	/**
 	 * Deletes the native OT object.
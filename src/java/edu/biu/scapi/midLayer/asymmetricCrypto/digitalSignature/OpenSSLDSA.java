@@ -56,6 +56,7 @@ import edu.biu.scapi.tools.Factories.DlogGroupFactory;
 public class OpenSSLDSA implements DSABasedSignature{
 
 	private long dsa;						// Pointer to the native dsa object.
+	private long batch;						// Pointer to the native state of the batch functions (fixed-base tables and precomputed nonces).
 	private DlogGroup dlog;					// DlogGroup to use in this dsa scheme.
 	private DSAPublicKey publicKey;
 	private boolean isKeySet;				//Sets to false until setKey is called
@@ -68,10 +69,22 @@ public class OpenSSLDSA implements DSABasedSignature{
 	private native void setKeys(long dsa, byte[] publicKey, byte[] privateKey);
 	//Sets the public key.
 	private native void setPublicKey(long dsa, byte[] publicKey);
-	//Signs the given message.
-	private native byte[] sign(long dsa, byte[] msg, int offset, int length);
+	//Signs the given message, using a precomputed nonce if there is one.
+	private native byte[] sign(long dsa, long batch, byte[] msg, int offset, int length);
 	//Verifies that the given signature is indeed the dignature of the given message.
 	private native boolean verify(long dsa, byte[] signature, byte[] msg, int offset, int length);
+	//Creates the native state of the batch functions.
+	private native long createBatchContext();
+	//Computes the given number of nonces for the following signatures.
+	private native boolean precomputeNonces(long dsa, long batch, int count);
+	//Returns the number of precomputed nonces that were not used yet.
+	private native int getNumOfNonces(long batch);
+	//Signs each one of the given messages.
+	private native byte[][] signBatch(long dsa, long batch, byte[][] msgs);
+	//Verifies each one of the given signatures. Fills the results array unless stopOnFailure is true and returns true if all the signatures are valid.
+	private native boolean verifyBatch(long dsa, long batch, byte[][] signatures, byte[][] msgs, boolean[] results, boolean stopOnFailure);
+	//Deletes the native state of the batch functions.
+	private native void deleteBatchContext(long batch);
 	//Generates keys to this dsa scheme.
 	private native byte[][] generateKey(long dsa);
 	//Delete the native dsa object.
@@ -109,6 +122,7 @@ public class OpenSSLDSA implements DSABasedSignature{
 		//Creates the native dsa object using the group parameters.
 		ZpGroupParams params = (ZpGroupParams) dlog.getGroupParams();
 		dsa = createDSA(params.getP().toByteArray(), params.getQ().toByteArray(), params.getXg().toByteArray());
+		batch = createBatchContext();
 	}
 	
 	/**
@@ -188,7 +202,8 @@ public class OpenSSLDSA implements DSABasedSignature{
 	}
 
 	/**
-	 * Signs the given message.
+	 * Signs the given message.<p>
+	 * If there are nonces that were precomputed by {@link #precomputeSignatures(int)}, one of them is used for this signature.
 	 * @param msg the byte array to sign.
 	 * @param offset the place in the msg to take the bytes from.
 	 * @param length the length of the msg.
@@ -209,7 +224,10 @@ public class OpenSSLDSA implements DSABasedSignature{
 		}
 		
 		//Sign the message.
-		byte [] signature = sign(dsa, msg, offset, length);
+		byte [] signature = sign(dsa, batch, msg, offset, length);
+		if (signature == null){
+			throw new IllegalStateException("failed to sign the given message");
+		}
 		
 		//In OpenSSL implementation the output of the signing is one byte array containing both r and s.
 		//This is different than SCAPI implementation for DSA signature, so there is another Signature class (unique for OpenSSL) that holds this result.
@@ -250,6 +268,123 @@ public class OpenSSLDSA implements DSABasedSignature{
 	
 	}
 
+	/**
+	 * Computes ahead of time the part of the next count signatures that does not depend on the message.<p>
+	 * For each signature a random nonce k is chosen and k^-1 mod q and r = (g^k mod p) mod q are computed. 
+	 * The following calls to sign use these nonces, one per signature, so that each one of them only computes s = k^-1(H(m) + xr) mod q.
+	 * Once all the nonces are used the signing goes back to compute a new nonce for each signature.
+	 * @param count the number of nonces to compute.
+	 * @throws IllegalStateException if the native computation failed.
+	 */
+	public void precomputeSignatures(int count){
+		if (count < 0){
+			throw new IllegalArgumentException("the number of nonces should be non negative");
+		}
+		if (!precomputeNonces(dsa, batch, count)){
+			throw new IllegalStateException("failed to compute the signing nonces");
+		}
+	}
+	
+	/**
+	 * @return the number of precomputed nonces that were not used by the signing yet.
+	 */
+	public int getNumOfPrecomputedSignatures(){
+		return getNumOfNonces(batch);
+	}
+	
+	/**
+	 * Signs each one of the given messages, using the precomputed nonces while there are any (see {@link #precomputeSignatures(int)}).
+	 * @param msgs the messages to sign.
+	 * @return the signature of each message.
+	 * @throws KeyException if PrivateKey is not set.
+	 * @throws IllegalArgumentException if one of the messages is null.
+	 */
+	public Signature[] sign(byte[][] msgs) throws KeyException {
+		//If there is no private key can not sign, throws exception.
+		if (!isPrivateKeySet){
+			throw new KeyException("in order to sign a message, this object must be initialized with private key");
+		}
+		checkMessages(msgs);
+		
+		byte[][] signatures = signBatch(dsa, batch, msgs);
+		if (signatures == null){
+			throw new IllegalStateException("failed to sign the given messages");
+		}
+		
+		Signature[] result = new Signature[signatures.length];
+		for (int i = 0; i < signatures.length; i++){
+			result[i] = new OpenSSLDSASignature(signatures[i]);
+		}
+		return result;
+	}
+	
+	/**
+	 * Verifies each one of the given signatures with the matching message.<p>
+	 * The signatures are verified together: the inverses of all the s values are computed with a single modular inversion, and 
+	 * g^u1 * y^u2 is computed with fixed-base tables of g and of the public key, that are built once for the public key.
+	 * Verifying a batch is therefore faster than verifying each signature by itself.
+	 * @param signatures the signatures to verify. Should be instances of OpenSSLDSASignature.
+	 * @param msgs the signed messages, msgs[i] is the message of signatures[i].
+	 * @return the result of each signature: true if it is valid, false otherwise.
+	 * @throws IllegalStateException if no public key was set.
+	 * @throws IllegalArgumentException if the given Signatures do not match this signature scheme or the number of signatures and messages differ, 
+	 * or if one of the messages is null.
+	 */
+	public boolean[] verify(Signature[] signatures, byte[][] msgs) {
+		byte[][] sigs = toSignatureBytes(signatures, msgs);
+		boolean[] results = new boolean[sigs.length];
+		verifyBatch(dsa, batch, sigs, msgs, results, false);
+		return results;
+	}
+	
+	/**
+	 * Verifies the given signatures as in {@link #verify(Signature[], byte[][])}, but returns a single aggregate result.<p>
+	 * The verification stops at the first invalid signature.
+	 * @param signatures the signatures to verify. Should be instances of OpenSSLDSASignature.
+	 * @param msgs the signed messages, msgs[i] is the message of signatures[i].
+	 * @return true if all the signatures are valid. false, otherwise.
+	 * @throws IllegalStateException if no public key was set.
+	 * @throws IllegalArgumentException if the given Signatures do not match this signature scheme or the number of signatures and messages differ, 
+	 * or if one of the messages is null.
+	 */
+	public boolean verifyAll(Signature[] signatures, byte[][] msgs) {
+		return verifyBatch(dsa, batch, toSignatureBytes(signatures, msgs), msgs, null, true);
+	}
+	
+	/**
+	 * Checks the arguments of the batch verification and extracts the bytes of the given signatures.
+	 */
+	private byte[][] toSignatureBytes(Signature[] signatures, byte[][] msgs){
+		//If there is no public key can not verify, throws exception.
+		if (!isKeySet()){
+			throw new IllegalStateException("in order to verify a signature this object must be initialized with public key");
+		}
+		if (signatures.length != msgs.length){
+			throw new IllegalArgumentException("the number of signatures and messages should be equal");
+		}
+		checkMessages(msgs);
+		
+		byte[][] sigs = new byte[signatures.length][];
+		for (int i = 0; i < signatures.length; i++){
+			if (!(signatures[i] instanceof OpenSSLDSASignature)){
+				throw new IllegalArgumentException("Signature must be instance of OpenSSLDSASignature");
+			}
+			sigs[i] = ((OpenSSLDSASignature) signatures[i]).getSignature();
+		}
+		return sigs;
+	}
+	
+	/**
+	 * Checks that none of the messages of a batch is null, since the native code reads them without checking.
+	 */
+	private void checkMessages(byte[][] msgs){
+		for (int i = 0; i < msgs.length; i++){
+			if (msgs[i] == null){
+				throw new IllegalArgumentException("message " + i + " is null");
+			}
+		}
+	}
+
 	/**
 	 * This function is not supported in this class. 
 	 * Use generateKey() instead.
@@ -284,6 +419,7 @@ public class OpenSSLDSA implements DSABasedSignature{
 
 		// Delete from the dll the dynamic allocation of the DSA object.
 		deleteDSA(dsa);
+		deleteBatchContext(batch);
 
 	}	
 	
@@ -63,6 +63,10 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 	private native int getIVSize(long enc);		// Return the size of the Iv in the current encryption scheme.
 	private native byte[] encrypt(long enc, byte[] plaintext, byte[] iv);	//Encrypt the given plaintext.
 	private native byte[] decrypt(long dec, byte[] cipher, byte[] iv);		//Decrypt the given ciphertext.
+	private native int getBlockSize(long enc);	// Return the block size of the current encryption scheme, 1 in CTR mode.
+	//Encrypt/decrypt a region of an array into a given array, that may be the same array. Return the number of bytes written or -1.
+	private native int encryptInto(long enc, byte[] plaintext, int inOffset, int len, byte[] iv, byte[] out, int outOffset);
+	private native int decryptInto(long dec, byte[] cipher, int inOffset, int len, byte[] iv, byte[] out, int outOffset);
 	private native void deleteNative(long enc, long dec);					//Delete teh native objects.
 	
 	/**
@@ -299,6 +303,88 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 		return new ByteArrayPlaintext(plaintext);
 	}
 	
+	/**
+	 * Returns the size of the ciphertext of a plaintext of the given length.<p>
+	 * In CBC mode the plaintext is padded to the next multiple of the block size (a full block is added if it is already aligned).
+	 * In CTR mode the ciphertext is as long as the plaintext.
+	 * @param plaintextLength the length of the plaintext in bytes.
+	 * @return the size of the ciphertext in bytes.
+	 * @throws IllegalStateException if no secret key was set.
+	 */
+	public int getCiphertextSize(int plaintextLength){
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		int blockSize = getBlockSize(enc);
+		if (blockSize == 1){
+			return plaintextLength;
+		}
+		return (plaintextLength / blockSize + 1) * blockSize;
+	}
+	
+	/**
+	 * Encrypts the plaintext in plaintext[inOffset, inOffset+len) with the given IV and writes the ciphertext to out, starting at outOffset.<p>
+	 * Unlike {@link #encrypt(Plaintext, byte[])}, no memory is allocated. 
+	 * out may be the plaintext array itself with outOffset == inOffset, in which case the plaintext is encrypted in place.
+	 * The IV is not written to out, the caller should send it along with the ciphertext.
+	 * @param plaintext the array that holds the plaintext.
+	 * @param inOffset the offset of the plaintext in the array.
+	 * @param len the length of the plaintext.
+	 * @param iv random bytes to use in the encryption of the message.
+	 * @param out the array to write the ciphertext to. Must have room for {@link #getCiphertextSize(int)} bytes.
+	 * @param outOffset the offset in out to write the ciphertext at.
+	 * @return the number of bytes written to out.
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalBlockSizeException if the given IV length is not as the block size.
+	 * @throws IllegalArgumentException if the given regions are out of bounds or partially overlap.
+	 */
+	public int encrypt(byte[] plaintext, int inOffset, int len, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		checkRegions(plaintext, inOffset, len, iv, out, outOffset, getCiphertextSize(len));
+		
+		return encryptInto(enc, plaintext, inOffset, len, iv, out, outOffset);
+	}
+	
+	/**
+	 * Decrypts the ciphertext in cipher[inOffset, inOffset+len) with the given IV and writes the plaintext to out, starting at outOffset.<p>
+	 * Unlike {@link #decrypt(SymmetricCiphertext)}, no memory is allocated. 
+	 * out may be the ciphertext array itself with outOffset == inOffset, in which case the ciphertext is decrypted in place.
+	 * @param cipher the array that holds the ciphertext.
+	 * @param inOffset the offset of the ciphertext in the array.
+	 * @param len the length of the ciphertext.
+	 * @param iv the IV that was used to encrypt the message.
+	 * @param out the array to write the plaintext to. Must have room for len bytes.
+	 * @param outOffset the offset in out to write the plaintext at.
+	 * @return the number of bytes written to out, or -1 if the decryption failed (for example, because of a wrong padding).
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalBlockSizeException if the given IV length is not as the block size.
+	 * @throws IllegalArgumentException if the given regions are out of bounds or partially overlap.
+	 */
+	public int decrypt(byte[] cipher, int inOffset, int len, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		checkRegions(cipher, inOffset, len, iv, out, outOffset, len);
+		
+		return decryptInto(dec, cipher, inOffset, len, iv, out, outOffset);
+	}
+	
+	//Checks the arguments of the encrypt and decrypt functions that work on a given array.
+	private void checkRegions(byte[] in, int inOffset, int len, byte[] iv, byte[] out, int outOffset, int outLen) throws IllegalBlockSizeException{
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		if(iv.length != getIVSize(enc)){
+			throw new IllegalBlockSizeException("The length of the IV passed is not equal to the block size of current PRP");
+		}
+		if (inOffset < 0 || len < 0 || inOffset + len > in.length){
+			throw new IllegalArgumentException("wrong offset for the given input buffer");
+		}
+		if (outOffset < 0 || outOffset + outLen > out.length){
+			throw new IllegalArgumentException("output buffer too short");
+		}
+		//OpenSSL supports in place operations only when the input and the output start at the same place.
+		if (in == out && inOffset != outOffset && inOffset < outOffset + outLen && outOffset < inOffset + len){
+			throw new IllegalArgumentException("the input and output regions overlap");
+		}
+	}
+	
 	/**
 	 * Deletes the native objects.
 	 */
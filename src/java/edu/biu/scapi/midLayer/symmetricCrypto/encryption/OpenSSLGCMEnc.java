@@ -0,0 +1,375 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.midLayer.symmetricCrypto.encryption;
+
+import java.security.InvalidKeyException;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.security.spec.AlgorithmParameterSpec;
+import java.util.Arrays;
+
+import javax.crypto.IllegalBlockSizeException;
+import javax.crypto.KeyGenerator;
+import javax.crypto.SecretKey;
+
+import edu.biu.scapi.midLayer.ciphertext.ByteArraySymCiphertext;
+import edu.biu.scapi.midLayer.ciphertext.IVCiphertext;
+import edu.biu.scapi.midLayer.ciphertext.SymmetricCiphertext;
+import edu.biu.scapi.midLayer.plaintext.ByteArrayPlaintext;
+import edu.biu.scapi.midLayer.plaintext.Plaintext;
+
+/**
+ * This class performs AES in Galois/Counter Mode (GCM), using OpenSSL library.<p>
+ * GCM encrypts and authenticates the message in a single pass and a single native call, so it is a cheaper alternative to 
+ * {@link ScEncryptThenMac} that runs an encryption and then a separate mac over the ciphertext. By definition, this encryption scheme is CCA2-secure.<p>
+ * The ciphertext is the encrypted data followed by a tag of {@link #TAG_SIZE} bytes. A random IV of {@link #IV_SIZE} bytes is chosen for every message 
+ * unless given by the user; the same IV must never be used twice with the same key.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OpenSSLGCMEnc implements AuthenticatedEnc {
+
+	/**
+	 * The size of the IV, in bytes.
+	 */
+	public static final int IV_SIZE = 12;
+	/**
+	 * The size of the authentication tag, in bytes.
+	 */
+	public static final int TAG_SIZE = 16;
+	
+	private long enc;							// A pointer to the native object that implements the encryption.
+	private long dec;							// A pointer to the native object that implements the decryption.
+	private boolean isKeySet; 
+	private SecureRandom random;				// Used to generate a SecretKey and IV if necessary.
+	
+	//Native functions that call the JNI architecture in order to use OpenSSL functions.
+	private native long createEncryption();		// Create the native object that does the encryption.
+	private native long createDecryption();		// Create the native object that does the decryption.
+	private native void setKey(long enc, long dec, byte[] key);	// Set the key of the native objects.
+	//Encrypt/decrypt a region of an array into a given array, that may be the same array. Return the number of bytes written or -1.
+	private native int encrypt(long enc, byte[] plaintext, int inOffset, int len, byte[] iv, byte[] out, int outOffset);
+	private native int decrypt(long dec, byte[] cipher, int inOffset, int len, byte[] iv, byte[] out, int outOffset);
+	private native void deleteNative(long enc, long dec);		// Delete the native objects.
+	
+	/**
+	 * Default constructor. Uses a default source of randomness.
+	 */
+	public OpenSSLGCMEnc(){
+		this(new SecureRandom());
+	}
+	
+	/**
+	 * Sets the name of a Random Number Generator Algorithm to use to generate the source of randomness.<p>
+	 * @param randNumGenAlg  the name of the RNG algorithm, for example "SHA1PRNG".
+	 * @throws NoSuchAlgorithmException  if the given randNumGenAlg is not a valid random number generator.
+	 */
+	public OpenSSLGCMEnc(String randNumGenAlg) throws NoSuchAlgorithmException {
+		this(SecureRandom.getInstance(randNumGenAlg));
+	}
+	
+	/**
+	 * Sets the source of randomness.
+	 * @param random a user provided source of randomness.
+	 */
+	public OpenSSLGCMEnc(SecureRandom random){
+		//Create native objects for encryption and decryption.
+		enc = createEncryption();
+		dec = createDecryption();
+		this.random = random;
+	}
+	
+	/**
+	 * Supplies the encryption scheme with a Secret Key.
+	 * @param secretKey an AES key of 128, 192 or 256 bits.
+	 * @throws InvalidKeyException if the key size is not valid for AES.
+	 */
+	@Override
+	public void setKey(SecretKey secretKey) throws InvalidKeyException {
+		byte[] key = secretKey.getEncoded();
+		int len = key.length*8;
+		if (len != 128 && len != 192 && len != 256){
+			throw new InvalidKeyException("AES key size should be 128/192/256 bits long");
+		}
+		
+		setKey(enc, dec, key);
+		isKeySet = true;
+	}
+
+	/**
+	 * Checks if this object has been given a SecretKey.
+	 * @return true, if already initialized; False, otherwise.
+	 */
+	@Override
+	public boolean isKeySet() {
+		return isKeySet;
+	}
+
+	/**
+	 * @return the algorithm name - GCM and the underlying prp name.
+	 */
+	@Override
+	public String getAlgorithmName() {
+		return "GCM Encryption with AES";
+	}
+
+	/**
+	 * This function should not be used to generate a key for the encryption and it throws UnsupportedOperationException.
+	 * @throws UnsupportedOperationException 
+	 */
+	@Override
+	public SecretKey generateKey(AlgorithmParameterSpec keyParams) {
+		throw new UnsupportedOperationException("To generate a key for this encryption object use the generateKey(int keySize) function");
+	}
+
+	/**
+	 * Generates an AES secret key.
+	 * @param keySize is the required secret key size in bits - 128, 192 or 256.
+	 * @return the generated secret key.
+	 */
+	@Override
+	public SecretKey generateKey(int keySize) {
+		try {
+			KeyGenerator keyGen = KeyGenerator.getInstance("AES");
+			keyGen.init(keySize, random);
+			return keyGen.generateKey();
+		} catch (NoSuchAlgorithmException e) {
+			//Should not occur since AES is provided by every java implementation.
+			throw new IllegalStateException(e);
+		}
+	}
+
+	/**
+	 * Returns the size of the ciphertext (the encrypted data and the tag, without the IV) of a plaintext of the given length.
+	 * @param plaintextLength the length of the plaintext in bytes.
+	 */
+	public int getCiphertextSize(int plaintextLength){
+		return plaintextLength + TAG_SIZE;
+	}
+	
+	/**
+	 * This function encrypts a plaintext. It lets the system choose the random IV.
+	 * @param plaintext should be an instance of ByteArrayPlaintext.
+	 * @return  an IVCiphertext, which contains the IV used and the encrypted data followed by the tag.
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalArgumentException if the given plaintext is not an instance of ByteArrayPlaintext.
+	 */
+	@Override
+	public SymmetricCiphertext encrypt(Plaintext plaintext) {
+		byte[] iv = new byte[IV_SIZE];
+		random.nextBytes(iv);
+		
+		try {
+			return encrypt(plaintext, iv);
+		} catch (IllegalBlockSizeException e) {
+			//Should not occur since IV was created of size IV_SIZE.
+			throw new IllegalStateException(e);
+		}
+	}
+
+	/**
+	 * This function encrypts a plaintext. It lets the user choose the IV.
+	 * @param plaintext should be an instance of ByteArrayPlaintext.
+	 * @param iv random bytes to use in the encryption of the message.
+	 * @return an IVCiphertext, which contains the IV used and the encrypted data followed by the tag. 
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalArgumentException if the given plaintext is not an instance of ByteArrayPlaintext.
+	 * @throws IllegalBlockSizeException if the given IV length is not IV_SIZE.
+	 */
+	@Override
+	public SymmetricCiphertext encrypt(Plaintext plaintext, byte[] iv) throws IllegalBlockSizeException {
+		if (!(plaintext instanceof ByteArrayPlaintext)){
+			throw new IllegalArgumentException("plaintext should be instance of ByteArrayPlaintext");
+		}
+		byte[] text = ((ByteArrayPlaintext) plaintext).getText();
+		byte[] cipher = new byte[getCiphertextSize(text.length)];
+		
+		encrypt(text, 0, text.length, iv, cipher, 0);
+		
+		return new IVCiphertext(new ByteArraySymCiphertext(cipher), iv);
+	}
+
+	/**
+	 * Verifies and decrypts the given ciphertext.
+	 * @param ciphertext the given ciphertext to decrypt. MUST be an instance of IVCiphertext.
+	 * @return the plaintext object containing the decrypted ciphertext, or null if the ciphertext was not authenticated.
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalArgumentException if the given ciphertext is not an instance of IVCiphertext.
+	 */
+	@Override
+	public Plaintext decrypt(SymmetricCiphertext ciphertext) {
+		if (!(ciphertext instanceof IVCiphertext)){
+			throw new IllegalArgumentException("The ciphertext has to be of type IVCiphertext");
+		}
+		byte[] iv = ((IVCiphertext) ciphertext).getIv();
+		byte[] cipher = ciphertext.getBytes();
+		if (cipher.length < TAG_SIZE){
+			return null;
+		}
+		byte[] text = new byte[cipher.length - TAG_SIZE];
+		
+		try {
+			if (decrypt(cipher, 0, cipher.length, iv, text, 0) == -1){
+				return null;
+			}
+		} catch (IllegalBlockSizeException e) {
+			throw new IllegalArgumentException(e.getMessage());
+		}
+		return new ByteArrayPlaintext(text);
+	}
+	
+	/**
+	 * Encrypts the plaintext in plaintext[inOffset, inOffset+len) with the given IV and writes the encrypted data followed by the tag to out, starting at outOffset.<p>
+	 * No memory is allocated and the data is passed over once. 
+	 * out may be the plaintext array itself with outOffset == inOffset, in which case the plaintext is encrypted in place.
+	 * The IV is not written to out, the caller should send it along with the ciphertext.
+	 * @param plaintext the array that holds the plaintext.
+	 * @param inOffset the offset of the plaintext in the array.
+	 * @param len the length of the plaintext.
+	 * @param iv random bytes to use in the encryption of the message. Must be IV_SIZE bytes long.
+	 * @param out the array to write the ciphertext to. Must have room for len + TAG_SIZE bytes.
+	 * @param outOffset the offset in out to write the ciphertext at.
+	 * @return the number of bytes written to out, that is, len + TAG_SIZE.
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalBlockSizeException if the given IV length is not IV_SIZE.
+	 * @throws IllegalArgumentException if the given regions are out of bounds or partially overlap.
+	 */
+	public int encrypt(byte[] plaintext, int inOffset, int len, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		checkRegions(plaintext, inOffset, len, iv, out, outOffset, len + TAG_SIZE);
+		
+		return encrypt(enc, plaintext, inOffset, len, iv, out, outOffset);
+	}
+	
+	/**
+	 * Verifies and decrypts the ciphertext in cipher[inOffset, inOffset+len), which is the encrypted data followed by the tag, 
+	 * and writes the plaintext to out, starting at outOffset.<p>
+	 * out may be the ciphertext array itself with outOffset == inOffset, in which case the ciphertext is decrypted in place.
+	 * @param cipher the array that holds the ciphertext.
+	 * @param inOffset the offset of the ciphertext in the array.
+	 * @param len the length of the ciphertext, including the tag.
+	 * @param iv the IV that was used to encrypt the message.
+	 * @param out the array to write the plaintext to. Must have room for len - TAG_SIZE bytes.
+	 * @param outOffset the offset in out to write the plaintext at.
+	 * @return the number of bytes written to out, or -1 if the ciphertext was not authenticated. In that case nothing of the plaintext is left in out.
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalBlockSizeException if the given IV length is not IV_SIZE.
+	 * @throws IllegalArgumentException if the given regions are out of bounds or partially overlap.
+	 */
+	public int decrypt(byte[] cipher, int inOffset, int len, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		if (len < TAG_SIZE){
+			return -1;
+		}
+		checkRegions(cipher, inOffset, len, iv, out, outOffset, len - TAG_SIZE);
+		
+		return decrypt(dec, cipher, inOffset, len, iv, out, outOffset);
+	}
+	
+	/**
+	 * Encrypts the plaintext in plaintext[offset, offset+len) with a random IV and returns a single array that holds 
+	 * the IV, the encrypted data and the tag, in this order.<p>
+	 * This is the compact format used by {@link edu.biu.scapi.comm.EncryptedChannel} to send a message in one piece. 
+	 * @param plaintext the array that holds the plaintext.
+	 * @param offset the offset of the plaintext in the array.
+	 * @param len the length of the plaintext.
+	 * @return IV_SIZE + len + TAG_SIZE bytes of the IV and the ciphertext.
+	 * @throws IllegalStateException if no secret key was set.
+	 */
+	public byte[] seal(byte[] plaintext, int offset, int len){
+		byte[] iv = new byte[IV_SIZE];
+		random.nextBytes(iv);
+		byte[] sealed = new byte[IV_SIZE + getCiphertextSize(len)];
+		System.arraycopy(iv, 0, sealed, 0, IV_SIZE);
+		
+		try {
+			encrypt(plaintext, offset, len, iv, sealed, IV_SIZE);
+		} catch (IllegalBlockSizeException e) {
+			//Should not occur since IV was created of size IV_SIZE.
+			throw new IllegalStateException(e);
+		}
+		return sealed;
+	}
+	
+	/**
+	 * Verifies and decrypts an array created by {@link #seal(byte[], int, int)}.
+	 * @param sealed the IV, the encrypted data and the tag.
+	 * @return the plaintext, or null if the ciphertext was not authenticated.
+	 * @throws IllegalStateException if no secret key was set.
+	 */
+	public byte[] open(byte[] sealed){
+		int cipherLen = sealed.length - IV_SIZE;
+		if (cipherLen < TAG_SIZE){
+			return null;
+		}
+		byte[] iv = Arrays.copyOf(sealed, IV_SIZE);
+		byte[] text = new byte[cipherLen - TAG_SIZE];
+		
+		try {
+			if (decrypt(sealed, IV_SIZE, cipherLen, iv, text, 0) == -1){
+				return null;
+			}
+		} catch (IllegalBlockSizeException e) {
+			//Should not occur since IV was taken of size IV_SIZE.
+			throw new IllegalStateException(e);
+		}
+		return text;
+	}
+	
+	//Checks the arguments of the encrypt and decrypt functions.
+	private void checkRegions(byte[] in, int inOffset, int len, byte[] iv, byte[] out, int outOffset, int outLen) throws IllegalBlockSizeException{
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		if (iv.length != IV_SIZE){
+			throw new IllegalBlockSizeException("The length of the IV should be " + IV_SIZE + " bytes");
+		}
+		if (inOffset < 0 || len < 0 || inOffset + len > in.length){
+			throw new IllegalArgumentException("wrong offset for the given input buffer");
+		}
+		if (outOffset < 0 || outOffset + outLen > out.length){
+			throw new IllegalArgumentException("output buffer too short");
+		}
+		//OpenSSL supports in place operations only when the input and the output start at the same place.
+		if (in == out && inOffset != outOffset && inOffset < outOffset + outLen && outOffset < inOffset + len){
+			throw new IllegalArgumentException("the input and output regions overlap");
+		}
+	}
+	
+	/**
+	 * Deletes the native objects.
+	 */
+	protected void finalize() throws Throwable {
+
+		// Delete from the dll the dynamic allocation.
+		deleteNative(enc, dec);
+
+		super.finalize();
+	}
+
+	static {
+		//loads the OpenSSL dll.
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
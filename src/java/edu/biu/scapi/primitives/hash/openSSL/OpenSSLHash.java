@@ -58,6 +58,9 @@ public class OpenSSLHash implements CryptographicHash {
 	//Finishes the hash computation.
 	private native void finalHash(long ptr, byte[] output);
 	
+	//Hashes many independent messages.
+	private native void batchHash(long ptr, byte[] in, int[] offsets, int[] lengths, int numMessages, byte[] out, int outOffset);
+	
 	//Returns the size of the hashed msg.
 	private native int getDigestSize(long ptr);
 	
@@ -151,6 +154,69 @@ public class OpenSSLHash implements CryptographicHash {
 
 	}
 
+	/**
+	 * Hashes many independent messages in a single call. <p>
+	 * Message i is taken from in[offsets[i]..offsets[i]+lengths[i]) and its digest is put in out, starting at outOffset + i*getHashedMsgSize(). 
+	 * The messages may be of different lengths. <p>
+	 * This function does not use or change the message accumulated by update, and is much faster than calling update and hashFinal
+	 * for each message. For SHA-1 and SHA-256, short messages are hashed together by a multi-buffer implementation that computes 
+	 * several digests in the lanes of the vector registers.
+	 * @param in the array that holds all the messages.
+	 * @param offsets the offset of each message in the input array.
+	 * @param lengths the length of each message.
+	 * @param out the array to put the digests in.
+	 * @param outOffset the offset in out of the first digest.
+	 */
+	public void hashBatch(byte[] in, int[] offsets, int[] lengths, byte[] out, int outOffset){
+		int numMessages = offsets.length;
+		if (lengths.length != numMessages){
+			throw new IllegalArgumentException("there should be a length for each offset");
+		}
+		for (int i = 0; i < numMessages; i++){
+			if ((offsets[i] < 0) || (lengths[i] < 0) || ((long) offsets[i] + lengths[i] > in.length)){
+				throw new ArrayIndexOutOfBoundsException("wrong offset or length of message " + i);
+			}
+		}
+		checkBatchOutput(numMessages, out, outOffset);
+		
+		batchHash(hash, in, offsets, lengths, numMessages, out, outOffset);
+	}
+	
+	/**
+	 * Hashes numMessages consecutive messages of the same length in a single call. <p>
+	 * Message i is taken from in, starting at inOffset + i*messageLen, and its digest is put in out, starting at outOffset + i*getHashedMsgSize().
+	 * See {@link #hashBatch(byte[], int[], int[], byte[], int)}.
+	 * @param in the array that holds all the messages.
+	 * @param inOffset the offset of the first message in the input array.
+	 * @param messageLen the length of each message.
+	 * @param numMessages the number of messages.
+	 * @param out the array to put the digests in.
+	 * @param outOffset the offset in out of the first digest.
+	 */
+	public void hashBatch(byte[] in, int inOffset, int messageLen, int numMessages, byte[] out, int outOffset){
+		if ((inOffset < 0) || (messageLen < 0) || (numMessages < 0) || ((long) inOffset + (long) messageLen*numMessages > in.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		checkBatchOutput(numMessages, out, outOffset);
+		
+		int[] offsets = new int[numMessages];
+		int[] lengths = new int[numMessages];
+		for (int i = 0; i < numMessages; i++){
+			offsets[i] = inOffset + i*messageLen;
+			lengths[i] = messageLen;
+		}
+		batchHash(hash, in, offsets, lengths, numMessages, out, outOffset);
+	}
+	
+	/*
+	 * Checks that the digests of numMessages messages fit in the output array.
+	 */
+	private void checkBatchOutput(int numMessages, byte[] out, int outOffset){
+		if ((outOffset < 0) || ((long) outOffset + (long) numMessages*hashSize > out.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+	}
+
 	/** 
 	 * @return the size of the hashed massage in bytes.
 	 */
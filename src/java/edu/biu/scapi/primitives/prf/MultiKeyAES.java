@@ -0,0 +1,101 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.prf;
+
+import java.security.InvalidKeyException;
+
+import javax.crypto.SecretKey;
+
+/**
+ * General interface for AES under many keys at once. <p>
+ * 
+ * Protocols such as garbled circuits and OT extension encrypt a large number of blocks, each one under a different key. 
+ * Using an {@link AES} object for that requires setting a new key (and expanding it) before every block and crossing the JNI
+ * boundary for every block. An object of this interface holds all the expanded keys, and encrypts any number of blocks, each one 
+ * under its own key, in a single call. <p>
+ * 
+ * Only the forward direction of AES is supported, in ECB mode or as a seekable CTR mode keystream.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public interface MultiKeyAES {
+
+	/**
+	 * Sets the keys of this object. Any previous keys are deleted.
+	 * @param keys the keys. All the keys must be of the same size, 128, 192 or 256 bits.
+	 * @throws InvalidKeyException if the keys are not of the same valid AES key size.
+	 */
+	public void setKeys(SecretKey[] keys) throws InvalidKeyException;
+	
+	/**
+	 * @return the number of keys that were set.
+	 */
+	public int getNumKeys();
+	
+	/**
+	 * An object trying to use an instance of MultiKeyAES needs to check if it has already been initialized.
+	 * @return true if the object was initialized by calling the function setKeys.
+	 */
+	public boolean isKeySet();
+	
+	/**
+	 * Encrypts numBlocks consecutive blocks in ECB mode, block i under key i % getNumKeys(). <p>
+	 * In particular, if the number of blocks equals the number of keys, each block is encrypted under the key of the same index.
+	 * @param inBytes the input blocks.
+	 * @param inOff the offset of the first block in inBytes.
+	 * @param outBytes the array to put the encrypted blocks in. May be the same array as inBytes.
+	 * @param outOff the offset in outBytes to put the first encrypted block.
+	 * @param numBlocks the number of blocks to encrypt.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks);
+	
+	/**
+	 * Encrypts numBlocks consecutive blocks in ECB mode, block i under key keyIndices[i].
+	 * @param inBytes the input blocks.
+	 * @param inOff the offset of the first block in inBytes.
+	 * @param outBytes the array to put the encrypted blocks in. May be the same array as inBytes.
+	 * @param outOff the offset in outBytes to put the first encrypted block.
+	 * @param numBlocks the number of blocks to encrypt.
+	 * @param keyIndices the index of the key of each block.
+	 * @throws IllegalArgumentException if one of the indices is not the index of a key.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks, int[] keyIndices);
+	
+	/**
+	 * Encrypts (or decrypts) in CTR mode with the given key. <p>
+	 * Block j of the output is the input block xored with AES(key, iv + counterOffset + j), where iv is treated as a 128 bit 
+	 * big endian counter. Since the counter is given explicitly, any part of the keystream can be computed without computing the parts before it.
+	 * @param keyIndex the index of the key to use.
+	 * @param iv the initial counter block, 16 bytes.
+	 * @param counterOffset the index of the first keystream block to use.
+	 * @param inBytes the input to xor with the keystream. If null, the keystream itself is written to outBytes.
+	 * @param inOff the offset in inBytes.
+	 * @param outBytes the array to put the result in. May be the same array as inBytes.
+	 * @param outOff the offset in outBytes.
+	 * @param numBlocks the number of blocks to compute.
+	 */
+	public void ctr(int keyIndex, byte[] iv, long counterOffset, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks);
+}
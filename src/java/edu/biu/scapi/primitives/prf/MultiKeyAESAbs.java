@@ -0,0 +1,162 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.prf;
+
+import java.security.InvalidKeyException;
+
+import javax.crypto.SecretKey;
+
+/**
+ * Abstract class of the native MultiKeyAES implementations. <p>
+ * This class checks the arguments and manages the native keys, while the concrete classes call the library specific native functions.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public abstract class MultiKeyAESAbs implements MultiKeyAES {
+	
+	private static final int BLOCK_SIZE = 16;
+	
+	private long keysP;		//Pointer to the native expanded keys.
+	private int numKeys;
+	
+	/*
+	 * The library specific native functions.
+	 */
+	protected abstract long createNativeKeys(byte[] keys, int numKeys, int keySize);
+	protected abstract void computeNativeBlocks(long keysP, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks, int[] keyIndices);
+	protected abstract void nativeCtr(long keysP, int keyIndex, byte[] iv, long counterOffset, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks);
+	protected abstract void deleteNativeKeys(long keysP);
+	
+	@Override
+	public void setKeys(SecretKey[] keys) throws InvalidKeyException {
+		if (keys.length == 0){
+			throw new InvalidKeyException("at least one key should be given");
+		}
+		int keySize = keys[0].getEncoded().length;
+		//AES key size should be 128/192/256 bits long.
+		if(keySize!=16 && keySize!=24 && keySize!=32){
+			throw new InvalidKeyException("AES key size should be 128/192/256 bits long");
+		}
+		
+		//Put all the keys in one array, so they are passed to the native code at once.
+		byte[] allKeys = new byte[keys.length * keySize];
+		for (int i = 0; i < keys.length; i++){
+			byte[] key = keys[i].getEncoded();
+			if (key.length != keySize){
+				throw new InvalidKeyException("all the keys should be of the same size");
+			}
+			System.arraycopy(key, 0, allKeys, i*keySize, keySize);
+		}
+		
+		if (keysP != 0){
+			deleteNativeKeys(keysP);
+		}
+		keysP = createNativeKeys(allKeys, keys.length, keySize);
+		numKeys = keys.length;
+	}
+	
+	@Override
+	public int getNumKeys() {
+		return numKeys;
+	}
+
+	@Override
+	public boolean isKeySet() {
+		return keysP != 0;
+	}
+	
+	@Override
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		checkArguments(inBytes, inOff, outBytes, outOff, numBlocks);
+		
+		computeNativeBlocks(keysP, inBytes, inOff, outBytes, outOff, numBlocks, null);
+	}
+
+	@Override
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks, int[] keyIndices) {
+		checkArguments(inBytes, inOff, outBytes, outOff, numBlocks);
+		if (keyIndices.length < numBlocks){
+			throw new IllegalArgumentException("a key index should be given for each block");
+		}
+		//The native code uses the indices without checking them.
+		for (int i = 0; i < numBlocks; i++){
+			if (keyIndices[i] < 0 || keyIndices[i] >= numKeys){
+				throw new IllegalArgumentException("wrong key index " + keyIndices[i] + " for block " + i);
+			}
+		}
+		
+		computeNativeBlocks(keysP, inBytes, inOff, outBytes, outOff, numBlocks, keyIndices);
+	}
+
+	@Override
+	public void ctr(int keyIndex, byte[] iv, long counterOffset, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		if (inBytes == null){
+			checkArguments(outBytes, outOff, outBytes, outOff, numBlocks);
+		} else {
+			checkArguments(inBytes, inOff, outBytes, outOff, numBlocks);
+		}
+		if (keyIndex < 0 || keyIndex >= numKeys){
+			throw new IllegalArgumentException("wrong key index " + keyIndex);
+		}
+		if (iv.length != BLOCK_SIZE){
+			throw new IllegalArgumentException("iv should be " + BLOCK_SIZE + " bytes long");
+		}
+		if (counterOffset < 0){
+			throw new IllegalArgumentException("counterOffset should be non negative");
+		}
+		
+		nativeCtr(keysP, keyIndex, iv, counterOffset, inBytes, inOff, outBytes, outOff, numBlocks);
+	}
+	
+	/*
+	 * Checks that the keys are set and that the given blocks are inside the arrays.
+	 */
+	private void checkArguments(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (numBlocks < 0){
+			throw new IllegalArgumentException("numBlocks should be non negative");
+		}
+		if ((inOff < 0) || ((long) inOff + (long) numBlocks*BLOCK_SIZE > inBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || ((long) outOff + (long) numBlocks*BLOCK_SIZE > outBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+	}
+	
+	/**
+	 * Deletes the native keys.
+	 */
+	protected void finalize() throws Throwable {
+		if (keysP != 0){
+			deleteNativeKeys(keysP);
+			keysP = 0;
+		}
+		super.finalize();
+	}
+}
@@ -0,0 +1,67 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.prf.cryptopp;
+
+import edu.biu.scapi.primitives.prf.MultiKeyAESAbs;
+
+/**
+ * Concrete class of MultiKeyAES that wraps the implementation of Crypto++ library.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class CryptoPpMultiKeyAES extends MultiKeyAESAbs {
+	
+	//Native functions that implements the multi key AES using Crypto++.
+	private native long createKeys(byte[] keys, int numKeys, int keySize);	//Expands all the given keys.
+	private native void computeBlocks(long keysP, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks, int[] keyIndices); //Encrypts the blocks in ECB mode.
+	private native void ctr(long keysP, int keyIndex, byte[] iv, long counterOffset, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks); //Computes the CTR mode.
+	private native void deleteKeys(long keysP);	//Deletes the native keys.
+	
+	@Override
+	protected long createNativeKeys(byte[] keys, int numKeys, int keySize) {
+		return createKeys(keys, numKeys, keySize);
+	}
+
+	@Override
+	protected void computeNativeBlocks(long keysP, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks, int[] keyIndices) {
+		computeBlocks(keysP, inBytes, inOff, outBytes, outOff, numBlocks, keyIndices);
+	}
+
+	@Override
+	protected void nativeCtr(long keysP, int keyIndex, byte[] iv, long counterOffset, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		ctr(keysP, keyIndex, iv, counterOffset, inBytes, inOff, outBytes, outOff, numBlocks);
+	}
+
+	@Override
+	protected void deleteNativeKeys(long keysP) {
+		deleteKeys(keysP);
+	}
+	
+	static {
+		//loads the Crypto++ dll.
+		System.loadLibrary("CryptoPPJavaInterface");
+	}
+}
@@ -57,6 +57,8 @@ public class OpenSSLHMAC implements Hmac {
 	private native String getName(long hmac);			//Returns the name of the underlying hash.
 	private native void updateNative(long hmac, byte[] in, int inOffset, int inLen);//Updates the Hmac eith the given in array.
 	private native void updateFinal(long hmac, byte[] out, int outOffset);//Finalize the Hmac operation and puts the result in the given out array.
+	private native void macMany(long hmac, byte[] in, int[] offsets, int[] lengths, int numMessages, byte[] out, int outOffset); //Computes the macs of many messages.
+	private native boolean verifyMany(long hmac, byte[] in, int[] offsets, int[] lengths, int numMessages, byte[] tags, int tagsOffset, boolean[] results); //Verifies the tags of many messages.
 	private native void deleteNative(long hmac);		//Deletes the native object.
 	
 	/**
@@ -343,6 +345,67 @@ public class OpenSSLHMAC implements Hmac {
 		return equal;	
 	}
 	
+	/**
+	 * Computes the macs of many messages in a single call. <p>
+	 * Message i is taken from in[offsets[i]..offsets[i]+lengths[i]) and its tag is put in tags, starting at tagsOffset + i*getMacSize().
+	 * This function does not use or change the message accumulated by update.
+	 * @param in the array that holds all the messages.
+	 * @param offsets the offset of each message in the input array.
+	 * @param lengths the length of each message.
+	 * @param tags the array to put the tags in.
+	 * @param tagsOffset the offset in tags of the first tag.
+	 */
+	public void macMany(byte[] in, int[] offsets, int[] lengths, byte[] tags, int tagsOffset){
+		checkMany(in, offsets, lengths, tags, tagsOffset);
+		
+		macMany(hmac, in, offsets, lengths, offsets.length, tags, tagsOffset);
+	}
+	
+	/**
+	 * Verifies the tags of many messages in a single call. <p>
+	 * The tag of message i is taken from tags, starting at tagsOffset + i*getMacSize(). The tags are compared in constant time, 
+	 * and all of them are checked even if some are wrong. 
+	 * This function does not use or change the message accumulated by update.
+	 * @param in the array that holds all the messages.
+	 * @param offsets the offset of each message in the input array.
+	 * @param lengths the length of each message.
+	 * @param tags the tags to verify.
+	 * @param tagsOffset the offset in tags of the first tag.
+	 * @param results if not null, filled with the result of the verification of each message.
+	 * @return true if all the tags are valid.
+	 */
+	public boolean verifyMany(byte[] in, int[] offsets, int[] lengths, byte[] tags, int tagsOffset, boolean[] results){
+		checkMany(in, offsets, lengths, tags, tagsOffset);
+		if (results == null){
+			results = new boolean[offsets.length];
+		} else if (results.length < offsets.length){
+			throw new IllegalArgumentException("results should have a place for each message");
+		}
+		
+		return verifyMany(hmac, in, offsets, lengths, offsets.length, tags, tagsOffset, results);
+	}
+	
+	/*
+	 * Checks the arguments of macMany and verifyMany.
+	 */
+	private void checkMany(byte[] in, int[] offsets, int[] lengths, byte[] tags, int tagsOffset){
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		int numMessages = offsets.length;
+		if (lengths.length != numMessages){
+			throw new IllegalArgumentException("there should be a length for each offset");
+		}
+		for (int i = 0; i < numMessages; i++){
+			if ((offsets[i] < 0) || (lengths[i] < 0) || ((long) offsets[i] + lengths[i] > in.length)){
+				throw new ArrayIndexOutOfBoundsException("wrong offset or length of message " + i);
+			}
+		}
+		if ((tagsOffset < 0) || ((long) tagsOffset + (long) numMessages*getMacSize() > tags.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given tags buffer");
+		}
+	}
+	
 	/**
 	 * Adds the byte array to the existing message to mac.
 	 * @param msg the message to add.
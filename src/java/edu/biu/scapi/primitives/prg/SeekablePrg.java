@@ -0,0 +1,58 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.prg;
+
+/** 
+ * General interface of a pseudorandom generator whose output can be read from any position. <p>
+ * 
+ * The output of such a prg is determined by the key alone, and any segment of it can be regenerated without generating 
+ * the bytes before it. This lets seed based protocols (for example, garbling from a seed or the padding of the OT extension)
+ * recompute only the part of the output they need.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public interface SeekablePrg extends PseudorandomGenerator {
+	
+	/**
+	 * Moves the prg to the given position, so that the next call to getPRGBytes outputs the bytes from this position. 
+	 * @param position the position in the output, in bytes.
+	 */
+	public void seek(long position);
+	
+	/**
+	 * @return the position in the output of the next byte that getPRGBytes will output.
+	 */
+	public long getPosition();
+	
+	/**
+	 * Outputs outLen bytes starting at the given position of the output. <p>
+	 * Afterwards, the position of the prg is the position after the last generated byte.
+	 * @param position the position in the output of the first byte to generate.
+	 * @param outBytes output bytes.
+	 * @param outOffset output offset.
+	 * @param outLen the required output length.
+	 */
+	public void getPRGBytes(long position, byte[] outBytes, int outOffset, int outLen);
+}
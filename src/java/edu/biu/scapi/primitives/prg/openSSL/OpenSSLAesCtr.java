@@ -0,0 +1,225 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.prg.openSSL;
+
+import java.nio.ByteBuffer;
+import java.security.InvalidKeyException;
+import java.security.InvalidParameterException;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.security.spec.AlgorithmParameterSpec;
+import java.security.spec.InvalidParameterSpecException;
+
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import edu.biu.scapi.primitives.prg.SeekablePrg;
+
+/**
+ * This class wraps the OpenSSL implementation of AES in counter mode, used as a pseudorandom generator. <p>
+ * 
+ * The output is AES(key, 1) || AES(key, 2) || ..., where the counters are 128 bit big endian numbers. This is the same output as 
+ * ScPrgFromPrf with AES, but it is generated natively by OpenSSL (using AES-NI when available), any number of bytes in a single call.
+ * The output can be read from any position, see {@link SeekablePrg}. 
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OpenSSLAesCtr implements SeekablePrg{
+	
+	private long prg; 		//pointer to the native prg object.
+	private long position;	//The position of the next byte to output.
+	
+	private SecureRandom random;
+	private boolean isKeySet;
+	
+	//Native functions that uses OpenSSL's AES-CTR implementation. 
+	private native long createAesCtr();						// Creates the native prg object.
+	private native void initAesCtr(long prg, byte[] key);	// Initializes the native prg with the key.
+	private native void generateBytes(long prg, long position, byte[] outBytes, int outOffset, int outLen); //Generates the bytes from the given position.
+	private native void generateBytesDirect(long prg, long position, ByteBuffer out, int outOffset, int outLen); //Generates the bytes into a direct buffer.
+	private native void deleteNative(long prg);				//Deletes the native object.
+	
+	/**
+	 * Creates the object using default random.
+	 */
+	public OpenSSLAesCtr(){
+		this (new SecureRandom());
+	}
+	
+	/**
+	 * Creates the object using the given random object.
+	 * @param random
+	 */
+	public OpenSSLAesCtr(SecureRandom random){
+		this.random = random;
+		
+		//Creates the native object.
+		prg = createAesCtr();
+	}
+	
+	/**
+	 * Creates the object using the given random number generator algorithm.
+	 * @param randNumGenAlg
+	 * @throws NoSuchAlgorithmException if the given algorithm is not exist.
+	 */
+	public OpenSSLAesCtr(String randNumGenAlg) throws NoSuchAlgorithmException {
+		
+		this(SecureRandom.getInstance(randNumGenAlg));
+	}
+	
+	/**
+	 * Sets the given key and moves the prg to the beginning of its output.
+	 * @throws InvalidKeyException if the key is not 128/192/256 bits long.
+	 */
+	public void setKey(SecretKey secretKey) throws InvalidKeyException {
+		int len = secretKey.getEncoded().length;
+		//AES key size should be 128/192/256 bits long.
+		if(len!=16 && len!=24 && len!=32){
+			throw new InvalidKeyException("AES key size should be 128/192/256 bits long");
+		}
+		
+		//Call the native function to set the key.
+		initAesCtr(prg, secretKey.getEncoded());
+		position = 0;
+		//Marks this object as initialized.
+		isKeySet = true;
+	}
+	
+	public boolean isKeySet(){
+		return isKeySet;
+	}
+	
+	/** 
+	 * Returns the name of the algorithm.
+	 * @return - the algorithm name "AesCtr".
+	 */
+	public String getAlgorithmName() {
+		
+		return "AesCtr";
+	}
+
+	/**
+	 * This function is not supported in this implementation. Throws exception.
+	 * @throws UnsupportedOperationException 
+	 */
+	public SecretKey generateKey(AlgorithmParameterSpec keyParams) throws InvalidParameterSpecException{
+		throw new UnsupportedOperationException("To generate a key for this prg object use the generateKey(int keySize) function");
+	}
+	
+	/**
+	 * Generates a secret key to initialize this prg object.
+	 * @param keySize is the required secret key size in bits (128, 192 or 256).
+	 * @return the generated secret key 
+	 */
+	public SecretKey generateKey(int keySize){
+		if(keySize!=128 && keySize!=192 && keySize!=256){
+			throw new InvalidParameterException("Wrong key size: must be 128/192/256 bits long");
+		}
+		byte[] genBytes = new byte[keySize/8];
+
+		//Generates the bytes using the random.
+		random.nextBytes(genBytes);
+		//Creates a secretKey from the generated bytes.
+		return new SecretKeySpec(genBytes, "AES");
+	}
+	
+	@Override
+	public void seek(long position) {
+		if (position < 0){
+			throw new IllegalArgumentException("position should be non negative");
+		}
+		this.position = position;
+	}
+
+	@Override
+	public long getPosition() {
+		return position;
+	}
+	
+	/** 
+	 * Streams the bytes from the current position.
+	 * @param outBytes - output bytes. The result of streaming the bytes.
+	 * @param outOffset - output offset.
+	 * @param outLen - the required output length.
+	 */
+	public void getPRGBytes(byte[] outBytes, int outOffset,	int outLen){
+		getPRGBytes(position, outBytes, outOffset, outLen);
+	}
+	
+	@Override
+	public void getPRGBytes(long position, byte[] outBytes, int outOffset, int outLen) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (position < 0){
+			throw new IllegalArgumentException("position should be non negative");
+		}
+		//checks that the offset and the length are correct.
+		if ((outOffset < 0) || (outLen < 0) || ((long) outOffset + outLen > outBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		generateBytes(prg, position, outBytes, outOffset, outLen);
+		this.position = position + outLen;
+	}
+	
+	/** 
+	 * Streams the bytes from the current position into the given direct buffer. <p>
+	 * The bytes are written from the position of the buffer, which is then advanced by outLen.
+	 * @param out a direct buffer to put the bytes in.
+	 * @param outLen the required output length.
+	 * @throws IllegalArgumentException if the given buffer is not direct.
+	 */
+	public void getPRGBytes(ByteBuffer out, int outLen){
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (!out.isDirect()){
+			throw new IllegalArgumentException("the given buffer should be a direct buffer");
+		}
+		if ((outLen < 0) || (outLen > out.remaining())){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given output buffer");
+		}
+		
+		generateBytesDirect(prg, position, out, out.position(), outLen);
+		out.position(out.position() + outLen);
+		position += outLen;
+	}
+	
+	/**
+	 * deletes the native prg object.
+	 */
+	protected void finalize() throws Throwable {
+
+		// delete from the dll the dynamic allocation.
+		deleteNative(prg);
+	}
+	
+	static {
+		//loads the OpenSSL dll.
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
@@ -40,6 +40,7 @@ import edu.biu.scapi.primitives.prg.RC4;
  * 
  * RC4 is a well known stream cipher, that is essentially a pseudorandom generator.<p> 
  * In our implementation, we throw out the first 1024 bits since the first few bytes have been shown to have some bias. 
+ * New code should prefer {@link OpenSSLAesCtr}, which is faster and can be read from any position.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Meital Levy)
  *
@@ -112,6 +112,29 @@ public interface TrapdoorPermutation {
 	 * @throws IllegalArgumentException if the given element is invalid for this permutation
 	 */
 	public TPElement invert(TPElement tpEl) throws KeyException;
+	
+	/** 
+	 * Computes the operation of this trapdoor permutation on each one of the given TPElements.<p>
+	 * Native implementations compute the whole batch in one call, reusing the precomputations on the key between the elements,
+	 * and may split the batch between the given number of threads.
+	 * @param tpEls - the inputs for the computation
+	 * @param numThreads - the number of threads to use. Values smaller than 2 compute all the elements in the calling thread
+	 * @return - the result TPElements, in the order of the inputs
+	 * @throws IllegalArgumentException if one of the given elements is invalid for this permutation
+	 */
+	public TPElement[] compute(TPElement[] tpEls, int numThreads) throws IllegalArgumentException;
+	
+	/** 
+	 * Inverts the operation of this trapdoor permutation on each one of the given TPElements.<p>
+	 * Native implementations invert the whole batch in one call, reusing the precomputations on the key between the elements,
+	 * and may split the batch between the given number of threads.
+	 * @param tpEls - the inputs to invert
+	 * @param numThreads - the number of threads to use. Values smaller than 2 invert all the elements in the calling thread
+	 * @return - the result TPElements, in the order of the inputs
+	 * @throws KeyException if there is no private key
+	 * @throws IllegalArgumentException if one of the given elements is invalid for this permutation
+	 */
+	public TPElement[] invert(TPElement[] tpEls, int numThreads) throws KeyException;
 
 	/** 
 	 * Computes the hard core predicate of the given tpElement. <p>
@@ -28,6 +28,7 @@ package edu.biu.scapi.primitives.trapdoorPermutation;
 
 import java.math.BigInteger;
 import java.security.InvalidKeyException;
+import java.security.KeyException;
 import java.security.PrivateKey;
 import java.security.PublicKey;
 
@@ -78,6 +79,30 @@ public abstract class TrapdoorPermutationAbs implements TrapdoorPermutation {
 	}
 	
 	
+	/**
+	 * Computes the permutation on each one of the given elements, one after the other.<p>
+	 * The number of threads is ignored. Derived classes with a native batch implementation override this function.
+	 */
+	public TPElement[] compute(TPElement[] tpEls, int numThreads) throws IllegalArgumentException {
+		TPElement[] results = new TPElement[tpEls.length];
+		for (int i = 0; i < tpEls.length; i++) {
+			results[i] = compute(tpEls[i]);
+		}
+		return results;
+	}
+	
+	/**
+	 * Inverts the permutation on each one of the given elements, one after the other.<p>
+	 * The number of threads is ignored. Derived classes with a native batch implementation override this function.
+	 */
+	public TPElement[] invert(TPElement[] tpEls, int numThreads) throws KeyException {
+		TPElement[] results = new TPElement[tpEls.length];
+		for (int i = 0; i < tpEls.length; i++) {
+			results[i] = invert(tpEls[i]);
+		}
+		return results;
+	}
+	
 	/** 
 	 * Compute the hard core predicate of the given tpElement, by return the least significant bit of the element. 
 	 *
@@ -80,6 +80,10 @@ public final class CryptoPpRSAPermutation extends TrapdoorPermutationAbs impleme
 	private native long computeRSA(long tpr, long x);
 	//inverts RSA permutation
 	private native long invertRSA(long ptr, long y);
+	//computes RSA permutation on a batch of elements
+	private native long[] computeRSABatch(long ptr, long[] elements, int numThreads);
+	//inverts RSA permutation on a batch of elements
+	private native long[] invertRSABatch(long ptr, long[] elements, int numThreads);
 	
 	//deletes the native object
 	private native void deleteRSA(long ptr);
@@ -269,6 +273,79 @@ public final class CryptoPpRSAPermutation extends TrapdoorPermutationAbs impleme
 		return returnEl; // returns the result TPElement
 	}
 	
+	/**
+	 * Computes the RSA permutation on each one of the given elements in one native call.<p>
+	 * The batch is split between the given number of threads.
+	 * @param tpEls - the inputs for the computation
+	 * @param numThreads - the number of threads to use
+	 * @return - the result elements, in the order of the inputs
+	 * @throws - IllegalArgumentException if one of the given elements is not RSA element
+	 */
+	public TPElement[] compute(TPElement[] tpEls, int numThreads) throws IllegalArgumentException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//calls for the native function
+		long[] results = computeRSABatch(tpPtr, getPointers(tpEls), numThreads);
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * Inverts the RSA permutation on each one of the given elements in one native call.<p>
+	 * Each thread prepares the CRT computation once and blinds its elements with one random factor that is squared between the elements.
+	 * The result of the CRT is checked against the input and recomputed without the CRT if the check fails.
+	 * @param tpEls - the inputs to invert
+	 * @param numThreads - the number of threads to use
+	 * @return - the result elements, in the order of the inputs
+	 * @throws KeyException if the private key was not set
+	 * @throws IllegalStateException if the recomputed result of an element is also wrong
+	 * @throws - IllegalArgumentException if one of the given elements is not RSA element
+	 */
+	public TPElement[] invert(TPElement[] tpEls, int numThreads) throws IllegalArgumentException, KeyException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//If the key set was only the public key and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to invert a message, this object must be initialized with private key");
+		}
+		
+		//calls for the native function
+		long[] results = invertRSABatch(tpPtr, getPointers(tpEls), numThreads);
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * Returns the pointers to the native elements of the given CryptoPpRSAElements.
+	 */
+	private long[] getPointers(TPElement[] tpEls){
+		long[] pointers = new long[tpEls.length];
+		for (int i = 0; i < tpEls.length; i++) {
+			if (!(tpEls[i] instanceof CryptoPpRSAElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			pointers[i] = ((CryptoPpRSAElement)tpEls[i]).getPointerToElement();
+		}
+		return pointers;
+	}
+	
+	/**
+	 * Creates CryptoPpRSAElements that hold the given native results.
+	 */
+	private TPElement[] toElements(long[] results){
+		TPElement[] elements = new TPElement[results.length];
+		for (int i = 0; i < results.length; i++) {
+			elements[i] = new CryptoPpRSAElement(results[i]);
+		}
+		return elements;
+	}
+	
 	/** 
 	 * Checks if the given element is valid for this RSA permutation
 	 * @param tpEl - the element to check
@@ -86,6 +86,10 @@ public final class CryptoPpRabinPermutation extends TrapdoorPermutationAbs imple
 	private native long computeRabin(long tpr, long x);
 	//inverts Rabin permutation
 	private native long invertRabin(long ptr, long y);
+	//computes Rabin permutation on a batch of elements
+	private native long[] computeRabinBatch(long ptr, long[] elements, int numThreads);
+	//inverts Rabin permutation on a batch of elements
+	private native long[] invertRabinBatch(long ptr, long[] elements, int numThreads);
 
 	//deletes the native object
 	private native void deleteRabin(long ptr);
@@ -263,6 +267,77 @@ public final class CryptoPpRabinPermutation extends TrapdoorPermutationAbs imple
 	}
 
 	
+	/**
+	 * Computes the Rabin permutation on each one of the given elements in one native call.<p>
+	 * The batch is split between the given number of threads.
+	 * @param tpEls - the inputs for the computation
+	 * @param numThreads - the number of threads to use
+	 * @return - the result elements, in the order of the inputs
+	 * @throws - IllegalArgumentException if one of the given elements is not Rabin element
+	 */
+	public TPElement[] compute(TPElement[] tpEls, int numThreads) throws IllegalArgumentException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//calls for the native function
+		long[] results = computeRabinBatch(tpPtr, getPointers(tpEls), numThreads);
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * Inverts the Rabin permutation on each one of the given elements in one native call.<p>
+	 * The CRT coefficients are computed once for the whole batch, and each thread prepares the square root computation once.
+	 * @param tpEls - the inputs to invert
+	 * @param numThreads - the number of threads to use
+	 * @return - the result elements, in the order of the inputs
+	 * @throws KeyException if the private key was not set
+	 * @throws - IllegalArgumentException if one of the given elements is not Rabin element
+	 */
+	public TPElement[] invert(TPElement[] tpEls, int numThreads) throws IllegalArgumentException, KeyException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//If the key set was only the public key and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to invert a RabinElement, this object must be initialized with private key");
+		}
+		
+		//calls for the native function
+		long[] results = invertRabinBatch(tpPtr, getPointers(tpEls), numThreads);
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * Returns the pointers to the native elements of the given CryptoPpRabinElements.
+	 */
+	private long[] getPointers(TPElement[] tpEls){
+		long[] pointers = new long[tpEls.length];
+		for (int i = 0; i < tpEls.length; i++) {
+			if (!(tpEls[i] instanceof CryptoPpRabinElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			pointers[i] = ((CryptoPpRabinElement)tpEls[i]).getPointerToElement();
+		}
+		return pointers;
+	}
+	
+	/**
+	 * Creates CryptoPpRabinElements that hold the given native results.
+	 */
+	private TPElement[] toElements(long[] results){
+		TPElement[] elements = new TPElement[results.length];
+		for (int i = 0; i < results.length; i++) {
+			elements[i] = new CryptoPpRabinElement(results[i]);
+		}
+		return elements;
+	}
+	
 	/** 
 	 * Checks if the given element is valid for this Rabin permutation
 	 * @param tpEl - the element to check
@@ -75,6 +75,10 @@ public final class OpenSSLRSAPermutation extends TrapdoorPermutationAbs implemen
 	private native byte[] computeRSA(long tpr, byte[] x);
 	//Inverts RSA permutation.
 	private native byte[] invertRSA(long ptr, byte[] y);
+	//Computes RSA permutation on a batch of elements of RSA_size bytes each. Returns false if one of the elements is not smaller than the modulus.
+	private native boolean computeRSABatch(long ptr, byte[] elements, int numElements, byte[] results, int numThreads);
+	//Inverts RSA permutation on a batch of elements of RSA_size bytes each. Returns false if one of the elements is not smaller than the modulus.
+	private native boolean invertRSABatch(long ptr, byte[] elements, int numElements, byte[] results, int numThreads);
 	
 	//Deletes the native object.
 	private native void deleteRSA(long ptr);
@@ -274,6 +278,109 @@ public final class OpenSSLRSAPermutation extends TrapdoorPermutationAbs implemen
 		return returnEl; // return the result TPElement.
 	}
 	
+	/**
+	 * Computes the RSA permutation on each one of the given elements in one native call.<p>
+	 * The Montgomery context of the modulus is computed once for the whole batch, and the batch is split between the given number of threads.
+	 * @param tpEls - the inputs for the computation.
+	 * @param numThreads - the number of threads to use.
+	 * @return - the result elements, in the order of the inputs.
+	 * @throws - IllegalArgumentException if one of the given elements is not a RSA element or is not smaller than the modulus.
+	 */
+	public TPElement[] compute(TPElement[] tpEls, int numThreads) throws IllegalArgumentException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		if (tpEls.length == 0){
+			return new TPElement[0];
+		}
+		
+		byte[] elements = toBatch(tpEls);
+		byte[] results = new byte[elements.length];
+		
+		//Call the native function.
+		if (!computeRSABatch(rsa, elements, tpEls.length, results, numThreads)){
+			throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+		}
+		
+		return fromBatch(results, tpEls.length);
+	}
+	
+	/**
+	 * Inverts the RSA permutation on each one of the given elements in one native call.<p>
+	 * The Montgomery contexts and the CRT parameters are prepared once for the whole batch. Each thread blinds its elements 
+	 * with one blinding factor that is squared between the elements, instead of creating a new factor for each element.
+	 * @param tpEls - the inputs to invert.
+	 * @param numThreads - the number of threads to use.
+	 * @return - the result elements, in the order of the inputs.
+	 * @throws KeyException if private key was not set.
+	 * @throws IllegalArgumentException if one of the given elements is not a RSA element or is not smaller than the modulus.
+	 */
+	public TPElement[] invert(TPElement[] tpEls, int numThreads) throws IllegalArgumentException, KeyException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+
+		//If only the public key was set and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to decrypt a message, this object must be initialized with private key");
+		}
+		
+		if (tpEls.length == 0){
+			return new TPElement[0];
+		}
+		
+		byte[] elements = toBatch(tpEls);
+		byte[] results = new byte[elements.length];
+		
+		//Call the native function.
+		if (!invertRSABatch(rsa, elements, tpEls.length, results, numThreads)){
+			throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+		}
+		
+		return fromBatch(results, tpEls.length);
+	}
+	
+	/**
+	 * Packs the given elements to one array, each element as a big endian number of the size of the modulus.
+	 */
+	private byte[] toBatch(TPElement[] tpEls){
+		int size = (modulus.bitLength() + 7) / 8;
+		byte[] elements = new byte[tpEls.length * size];
+		
+		for (int i = 0; i < tpEls.length; i++) {
+			if (!(tpEls[i] instanceof RSAElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			// In java, BigInteger can have 0 in the first byte in order the BigInteger to be positive. 
+			// The number is copied aligned to the end of its place, so that the first zero is ignored and short numbers are padded.
+			byte[] bytes = ((RSAElement)tpEls[i]).getElement().toByteArray();
+			if (bytes.length > size + 1 || (bytes.length == size + 1 && bytes[0] != 0)){
+				throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+			}
+			int length = Math.min(bytes.length, size);
+			System.arraycopy(bytes, bytes.length - length, elements, (i + 1) * size - length, length);
+		}
+		return elements;
+	}
+	
+	/**
+	 * Creates a RSAElement from each one of the numbers in the given array.
+	 */
+	private TPElement[] fromBatch(byte[] results, int numElements){
+		int size = results.length / numElements;
+		TPElement[] elements = new TPElement[numElements];
+		byte[] element = new byte[size];
+		
+		for (int i = 0; i < numElements; i++) {
+			System.arraycopy(results, i * size, element, 0, size);
+			elements[i] = new RSAElement(modulus, new BigInteger(1, element), false);
+		}
+		return elements;
+	}
+	
 	/** 
 	 * Checks if the given element is valid in this RSA permutation.
 	 * @param tpEl - the element to check.
@@ -0,0 +1,232 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.universalHash;
+
+import java.security.InvalidKeyException;
+import java.security.InvalidParameterException;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.security.spec.AlgorithmParameterSpec;
+import java.security.spec.InvalidParameterSpecException;
+import java.util.Arrays;
+
+import javax.crypto.IllegalBlockSizeException;
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import edu.biu.scapi.exceptions.FactoriesException;
+import edu.biu.scapi.paddings.BitPadding;
+import edu.biu.scapi.paddings.NoPadding;
+import edu.biu.scapi.paddings.PaddingScheme;
+import edu.biu.scapi.tools.Factories.PaddingFactory;
+
+/** 
+ * Concrete class of perfect universal hash for evaluation hash function, implemented natively with the carry-less multiplication instruction (PCLMULQDQ).<p>
+ * The outputs are identical to those of {@link EvaluationHashFunction} with the same key and padding scheme, but the field operations are done 
+ * on 64 bit words instead of NTL field elements, and the input is hashed in place: only its last unaligned bytes are copied in order to pad them.
+ * Unlike the NTL implementation, every instance has its own state, so different instances can be used by different threads concurrently.
+ * The processor must support the PCLMULQDQ instruction.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public final class ClmulEvaluationHashFunction implements UniversalHash{
+	private SecureRandom random;
+	protected SecretKey secretKey = null;
+	protected boolean isKeySet = false;
+	
+	protected long evalHashPtr; // pointer to the native evaluation object
+	private PaddingScheme padding;
+	
+	//native functions. These functions are implemented in the NTLJavaInterface dll using the JNI
+	
+	//creates the native object and initializes it with the first 8 bytes of the secret key
+	private native long initHash(byte[] key);
+	//computes the evaluation hash function of in[inOffset, inOffset+inLen) followed by the padded tail. inLen is aligned to 8 bytes.
+	private native void computeFunction(long evalHashPtr, byte[] in, int inOffset, int inLen, byte[] tail, byte[] out, int outOffset);
+	//deletes the native object
+	private native void deleteHash(long evalHashPtr);
+	
+	/**
+	 * Default constructor. uses Bit padding.
+	 */
+	public ClmulEvaluationHashFunction(){
+		this(new BitPadding(), new SecureRandom());
+	}
+	
+	/**
+	 * Constructor that receives the names of the required padding scheme and randomness algorithm.
+	 * @param paddingName - name of padding scheme to use.
+	 * @param randNumGenAlg name of random algorithm to use.
+	 * @throws FactoriesException
+	 * @throws NoSuchAlgorithmException 
+	 */
+	public ClmulEvaluationHashFunction(String paddingName, String randNumGenAlg) throws FactoriesException, NoSuchAlgorithmException{
+		//creates padding scheme and random, then call the other constructor
+		this(PaddingFactory.getInstance().getObject(paddingName), SecureRandom.getInstance(randNumGenAlg));
+	}
+	
+	/**
+	 * Constructor that receives the padding scheme and random to use.
+	 * @param padding
+	 * @param random
+	 */
+	public ClmulEvaluationHashFunction(PaddingScheme padding, SecureRandom random){
+		this.padding = padding;
+		this.random = random;
+	}
+	
+	/**
+	 * Sets the secret key. The first 8 bytes of the key are the field element the input polynomial is evaluated on.
+	 * @throws InvalidKeyException if the key is shorter than 8 bytes.
+	 */
+	public void setKey(SecretKey secretKey) throws InvalidKeyException {
+		byte[] key = secretKey.getEncoded();
+		if (key.length < 8){
+			throw new InvalidKeyException("the key should be at least 64 bits long");
+		}
+		
+		//replaces the native object of the previous key, if there is one.
+		if (isKeySet){
+			deleteHash(evalHashPtr);
+		}
+		evalHashPtr = initHash(key);
+		
+		//sets the key
+		this.secretKey = secretKey;
+		
+		isKeySet = true; //marks this object as initialized
+	}
+	
+	public boolean isKeySet() {
+		return isKeySet; 
+	}
+	
+	/**
+	 * Evaluation hash function can get any input size which is between 0 to 64t bits. while t = 2^24.
+	 * @return the upper bound of the input size - 64t
+	 */
+	public int getInputSize() {
+		//limit = 8t, which is 64t bits in bytes, minus maximum 8 bytes of padding
+		return (1 << 24) * 8 - 8;
+	}
+
+	/** 
+	 * @return the output size of evaluation hash function - 8 bytes.
+	 */
+	public int getOutputSize() {
+		//64 bits long
+		return 8;
+	}
+
+	/**
+	 * @return the algorithm name - Evaluation Hash Function
+	 */
+	public String getAlgorithmName() {
+		return "Evaluation Hash Function";
+	}
+
+	/**
+	 * Generates a secret key to initialize this UH object.
+	 * @param keyParams algorithmParameterSpec contains the required secret key size in bits 
+	 * @return the generated secret key
+	 * @throws InvalidParameterSpecException 
+	 */
+	public SecretKey generateKey(AlgorithmParameterSpec keyParams) throws InvalidParameterSpecException{
+		throw new UnsupportedOperationException("To generate a key for this univarsal hash object use the generateKey(int keySize) function");
+	}
+	
+	/**
+	 * Generates a secret key to initialize this UH object.
+	 * @param keySize is the required secret key size in bits (it has to be greater than 0 a multiple of 8) 
+	 * @return the generated secret key 
+	 */
+	public SecretKey generateKey(int keySize){
+		//if the key size is zero or less - throw exception
+		if (keySize <= 0){
+			throw new NegativeArraySizeException("Key size must be greater than 0");
+		}
+		//the key size has to be a multiple of 8 so that we can obtain an array of random bytes which we use
+		//to create the SecretKey.
+		if ((keySize % 8) != 0)  {
+			throw new InvalidParameterException("Wrong key size: must be a multiple of 8");
+		}
+		//generates the bytes using the random and creates a secretKey from them
+		byte[] genBytes = new byte[keySize/8];
+		random.nextBytes(genBytes);
+		return new SecretKeySpec(genBytes, "");
+	}
+	
+	public void compute(byte[] in, int inOffset, int inLen, byte[] out,
+			int outOffset) throws IllegalBlockSizeException {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		//checks that the offset and length are correct
+		if ((inOffset > in.length) || (inOffset+inLen> in.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOffset > out.length) || (outOffset+getOutputSize() > out.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//checks that the input length is not greater than the upper limit
+		if(inLen > getInputSize()){
+			throw new IllegalBlockSizeException("input length must be less than 64*(2^24-1) bits long");
+		}
+		
+		//The padding schemes only append bytes to their input, so instead of padding a copy of the whole input 
+		//only the unaligned end of the input is padded. The aligned part is hashed directly from the given array.
+		int alignedLen = inLen - (inLen % 8);
+		byte[] unaligned = Arrays.copyOfRange(in, inOffset + alignedLen, inOffset + inLen);
+		byte[] tail;
+		if ((inLen%8) == 0){
+			//the input is aligned to 64 bits so pads it as aligned array
+			tail = padding.pad(unaligned, 8);
+		} else {
+			if (padding instanceof NoPadding){
+				throw new IllegalArgumentException("input is not aligned to blockSize");
+			}
+			//the input is not aligned to 64 bits so pads it to aligned array
+			tail = padding.pad(unaligned, 8 - (inLen % 8));
+		}
+		
+		computeFunction(evalHashPtr, in, inOffset, alignedLen, tail, out, outOffset);
+	}
+	
+	/**
+	 * Deletes the native object.
+	 */
+	protected void finalize() throws Throwable {
+		if (isKeySet){
+			deleteHash(evalHashPtr);
+		}
+		super.finalize();
+	}
+	
+	static {
+		 //load the NTL jni dll
+		 System.loadLibrary("NTLJavaInterface");
+	}
+}
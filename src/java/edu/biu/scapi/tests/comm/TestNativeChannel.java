@@ -0,0 +1,102 @@
+package edu.biu.scapi.tests.comm;
+
+import static org.junit.Assert.*;
+
+import java.net.InetAddress;
+import java.nio.ByteBuffer;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import org.junit.Test;
+
+import edu.biu.scapi.comm.twoPartyComm.NativeChannel;
+import edu.biu.scapi.comm.twoPartyComm.NativeSocketCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+
+/**
+ * Checks the framing of the messages that NativeChannel gathers in sendMany.
+ */
+public class TestNativeChannel {
+
+	/**
+	 * Connects two native channels to each other over loopback, each one from its own thread.
+	 */
+	private static NativeChannel[] connect(int port) throws Exception{
+		InetAddress ip = InetAddress.getByName("127.0.0.1");
+		final SocketPartyData party0 = new SocketPartyData(ip, port);
+		final SocketPartyData party1 = new SocketPartyData(ip, port + 1);
+
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<NativeChannel> other = executor.submit(new Callable<NativeChannel>() {
+			public NativeChannel call() throws Exception {
+				return (NativeChannel) new NativeSocketCommunicationSetup(party1, party0).prepareForCommunication(1, 200000).values().iterator().next();
+			}
+		});
+		NativeChannel channel = (NativeChannel) new NativeSocketCommunicationSetup(party0, party1).prepareForCommunication(1, 200000).values().iterator().next();
+		NativeChannel[] channels = {channel, other.get()};
+		executor.shutdown();
+		return channels;
+	}
+
+	/**
+	 * Returns a message of the given size whose bytes depend on the given index.
+	 */
+	private static byte[] message(int size, int index){
+		byte[] msg = new byte[size];
+		for (int i = 0; i < size; i++) {
+			msg[i] = (byte) (i * 31 + index);
+		}
+		return msg;
+	}
+
+	@Test
+	public void testSendMany() throws Exception{
+		final NativeChannel[] channels = connect(25051);
+
+		//Small messages that are gathered, around one that is larger than the gathering buffer (64 KB) and is sent on its own.
+		final byte[][] messages = {message(10, 0), message(0, 1), message(1000, 2), message(200000, 3), message(5, 4), message(65536, 5), message(20, 6)};
+
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<?> sender = executor.submit(new Callable<Void>() {
+			public Void call() throws Exception {
+				//A batch with a null message is rejected before anything is sent, so it does not break the framing of the next batch.
+				try {
+					channels[0].sendMany(new byte[][]{message(10, 0), null});
+					fail("sendMany should fail on a null message");
+				} catch (NullPointerException e) {
+				}
+				channels[0].sendMany(messages);
+				channels[0].sendMany(messages);
+				return null;
+			}
+		});
+
+		for (int i = 0; i < messages.length; i++) {
+			assertArrayEquals("message " + i, messages[i], channels[1].receiveBytes());
+		}
+
+		//The second batch is received into a direct buffer, that is too small for the large message.
+		ByteBuffer buffer = ByteBuffer.allocateDirect(100000);
+		for (int i = 0; i < messages.length; i++) {
+			buffer.clear();
+			int size = channels[1].receive(buffer);
+			if (messages[i].length > buffer.capacity()) {
+				assertEquals(-messages[i].length, size);
+				assertArrayEquals("message " + i, messages[i], channels[1].receiveBytes());
+			} else {
+				assertEquals(messages[i].length, size);
+				byte[] received = new byte[size];
+				buffer.flip();
+				buffer.get(received);
+				assertArrayEquals("message " + i, messages[i], received);
+			}
+		}
+
+		sender.get();
+		executor.shutdown();
+		channels[0].close();
+		channels[1].close();
+	}
+}
@@ -0,0 +1,145 @@
+package edu.biu.scapi.tests.comm;
+
+import static org.junit.Assert.*;
+
+import java.io.Serializable;
+import java.net.InetAddress;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import org.junit.Test;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.twoPartyComm.PlainTCPSocketChannel;
+import edu.biu.scapi.comm.twoPartyComm.SocketCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+
+/**
+ * Checks the framing of PlainTCPSocketChannel over loopback, and measures its latency and throughput for byte arrays 
+ * (written as is) and for other objects (serialized) (see main).
+ */
+public class TestPlainTCPSocketChannel {
+
+	/**
+	 * Connects two channels to each other over loopback, each one from its own thread.
+	 */
+	private static Channel[] connect(int port) throws Exception{
+		InetAddress ip = InetAddress.getByName("127.0.0.1");
+		final SocketPartyData party0 = new SocketPartyData(ip, port);
+		final SocketPartyData party1 = new SocketPartyData(ip, port + 1);
+		
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<Channel> other = executor.submit(new Callable<Channel>() {
+			public Channel call() throws Exception {
+				return new SocketCommunicationSetup(party1, party0).prepareForCommunication(1, 200000).values().iterator().next();
+			}
+		});
+		Channel channel = new SocketCommunicationSetup(party0, party1).prepareForCommunication(1, 200000).values().iterator().next();
+		Channel[] channels = {channel, other.get()};
+		executor.shutdown();
+		return channels;
+	}
+	
+	@Test
+	public void testMessageTypes() throws Exception{
+		Channel[] channels = connect(25011);
+		byte[] data = new byte[100000];
+		for (int i = 0; i < data.length; i++) {
+			data[i] = (byte) i;
+		}
+		
+		channels[0].send(data);
+		channels[0].send("a string message");
+		channels[0].send(new byte[0]);
+		channels[0].send(new PlainTCPSocketChannel.Message(data));
+		
+		assertArrayEquals(data, (byte[]) channels[1].receive());
+		assertEquals("a string message", channels[1].receive());
+		assertEquals(0, ((byte[]) channels[1].receive()).length);
+		assertArrayEquals(data, ((PlainTCPSocketChannel.Message) channels[1].receive()).getData());
+		
+		channels[0].close();
+		channels[1].close();
+	}
+	
+	/**
+	 * Returns the average time in microseconds of a round trip of the given message.
+	 */
+	private static double latency(final Channel[] channels, final Serializable msg, final int rounds) throws Exception{
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<?> echo = executor.submit(new Callable<Void>() {
+			public Void call() throws Exception {
+				for (int i = 0; i < rounds; i++) {
+					channels[1].send(channels[1].receive());
+				}
+				return null;
+			}
+		});
+		long start = System.nanoTime();
+		for (int i = 0; i < rounds; i++) {
+			channels[0].send(msg);
+			channels[0].receive();
+		}
+		long time = System.nanoTime() - start;
+		echo.get();
+		executor.shutdown();
+		return time / 1000.0 / rounds;
+	}
+	
+	/**
+	 * Returns the throughput in MB per second of sending the given message the given number of times in one direction.
+	 */
+	private static double throughput(final Channel[] channels, final Serializable msg, final int count, int size) throws Exception{
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<?> receiver = executor.submit(new Callable<Void>() {
+			public Void call() throws Exception {
+				for (int i = 0; i < count; i++) {
+					channels[1].receive();
+				}
+				channels[1].send(new byte[0]);
+				return null;
+			}
+		});
+		long start = System.nanoTime();
+		for (int i = 0; i < count; i++) {
+			channels[0].send(msg);
+		}
+		channels[0].receive();
+		long time = System.nanoTime() - start;
+		receiver.get();
+		executor.shutdown();
+		return ((double) count * size / (1024 * 1024)) / (time / 1e9);
+	}
+	
+	/**
+	 * Prints the latency and throughput of the channel for byte arrays and for serialized objects of the same sizes.
+	 */
+	public static void main(String[] args) throws Exception{
+		Channel[] channels = connect(25021);
+		int[] latencySizes = {16, 1024};
+		int[] throughputSizes = {16 * 1024, 1024 * 1024};
+		
+		for (int size : latencySizes) {
+			byte[] data = new byte[size];
+			//Warm up.
+			latency(channels, data, 2000);
+			latency(channels, new PlainTCPSocketChannel.Message(data), 2000);
+			System.out.printf("round trip of %d bytes: byte[] %.1f us, serialized object %.1f us%n", size, 
+					latency(channels, data, 10000), latency(channels, new PlainTCPSocketChannel.Message(data), 10000));
+		}
+		
+		for (int size : throughputSizes) {
+			byte[] data = new byte[size];
+			int count = (int) (512L * 1024 * 1024 / size);
+			throughput(channels, data, count / 4, size);
+			throughput(channels, new PlainTCPSocketChannel.Message(data), count / 4, size);
+			System.out.printf("throughput of %d byte messages: byte[] %.0f MB/s, serialized object %.0f MB/s%n", size, 
+					throughput(channels, data, count, size), throughput(channels, new PlainTCPSocketChannel.Message(data), count, size));
+		}
+		
+		channels[0].close();
+		channels[1].close();
+	}
+}
@@ -0,0 +1,273 @@
+package edu.biu.scapi.tests.comm;
+
+import static org.junit.Assert.*;
+
+import java.io.Serializable;
+import java.net.InetAddress;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import org.junit.Test;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.multiPartyComm.SelectorMultipartyChannel;
+import edu.biu.scapi.comm.multiPartyComm.SocketMultipartyCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.PartyData;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+
+/**
+ * Checks the broadcast and gather of SelectorMultipartyChannel between local parties, and compares its round latency to
+ * SocketMultipartyCommunicationSetup for 3 to 16 parties (see main).
+ */
+public class TestSelectorMultipartyChannel {
+
+	/**
+	 * Returns the list of parties as seen by the given party, which is first in the list.
+	 */
+	private static List<PartyData> parties(int port, int numOfParties, int me) throws Exception{
+		InetAddress ip = InetAddress.getByName("127.0.0.1");
+		List<PartyData> parties = new ArrayList<PartyData>();
+		parties.add(new SocketPartyData(ip, port + me));
+		for (int i = 0; i < numOfParties; i++) {
+			if (i != me) {
+				parties.add(new SocketPartyData(ip, port + i));
+			}
+		}
+		return parties;
+	}
+
+	/**
+	 * Connects the given number of local parties to each other, each one from its own thread.
+	 */
+	private static SelectorMultipartyChannel[] connect(final int port, final int numOfParties) throws Exception{
+		ExecutorService executor = Executors.newFixedThreadPool(numOfParties);
+		List<Future<SelectorMultipartyChannel>> futures = new ArrayList<Future<SelectorMultipartyChannel>>();
+		for (int i = 0; i < numOfParties; i++) {
+			final int me = i;
+			futures.add(executor.submit(new Callable<SelectorMultipartyChannel>() {
+				public SelectorMultipartyChannel call() throws Exception {
+					SelectorMultipartyChannel channel = new SelectorMultipartyChannel(parties(port, numOfParties, me));
+					channel.connect(200000);
+					return channel;
+				}
+			}));
+		}
+		SelectorMultipartyChannel[] channels = new SelectorMultipartyChannel[numOfParties];
+		for (int i = 0; i < numOfParties; i++) {
+			channels[i] = futures.get(i).get();
+		}
+		executor.shutdown();
+		return channels;
+	}
+
+	/**
+	 * Returns the party that is in the given index of the list of the given party.
+	 */
+	private static int partyAt(int me, int index){
+		return (index <= me) ? index - 1 : index;
+	}
+
+	@Test
+	public void testBroadcastAndGather() throws Exception{
+		final int numOfParties = 4;
+		final SelectorMultipartyChannel[] channels = connect(25101, numOfParties);
+		ExecutorService executor = Executors.newFixedThreadPool(numOfParties);
+		List<Future<Void>> futures = new ArrayList<Future<Void>>();
+		for (int i = 0; i < numOfParties; i++) {
+			final int me = i;
+			futures.add(executor.submit(new Callable<Void>() {
+				public Void call() throws Exception {
+					//A large message that does not fit in the socket buffers, a serialized object and an empty message.
+					byte[] data = new byte[4 * 1024 * 1024];
+					data[0] = (byte) me;
+					channels[me].broadcast(data);
+					channels[me].broadcast("party " + me);
+					for (int j = 1; j < numOfParties; j++) {
+						channels[me].getChannel(j).send(new byte[0]);
+					}
+
+					Serializable[] messages = channels[me].gather();
+					Serializable[] strings = channels[me].gather();
+					for (int j = 1; j < numOfParties; j++) {
+						int party = partyAt(me, j);
+						assertEquals(data.length, ((byte[]) messages[j]).length);
+						assertEquals(party, ((byte[]) messages[j])[0]);
+						assertEquals("party " + party, strings[j]);
+					}
+					for (int j = 1; j < numOfParties; j++) {
+						assertEquals(0, ((byte[]) channels[me].getChannel(j).receive()).length);
+					}
+					return null;
+				}
+			}));
+		}
+		for (Future<Void> future : futures) {
+			future.get();
+		}
+		executor.shutdown();
+		for (SelectorMultipartyChannel channel : channels) {
+			channel.close();
+		}
+	}
+
+	@Test
+	public void testReuseOfSentArray() throws Exception{
+		SelectorMultipartyChannel[] channels = connect(25111, 2);
+
+		//The messages do not fit in the socket buffers, so their rest is still queued when send returns.
+		byte[] data = new byte[4 * 1024 * 1024];
+		Arrays.fill(data, (byte) 1);
+		channels[0].send(1, data);
+		Arrays.fill(data, (byte) 2);
+		channels[0].broadcast(data);
+		Arrays.fill(data, (byte) 3);
+
+		for (int i = 1; i <= 2; i++) {
+			byte[] received = (byte[]) channels[1].receive(1);
+			assertEquals(data.length, received.length);
+			for (int j = 0; j < received.length; j++) {
+				if (received[j] != i) {
+					fail("byte " + j + " of message " + i + " was changed after it was sent");
+				}
+			}
+		}
+
+		for (SelectorMultipartyChannel channel : channels) {
+			channel.close();
+		}
+	}
+
+	/**
+	 * Returns the average time in microseconds of a round where each party sends a message to all the others and receives their messages,
+	 * using SelectorMultipartyChannel.
+	 */
+	private static double selectorRound(final SelectorMultipartyChannel[] channels, final int size, final int rounds) throws Exception{
+		ExecutorService executor = Executors.newFixedThreadPool(channels.length);
+		List<Future<Long>> futures = new ArrayList<Future<Long>>();
+		for (int i = 0; i < channels.length; i++) {
+			final SelectorMultipartyChannel channel = channels[i];
+			futures.add(executor.submit(new Callable<Long>() {
+				public Long call() throws Exception {
+					byte[] data = new byte[size];
+					long start = System.nanoTime();
+					for (int r = 0; r < rounds; r++) {
+						channel.broadcast(data);
+						channel.gather();
+					}
+					return System.nanoTime() - start;
+				}
+			}));
+		}
+		long time = futures.get(0).get();
+		for (Future<Long> future : futures) {
+			future.get();
+		}
+		executor.shutdown();
+		return time / 1000.0 / rounds;
+	}
+
+	/**
+	 * Returns the average time in microseconds of the same round using SocketMultipartyCommunicationSetup, where each party sends
+	 * to all the others one after the other and then receives from all of them.
+	 */
+	private static double blockingRound(final Channel[][] channels, final int size, final int rounds) throws Exception{
+		ExecutorService executor = Executors.newFixedThreadPool(channels.length);
+		List<Future<Long>> futures = new ArrayList<Future<Long>>();
+		for (int i = 0; i < channels.length; i++) {
+			final Channel[] partyChannels = channels[i];
+			futures.add(executor.submit(new Callable<Long>() {
+				public Long call() throws Exception {
+					byte[] data = new byte[size];
+					long start = System.nanoTime();
+					for (int r = 0; r < rounds; r++) {
+						for (Channel channel : partyChannels) {
+							channel.send(data);
+						}
+						for (Channel channel : partyChannels) {
+							channel.receive();
+						}
+					}
+					return System.nanoTime() - start;
+				}
+			}));
+		}
+		long time = futures.get(0).get();
+		for (Future<Long> future : futures) {
+			future.get();
+		}
+		executor.shutdown();
+		return time / 1000.0 / rounds;
+	}
+
+	/**
+	 * Connects the given number of local parties using SocketMultipartyCommunicationSetup.
+	 */
+	private static Channel[][] connectBlocking(final int port, final int numOfParties) throws Exception{
+		ExecutorService executor = Executors.newFixedThreadPool(numOfParties);
+		List<Future<Channel[]>> futures = new ArrayList<Future<Channel[]>>();
+		for (int i = 0; i < numOfParties; i++) {
+			final int me = i;
+			futures.add(executor.submit(new Callable<Channel[]>() {
+				public Channel[] call() throws Exception {
+					List<PartyData> parties = parties(port, numOfParties, me);
+					Map<PartyData, Object> connections = new HashMap<PartyData, Object>();
+					for (int j = 1; j < parties.size(); j++) {
+						connections.put(parties.get(j), 1);
+					}
+					Map<PartyData, Map<String, Channel>> created = new SocketMultipartyCommunicationSetup(parties).prepareForCommunication(connections, 200000);
+					Channel[] channels = new Channel[parties.size() - 1];
+					for (int j = 1; j < parties.size(); j++) {
+						channels[j - 1] = created.get(parties.get(j)).values().iterator().next();
+					}
+					return channels;
+				}
+			}));
+		}
+		Channel[][] channels = new Channel[numOfParties][];
+		for (int i = 0; i < numOfParties; i++) {
+			channels[i] = futures.get(i).get();
+		}
+		executor.shutdown();
+		return channels;
+	}
+
+	/**
+	 * Prints the round latency of both implementations for 3 to 16 local parties.
+	 */
+	public static void main(String[] args) throws Exception{
+		int[] numsOfParties = {3, 4, 8, 16};
+		int[] sizes = {64, 16 * 1024};
+		int port = 25200;
+
+		for (int numOfParties : numsOfParties) {
+			SelectorMultipartyChannel[] selectorChannels = connect(port, numOfParties);
+			port += numOfParties;
+			Channel[][] blockingChannels = connectBlocking(port, numOfParties);
+			port += numOfParties;
+
+			for (int size : sizes) {
+				//Warm up.
+				selectorRound(selectorChannels, size, 500);
+				blockingRound(blockingChannels, size, 500);
+				System.out.printf("%d parties, %d byte messages: selector %.1f us per round, blocking sockets %.1f us per round%n", numOfParties, size,
+						selectorRound(selectorChannels, size, 2000), blockingRound(blockingChannels, size, 2000));
+			}
+
+			for (SelectorMultipartyChannel channel : selectorChannels) {
+				channel.close();
+			}
+			for (Channel[] partyChannels : blockingChannels) {
+				for (Channel channel : partyChannels) {
+					channel.close();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,152 @@
+package edu.biu.scapi.tests.comm;
+
+import static org.junit.Assert.*;
+
+import java.io.IOException;
+import java.net.InetAddress;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import org.junit.Test;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.twoPartyComm.SharedMemoryCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.SocketCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+import edu.biu.scapi.comm.twoPartyComm.TwoPartyCommunicationSetup;
+
+/**
+ * Checks the framing of SharedMemoryChannel, and compares its throughput for multi gigabyte transfers to PlainTCPSocketChannel
+ * over loopback (see main).
+ */
+public class TestSharedMemoryChannel {
+
+	/**
+	 * Connects two shared memory channels to each other, each one from its own thread.
+	 */
+	private static Channel[] connect(int port, final long capacity) throws Exception{
+		InetAddress ip = InetAddress.getByName("127.0.0.1");
+		final SocketPartyData party0 = new SocketPartyData(ip, port);
+		final SocketPartyData party1 = new SocketPartyData(ip, port + 1);
+
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<Channel> other = executor.submit(new Callable<Channel>() {
+			public Channel call() throws Exception {
+				return new SharedMemoryCommunicationSetup(party1, party0, capacity).prepareForCommunication(1, 200000).values().iterator().next();
+			}
+		});
+		Channel channel = new SharedMemoryCommunicationSetup(party0, party1, capacity).prepareForCommunication(1, 200000).values().iterator().next();
+		Channel[] channels = {channel, other.get()};
+		executor.shutdown();
+		return channels;
+	}
+
+	/**
+	 * Connects two tcp channels to each other over loopback, each one from its own thread.
+	 */
+	private static Channel[] connectTcp(int port) throws Exception{
+		InetAddress ip = InetAddress.getByName("127.0.0.1");
+		final SocketPartyData party0 = new SocketPartyData(ip, port);
+		final SocketPartyData party1 = new SocketPartyData(ip, port + 1);
+
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<Channel> other = executor.submit(new Callable<Channel>() {
+			public Channel call() throws Exception {
+				return new SocketCommunicationSetup(party1, party0).prepareForCommunication(1, 200000).values().iterator().next();
+			}
+		});
+		TwoPartyCommunicationSetup setup = new SocketCommunicationSetup(party0, party1);
+		Channel[] channels = {setup.prepareForCommunication(1, 200000).values().iterator().next(), other.get()};
+		executor.shutdown();
+		return channels;
+	}
+
+	@Test
+	public void testMessageTypes() throws Exception{
+		//A small ring, so that the large message wraps around it many times.
+		final Channel[] channels = connect(25031, 64 * 1024);
+		final byte[] data = new byte[1000000];
+		for (int i = 0; i < data.length; i++) {
+			data[i] = (byte) i;
+		}
+
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<?> sender = executor.submit(new Callable<Void>() {
+			public Void call() throws Exception {
+				channels[0].send(data);
+				channels[0].send("a string message");
+				channels[0].send(new byte[0]);
+				return null;
+			}
+		});
+
+		assertArrayEquals(data, (byte[]) channels[1].receive());
+		assertEquals("a string message", channels[1].receive());
+		assertEquals(0, ((byte[]) channels[1].receive()).length);
+		sender.get();
+		executor.shutdown();
+
+		//A party that waits for a message is woken when the channel is closed.
+		channels[0].close();
+		try {
+			channels[1].receive();
+			fail("receive should fail after the channel was closed");
+		} catch (IOException e) {
+		}
+		channels[1].close();
+		assertTrue(channels[0].isClosed());
+	}
+
+	/**
+	 * Returns the throughput in MB per second of sending the given number of bytes in messages of the given size in one direction.
+	 */
+	private static double throughput(final Channel[] channels, long total, int size) throws Exception{
+		final int count = (int) (total / size);
+		final byte[] data = new byte[size];
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		Future<?> receiver = executor.submit(new Callable<Void>() {
+			public Void call() throws Exception {
+				for (int i = 0; i < count; i++) {
+					channels[1].receive();
+				}
+				channels[1].send(new byte[0]);
+				return null;
+			}
+		});
+		long start = System.nanoTime();
+		for (int i = 0; i < count; i++) {
+			channels[0].send(data);
+		}
+		channels[0].receive();
+		long time = System.nanoTime() - start;
+		receiver.get();
+		executor.shutdown();
+		return ((double) count * size / (1024 * 1024)) / (time / 1e9);
+	}
+
+	/**
+	 * Prints the throughput of the shared memory channel and of the tcp channel for a 4 GB transfer, which is the size of the
+	 * garbled tables of a large circuit.
+	 */
+	public static void main(String[] args) throws Exception{
+		Channel[] shared = connect(25041, 32 * 1024 * 1024);
+		Channel[] tcp = connectTcp(25043);
+		int[] sizes = {64 * 1024, 1024 * 1024, 64 * 1024 * 1024};
+		long total = 4L * 1024 * 1024 * 1024;
+
+		for (int size : sizes) {
+			//Warm up.
+			throughput(shared, total / 8, size);
+			throughput(tcp, total / 8, size);
+			System.out.printf("throughput of 4 GB in %d byte messages: shared memory %.0f MB/s, tcp %.0f MB/s%n", size,
+					throughput(shared, total, size), throughput(tcp, total, size));
+		}
+
+		shared[0].close();
+		shared[1].close();
+		tcp[0].close();
+		tcp[1].close();
+	}
+}
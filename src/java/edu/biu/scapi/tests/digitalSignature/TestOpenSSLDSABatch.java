@@ -0,0 +1,127 @@
+package edu.biu.scapi.tests.digitalSignature;
+
+import static org.junit.Assert.*;
+
+import java.security.KeyPair;
+import java.security.SecureRandom;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.midLayer.asymmetricCrypto.digitalSignature.OpenSSLDSA;
+import edu.biu.scapi.midLayer.signature.OpenSSLDSASignature;
+import edu.biu.scapi.midLayer.signature.Signature;
+
+/**
+ * Checks the batch signing and verification of OpenSSLDSA against the single message functions, 
+ * and measures the time of both (see main).
+ */
+public class TestOpenSSLDSABatch {
+
+	private static final int NUM_MESSAGES = 50;
+	
+	private OpenSSLDSA dsa;
+	private byte[][] msgs;
+	
+	private static byte[][] randomMessages(int num){
+		SecureRandom random = new SecureRandom();
+		byte[][] msgs = new byte[num][];
+		for (int i = 0; i < num; i++) {
+			msgs[i] = new byte[20 + i % 20];
+			random.nextBytes(msgs[i]);
+		}
+		return msgs;
+	}
+	
+	@Before
+	public void setUp() throws Exception{
+		dsa = new OpenSSLDSA();
+		KeyPair pair = dsa.generateKey();
+		dsa.setKey(pair.getPublic(), pair.getPrivate());
+		msgs = randomMessages(NUM_MESSAGES);
+	}
+	
+	@Test
+	public void testPrecomputedSignatures() throws Exception{
+		dsa.precomputeSignatures(NUM_MESSAGES / 2);
+		assertEquals(NUM_MESSAGES / 2, dsa.getNumOfPrecomputedSignatures());
+		
+		//Half of the signatures use the precomputed nonces and half compute their own.
+		Signature[] signatures = dsa.sign(msgs);
+		assertEquals(0, dsa.getNumOfPrecomputedSignatures());
+		for (int i = 0; i < NUM_MESSAGES; i++) {
+			assertTrue(dsa.verify(signatures[i], msgs[i], 0, msgs[i].length));
+		}
+		
+		dsa.precomputeSignatures(1);
+		Signature signature = dsa.sign(msgs[0], 0, msgs[0].length);
+		assertEquals(0, dsa.getNumOfPrecomputedSignatures());
+		assertTrue(dsa.verify(signature, msgs[0], 0, msgs[0].length));
+	}
+	
+	@Test
+	public void testBatchVerify() throws Exception{
+		Signature[] signatures = new Signature[NUM_MESSAGES];
+		for (int i = 0; i < NUM_MESSAGES; i++) {
+			signatures[i] = dsa.sign(msgs[i], 0, msgs[i].length);
+		}
+		
+		boolean[] results = dsa.verify(signatures, msgs);
+		for (int i = 0; i < NUM_MESSAGES; i++) {
+			assertTrue(results[i]);
+		}
+		assertTrue(dsa.verifyAll(signatures, msgs));
+		
+		//Change one message and one signature.
+		msgs[3][0] ^= 1;
+		byte[] corrupted = ((OpenSSLDSASignature) signatures[10]).getSignature().clone();
+		corrupted[corrupted.length - 1] ^= 1;
+		signatures[10] = new OpenSSLDSASignature(corrupted);
+		
+		results = dsa.verify(signatures, msgs);
+		for (int i = 0; i < NUM_MESSAGES; i++) {
+			assertEquals(dsa.verify(signatures[i], msgs[i], 0, msgs[i].length), results[i]);
+			assertEquals(i != 3 && i != 10, results[i]);
+		}
+		assertFalse(dsa.verifyAll(signatures, msgs));
+	}
+	
+	/**
+	 * Prints the time of signing and verifying a batch of messages one by one and in one call.
+	 */
+	public static void main(String[] args) throws Exception{
+		int num = 2000;
+		OpenSSLDSA dsa = new OpenSSLDSA();
+		KeyPair pair = dsa.generateKey();
+		dsa.setKey(pair.getPublic(), pair.getPrivate());
+		byte[][] msgs = randomMessages(num);
+		Signature[] signatures = new Signature[num];
+		
+		long start = System.nanoTime();
+		for (int i = 0; i < num; i++) {
+			signatures[i] = dsa.sign(msgs[i], 0, msgs[i].length);
+		}
+		long sign = System.nanoTime() - start;
+		
+		start = System.nanoTime();
+		dsa.precomputeSignatures(num);
+		long precompute = System.nanoTime() - start;
+		start = System.nanoTime();
+		dsa.sign(msgs);
+		long signBatch = System.nanoTime() - start;
+		
+		start = System.nanoTime();
+		for (int i = 0; i < num; i++) {
+			dsa.verify(signatures[i], msgs[i], 0, msgs[i].length);
+		}
+		long verify = System.nanoTime() - start;
+		
+		start = System.nanoTime();
+		dsa.verify(signatures, msgs);
+		long verifyBatch = System.nanoTime() - start;
+		
+		System.out.println("sign of " + num + " messages: one by one " + sign / 1000000 + " ms, precompute " + precompute / 1000000 + 
+				" ms + batch " + signBatch / 1000000 + " ms");
+		System.out.println("verify of " + num + " signatures: one by one " + verify / 1000000 + " ms, batch " + verifyBatch / 1000000 + " ms");
+	}
+}
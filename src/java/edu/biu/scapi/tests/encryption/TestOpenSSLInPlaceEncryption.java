@@ -0,0 +1,105 @@
+package edu.biu.scapi.tests.encryption;
+
+import static org.junit.Assert.*;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import javax.crypto.Cipher;
+import javax.crypto.SecretKey;
+import javax.crypto.spec.GCMParameterSpec;
+
+import org.junit.Test;
+
+import edu.biu.scapi.midLayer.ciphertext.IVCiphertext;
+import edu.biu.scapi.midLayer.plaintext.ByteArrayPlaintext;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLCBCEncRandomIV;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLCTREncRandomIV;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLEncWithIVAbs;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLGCMEnc;
+
+/**
+ * Checks the in place and caller buffer encryption of the OpenSSL CBC and CTR schemes against the ciphertext objects API,
+ * and the OpenSSL GCM scheme against the GCM of the java provider.
+ */
+public class TestOpenSSLInPlaceEncryption {
+
+	private Random random = new Random();
+	
+	private void checkInPlace(OpenSSLEncWithIVAbs scheme) throws Exception{
+		scheme.setKey(scheme.generateKey(128));
+		for (int len = 0; len < 100; len++){
+			byte[] text = new byte[len];
+			random.nextBytes(text);
+			IVCiphertext expected = (IVCiphertext) scheme.encrypt(new ByteArrayPlaintext(text));
+			byte[] iv = expected.getIv();
+			
+			//Encrypt into a separate buffer.
+			byte[] out = new byte[scheme.getCiphertextSize(len) + 5];
+			int size = scheme.encrypt(text, 0, len, iv, out, 5);
+			assertArrayEquals(expected.getBytes(), Arrays.copyOfRange(out, 5, 5 + size));
+			
+			//Encrypt and decrypt in place.
+			byte[] buf = Arrays.copyOf(text, scheme.getCiphertextSize(len));
+			size = scheme.encrypt(buf, 0, len, iv, buf, 0);
+			assertArrayEquals(expected.getBytes(), Arrays.copyOf(buf, size));
+			size = scheme.decrypt(buf, 0, size, iv, buf, 0);
+			assertArrayEquals(text, Arrays.copyOf(buf, size));
+		}
+	}
+	
+	@Test
+	public void testCBC() throws Exception{
+		checkInPlace(new OpenSSLCBCEncRandomIV("AES", "SHA1PRNG"));
+	}
+	
+	@Test
+	public void testCTR() throws Exception{
+		checkInPlace(new OpenSSLCTREncRandomIV("AES", "SHA1PRNG"));
+	}
+	
+	@Test
+	public void testGCM() throws Exception{
+		OpenSSLGCMEnc gcm = new OpenSSLGCMEnc();
+		SecretKey key = gcm.generateKey(128);
+		gcm.setKey(key);
+		Cipher jce = Cipher.getInstance("AES/GCM/NoPadding");
+		
+		for (int len = 0; len < 100; len++){
+			byte[] text = new byte[len];
+			random.nextBytes(text);
+			byte[] sealed = gcm.seal(text, 0, len);
+			assertEquals(OpenSSLGCMEnc.IV_SIZE + len + OpenSSLGCMEnc.TAG_SIZE, sealed.length);
+			
+			//The ciphertext and the tag are the same as the java provider's.
+			byte[] iv = Arrays.copyOf(sealed, OpenSSLGCMEnc.IV_SIZE);
+			jce.init(Cipher.ENCRYPT_MODE, key, new GCMParameterSpec(OpenSSLGCMEnc.TAG_SIZE * 8, iv));
+			assertArrayEquals(jce.doFinal(text), Arrays.copyOfRange(sealed, OpenSSLGCMEnc.IV_SIZE, sealed.length));
+			assertArrayEquals(text, gcm.open(sealed));
+			
+			//A change in any byte fails the authentication.
+			sealed[random.nextInt(sealed.length)] ^= 1;
+			assertNull(gcm.open(sealed));
+		}
+	}
+	
+	@Test
+	public void testGCMInPlace() throws Exception{
+		OpenSSLGCMEnc gcm = new OpenSSLGCMEnc();
+		gcm.setKey(gcm.generateKey(256));
+		byte[] iv = new byte[OpenSSLGCMEnc.IV_SIZE];
+		random.nextBytes(iv);
+		
+		byte[] text = new byte[1000];
+		random.nextBytes(text);
+		byte[] buf = Arrays.copyOf(text, text.length + OpenSSLGCMEnc.TAG_SIZE);
+		int size = gcm.encrypt(buf, 0, text.length, iv, buf, 0);
+		assertEquals(buf.length, size);
+		
+		IVCiphertext cipher = (IVCiphertext) gcm.encrypt(new ByteArrayPlaintext(text), iv);
+		assertArrayEquals(cipher.getBytes(), buf);
+		
+		assertEquals(text.length, gcm.decrypt(buf, 0, size, iv, buf, 0));
+		assertArrayEquals(text, Arrays.copyOf(buf, text.length));
+	}
+}
@@ -0,0 +1,112 @@
+package edu.biu.scapi.tests.hash;
+
+import static org.junit.Assert.*;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLHash;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA1;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA256;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA512;
+
+/**
+ * Checks the batch hashing of OpenSSLHash against hashing the messages one by one, and measures the number of 
+ * messages hashed per second by both (see main).
+ */
+public class TestOpenSSLHashBatch {
+	
+	private Random random = new Random();
+	
+	private void checkBatch(OpenSSLHash hash){
+		//Lengths around the block boundaries and the multi-buffer limit, and a few long messages.
+		int numMessages = 600;
+		int[] offsets = new int[numMessages];
+		int[] lengths = new int[numMessages];
+		byte[] in = new byte[numMessages * 1000];
+		random.nextBytes(in);
+		for (int i = 0; i < numMessages; i++){
+			lengths[i] = (i < 300) ? i : random.nextInt(1000);
+			offsets[i] = random.nextInt(in.length - lengths[i] + 1);
+		}
+		
+		int size = hash.getHashedMsgSize();
+		byte[] out = new byte[numMessages*size + 7];
+		hash.hashBatch(in, offsets, lengths, out, 7);
+		
+		byte[] expected = new byte[size];
+		for (int i = 0; i < numMessages; i++){
+			if (lengths[i] > 0){
+				hash.update(in, offsets[i], lengths[i]);
+			}
+			hash.hashFinal(expected, 0);
+			assertArrayEquals("message " + i + " of length " + lengths[i], expected, Arrays.copyOfRange(out, 7 + i*size, 7 + (i+1)*size));
+		}
+	}
+	
+	@Test
+	public void testSHA1(){
+		checkBatch(new OpenSSLSHA1());
+	}
+	
+	@Test
+	public void testSHA256(){
+		checkBatch(new OpenSSLSHA256());
+	}
+	
+	@Test
+	public void testSHA512(){
+		checkBatch(new OpenSSLSHA512());
+	}
+	
+	@Test
+	public void testBatchDoesNotChangeState(){
+		OpenSSLHash hash = new OpenSSLSHA256();
+		byte[] msg = new byte[100];
+		random.nextBytes(msg);
+		byte[] expected = new byte[32];
+		hash.update(msg, 0, msg.length);
+		hash.hashFinal(expected, 0);
+		
+		//A batch in the middle of an update does not affect the accumulated message.
+		byte[] result = new byte[32];
+		hash.update(msg, 0, 50);
+		hash.hashBatch(msg, 0, 10, 10, new byte[320], 0);
+		hash.update(msg, 50, 50);
+		hash.hashFinal(result, 0);
+		assertArrayEquals(expected, result);
+	}
+	
+	private static void benchmark(OpenSSLHash hash, int numMessages, int messageLen){
+		byte[] in = new byte[numMessages * messageLen];
+		new Random().nextBytes(in);
+		byte[] out = new byte[numMessages * hash.getHashedMsgSize()];
+		
+		long start = System.nanoTime();
+		for (int i = 0; i < numMessages; i++){
+			hash.update(in, i*messageLen, messageLen);
+			hash.hashFinal(out, i*hash.getHashedMsgSize());
+		}
+		double perMessage = (System.nanoTime() - start) / 1e9;
+		
+		start = System.nanoTime();
+		hash.hashBatch(in, 0, messageLen, numMessages, out, 0);
+		double batch = (System.nanoTime() - start) / 1e9;
+		
+		System.out.println(hash.getAlgorithmName() + ", " + messageLen + " byte messages: update/hashFinal " + (long) (numMessages / perMessage) + 
+				" messages/s, hashBatch " + (long) (numMessages / batch) + " messages/s");
+	}
+	
+	public static void main(String[] args){
+		int numMessages = (args.length > 0) ? Integer.parseInt(args[0]) : 1 << 18;
+		//Run twice, the first run warms up the JIT.
+		for (int i = 0; i < 2; i++){
+			for (int messageLen : new int[]{16, 32, 64, 128, 1024}){
+				benchmark(new OpenSSLSHA1(), numMessages, messageLen);
+				benchmark(new OpenSSLSHA256(), numMessages, messageLen);
+			}
+		}
+	}
+}
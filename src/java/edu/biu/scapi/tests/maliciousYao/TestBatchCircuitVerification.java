@@ -0,0 +1,151 @@
+package edu.biu.scapi.tests.maliciousYao;
+
+import static org.junit.Assert.*;
+
+import java.security.SecureRandom;
+
+import org.junit.Test;
+
+import edu.biu.protocols.yao.offlineOnline.primitives.Bundle;
+import edu.biu.protocols.yao.offlineOnline.primitives.BundleBuilder;
+import edu.biu.protocols.yao.offlineOnline.primitives.CommitmentBundle;
+import edu.biu.protocols.yao.primitives.CryptoPrimitives;
+import edu.biu.protocols.yao.primitives.KProbeResistantMatrix;
+import edu.biu.protocols.yao.primitives.KProbeResistantMatrixBuilder;
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit.CircuitType;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledTablesHolder;
+import edu.biu.scapi.circuits.garbledCircuit.JustGarbledGarbledTablesHolder;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashDecommitmentMessage;
+
+/**
+ * Checks that the native batch verification of the checked circuits agrees with building each checked circuit from its seed,
+ * as done by CutAndChooseVerifier before the batch verification was added.
+ */
+public class TestBatchCircuitVerification {
+	private static final String CIRCUIT_FILE = "src/java/edu/biu/SCProtocols/MaliciousYao/assets/circuits/ADD/NigelAdd32.txt";
+	private static final int NUM_OF_CIRCUITS = 10;
+	private static final int NUM_OF_THREADS = 4;
+	private static final int SEED_SIZE = 16;
+
+	/**
+	 * The circuits built by the first party, from their seeds.
+	 */
+	private static class CheckedCircuits {
+		byte[][] seeds = new byte[NUM_OF_CIRCUITS][];
+		Bundle[] bundles = new Bundle[NUM_OF_CIRCUITS];
+		GarbledTablesHolder[] garbledTables = new GarbledTablesHolder[NUM_OF_CIRCUITS];
+		byte[][] translationTables = new byte[NUM_OF_CIRCUITS][];
+	}
+
+	private final CryptoPrimitives primitives = CryptoPrimitives.defaultPrimitives(NUM_OF_THREADS);
+
+	private CheckedCircuits garble(BundleBuilder builder){
+		SecureRandom random = new SecureRandom();
+		CheckedCircuits checked = new CheckedCircuits();
+		for (int i = 0; i < NUM_OF_CIRCUITS; i++) {
+			checked.seeds[i] = random.generateSeed(SEED_SIZE);
+			checked.bundles[i] = builder.build(checked.seeds[i]);
+			checked.garbledTables[i] = checked.bundles[i].getGarbledTables();
+			checked.translationTables[i] = checked.bundles[i].getTranslationTable();
+		}
+		return checked;
+	}
+
+	private static ScNativeGarbledBooleanCircuit[] createCircuits(int count){
+		ScNativeGarbledBooleanCircuit[] circuits = new ScNativeGarbledBooleanCircuit[count];
+		for (int i = 0; i < count; i++) {
+			circuits[i] = new ScNativeGarbledBooleanCircuit(CIRCUIT_FILE, CircuitType.FREE_XOR_HALF_GATES, true);
+		}
+		return circuits;
+	}
+
+	private static byte[][] garblingSeeds(byte[][] seeds){
+		byte[][] garblingSeeds = new byte[seeds.length][];
+		for (int i = 0; i < seeds.length; i++) {
+			garblingSeeds[i] = BundleBuilder.getGarblingSeed(seeds[i]);
+		}
+		return garblingSeeds;
+	}
+
+	private BundleBuilder createBuilder(ScNativeGarbledBooleanCircuit circuit) throws Exception{
+		KProbeResistantMatrix matrix = new KProbeResistantMatrixBuilder(circuit.getInputWireIndices(2).length, primitives.getStatisticalParameter()).build();
+		return new BundleBuilder(circuit, matrix, primitives, null);
+	}
+
+	@Test
+	public void testBatchMatchesBuild() throws Exception{
+		ScNativeGarbledBooleanCircuit[] circuits = createCircuits(NUM_OF_THREADS + 1);
+		BundleBuilder builder = createBuilder(circuits[NUM_OF_THREADS]);
+		CheckedCircuits checked = garble(builder);
+
+		ScNativeGarbledBooleanCircuit[] verifiers = new ScNativeGarbledBooleanCircuit[NUM_OF_THREADS];
+		System.arraycopy(circuits, 0, verifiers, 0, NUM_OF_THREADS);
+		FastCircuitCreationValues[] wireValues = new FastCircuitCreationValues[NUM_OF_CIRCUITS];
+		boolean[] verified = ScNativeGarbledBooleanCircuit.verifyGarbledCircuits(verifiers, garblingSeeds(checked.seeds),
+				checked.garbledTables, checked.translationTables, wireValues);
+
+		for (int i = 0; i < NUM_OF_CIRCUITS; i++) {
+			assertTrue("circuit " + i, verified[i]);
+			//Building the bundle from the output of the batch should give the bundle that was built by garbling the circuit.
+			assertBundlesEqual(checked.bundles[i], builder.build(checked.seeds[i], wireValues[i]));
+		}
+	}
+
+	@Test
+	public void testBatchRejectsFlippedByte() throws Exception{
+		ScNativeGarbledBooleanCircuit[] circuits = createCircuits(NUM_OF_THREADS + 1);
+		BundleBuilder builder = createBuilder(circuits[NUM_OF_THREADS]);
+		CheckedCircuits checked = garble(builder);
+
+		//Flip one byte in the middle of the received tables of one circuit.
+		int cheated = NUM_OF_CIRCUITS / 2;
+		byte[] tables = checked.garbledTables[cheated].toDoubleByteArray()[0].clone();
+		tables[tables.length / 2] ^= 1;
+		checked.garbledTables[cheated] = new JustGarbledGarbledTablesHolder(tables);
+
+		ScNativeGarbledBooleanCircuit[] verifiers = new ScNativeGarbledBooleanCircuit[NUM_OF_THREADS];
+		System.arraycopy(circuits, 0, verifiers, 0, NUM_OF_THREADS);
+		FastCircuitCreationValues[] wireValues = new FastCircuitCreationValues[NUM_OF_CIRCUITS];
+		boolean[] verified = ScNativeGarbledBooleanCircuit.verifyGarbledCircuits(verifiers, garblingSeeds(checked.seeds),
+				checked.garbledTables, checked.translationTables, wireValues);
+
+		for (int i = 0; i < NUM_OF_CIRCUITS; i++) {
+			assertEquals("circuit " + i, i != cheated, verified[i]);
+		}
+	}
+
+	private static void assertBundlesEqual(Bundle expected, Bundle actual){
+		assertArrayEquals(expected.getSeed(), actual.getSeed());
+		assertArrayEquals(expected.getTranslationTable(), actual.getTranslationTable());
+		assertArrayEquals(expected.getPlacementMask(), actual.getPlacementMask());
+		assertArrayEquals(expected.getCommitmentMask(), actual.getCommitmentMask());
+		assertArrayEquals(expected.getInputWiresX(), actual.getInputWiresX());
+		assertArrayEquals(expected.getInputWiresY1Extended(), actual.getInputWiresY1Extended());
+		assertArrayEquals(expected.getInputWiresY2(), actual.getInputWiresY2());
+		assertArrayEquals(expected.getOutputWires(), actual.getOutputWires());
+
+		assertCommitmentBundlesEqual(expected.getCommitmentsX(), actual.getCommitmentsX(), expected.getInputLabelsX().length);
+		assertCommitmentBundlesEqual(expected.getCommitmentsY1Extended(), actual.getCommitmentsY1Extended(), expected.getInputLabelsY1Extended().length);
+		assertCommitmentBundlesEqual(expected.getCommitmentsY2(), actual.getCommitmentsY2(), expected.getInputLabelsY2().length);
+		assertArrayEquals(((CmtSimpleHashCommitmentMessage) expected.getCommitmentsOutputKeys()).getCommitment(),
+				((CmtSimpleHashCommitmentMessage) actual.getCommitmentsOutputKeys()).getCommitment());
+		assertArrayEquals(((CmtSimpleHashDecommitmentMessage) expected.getDecommitmentsOutputKeys()).getX(),
+				((CmtSimpleHashDecommitmentMessage) actual.getDecommitmentsOutputKeys()).getX());
+	}
+
+	private static void assertCommitmentBundlesEqual(CommitmentBundle expected, CommitmentBundle actual, int numOfWires){
+		assertArrayEquals(expected.getCommitments(), actual.getCommitments());
+		assertArrayEquals(expected.getCommitmentsIds(), actual.getCommitmentsIds());
+		for (int i = 0; i < numOfWires; i++) {
+			for (int sigma = 0; sigma < 2; sigma++) {
+				CmtSimpleHashDecommitmentMessage expectedDecommitment = (CmtSimpleHashDecommitmentMessage) expected.getDecommitment(i, sigma);
+				CmtSimpleHashDecommitmentMessage actualDecommitment = (CmtSimpleHashDecommitmentMessage) actual.getDecommitment(i, sigma);
+				assertArrayEquals(expectedDecommitment.getR().getR(), actualDecommitment.getR().getR());
+				assertArrayEquals(expectedDecommitment.getX(), actualDecommitment.getX());
+			}
+		}
+	}
+}
@@ -0,0 +1,193 @@
+package edu.biu.scapi.tests.maliciousYao;
+
+import static org.junit.Assert.*;
+
+import java.io.File;
+import java.nio.file.Files;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+
+import javax.crypto.spec.SecretKeySpec;
+
+import org.junit.Test;
+
+import edu.biu.protocols.CommitmentWithZkProofOfDifference.DifferenceCommitmentCommitterBundle;
+import edu.biu.protocols.CommitmentWithZkProofOfDifference.SC;
+import edu.biu.protocols.CommitmentWithZkProofOfDifference.SCom;
+import edu.biu.protocols.yao.offlineOnline.primitives.BucketFile;
+import edu.biu.protocols.yao.offlineOnline.primitives.Bundle;
+import edu.biu.protocols.yao.offlineOnline.primitives.CommitmentBundle;
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.interactiveMidProtocols.ByteArrayRandomValue;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCCommitmentMsg;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCDecommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitmentMessage;
+import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashDecommitmentMessage;
+
+/**
+ * Writes buckets of full bundles to a bucket file, reads them back and checks every member that is written to the file.
+ */
+public class TestBucketFile {
+	private static final int NUM_OF_WIRES = 8;
+	private static final int KEY_SIZE = 16;
+	private static final int COMMITMENT_SIZE = 20;
+	private static final SecureRandom random = new SecureRandom();
+
+	@Test
+	public void testBundleRoundTrip() throws Exception{
+		ArrayList<Bundle> bucket = new ArrayList<Bundle>();
+		//A bundle with difference commitments, one whose difference commitments have no pairs and one without them and without a secret.
+		bucket.add(createBundle(3, true));
+		bucket.add(createBundle(0, true));
+		bucket.add(createBundle(-1, false));
+
+		File file = File.createTempFile("bucket", ".cbundle");
+		File copy = File.createTempFile("bucket", ".copy.cbundle");
+		try {
+			BucketFile.save(bucket, file.getPath());
+			assertTrue(BucketFile.isBucketFile(file.getPath()));
+			ArrayList<Bundle> loaded = BucketFile.loadBundles(file.getPath());
+
+			assertEquals(bucket.size(), loaded.size());
+			for (int i = 0; i < bucket.size(); i++) {
+				assertBundlesEqual(bucket.get(i), loaded.get(i));
+			}
+
+			//Writing the loaded bundles again gives the same file, which also covers the members that have no getter (the key size).
+			BucketFile.save(loaded, copy.getPath());
+			assertArrayEquals(Files.readAllBytes(file.toPath()), Files.readAllBytes(copy.toPath()));
+		} finally {
+			file.delete();
+			copy.delete();
+		}
+	}
+
+	private static void assertBundlesEqual(Bundle expected, Bundle actual){
+		assertArrayEquals(expected.getSeed(), actual.getSeed());
+		assertArrayEquals(expected.getPlacementMask(), actual.getPlacementMask());
+		assertArrayEquals(expected.getCommitmentMask(), actual.getCommitmentMask());
+		assertArrayEquals(expected.getInputLabelsX(), actual.getInputLabelsX());
+		assertArrayEquals(expected.getInputLabelsY1Extended(), actual.getInputLabelsY1Extended());
+		assertArrayEquals(expected.getInputLabelsY2(), actual.getInputLabelsY2());
+		assertArrayEquals(expected.getOutputLabels(), actual.getOutputLabels());
+		assertArrayEquals(expected.getOutputWires(), actual.getOutputWires());
+
+		assertCommitmentBundlesEqual(expected.getCommitmentsX(), actual.getCommitmentsX());
+		assertCommitmentBundlesEqual(expected.getCommitmentsY1Extended(), actual.getCommitmentsY1Extended());
+		assertCommitmentBundlesEqual(expected.getCommitmentsY2(), actual.getCommitmentsY2());
+		assertCommitmentsEqual(expected.getCommitmentsOutputKeys(), actual.getCommitmentsOutputKeys());
+		assertDecommitmentsEqual(expected.getDecommitmentsOutputKeys(), actual.getDecommitmentsOutputKeys());
+
+		if (expected.getSecret() == null) {
+			assertNull(actual.getSecret());
+		} else {
+			assertArrayEquals(expected.getSecret().getEncoded(), actual.getSecret().getEncoded());
+			assertEquals(expected.getSecret().getAlgorithm(), actual.getSecret().getAlgorithm());
+		}
+
+		DifferenceCommitmentCommitterBundle expectedDiff = expected.getDifferenceCommitmentBundle();
+		DifferenceCommitmentCommitterBundle actualDiff = actual.getDifferenceCommitmentBundle();
+		if (expectedDiff == null) {
+			assertNull(actualDiff);
+			return;
+		}
+		assertArrayEquals(expectedDiff.getX(), actualDiff.getX());
+		assertCommitmentsEqual(expectedDiff.getCommitmentToW(), actualDiff.getCommitmentToW());
+		SC expectedC = expectedDiff.getC();
+		SC actualC = actualDiff.getC();
+		CmtCCommitmentMsg[] expectedCommitments = expectedC.getCommitments();
+		CmtCCommitmentMsg[] actualCommitments = actualC.getCommitments();
+		CmtCDecommitmentMessage[] expectedDecommitments = expectedC.getDecommitments();
+		CmtCDecommitmentMessage[] actualDecommitments = actualC.getDecommitments();
+		assertEquals(expectedCommitments.length, actualCommitments.length);
+		for (int i = 0; i < expectedCommitments.length; i++) {
+			assertCommitmentsEqual(expectedCommitments[i], actualCommitments[i]);
+			assertDecommitmentsEqual(expectedDecommitments[i], actualDecommitments[i]);
+		}
+		for (int i = 0; i < expectedCommitments.length / 2; i++) {
+			assertArrayEquals(expectedC.getR(i), actualC.getR(i));
+		}
+		assertArrayEquals(expectedC.getR(), actualC.getR());
+		assertEquals(expectedC.getNextAvailableCommitmentId(), actualC.getNextAvailableCommitmentId());
+	}
+
+	private static void assertCommitmentBundlesEqual(CommitmentBundle expected, CommitmentBundle actual){
+		assertArrayEquals(expected.getCommitments(), actual.getCommitments());
+		assertArrayEquals(expected.getCommitmentsIds(), actual.getCommitmentsIds());
+		for (int i = 0; i < NUM_OF_WIRES; i++) {
+			for (int sigma = 0; sigma < 2; sigma++) {
+				assertDecommitmentsEqual(expected.getDecommitment(i, sigma), actual.getDecommitment(i, sigma));
+			}
+		}
+	}
+
+	private static void assertCommitmentsEqual(CmtCCommitmentMsg expected, CmtCCommitmentMsg actual){
+		assertArrayEquals(((CmtSimpleHashCommitmentMessage) expected).getCommitment(), ((CmtSimpleHashCommitmentMessage) actual).getCommitment());
+		assertEquals(expected.getId(), actual.getId());
+	}
+
+	private static void assertDecommitmentsEqual(CmtCDecommitmentMessage expected, CmtCDecommitmentMessage actual){
+		CmtSimpleHashDecommitmentMessage expectedHash = (CmtSimpleHashDecommitmentMessage) expected;
+		CmtSimpleHashDecommitmentMessage actualHash = (CmtSimpleHashDecommitmentMessage) actual;
+		assertArrayEquals(expectedHash.getR().getR(), actualHash.getR().getR());
+		assertArrayEquals(expectedHash.getX(), actualHash.getX());
+	}
+
+	/**
+	 * Creates a bundle filled with random values.
+	 * @param s The number of pairs of the difference commitments, or -1 for a bundle without difference commitments.
+	 * @param withSecret Whether the bundle has a secret.
+	 */
+	private static Bundle createBundle(int s, boolean withSecret){
+		Bundle.Builder builder = new Bundle.Builder(randomBytes(KEY_SIZE), KEY_SIZE)
+				.circuit(null, new FastCircuitCreationValues(randomBytes(2 * NUM_OF_WIRES * KEY_SIZE), randomBytes(2 * NUM_OF_WIRES * KEY_SIZE), randomBytes(NUM_OF_WIRES)))
+				.masks(randomBytes(NUM_OF_WIRES), randomBytes(NUM_OF_WIRES))
+				.labels(labels(0), labels(NUM_OF_WIRES), labels(2 * NUM_OF_WIRES), labels(3 * NUM_OF_WIRES))
+				.commitments(createCommitments(0), createCommitments(100), createCommitments(200),
+						new CmtSimpleHashCommitmentMessage(randomBytes(COMMITMENT_SIZE), 300),
+						new CmtSimpleHashDecommitmentMessage(new ByteArrayRandomValue(randomBytes(COMMITMENT_SIZE)), randomBytes(2 * NUM_OF_WIRES * KEY_SIZE)));
+		if (withSecret) {
+			builder.secret(new SecretKeySpec(randomBytes(KEY_SIZE), "AES"));
+		}
+		Bundle bundle = builder.build();
+
+		if (s >= 0) {
+			byte[][] r = new byte[s][];
+			SCom[] pairs = new SCom[s];
+			for (int i = 0; i < s; i++) {
+				r[i] = randomBytes(KEY_SIZE);
+				pairs[i] = new SCom(new CmtSimpleHashCommitmentMessage(randomBytes(COMMITMENT_SIZE), 400 + 2*i),
+						new CmtSimpleHashCommitmentMessage(randomBytes(COMMITMENT_SIZE), 401 + 2*i),
+						new CmtSimpleHashDecommitmentMessage(new ByteArrayRandomValue(randomBytes(COMMITMENT_SIZE)), randomBytes(KEY_SIZE)),
+						new CmtSimpleHashDecommitmentMessage(new ByteArrayRandomValue(randomBytes(COMMITMENT_SIZE)), randomBytes(KEY_SIZE)));
+			}
+			SC c = new SC(r, pairs, 400 + 2*s);
+			bundle.setDifferenceCommitmentBundle(new DifferenceCommitmentCommitterBundle(randomBytes(KEY_SIZE), c,
+					new CmtSimpleHashCommitmentMessage(randomBytes(COMMITMENT_SIZE), 500)));
+		}
+		return bundle;
+	}
+
+	private static CommitmentBundle createCommitments(long firstId){
+		long[] ids = new long[2 * NUM_OF_WIRES];
+		for (int i = 0; i < ids.length; i++) {
+			ids[i] = firstId + i;
+		}
+		return new CommitmentBundle(randomBytes(2 * NUM_OF_WIRES * COMMITMENT_SIZE), ids, randomBytes(2 * NUM_OF_WIRES * KEY_SIZE),
+				randomBytes(2 * NUM_OF_WIRES * COMMITMENT_SIZE));
+	}
+
+	private static int[] labels(int first){
+		int[] labels = new int[NUM_OF_WIRES];
+		for (int i = 0; i < labels.length; i++) {
+			labels[i] = first + i;
+		}
+		return labels;
+	}
+
+	private static byte[] randomBytes(int size){
+		byte[] bytes = new byte[size];
+		random.nextBytes(bytes);
+		return bytes;
+	}
+}
@@ -0,0 +1,187 @@
+package edu.biu.scapi.tests.prf;
+
+import static org.junit.Assert.*;
+
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.MultiKeyAES;
+import edu.biu.scapi.primitives.prf.bc.BcAES;
+import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpAES;
+import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpMultiKeyAES;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLAES;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLMultiKeyAES;
+
+/**
+ * Checks the MultiKeyAES implementations against the single key AES, and measures their throughput (see main).
+ */
+public class TestMultiKeyAES {
+	
+	private static final int NUM_KEYS = 37;
+	private static final int NUM_BLOCKS = 100;
+	
+	private SecureRandom random = new SecureRandom();
+	
+	private SecretKey[] createKeys(int numKeys, int keySize){
+		SecretKey[] keys = new SecretKey[numKeys];
+		for (int i = 0; i < numKeys; i++){
+			byte[] key = new byte[keySize];
+			random.nextBytes(key);
+			keys[i] = new SecretKeySpec(key, "AES");
+		}
+		return keys;
+	}
+	
+	private void checkBlocks(MultiKeyAES multiKey, int keySize) throws Exception{
+		SecretKey[] keys = createKeys(NUM_KEYS, keySize);
+		multiKey.setKeys(keys);
+		
+		byte[] in = new byte[NUM_BLOCKS*16 + 3];
+		random.nextBytes(in);
+		int[] indices = new int[NUM_BLOCKS];
+		for (int i = 0; i < NUM_BLOCKS; i++){
+			//Use runs of the same key as well as changing keys.
+			indices[i] = (i < NUM_BLOCKS/2) ? i / 5 : random.nextInt(NUM_KEYS);
+		}
+		byte[] out = new byte[NUM_BLOCKS*16 + 5];
+		byte[] outIndexed = new byte[NUM_BLOCKS*16 + 5];
+		multiKey.computeBlocks(in, 3, out, 5, NUM_BLOCKS);
+		multiKey.computeBlocks(in, 3, outIndexed, 5, NUM_BLOCKS, indices);
+		
+		AES aes = new BcAES();
+		byte[] expected = new byte[16];
+		for (int i = 0; i < NUM_BLOCKS; i++){
+			aes.setKey(keys[i % NUM_KEYS]);
+			aes.computeBlock(in, 3 + i*16, expected, 0);
+			assertArrayEquals(expected, Arrays.copyOfRange(out, 5 + i*16, 5 + (i+1)*16));
+			
+			aes.setKey(keys[indices[i]]);
+			aes.computeBlock(in, 3 + i*16, expected, 0);
+			assertArrayEquals(expected, Arrays.copyOfRange(outIndexed, 5 + i*16, 5 + (i+1)*16));
+		}
+	}
+	
+	private void checkCtr(MultiKeyAES multiKey) throws Exception{
+		SecretKey[] keys = createKeys(3, 16);
+		multiKey.setKeys(keys);
+		
+		//A counter that wraps around the low bytes, to check the carry.
+		byte[] iv = new byte[16];
+		random.nextBytes(iv);
+		iv[15] = (byte) 0xfe;
+		iv[14] = (byte) 0xff;
+		
+		byte[] stream = new byte[NUM_BLOCKS*16];
+		multiKey.ctr(1, iv, 0, null, 0, stream, 0, NUM_BLOCKS);
+		
+		//Seeking to the middle of the stream gives the same blocks.
+		byte[] part = new byte[10*16];
+		multiKey.ctr(1, iv, 40, null, 0, part, 0, 10);
+		assertArrayEquals(Arrays.copyOfRange(stream, 40*16, 50*16), part);
+		
+		//Encrypting xors the input with the stream, and encrypting twice decrypts.
+		byte[] plain = new byte[NUM_BLOCKS*16];
+		random.nextBytes(plain);
+		byte[] cipher = new byte[NUM_BLOCKS*16];
+		multiKey.ctr(1, iv, 0, plain, 0, cipher, 0, NUM_BLOCKS);
+		for (int i = 0; i < cipher.length; i++){
+			assertEquals((byte) (plain[i] ^ stream[i]), cipher[i]);
+		}
+		multiKey.ctr(1, iv, 0, cipher, 0, cipher, 0, NUM_BLOCKS);
+		assertArrayEquals(plain, cipher);
+		
+		//The first block is the encryption of the iv.
+		AES aes = new BcAES();
+		aes.setKey(keys[1]);
+		byte[] expected = new byte[16];
+		aes.computeBlock(iv, 0, expected, 0);
+		assertArrayEquals(expected, Arrays.copyOfRange(stream, 0, 16));
+	}
+	
+	@Test
+	public void testOpenSSL() throws Exception{
+		MultiKeyAES multiKey = new OpenSSLMultiKeyAES();
+		for (int keySize = 16; keySize <= 32; keySize += 8){
+			checkBlocks(multiKey, keySize);
+		}
+		checkCtr(multiKey);
+	}
+	
+	@Test
+	public void testCryptoPp() throws Exception{
+		MultiKeyAES multiKey = new CryptoPpMultiKeyAES();
+		for (int keySize = 16; keySize <= 32; keySize += 8){
+			checkBlocks(multiKey, keySize);
+		}
+		checkCtr(multiKey);
+	}
+	
+	@Test(expected = IllegalArgumentException.class)
+	public void testWrongKeyIndex() throws Exception{
+		MultiKeyAES multiKey = new OpenSSLMultiKeyAES();
+		multiKey.setKeys(createKeys(2, 16));
+		multiKey.computeBlocks(new byte[32], 0, new byte[32], 0, 2, new int[]{0, 2});
+	}
+	
+	/*
+	 * Measures the time to encrypt numBlocks blocks, each one under a different key, with a single key AES
+	 * (setting the key before every block) and with the multi key AES.
+	 */
+	private static void benchmark(String name, AES aes, MultiKeyAES multiKey, int numKeys, int numBlocks) throws Exception{
+		TestMultiKeyAES test = new TestMultiKeyAES();
+		SecretKey[] keys = test.createKeys(numKeys, 16);
+		byte[] in = new byte[numBlocks*16];
+		byte[] out = new byte[numBlocks*16];
+		
+		long start = System.nanoTime();
+		for (int i = 0; i < numBlocks; i++){
+			aes.setKey(keys[i % numKeys]);
+			aes.computeBlock(in, i*16, out, i*16);
+		}
+		double singleKey = (System.nanoTime() - start) / 1000000.0;
+		
+		start = System.nanoTime();
+		multiKey.setKeys(keys);
+		multiKey.computeBlocks(in, 0, out, 0, numBlocks);
+		double multipleKeys = (System.nanoTime() - start) / 1000000.0;
+		
+		//The case of a single key, compared to optimizedCompute.
+		aes.setKey(keys[0]);
+		start = System.nanoTime();
+		if (aes instanceof OpenSSLAES){
+			((OpenSSLAES) aes).optimizedCompute(in, out);
+		} else {
+			((CryptoPpAES) aes).optimizedCompute(in, out);
+		}
+		double optimized = (System.nanoTime() - start) / 1000000.0;
+		
+		multiKey.setKeys(new SecretKey[]{keys[0]});
+		start = System.nanoTime();
+		multiKey.computeBlocks(in, 0, out, 0, numBlocks);
+		double multiKeyOneKey = (System.nanoTime() - start) / 1000000.0;
+		
+		double mb = numBlocks*16 / (1024.0*1024.0);
+		System.out.println(name + ": " + numBlocks + " blocks under " + numKeys + " keys");
+		System.out.println("  AES with a key per block:      " + singleKey + " ms (" + mb / singleKey * 1000 + " MB/s)");
+		System.out.println("  MultiKeyAES:                   " + multipleKeys + " ms (" + mb / multipleKeys * 1000 + " MB/s)");
+		System.out.println("  AES optimizedCompute, one key: " + optimized + " ms (" + mb / optimized * 1000 + " MB/s)");
+		System.out.println("  MultiKeyAES, one key:          " + multiKeyOneKey + " ms (" + mb / multiKeyOneKey * 1000 + " MB/s)");
+	}
+	
+	public static void main(String[] args) throws Exception{
+		int numBlocks = (args.length > 0) ? Integer.parseInt(args[0]) : 1 << 20;
+		for (int numKeys : new int[]{1 << 10, numBlocks}){
+			//Run twice, the first run warms up the JIT.
+			for (int i = 0; i < 2; i++){
+				benchmark("OpenSSL", new OpenSSLAES(), new OpenSSLMultiKeyAES(), numKeys, numBlocks);
+				benchmark("Crypto++", new CryptoPpAES(), new CryptoPpMultiKeyAES(), numKeys, numBlocks);
+			}
+		}
+	}
+}
@@ -0,0 +1,111 @@
+package edu.biu.scapi.tests.trapdoorPermutation;
+
+import static org.junit.Assert.*;
+
+import java.security.KeyPair;
+import java.security.spec.AlgorithmParameterSpec;
+import java.security.spec.RSAKeyGenParameterSpec;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.trapdoorPermutation.RabinKeyGenParameterSpec;
+import edu.biu.scapi.primitives.trapdoorPermutation.TPElement;
+import edu.biu.scapi.primitives.trapdoorPermutation.TrapdoorPermutation;
+import edu.biu.scapi.primitives.trapdoorPermutation.cryptopp.CryptoPpRSAPermutation;
+import edu.biu.scapi.primitives.trapdoorPermutation.cryptopp.CryptoPpRabinPermutation;
+import edu.biu.scapi.primitives.trapdoorPermutation.openSSL.OpenSSLRSAPermutation;
+
+/**
+ * Checks that the batch compute and invert of the native trapdoor permutations give the same results as the single element functions, 
+ * and measures the time of both (see main).
+ */
+public class TestTrapdoorPermutationBatch {
+
+	private static final int NUM_ELEMENTS = 100;
+	
+	private static TPElement[] randomElements(TrapdoorPermutation tp, int num){
+		TPElement[] elements = new TPElement[num];
+		for (int i = 0; i < num; i++) {
+			elements[i] = tp.generateRandomTPElement();
+		}
+		return elements;
+	}
+	
+	private void crossCheck(TrapdoorPermutation tp, AlgorithmParameterSpec params, int numThreads) throws Exception{
+		KeyPair pair = tp.generateKey(params);
+		tp.setKey(pair.getPublic(), pair.getPrivate());
+		
+		TPElement[] elements = randomElements(tp, NUM_ELEMENTS);
+		TPElement[] computed = tp.compute(elements, numThreads);
+		TPElement[] inverted = tp.invert(computed, numThreads);
+		
+		assertEquals(elements.length, computed.length);
+		for (int i = 0; i < elements.length; i++) {
+			assertEquals(tp.compute(elements[i]).getElement(), computed[i].getElement());
+			assertEquals(tp.invert(computed[i]).getElement(), inverted[i].getElement());
+		}
+	}
+	
+	@Test
+	public void testOpenSSLRSA() throws Exception{
+		crossCheck(new OpenSSLRSAPermutation(), new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4), 1);
+		crossCheck(new OpenSSLRSAPermutation(), new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4), 4);
+	}
+	
+	@Test
+	public void testOpenSSLRSAInvertsCompute() throws Exception{
+		OpenSSLRSAPermutation tp = new OpenSSLRSAPermutation();
+		KeyPair pair = tp.generateKey(new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4));
+		tp.setKey(pair.getPublic(), pair.getPrivate());
+		
+		TPElement[] elements = randomElements(tp, NUM_ELEMENTS);
+		TPElement[] inverted = tp.invert(tp.compute(elements, 3), 3);
+		for (int i = 0; i < elements.length; i++) {
+			assertEquals(elements[i].getElement(), inverted[i].getElement());
+		}
+	}
+	
+	@Test
+	public void testCryptoPpRSA() throws Exception{
+		crossCheck(new CryptoPpRSAPermutation(), new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4), 1);
+		crossCheck(new CryptoPpRSAPermutation(), new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4), 4);
+	}
+	
+	@Test
+	public void testCryptoPpRabin() throws Exception{
+		crossCheck(new CryptoPpRabinPermutation(), new RabinKeyGenParameterSpec(1024), 1);
+		crossCheck(new CryptoPpRabinPermutation(), new RabinKeyGenParameterSpec(1024), 4);
+	}
+	
+	/**
+	 * Prints the time of inverting a batch of elements one by one and in one call.
+	 */
+	public static void main(String[] args) throws Exception{
+		int num = 2000;
+		int numThreads = Runtime.getRuntime().availableProcessors();
+		TrapdoorPermutation[] tps = {new OpenSSLRSAPermutation(), new CryptoPpRSAPermutation()};
+		
+		for (TrapdoorPermutation tp : tps) {
+			KeyPair pair = tp.generateKey(new RSAKeyGenParameterSpec(2048, RSAKeyGenParameterSpec.F4));
+			tp.setKey(pair.getPublic(), pair.getPrivate());
+			TPElement[] elements = randomElements(tp, num);
+			
+			long start = System.nanoTime();
+			for (int i = 0; i < num; i++) {
+				tp.invert(elements[i]);
+			}
+			long single = System.nanoTime() - start;
+			
+			start = System.nanoTime();
+			tp.invert(elements, 1);
+			long batch = System.nanoTime() - start;
+			
+			start = System.nanoTime();
+			tp.invert(elements, numThreads);
+			long threaded = System.nanoTime() - start;
+			
+			System.out.println(tp.getAlgorithmName() + " invert of " + num + " elements: one by one " + single / 1000000 + " ms, batch " + 
+					batch / 1000000 + " ms, batch with " + numThreads + " threads " + threaded / 1000000 + " ms");
+		}
+	}
+}
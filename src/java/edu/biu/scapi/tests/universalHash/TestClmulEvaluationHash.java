@@ -0,0 +1,102 @@
+package edu.biu.scapi.tests.universalHash;
+
+import static org.junit.Assert.*;
+
+import java.security.SecureRandom;
+import java.util.Random;
+
+import javax.crypto.SecretKey;
+
+import org.junit.Test;
+
+import edu.biu.scapi.paddings.BitPadding;
+import edu.biu.scapi.paddings.NoPadding;
+import edu.biu.scapi.primitives.universalHash.ClmulEvaluationHashFunction;
+import edu.biu.scapi.primitives.universalHash.EvaluationHashFunction;
+import edu.biu.scapi.primitives.universalHash.UniversalHash;
+
+/**
+ * Checks that the carry-less multiplication evaluation hash gives the same outputs as the NTL evaluation hash, 
+ * and measures the throughput of both (see main).
+ */
+public class TestClmulEvaluationHash {
+
+	private Random random = new Random();
+	
+	private void crossCheck(UniversalHash ntl, UniversalHash clmul, boolean alignedOnly) throws Exception{
+		SecretKey key = ntl.generateKey(64);
+		ntl.setKey(key);
+		clmul.setKey(key);
+		
+		byte[] in = new byte[2000];
+		random.nextBytes(in);
+		byte[] expected = new byte[8];
+		byte[] out = new byte[8];
+		for (int len = 0; len < 300; len++){
+			if (alignedOnly && len % 8 != 0){
+				continue;
+			}
+			int offset = random.nextInt(in.length - len);
+			ntl.compute(in, offset, len, expected, 0);
+			clmul.compute(in, offset, len, out, 0);
+			assertArrayEquals("length " + len, expected, out);
+		}
+	}
+	
+	@Test
+	public void testBitPadding() throws Exception{
+		crossCheck(new EvaluationHashFunction(), new ClmulEvaluationHashFunction(), false);
+	}
+	
+	@Test
+	public void testNoPadding() throws Exception{
+		crossCheck(new EvaluationHashFunction(new NoPadding(), new SecureRandom()), 
+				new ClmulEvaluationHashFunction(new NoPadding(), new SecureRandom()), true);
+	}
+	
+	@Test
+	public void testOutputOffset() throws Exception{
+		ClmulEvaluationHashFunction hash = new ClmulEvaluationHashFunction();
+		hash.setKey(hash.generateKey(64));
+		byte[] in = new byte[100];
+		random.nextBytes(in);
+		byte[] expected = new byte[8];
+		byte[] out = new byte[20];
+		hash.compute(in, 3, 90, expected, 0);
+		hash.compute(in, 3, 90, out, 5);
+		for (int i = 0; i < 8; i++){
+			assertEquals(expected[i], out[5 + i]);
+		}
+	}
+	
+	private static double megabytesPerSecond(UniversalHash hash, byte[] in, int iterations) throws Exception{
+		byte[] out = new byte[8];
+		long start = System.nanoTime();
+		for (int i = 0; i < iterations; i++){
+			hash.compute(in, 0, in.length, out, 0);
+		}
+		return (double) in.length * iterations / (System.nanoTime() - start) * 1000;
+	}
+	
+	/**
+	 * Prints the throughput of the NTL and the carry-less multiplication evaluation hash for a few input sizes.
+	 */
+	public static void main(String[] args) throws Exception{
+		UniversalHash ntl = new EvaluationHashFunction(new BitPadding(), new SecureRandom());
+		UniversalHash clmul = new ClmulEvaluationHashFunction(new BitPadding(), new SecureRandom());
+		SecretKey key = ntl.generateKey(64);
+		ntl.setKey(key);
+		clmul.setKey(key);
+		
+		for (int size : new int[]{64, 1024, 64*1024, 1024*1024}){
+			byte[] in = new byte[size];
+			new Random().nextBytes(in);
+			int iterations = Math.max(10, 64*1024*1024 / size);
+			//warm up
+			megabytesPerSecond(ntl, in, iterations / 10);
+			megabytesPerSecond(clmul, in, iterations / 10);
+			System.out.println(size + " bytes: NTL " + String.format("%.1f", megabytesPerSecond(ntl, in, iterations / 10)) + 
+					" MB/s, PCLMULQDQ " + String.format("%.1f", megabytesPerSecond(clmul, in, iterations)) + " MB/s");
+		}
+	}
+}
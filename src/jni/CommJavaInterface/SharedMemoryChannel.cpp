@@ -0,0 +1,83 @@
+#include "SharedMemoryChannel.h"
+#include "SharedMemoryConnection.h"
+
+using namespace std;
+
+/*
+ * The header of a message on the shared memory channel: the length of the message and its type (a byte array or
+ * a serialized object), which is only interpreted by the java side.
+ */
+struct FrameHeader {
+	int32_t length;
+	int32_t type;
+};
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_createSegment
+  (JNIEnv *env, jobject, jstring name, jlong capacity, jlong timeOut){
+	  const char* nameS = env->GetStringUTFChars(name, 0);
+	  SharedMemoryConnection* connection = SharedMemoryConnection::create(nameS, (size_t) capacity, (long) timeOut);
+	  env->ReleaseStringUTFChars(name, nameS);
+
+	  return (jlong) connection;
+}
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_openSegment
+  (JNIEnv *env, jobject, jstring name, jlong timeOut){
+	  const char* nameS = env->GetStringUTFChars(name, 0);
+	  SharedMemoryConnection* connection = SharedMemoryConnection::open(nameS, (long) timeOut);
+	  env->ReleaseStringUTFChars(name, nameS);
+
+	  return (jlong) connection;
+}
+
+/*
+ * Sends the header and then the message. The message is copied straight from the java array into the shared memory,
+ * one free part of the ring at a time, so there is a single copy on each side and no native buffer of the message size.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_send
+  (JNIEnv *env, jobject, jlong connectionPtr, jbyte type, jbyteArray data){
+	  SharedMemoryConnection* connection = (SharedMemoryConnection*) connectionPtr;
+	  FrameHeader header;
+	  header.length = env->GetArrayLength(data);
+	  header.type = type;
+
+	  if (connection->Send(&header, sizeof(FrameHeader)) == 0) {
+		  return false;
+	  }
+	  return connection->sendWith(header.length, [env, data](uint8_t* dest, size_t offset, size_t n) {
+		  env->GetByteArrayRegion(data, (jsize) offset, (jsize) n, (jbyte*) dest);
+	  });
+}
+
+/*
+ * Returns the type of the next message in the upper 32 bits and its length in the lower 32 bits, or -1 if the channel was closed.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_receiveHeader
+  (JNIEnv *, jobject, jlong connectionPtr){
+	  FrameHeader header;
+	  if (((SharedMemoryConnection*) connectionPtr)->Receive(&header, sizeof(FrameHeader)) == 0) {
+		  return -1;
+	  }
+	  return ((jlong) header.type << 32) | (uint32_t) header.length;
+}
+
+/*
+ * Receives the message whose header was received into the given array, which has the length of the message.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_receiveBody
+  (JNIEnv *env, jobject, jlong connectionPtr, jbyteArray data){
+	  return ((SharedMemoryConnection*) connectionPtr)->receiveWith(env->GetArrayLength(data),
+		  [env, data](const uint8_t* src, size_t offset, size_t n) {
+			  env->SetByteArrayRegion(data, (jsize) offset, (jsize) n, (const jbyte*) src);
+		  });
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_closeSegment
+  (JNIEnv *, jobject, jlong connectionPtr){
+	  ((SharedMemoryConnection*) connectionPtr)->Close();
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_deleteSegment
+  (JNIEnv *, jobject, jlong connectionPtr){
+	  delete (SharedMemoryConnection*) connectionPtr;
+}
@@ -0,0 +1,69 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel */
+
+#ifndef _Included_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+#define _Included_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    createSegment
+ * Signature: (Ljava/lang/String;JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_createSegment
+  (JNIEnv *, jobject, jstring, jlong, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    openSegment
+ * Signature: (Ljava/lang/String;J)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_openSegment
+  (JNIEnv *, jobject, jstring, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    send
+ * Signature: (JB[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_send
+  (JNIEnv *, jobject, jlong, jbyte, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    receiveHeader
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_receiveHeader
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    receiveBody
+ * Signature: (J[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_receiveBody
+  (JNIEnv *, jobject, jlong, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    closeSegment
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_closeSegment
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel
+ * Method:    deleteSegment
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_SharedMemoryChannel_deleteSegment
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,217 @@
+#include "SharedMemoryConnection.h"
+#include <chrono>
+#include <thread>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace std;
+
+// marks a segment that was fully initialized by its creator
+#define SEGMENT_MAGIC 0x53434d31
+
+// the number of times a waiting side checks the ring before it goes to sleep (a few microseconds).
+// on a single core the other side cannot make progress while we spin, so there we sleep at once.
+static const int spinCount = (thread::hardware_concurrency() > 1) ? 200 : 0;
+
+static_assert(sizeof(atomic<uint32_t>) == sizeof(uint32_t), "the futex words should be plain 32 bit integers");
+
+static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#else
+	this_thread::yield();
+#endif
+}
+
+/*
+ * Sleeps as long as the futex word holds the given value. The segment is shared between processes, so the futex is not private.
+ * Where there are no futexes the side sleeps for a short time and checks again.
+ */
+static void futexWait(atomic<uint32_t>* word, uint32_t value) {
+#ifdef __linux__
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAIT, value, NULL, NULL, 0);
+#else
+	if (word->load() == value) {
+		this_thread::sleep_for(chrono::microseconds(50));
+	}
+#endif
+}
+
+static void futexWake(atomic<uint32_t>* word) {
+#ifdef __linux__
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+#endif
+}
+
+/*
+ * Waits until ready() holds or the connection is closed.
+ * The waiting side reads the futex word, declares that it waits and checks again before it sleeps. The other side changes
+ * the ring, increments the futex word and then checks whether someone waits, so one of them always sees the other.
+ */
+template<typename Ready>
+static void waitUntil(atomic<uint32_t>* seq, atomic<uint32_t>* waiting, atomic<uint32_t>* closed, Ready ready) {
+	// the other side is usually about to catch up, so spin for a short while before sleeping
+	for (int i = 0; i < spinCount; i++) {
+		if (ready() || closed->load(memory_order_acquire)) {
+			return;
+		}
+		cpuRelax();
+	}
+
+	while (!ready() && !closed->load()) {
+		uint32_t value = seq->load();
+		waiting->store(1);
+		if (!ready() && !closed->load()) {
+			futexWait(seq, value);
+		}
+		waiting->store(0, memory_order_relaxed);
+	}
+}
+
+static void notify(atomic<uint32_t>* seq, atomic<uint32_t>* waiting) {
+	seq->fetch_add(1);
+	if (waiting->load()) {
+		futexWake(seq);
+	}
+}
+
+static size_t segmentSize(size_t capacity) {
+	return sizeof(SharedMemoryConnection::Segment) + 2 * capacity;
+}
+
+SharedMemoryConnection::SharedMemoryConnection(Segment* segment, size_t mappedSize, bool creator)
+	: segment(segment), mappedSize(mappedSize), capacity(segment->capacity) {
+	uint8_t* data = (uint8_t*) segment + sizeof(Segment);
+	sendRing = &segment->rings[creator ? 0 : 1];
+	receiveRing = &segment->rings[creator ? 1 : 0];
+	sendData = data + (creator ? 0 : capacity);
+	receiveData = data + (creator ? capacity : 0);
+}
+
+SharedMemoryConnection* SharedMemoryConnection::create(const string& name, size_t capacity, long timeOutMillis) {
+	shm_unlink(name.c_str());
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0) {
+		return NULL;
+	}
+
+	size_t size = segmentSize(capacity);
+	void* memory = MAP_FAILED;
+	if (ftruncate(fd, size) == 0) {
+		memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	close(fd);
+	if (memory == MAP_FAILED) {
+		shm_unlink(name.c_str());
+		return NULL;
+	}
+
+	Segment* segment = new (memory) Segment();
+	segment->attached.store(0);
+	segment->closed.store(0);
+	segment->capacity = capacity;
+	for (int i = 0; i < 2; i++) {
+		segment->rings[i].head.store(0);
+		segment->rings[i].tail.store(0);
+		segment->rings[i].dataSeq.store(0);
+		segment->rings[i].readerWaiting.store(0);
+		segment->rings[i].spaceSeq.store(0);
+		segment->rings[i].writerWaiting.store(0);
+	}
+	segment->magic.store(SEGMENT_MAGIC, memory_order_release);
+
+	// wait for the other side, and then remove the name. the segment itself lives until both sides unmap it.
+	auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeOutMillis);
+	while (!segment->attached.load(memory_order_acquire) && chrono::steady_clock::now() < deadline) {
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	shm_unlink(name.c_str());
+
+	if (!segment->attached.load(memory_order_acquire)) {
+		munmap(memory, size);
+		return NULL;
+	}
+	return new SharedMemoryConnection(segment, size, true);
+}
+
+SharedMemoryConnection* SharedMemoryConnection::open(const string& name, long timeOutMillis) {
+	auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeOutMillis);
+
+	do {
+		int fd = shm_open(name.c_str(), O_RDWR, 0600);
+		if (fd >= 0) {
+			struct stat st;
+			void* memory = MAP_FAILED;
+			size_t size = 0;
+			if (fstat(fd, &st) == 0 && (size_t) st.st_size >= sizeof(Segment)) {
+				size = st.st_size;
+				memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			}
+			close(fd);
+
+			if (memory != MAP_FAILED) {
+				Segment* segment = (Segment*) memory;
+				uint32_t notAttached = 0;
+				// a segment that is not initialized yet, or that was already taken by another party, is skipped
+				if (segment->magic.load(memory_order_acquire) == SEGMENT_MAGIC && size >= segmentSize(segment->capacity)
+					&& segment->attached.compare_exchange_strong(notAttached, 1)) {
+					return new SharedMemoryConnection(segment, size, false);
+				}
+				munmap(memory, size);
+			}
+		}
+		this_thread::sleep_for(chrono::milliseconds(1));
+	} while (chrono::steady_clock::now() < deadline);
+
+	return NULL;
+}
+
+SharedMemoryConnection::~SharedMemoryConnection() {
+	Close();
+	munmap(segment, mappedSize);
+}
+
+void SharedMemoryConnection::Close() {
+	segment->closed.store(1);
+	for (int i = 0; i < 2; i++) {
+		segment->rings[i].dataSeq.fetch_add(1);
+		futexWake(&segment->rings[i].dataSeq);
+		segment->rings[i].spaceSeq.fetch_add(1);
+		futexWake(&segment->rings[i].spaceSeq);
+	}
+}
+
+bool SharedMemoryConnection::waitForSpace() {
+	Ring* ring = sendRing;
+	size_t cap = capacity;
+	waitUntil(&ring->spaceSeq, &ring->writerWaiting, &segment->closed, [ring, cap]() {
+		return ring->head.load(memory_order_relaxed) - ring->tail.load() < cap;
+	});
+	return !segment->closed.load();
+}
+
+bool SharedMemoryConnection::waitForData() {
+	Ring* ring = receiveRing;
+	waitUntil(&ring->dataSeq, &ring->readerWaiting, &segment->closed, [ring]() {
+		return ring->head.load() != ring->tail.load(memory_order_relaxed);
+	});
+	// data that was written before the close is still delivered
+	return receiveRing->head.load() != receiveRing->tail.load(memory_order_relaxed);
+}
+
+void SharedMemoryConnection::publishWrite(uint64_t head) {
+	sendRing->head.store(head);
+	notify(&sendRing->dataSeq, &sendRing->readerWaiting);
+}
+
+void SharedMemoryConnection::publishRead(uint64_t tail) {
+	receiveRing->tail.store(tail);
+	notify(&receiveRing->spaceSeq, &receiveRing->writerWaiting);
+}
@@ -0,0 +1,148 @@
+#ifndef SHARED_MEMORY_CONNECTION_H
+#define SHARED_MEMORY_CONNECTION_H
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+/*
+ * A connection between two processes (or two threads) on the same host, over a shared memory segment.
+ *
+ * The segment holds two single producer single consumer ring buffers, one for each direction. The writer copies the data
+ * into the ring and advances the head, the reader copies it out and advances the tail, so the data never passes through
+ * the kernel. A side that waits for data (or for free space) spins for a short while and then sleeps on a futex in the
+ * segment. The other side wakes it only if it declared that it is waiting, so there is no system call while both sides keep up.
+ *
+ * The class has the Send and Receive functions of CSocket, so native code that sends over a CSocket can use it instead.
+ * Send and Receive block until all the given bytes were written or read, and return the number of bytes, or 0 if the
+ * connection was closed.
+ */
+class SharedMemoryConnection {
+public:
+	// the default capacity of each ring, in bytes
+	static const size_t DEFAULT_CAPACITY = 32 * 1024 * 1024;
+
+	/*
+	 * Creates the segment with the given name and waits until the other side opens it.
+	 * A stale segment with the same name (left by a process that crashed) is removed first.
+	 * Returns NULL if the segment cannot be created or the other side did not open it within the timeout.
+	 */
+	static SharedMemoryConnection* create(const std::string& name, size_t capacity, long timeOutMillis);
+
+	/*
+	 * Opens the segment with the given name, waiting for the other side to create it.
+	 * Returns NULL if the segment was not created within the timeout.
+	 */
+	static SharedMemoryConnection* open(const std::string& name, long timeOutMillis);
+
+	~SharedMemoryConnection();
+
+	int Send(const void* buf, int len) {
+		const uint8_t* src = (const uint8_t*) buf;
+		return sendWith(len, [src](uint8_t* dest, size_t offset, size_t n) { memcpy(dest, src + offset, n); }) ? len : 0;
+	}
+
+	int Receive(void* buf, int len) {
+		uint8_t* dest = (uint8_t*) buf;
+		return receiveWith(len, [dest](const uint8_t* src, size_t offset, size_t n) { memcpy(dest + offset, src, n); }) ? len : 0;
+	}
+
+	/*
+	 * Sends len bytes that are copied into the ring by copy(dest, offset, n), which should write the n bytes that start at
+	 * the given offset of the message to dest. This lets the caller copy straight from its own memory (a java array, for example)
+	 * into the shared memory.
+	 * Returns false if the connection was closed.
+	 */
+	template<typename Copy>
+	bool sendWith(size_t len, Copy copy) {
+		size_t done = 0;
+		while (done < len) {
+			if (!waitForSpace()) {
+				return false;
+			}
+			uint64_t head = sendRing->head.load(std::memory_order_relaxed);
+			size_t n = std::min((size_t) (capacity - (head - sendRing->tail.load(std::memory_order_acquire))), len - done);
+			size_t offset = head % capacity;
+			size_t first = std::min(n, capacity - offset);
+			copy(sendData + offset, done, first);
+			if (n > first) {
+				copy(sendData, done + first, n - first);
+			}
+			publishWrite(head + n);
+			done += n;
+		}
+		return true;
+	}
+
+	/*
+	 * Receives len bytes that are copied out of the ring by copy(src, offset, n), which should read the n bytes from src
+	 * into the given offset of the message.
+	 * Returns false if the connection was closed before all the bytes arrived.
+	 */
+	template<typename Copy>
+	bool receiveWith(size_t len, Copy copy) {
+		size_t done = 0;
+		while (done < len) {
+			if (!waitForData()) {
+				return false;
+			}
+			uint64_t tail = receiveRing->tail.load(std::memory_order_relaxed);
+			size_t n = std::min((size_t) (receiveRing->head.load(std::memory_order_acquire) - tail), len - done);
+			size_t offset = tail % capacity;
+			size_t first = std::min(n, capacity - offset);
+			copy(receiveData + offset, done, first);
+			if (n > first) {
+				copy(receiveData, done + first, n - first);
+			}
+			publishRead(tail + n);
+			done += n;
+		}
+		return true;
+	}
+
+	/*
+	 * Closes both directions. A side that waits on the connection is woken, and Send and Receive return 0 from now on
+	 * (Receive still returns the data that was written before the close).
+	 */
+	void Close();
+
+	// one direction of the connection. each field that is written by one side only is in its own cache line.
+	struct Ring {
+		alignas(64) std::atomic<uint64_t> head;				// the number of bytes written so far, advanced by the writer
+		alignas(64) std::atomic<uint64_t> tail;				// the number of bytes read so far, advanced by the reader
+		alignas(64) std::atomic<uint32_t> dataSeq;			// futex word of the reader, incremented after each write
+		std::atomic<uint32_t> readerWaiting;
+		alignas(64) std::atomic<uint32_t> spaceSeq;			// futex word of the writer, incremented after each read
+		std::atomic<uint32_t> writerWaiting;
+	};
+
+	// the header of the segment, followed by the data of the two rings
+	struct Segment {
+		std::atomic<uint32_t> magic;		// set by the creator when the segment is initialized
+		std::atomic<uint32_t> attached;		// set by the side that opened the segment
+		std::atomic<uint32_t> closed;
+		uint64_t capacity;
+		Ring rings[2];						// the creator sends on the first ring and receives on the second
+	};
+
+private:
+	SharedMemoryConnection(Segment* segment, size_t mappedSize, bool creator);
+
+	bool waitForSpace();
+	bool waitForData();
+	void publishWrite(uint64_t head);
+	void publishRead(uint64_t tail);
+
+	Segment* segment;
+	size_t mappedSize;
+	size_t capacity;
+	Ring* sendRing;
+	Ring* receiveRing;
+	uint8_t* sendData;
+	uint8_t* receiveData;
+};
+
+#endif
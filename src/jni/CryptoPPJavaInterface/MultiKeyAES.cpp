@@ -0,0 +1,168 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+// windows includes
+#include "StdAfx.h"
+
+// stdlib includes
+#include <vector>
+#include <string.h>
+
+// java jni includes
+#include "jni.h"
+
+// cryptopp includes
+#include "cryptlib.h"
+#include "aes.h"
+#include "modes.h"
+
+// local includes
+#include "MultiKeyAES.h"
+
+using namespace std;
+using namespace CryptoPP;
+
+/*
+ * Batch AES encryption under many keys.
+ * Each key gets its own AESEncryption object, and every run of consecutive blocks that use the same key is passed to 
+ * AdvancedProcessBlocks in one call, so that Crypto++ can use its parallel (AES-NI when available) implementation
+ * instead of encrypting the blocks one by one.
+ */
+typedef vector<AESEncryption*> MultiKeyAES;
+
+/* 
+ * function createKeys		: Creates an AES object for each one of the given keys.
+ * param keys				: The keys, one after the other.
+ * param numKeys			: The number of keys.
+ * param keySize			: The size of each key in bytes (16, 24 or 32).
+ * return					: A pointer to the AES objects.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpMultiKeyAES_createKeys
+  (JNIEnv *env, jobject, jbyteArray keys, jint numKeys, jint keySize){
+
+	  MultiKeyAES* aes = new MultiKeyAES(numKeys);
+	  jbyte* keyBytes = env->GetByteArrayElements(keys, 0);
+
+	  for (int k = 0; k < numKeys; k++) {
+		  (*aes)[k] = new AESEncryption((byte*) keyBytes + k*keySize, keySize);
+	  }
+
+	  //The keys are secret, make sure they are not left in the copied array.
+	  memset(keyBytes, 0, numKeys*keySize);
+	  env->ReleaseByteArrayElements(keys, keyBytes, JNI_ABORT);
+
+	  return (jlong) aes;
+}
+
+/* 
+ * function computeBlocks	: Encrypts numBlocks blocks in ECB mode. Block i is encrypted under key keyIndices[i],
+ *							  or under key i % numKeys if keyIndices is null.
+ * param aesPtr				: Pointer to the AES objects.
+ * param in, inOffset		: The input blocks.
+ * param out, outOffset		: The array to put the encrypted blocks in.
+ * param numBlocks			: The number of blocks to encrypt.
+ * param keyIndices			: The index of the key of each block. May be null.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpMultiKeyAES_computeBlocks
+  (JNIEnv *env, jobject, jlong aesPtr, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint numBlocks, jintArray keyIndices){
+
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+	  int numKeys = aes->size();
+
+	  //No JNI call is made until the arrays are released, so the arrays are accessed directly instead of being copied.
+	  jint* indices = (keyIndices == NULL) ? NULL : (jint*) env->GetPrimitiveArrayCritical(keyIndices, 0);
+	  byte* inBytes = (byte*) env->GetPrimitiveArrayCritical(in, 0) + inOffset;
+	  byte* outBytes = (byte*) env->GetPrimitiveArrayCritical(out, 0) + outOffset;
+
+	  int i = 0;
+	  while (i < numBlocks) {
+		  //Find the run of blocks that start at i and use the same key.
+		  int keyIndex = (indices == NULL) ? i % numKeys : indices[i];
+		  int end = i + 1;
+		  if (indices != NULL) {
+			  while (end < numBlocks && indices[end] == keyIndex) {
+				  end++;
+			  }
+		  } else if (numKeys == 1) {
+			  end = numBlocks;
+		  }
+
+		  (*aes)[keyIndex]->AdvancedProcessBlocks(inBytes + i*16, NULL, outBytes + i*16, (end - i)*16, BlockTransformation::BT_AllowParallel);
+		  i = end;
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, outBytes - outOffset, 0);
+	  env->ReleasePrimitiveArrayCritical(in, inBytes - inOffset, JNI_ABORT);
+	  if (indices != NULL) {
+		  env->ReleasePrimitiveArrayCritical(keyIndices, indices, JNI_ABORT);
+	  }
+}
+
+/* 
+ * function ctr				: Computes numBlocks blocks of the CTR mode keystream of the given key, starting from the counter 
+ *							  iv + counterOffset (as a 128 bit big endian number), and xors it with the input if given.
+ * param aesPtr				: Pointer to the AES objects.
+ * param keyIndex			: The index of the key to use.
+ * param iv					: The initial counter block.
+ * param counterOffset		: The index of the first block of the keystream to compute.
+ * param in, inOffset		: The input to xor with the keystream. If in is null, the keystream itself is written to out.
+ * param out, outOffset		: The array to put the result in.
+ * param numBlocks			: The number of blocks to compute.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpMultiKeyAES_ctr
+  (JNIEnv *env, jobject, jlong aesPtr, jint keyIndex, jbyteArray iv, jlong counterOffset, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint numBlocks){
+
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+
+	  byte ivBytes[16];
+	  env->GetByteArrayRegion(iv, 0, 16, (jbyte*) ivBytes);
+
+	  //The mode uses the existing key schedule of the AES object, Seek moves the counter to the requested block.
+	  CTR_Mode_ExternalCipher::Encryption ctr(*(*aes)[keyIndex], ivBytes);
+	  ctr.Seek((lword) counterOffset * 16);
+
+	  byte* outBytes = (byte*) env->GetPrimitiveArrayCritical(out, 0) + outOffset;
+	  if (in == NULL) {
+		  memset(outBytes, 0, numBlocks*16);
+		  ctr.ProcessData(outBytes, outBytes, numBlocks*16);
+	  } else {
+		  byte* inBytes = (byte*) env->GetPrimitiveArrayCritical(in, 0) + inOffset;
+		  ctr.ProcessData(outBytes, inBytes, numBlocks*16);
+		  env->ReleasePrimitiveArrayCritical(in, inBytes - inOffset, JNI_ABORT);
+	  }
+	  env->ReleasePrimitiveArrayCritical(out, outBytes - outOffset, 0);
+}
+
+/* 
+ * function deleteKeys		: Deletes the AES objects.
+ * param aesPtr				: Pointer to the AES objects.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpMultiKeyAES_deleteKeys
+  (JNIEnv *, jobject, jlong aesPtr){
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+	  for (size_t k = 0; k < aes->size(); k++) {
+		  delete (*aes)[k];
+	  }
+	  delete aes;
+}
@@ -28,6 +28,7 @@
 
 // stdlib includes
 #include <iostream>
+#include <atomic>
 
 // java jni includes
 #include "jni.h"
@@ -37,6 +38,7 @@
 #include "cryptlib.h"
 #include "osrng.h"
 #include "rabin.h"
+#include "modarith.h"
 
 // local includes
 #include "RSAPermutation.h"
@@ -254,6 +256,127 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 	  return (jlong) utils.getPointerToInteger(result);
 }
 
+/*
+ * The minimal number of elements given to each thread of a batch.
+ */
+#define MIN_RSA_ELEMENTS_PER_THREAD 16
+
+/*
+ * function computeRSABatch	: This function computes the RSA function on a batch of elements
+ * param tpPtr				: The pointer to the RSA object 
+ * param elements			: Pointers to the elements for the computation
+ * param numThreads			: The number of threads to split the batch between
+ * return jlongArray		: Pointers to the results, in the order of the elements
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_computeRSABatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements, jint numThreads) {
+
+	  int numElements = env->GetArrayLength(elements);
+	  vector<jlong> in(numElements + 1);
+	  vector<jlong> out(numElements + 1);
+	  env->GetLongArrayRegion(elements, 0, numElements, &in[0]);
+
+	  const Integer& n = ((RSAFunction *) tpPtr) -> GetModulus();
+	  const Integer& e = ((RSAFunction *) tpPtr) -> GetPublicExponent();
+
+	  //Each thread creates the Montgomery representation of n once and uses it for all its elements.
+	  runInThreads(numThreads, numElements, MIN_RSA_ELEMENTS_PER_THREAD, [&](int from, int to) {
+		  MontgomeryRepresentation mn(n);
+		  for (int i = from; i < to; i++) {
+			  Integer result = mn.ConvertOut(mn.Exponentiate(mn.ConvertIn(*(Integer*) in[i]), e));
+			  out[i] = (jlong) new Integer(result);
+		  }
+	  });
+
+	  jlongArray results = env->NewLongArray(numElements);
+	  env->SetLongArrayRegion(results, 0, numElements, &out[0]);
+	  return results;
+}
+
+/*
+ * function invertRSABatch	: This function inverts the RSA permutation on a batch of elements.
+ *							  Each thread prepares the Montgomery representations of p and q once, and blinds its elements
+ *							  with one random factor that is squared between the elements.
+ *							  A CRT result that fails the check is recomputed with the private exponent d.
+ * param tpPtr				: The pointer to the RSA object 
+ * param elements			: Pointers to the elements to invert
+ * param numThreads			: The number of threads to split the batch between
+ * return jlongArray		: Pointers to the results, in the order of the elements
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_invertRSABatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements, jint numThreads) {
+
+	  int numElements = env->GetArrayLength(elements);
+	  vector<jlong> in(numElements + 1);
+	  vector<jlong> out(numElements + 1);
+	  env->GetLongArrayRegion(elements, 0, numElements, &in[0]);
+
+	  InvertibleRSAFunction* rsa = (InvertibleRSAFunction *) tpPtr;
+	  const Integer& n = rsa -> GetModulus();
+	  const Integer& e = rsa -> GetPublicExponent();
+	  const Integer& p = rsa -> GetPrime1();
+	  const Integer& q = rsa -> GetPrime2();
+	  const Integer& dp = rsa -> GetModPrime1PrivateExponent();
+	  const Integer& dq = rsa -> GetModPrime2PrivateExponent();
+	  const Integer& u = rsa -> GetMultiplicativeInverseOfPrime2ModPrime1();
+	  const Integer& d = rsa -> GetPrivateExponent();
+	  atomic<bool> failed(false);
+
+	  runInThreads(numThreads, numElements, MIN_RSA_ELEMENTS_PER_THREAD, [&](int from, int to) {
+		  //The modular arithmetic objects keep their results in members, so each thread has its own objects.
+		  AutoSeededRandomPool rng;
+		  ModularArithmetic modn(n);
+		  ModularArithmetic modp(p);
+		  MontgomeryRepresentation mn(n);
+		  MontgomeryRepresentation mp(p);
+		  MontgomeryRepresentation mq(q);
+
+		  //The blinding factor r^e and its unblinding factor r^(-1).
+		  Integer r;
+		  do {
+			  r.Randomize(rng, Integer::One(), n - Integer::One());
+		  } while (Integer::Gcd(r, n) != Integer::One());
+		  Integer blind = mn.ConvertOut(mn.Exponentiate(mn.ConvertIn(r), e));
+		  Integer unblind = r.InverseMod(n);
+
+		  for (int i = from; i < to; i++) {
+			  Integer y = modn.Multiply(*(Integer*) in[i] % n, blind);
+
+			  //x = xq + q*(u*(xp - xq) mod p), where xp = y^dp mod p and xq = y^dq mod q.
+			  Integer xp = mp.ConvertOut(mp.Exponentiate(mp.ConvertIn(y % p), dp));
+			  Integer xq = mq.ConvertOut(mq.Exponentiate(mq.ConvertIn(y % q), dq));
+			  Integer x = xq + q * modp.Multiply(u, modp.Subtract(xp, xq % p));
+
+			  //Check the result before removing the blinding, as the single element inverse of Crypto++ does.
+			  //A fault in one of the half exponentiations would reveal p or q, so recompute x without the CRT if the check fails.
+			  if (mn.ConvertOut(mn.Exponentiate(mn.ConvertIn(x), e)) != y) {
+				  x = mn.ConvertOut(mn.Exponentiate(mn.ConvertIn(y), d));
+				  if (mn.ConvertOut(mn.Exponentiate(mn.ConvertIn(x), e)) != y) {
+					  failed = true;
+				  }
+			  }
+			  x = modn.Multiply(x, unblind);
+			  out[i] = (jlong) new Integer(x);
+
+			  blind = modn.Square(blind);
+			  unblind = modn.Square(unblind);
+		  }
+	  });
+
+	  //Like CalculateInverse, fail the operation instead of returning a wrong inverse.
+	  if (failed) {
+		  for (int i = 0; i < numElements; i++) {
+			  delete (Integer*) out[i];
+		  }
+		  env->ThrowNew(env->FindClass("java/lang/IllegalStateException"), "computational error during the RSA private key operation");
+		  return NULL;
+	  }
+
+	  jlongArray results = env->NewLongArray(numElements);
+	  env->SetLongArrayRegion(results, 0, numElements, &out[0]);
+	  return results;
+}
+
 /*
  * Delete the native object
  */
@@ -34,6 +34,7 @@
 #include "cryptlib.h"
 #include "osrng.h"
 #include "nbtheory.h"
+#include "modarith.h"
 
 // local includes
 #include "RabinPermutation.h"
@@ -358,6 +359,108 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 
 }
 
+/*
+ * The minimal number of elements given to each thread of a batch.
+ */
+#define MIN_RABIN_ELEMENTS_PER_THREAD 16
+
+/*
+ * function computeRabinBatch	: This function computes the Rabin function on a batch of elements
+ * param tpPtr					: The pointer to the Rabin object 
+ * param elements				: Pointers to the elements for the computation
+ * param numThreads				: The number of threads to split the batch between
+ * return jlongArray			: Pointers to the results, in the order of the elements
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_computeRabinBatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements, jint numThreads) {
+
+	  int numElements = env->GetArrayLength(elements);
+	  vector<jlong> in(numElements + 1);
+	  vector<jlong> out(numElements + 1);
+	  env->GetLongArrayRegion(elements, 0, numElements, &in[0]);
+
+	  ((RabinFunction *) tpPtr) -> DoQuickSanityCheck();
+	  const Integer& mod = ((RabinFunction *) tpPtr) -> GetModulus();
+
+	  runInThreads(numThreads, numElements, MIN_RABIN_ELEMENTS_PER_THREAD, [&](int from, int to) {
+		  for (int i = from; i < to; i++) {
+			  out[i] = (jlong) new Integer(((Integer*) in[i])->Squared() % mod);
+		  }
+	  });
+
+	  jlongArray results = env->NewLongArray(numElements);
+	  env->SetLongArrayRegion(results, 0, numElements, &out[0]);
+	  return results;
+}
+
+/*
+ * function invertRabinBatch	: This function inverts the Rabin permutation on a batch of elements.
+ *								  The CRT coefficients are computed once for the batch, and each thread prepares the 
+ *								  Montgomery representations of p and q once for all its elements.
+ * param tpPtr					: The pointer to the Rabin object 
+ * param elements				: Pointers to the elements to invert
+ * param numThreads				: The number of threads to split the batch between
+ * return jlongArray			: Pointers to the results, in the order of the elements. 
+ *								  As in invertRabin, the result of an element that has no valid square root is 0.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabinBatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements, jint numThreads) {
+
+	  int numElements = env->GetArrayLength(elements);
+	  vector<jlong> in(numElements + 1);
+	  vector<jlong> out(numElements + 1);
+	  env->GetLongArrayRegion(elements, 0, numElements, &in[0]);
+
+	  InvertibleRabinFunction* rabin = (InvertibleRabinFunction *) tpPtr;
+	  rabin->DoQuickSanityCheck();
+	  const Integer& mod = rabin->GetModulus();
+	  const Integer& p = rabin->GetPrime1();
+	  const Integer& q = rabin->GetPrime2();
+
+	  //The CRT coefficients, which invertRabin computes for every element.
+	  Integer v = p.InverseMod(q);
+	  Integer u = rabin->GetMultiplicativeInverseOfPrime2ModPrime1();
+	  Integer onep = (u * q) % mod;
+	  Integer oneq = (v * p) % mod;
+
+	  //For p = 3 mod 4 the square root of a mod p is a^((p+1)/4) mod p.
+	  bool fastRootP = (p % 4 == 3);
+	  bool fastRootQ = (q % 4 == 3);
+	  Integer rootExpP = (p + 1) >> 2;
+	  Integer rootExpQ = (q + 1) >> 2;
+
+	  runInThreads(numThreads, numElements, MIN_RABIN_ELEMENTS_PER_THREAD, [&](int from, int to) {
+		  //The modular arithmetic objects keep their results in members, so each thread has its own objects.
+		  ModularArithmetic modn(mod);
+		  MontgomeryRepresentation mp(p);
+		  MontgomeryRepresentation mq(q);
+
+		  for (int i = from; i < to; i++) {
+			  Integer x = *(Integer*) in[i];
+			  Integer cp = fastRootP ? mp.ConvertOut(mp.Exponentiate(mp.ConvertIn(x % p), rootExpP)) : ModularSquareRoot(x % p, p);
+			  Integer cq = fastRootQ ? mq.ConvertOut(mq.Exponentiate(mq.ConvertIn(x % q), rootExpQ)) : ModularSquareRoot(x % q, q);
+
+			  Integer outp[2] = { modn.Multiply(onep, cp), modn.Multiply(onep, p - cp) };
+			  Integer outq[2] = { modn.Multiply(oneq, cq), modn.Multiply(oneq, q - cq) };
+
+			  //Return the square root that is a quadratic residue itself, in the same order as invertRabin.
+			  Integer result = Integer::Zero();
+			  for (int j = 0; j < 4; j++) {
+				  Integer candidate = (outp[j / 2] + outq[j % 2]) % mod;
+				  if ((Jacobi(candidate % p, p) == 1) && (Jacobi(candidate % q, q) == 1)) {
+					  result = candidate;
+					  break;
+				  }
+			  }
+			  out[i] = (jlong) new Integer(result);
+		  }
+	  });
+
+	  jlongArray results = env->NewLongArray(numElements);
+	  env->SetLongArrayRegion(results, 0, numElements, &out[0]);
+	  return results;
+}
+
 /*
  * Delete the native object
  */
@@ -136,6 +136,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabin
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation
+ * Method:    computeRabinBatch
+ * Signature: (J[JI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_computeRabinBatch
+  (JNIEnv *, jobject, jlong, jlongArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation
+ * Method:    invertRabinBatch
+ * Signature: (J[JI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabinBatch
+  (JNIEnv *, jobject, jlong, jlongArray, jint);
+
 /*
  * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation
  * Method:    deleteRabin
@@ -32,6 +32,8 @@
 
 #include "jni.h" 
 #include "cryptlib.h"
+#include <vector>
+#include <thread>
 
 using namespace CryptoPP;
 
@@ -49,5 +51,27 @@ public:
 	bool HasSquareRoot(Integer value, Integer p, Integer q);
 };
 
+/*
+ * Splits the indices [0, numElements) to contiguous ranges of at least minPerThread indices each,
+ * and calls worker(from, to) on each range in a different thread, up to numThreads threads.
+ * The calling thread runs the last range.
+ */
+template<class Worker> void runInThreads(int numThreads, int numElements, int minPerThread, Worker worker) {
+	int threadCount = (numThreads < 1) ? 1 : numThreads;
+	if (threadCount > numElements / minPerThread) {
+		threadCount = (numElements / minPerThread > 0) ? numElements / minPerThread : 1;
+	}
+
+	std::vector<std::thread> threads;
+	int perThread = numElements / threadCount;
+	for (int t = 0; t < threadCount - 1; t++) {
+		threads.push_back(std::thread(worker, t*perThread, (t+1)*perThread));
+	}
+	worker((threadCount-1)*perThread, numElements);
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+}
+
 
 #endif
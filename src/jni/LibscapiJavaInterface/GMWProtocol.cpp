@@ -20,9 +20,12 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_createGMWParty
     shared_ptr<Circuit> circuit = make_shared<Circuit>();
     circuit->readCircuit(circuitFile);
 
-cout<<"after circuit"<<endl;
 	//Create the GMW party. This is the class that executes the protocol.
     GMWParty* party = new GMWParty(id, circuit, partiesFile, numThreads, inputFile);
+
+	env->ReleaseStringUTFChars(circuitFileName, circuitFile);
+	env->ReleaseStringUTFChars(partiesFileName, partiesFile);
+	env->ReleaseStringUTFChars(inputsFileName, inputFile);
 	
 	//Return a pointer to the protocol object.
     return (long) party;
@@ -46,6 +49,31 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runProtocol
 	return result;
 }
 
+/**
+ * Run the offline phase of the GMW protocol, which generates the multiplication triples of the next online phase.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOffline
+		(JNIEnv *, jobject, jlong party){
+
+	((GMWParty*)party)->runOffline();
+}
+
+/**
+ * Run the online phase of the GMW protocol, using the multiplication triples of the last offline phase.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOnline
+		(JNIEnv *env, jobject, jlong party){
+
+    auto output = ((GMWParty*)party)->runOnline();
+
+	//Create a jni object and fill it with the protocol output.
+	jbyteArray result = env->NewByteArray(output.size());
+	env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
+
+	//Return the output
+	return result;
+}
+
 /**
  * Delete the allocated memory.
  */
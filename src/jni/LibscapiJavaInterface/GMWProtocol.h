@@ -31,6 +31,22 @@ extern "C" {
 	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runProtocol
 		(JNIEnv *, jobject, jlong);
 
+	/*
+	* Class:     edu_biu_SCProtocols_gmw_GmwParty
+	* Method:    runOffline
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOffline
+		(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_gmw_GmwParty
+	* Method:    runOnline
+	* Signature: (J)[B
+	*/
+	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOnline
+		(JNIEnv *, jobject, jlong);
+
 	/*
 	* Class:     edu_biu_SCProtocols_gmw_GmwParty
 	* Method:    deleteGMW
@@ -1,63 +1,127 @@
 #include "YaoProtocol.h"
 #include <libscapi/protocols/SemiHonestYao/YaoParties.hpp>
 
+/**
+ * The native object that is held by the java YaoParty.
+ * Besides the party itself, it keeps the time of each iteration that was executed since the last call to runProtocol.
+ */
+struct YaoPartyHolder {
+	int id;
+	PartyOne* p1;
+	PartyTwo* p2;
+	vector<double> iterationMillis;
+
+	YaoPartyHolder(int id, YaoConfig & yao_config) : id(id), p1(NULL), p2(NULL) {
+		if (id == 1) {
+			p1 = new PartyOne(yao_config);
+			p1->setInputs(yao_config.input_file_1);
+		} else {
+			p2 = new PartyTwo(yao_config);
+			p2->setInputs(yao_config.input_file_2);
+		}
+	}
+
+	~YaoPartyHolder() {
+		delete p1;
+		delete p2;
+	}
+
+	int numberOfIterations() {
+		return (id == 1) ? p1->getConfig().number_of_iterations : p2->getConfig().number_of_iterations;
+	}
+
+	/**
+	 * Runs one iteration of the protocol and keeps its time.
+	 */
+	void runIteration() {
+		auto start = scapi_now();
+		if (id == 1)
+			p1->run();
+		else
+			p2->run();
+		auto end = scapi_now();
+		iterationMillis.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0);
+	}
+
+	/**
+	 * Returns the output of the last iteration. In case of party one, the output is empty. (p1 has no output in this protocol)
+	 */
+	jbyteArray getOutput(JNIEnv *env) {
+		if (id == 1) {
+			return env->NewByteArray(0);
+		}
+		auto output = p2->getOutput();
+		jbyteArray result = env->NewByteArray(output.size());
+		env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
+		return result;
+	}
+};
+
 /**
  * Create the Yao party.
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_createYaoParty
 (JNIEnv *env, jobject, jint id, jstring configFileName) {
+	if (id != 1 && id != 2) {
+		return 0;
+	}
 	//Convert the jni objects to c++ objects.
 	const char* configFile = env->GetStringUTFChars(configFileName, NULL);
 	YaoConfig yao_config(configFile);
-	if (id == 1) {
-		PartyOne * p1 = new PartyOne(yao_config);
-		p1->setInputs(yao_config.input_file_1);
-		return (long)p1;
-	} else if (id == 2) {
-		PartyTwo * p2 = new PartyTwo(yao_config);
-		p2->setInputs(yao_config.input_file_2);
-		return (long)p2;
-	}
+	env->ReleaseStringUTFChars(configFileName, configFile);
+
+	return (jlong) new YaoPartyHolder(id, yao_config);
 }
 
 /**
  *  Run the protocol according the number of execution given in the config file.
  * In case of party two, the output is the output of the circuit.
  * In case of party one, the output is an empty array. (p1 has no input in this protocol)
+ * The time of each iteration can be read afterwards using getIterationMillis.
  */
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_runProtocol
 (JNIEnv *env, jobject,  jint id, jlong party) {
-	
-	int number_of_iterations;
-	if (id == 1)
-		number_of_iterations = ((PartyOne*)party)->getConfig().number_of_iterations;
-	else if (id == 2)
-		number_of_iterations = ((PartyTwo*)party)->getConfig().number_of_iterations;
+	YaoPartyHolder* holder = (YaoPartyHolder*) party;
+	int number_of_iterations = holder->numberOfIterations();
 
-	auto all = scapi_now();
+	holder->iterationMillis.clear();
+	holder->iterationMillis.reserve(number_of_iterations);
 	for (int i = 0; i < number_of_iterations; i++) {
 		// run the protocol
-		if (id == 1)
-			((PartyOne*)party)->run();
-		else if (id == 2)
-			((PartyTwo*)party)->run();
+		holder->runIteration();
 	}
-	auto end = std::chrono::system_clock::now();
-	int elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - all).count();
-	cout << "Running " << number_of_iterations <<
-		" iterations took: " << elapsed_ms << " milliseconds" << endl
-		<< "Average time per iteration: " << elapsed_ms / (float)number_of_iterations << " milliseconds" << endl;
 
 	//Create a jni object and fill it with the protocol output.
-	jbyteArray result = env->NewByteArray(0);
-	
-	if (id == 2) {
-		auto output = ((PartyTwo*)party)->getOutput();
-		result = env->NewByteArray(output.size());
-		env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
-	}
+	return holder->getOutput(env);
+}
+
+/**
+ * Run a single iteration of the protocol and return its output.
+ * Used by the java side in order to run several parties in a pipeline.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_runIteration
+(JNIEnv *env, jobject, jint id, jlong party) {
+	YaoPartyHolder* holder = (YaoPartyHolder*) party;
+	holder->runIteration();
+	return holder->getOutput(env);
+}
+
+/**
+ * Return the number of iterations that is given in the config file.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_getNumberOfIterations
+(JNIEnv *, jobject, jint id, jlong party) {
+	return ((YaoPartyHolder*) party)->numberOfIterations();
+}
 
-	//Return the output
+/**
+ * Return the time in milliseconds of each iteration since the last call to runProtocol.
+ */
+JNIEXPORT jdoubleArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_getIterationMillis
+(JNIEnv *env, jobject, jlong party) {
+	vector<double> & millis = ((YaoPartyHolder*) party)->iterationMillis;
+	jdoubleArray result = env->NewDoubleArray(millis.size());
+	env->SetDoubleArrayRegion(result, 0, millis.size(), millis.data());
 	return result;
 }
 
@@ -66,8 +130,5 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoPar
  */
 JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_deleteYao
 (JNIEnv *, jobject, jint id, jlong party) {
-	if (id == 1)
-		delete (PartyOne*)party;
-	else if (id == 2)
-		delete (PartyTwo*)party;
+	delete (YaoPartyHolder*) party;
 }
\ No newline at end of file
@@ -23,6 +23,30 @@ extern "C" {
 	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_runProtocol
 		(JNIEnv *, jobject, jint, jlong);
 
+	/*
+	* Class:     edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty
+	* Method:    runIteration
+	* Signature: (IJ)[B
+	*/
+	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_runIteration
+		(JNIEnv *, jobject, jint, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty
+	* Method:    getNumberOfIterations
+	* Signature: (IJ)I
+	*/
+	JNIEXPORT jint JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_getNumberOfIterations
+		(JNIEnv *, jobject, jint, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty
+	* Method:    getIterationMillis
+	* Signature: (J)[D
+	*/
+	JNIEXPORT jdoubleArray JNICALL Java_edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty_getIterationMillis
+		(JNIEnv *, jobject, jlong);
+
 	/*
 	* Class:     edu_biu_SCProtocols_NativeSemiHonestYao_YaoParty
 	* Method:    deleteYao
@@ -1,5 +1,114 @@
 #include "YaoSingleExecutionProtocol.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
+/**
+ * The converted circuits, by the hash of the original circuit file.
+ * The converted file name is derived from the hash, so each circuit is converted once in the process and parties that
+ * use the same circuit (in this process or in another one) share the converted file instead of racing on a fixed file name.
+ */
+static map<string, string> convertedCircuits;
+static mutex convertedCircuitsMutex;
+
+/**
+ * Return the 64 bit FNV-1a hash of the given content, as a hexadecimal string.
+ */
+static string contentHash(const string & content) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < content.size(); i++) {
+		hash ^= (unsigned char)content[i];
+		hash *= 1099511628211ULL;
+	}
+	stringstream stream;
+	stream << hex << hash << "_" << dec << content.size();
+	return stream.str();
+}
+
+/**
+ * Return the name of a file that holds the given scapi circuit in the format of EMP.
+ * The circuit file is read to memory and hashed. If a circuit with the same content was already converted, its file is used.
+ * Otherwise, the circuit is converted to a temporary file that is renamed to its final name only when it is complete.
+ */
+static string getConvertedCircuit(const char* circuitFile) {
+	ifstream in(circuitFile, ios::binary);
+	stringstream content;
+	content << in.rdbuf();
+	string hash = contentHash(content.str());
+
+	lock_guard<mutex> lock(convertedCircuitsMutex);
+	auto cached = convertedCircuits.find(hash);
+	if (cached != convertedCircuits.end()) {
+		return cached->second;
+	}
+
+	string newCircuit = "emp_format_circuit_" + hash + ".txt";
+	//A file with this name is complete, since it is created by rename.
+	if (!ifstream(newCircuit).good()) {
+		static atomic<int> counter(0);
+		stringstream tempName;
+		tempName << newCircuit << "." << std::hash<std::thread::id>()(this_thread::get_id()) << "."
+			<< chrono::steady_clock::now().time_since_epoch().count() << "." << counter++ << ".tmp";
+		CircuitConverter::convertScapiToBristol(circuitFile, tempName.str(), false);
+		if (rename(tempName.str().c_str(), newCircuit.c_str()) != 0) {
+			//Another process already created the file, with the same content.
+			remove(tempName.str().c_str());
+		}
+	}
+	convertedCircuits[hash] = newCircuit;
+	return newCircuit;
+}
+
+/**
+ * The native object that is held by the java YaoSEParty.
+ * The native party executes the protocol once, so after its online phase it is replaced by a new party on the same
+ * connection parameters and the cached circuit. Thus, the java party can run many offline and online phases, with new inputs.
+ * The native party reads its inputs when it is created, so it is created only when an execution begins, with the inputs file
+ * that was set last. Both sides create their parties at the same points, so their connections still match.
+ */
+struct YaoSEPartyHolder {
+	int id;
+	string circuitFile;		//The circuit in the format of EMP.
+	string ip;
+	int port;
+	string inputFile;		//The inputs of the next execution.
+	YaoSEParty* party;		//The party of the current execution, or NULL before the first execution.
+	bool used;				//Indicates that the party already executed its online phase.
+
+	YaoSEPartyHolder(int id, const string & circuitFile, const string & ip, int port, const string & inputFile)
+		: id(id), circuitFile(circuitFile), ip(ip), port(port), inputFile(inputFile), party(NULL), used(false) {
+	}
+
+	~YaoSEPartyHolder() {
+		delete party;
+	}
+
+	/**
+	 * Return a party that can run a new execution, creating it with the current inputs file if there is no such party.
+	 * The connection of the used party is closed before the new party connects.
+	 */
+	YaoSEParty* getParty() {
+		if (party == NULL || used) {
+			delete party;
+			party = NULL;
+			party = new YaoSEParty(id, circuitFile, ip, port, inputFile);
+			used = false;
+		}
+		return party;
+	}
+
+	jbyteArray getOutput(JNIEnv *env) {
+		auto output = party->getOutput();
+		jbyteArray result = env->NewByteArray(output.size());
+		env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
+		return result;
+	}
+};
 
 JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_createYaoSEParty
 (JNIEnv * env, jobject, jint id, jstring circuitFileName, jstring ipAddress, jint port, jstring inputsFileName) {
@@ -9,51 +118,58 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_c
 	const char* ip = env->GetStringUTFChars(ipAddress, NULL);
 	const char* inputFile = env->GetStringUTFChars(inputsFileName, NULL);
 
-	string newCircuit = "emp_format_circuit.txt";
-	CircuitConverter::convertScapiToBristol(circuitFile, newCircuit, false);
+	string newCircuit = getConvertedCircuit(circuitFile);
+
+	//Create the Yao party. This is the class that executes the protocol.
+	YaoSEPartyHolder* holder = new YaoSEPartyHolder(id, newCircuit, ip, port, inputFile);
 
-	//Create the GMW party. This is the class that executes the protocol.
-	YaoSEParty* party = new YaoSEParty(id, newCircuit, ip, port, inputFile);
+	env->ReleaseStringUTFChars(circuitFileName, circuitFile);
+	env->ReleaseStringUTFChars(ipAddress, ip);
+	env->ReleaseStringUTFChars(inputsFileName, inputFile);
 
 	//Return a pointer to the protocol object.
-	return (long)party;
+	return (long)holder;
+}
+
+/**
+ * Set the inputs file of the next execution. It is read when the party of that execution is created, at its beginning.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_setInputs
+(JNIEnv * env, jobject, jlong party, jstring inputsFileName) {
+	const char* inputFile = env->GetStringUTFChars(inputsFileName, NULL);
+	((YaoSEPartyHolder*)party)->inputFile = inputFile;
+	env->ReleaseStringUTFChars(inputsFileName, inputFile);
 }
 
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_runProtocol
 (JNIEnv *env, jobject, jlong party) {
+	YaoSEPartyHolder* holder = (YaoSEPartyHolder*)party;
 	//Run the protocol/
-	((YaoSEParty*)party)->run();
-	auto output = ((YaoSEParty*)party)->getOutput();
+	holder->getParty()->run();
+	holder->used = true;
 
 	//Create a jni object and fill it with the protocol output.
-	jbyteArray result = env->NewByteArray(output.size());
-	env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
-
-	//Return the output
-	return result;
+	return holder->getOutput(env);
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_runOfflineProtocol
 (JNIEnv *, jobject, jlong party) {
 	//Run the protocol/
-	((YaoSEParty*)party)->runOffline();
+	((YaoSEPartyHolder*)party)->getParty()->runOffline();
 }
 
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_runOnlineProtocol
 (JNIEnv *env, jobject, jlong party) {
+	YaoSEPartyHolder* holder = (YaoSEPartyHolder*)party;
 	//Run the protocol/
-	((YaoSEParty*)party)->runOnline();
-	auto output = ((YaoSEParty*)party)->getOutput();
+	holder->party->runOnline();
+	holder->used = true;
 
 	//Create a jni object and fill it with the protocol output.
-	jbyteArray result = env->NewByteArray(output.size());
-	env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
-
-	//Return the output
-	return result;
+	return holder->getOutput(env);
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_deleteYaoSE
 (JNIEnv *, jobject, jlong party) {
-	delete (YaoSEParty*)party;
-}
\ No newline at end of file
+	delete (YaoSEPartyHolder*)party;
+}
@@ -18,6 +18,14 @@ extern "C" {
 	JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_createYaoSEParty
 		(JNIEnv *, jobject, jint, jstring, jstring, jint, jstring);
 
+	/*
+	* Class:     edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty
+	* Method:    setInputs
+	* Signature: (JLjava/lang/String;)V
+	*/
+	JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty_setInputs
+		(JNIEnv *, jobject, jlong, jstring);
+
 	/*
 	* Class:     edu_biu_SCProtocols_YaoSingleExecution_YaoSEParty
 	* Method:    runProtocol
@@ -2,28 +2,98 @@
 #include <string.h>
 #include <iostream>
 #include <MaliciousOTExtension/util/socket.h>
+#include <vector>
 
 using namespace std;
 using namespace maliciousot;
 
+/*
+ * A connected socket of the native channel together with its reusable buffers.
+ * The buffers only grow, so after the first messages sending and receiving do not allocate native memory.
+ */
+struct NativeChannelSocket {
+	CSocket sock;
+
+	// holds the frames (4 bytes length and the message) that are sent in a single call to Send
+	vector<BYTE> sendBuf;
+
+	// holds the received message that is copied to java
+	vector<BYTE> receiveBuf;
+
+	// the size of a message that was already read into receiveBuf but did not fit in the buffer given by the caller, -1 if there is none
+	int pendingSize;
+
+	NativeChannelSocket() : pendingSize(-1) {}
+};
+
+// messages larger than this are sent directly from the java array instead of being copied to the send buffer
+#define MAX_GATHERED_MESSAGE_SIZE (64 * 1024)
+
+static void ensureSize(vector<BYTE>& buf, size_t size) {
+	if (buf.size() < size) {
+		buf.resize(size);
+	}
+}
+
+/*
+ * Sends the framed message, that is, the 4 bytes of its size followed by the message.
+ * small messages are gathered with their size into the send buffer and sent in a single call, 
+ * so there is one system call and no allocation per message.
+ */
+static void sendFramed(JNIEnv *env, NativeChannelSocket* s, jbyteArray data) {
+	int size = env->GetArrayLength(data);
+
+	if (size > MAX_GATHERED_MESSAGE_SIZE) {
+		// the cost of the extra system call is negligible compared to copying a large message
+		jbyte* msg = env->GetByteArrayElements(data, 0);
+		s->sock.Send(&size, sizeof(int));
+		s->sock.Send((char*)msg, size);
+		env->ReleaseByteArrayElements(data, msg, JNI_ABORT);
+		return;
+	}
+
+	ensureSize(s->sendBuf, sizeof(int) + size);
+	memcpy(s->sendBuf.data(), &size, sizeof(int));
+	env->GetByteArrayRegion(data, 0, size, (jbyte*) s->sendBuf.data() + sizeof(int));
+	s->sock.Send(s->sendBuf.data(), sizeof(int) + size);
+}
+
+/*
+ * Receives the size of the next message and the message itself into the receive buffer, unless such a message is already pending.
+ */
+static int receiveToBuffer(NativeChannelSocket* s) {
+	if (s->pendingSize >= 0) {
+		int size = s->pendingSize;
+		s->pendingSize = -1;
+		return size;
+	}
+
+	int size;
+	s->sock.Receive((BYTE*) &size, sizeof(int));
+
+	ensureSize(s->receiveBuf, size);
+	s->sock.Receive(s->receiveBuf.data(), size);
+	return size;
+}
+
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_initSendSocket
   (JNIEnv *env, jobject, jstring ip, jint port){
 
 	 const char* ipS = env->GetStringUTFChars(ip, 0);
 	
-	 CSocket* s = new CSocket();
-	 s->Socket();
+	 NativeChannelSocket* s = new NativeChannelSocket();
+	 s->sock.Socket();
 	 
-	 bool connect = s->Connect(ipS, port);
+	 bool connect = s->sock.Connect(ipS, port);
 	 
 	 env->ReleaseStringUTFChars(ip, ipS);
 
 	 if (connect){
-		 s->DisableNagle();
+		 s->sock.DisableNagle();
 		 return (long) s;
 	 } else{ 
-		 return 0;
 		 delete s;
+		 return 0;
 	 }
 
 }
@@ -31,42 +101,108 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_initS
 JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_send
   (JNIEnv *env, jobject, jlong sendSocketPtr, jbyteArray data){
 	  
-	  jbyte* msg = env->GetByteArrayElements(data, 0);
+	  sendFramed(env, (NativeChannelSocket*) sendSocketPtr, data);
+}
 
-	  int size = env->GetArrayLength(data);
-	  ((CSocket*)sendSocketPtr)->Send(&size, sizeof(int));
-	  
-	  ((CSocket*)sendSocketPtr)->Send((char*)msg, size);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_sendMany
+  (JNIEnv *env, jobject, jlong sendSocketPtr, jobjectArray messages){
 
-	  env->ReleaseByteArrayElements(data, msg, 0);
-}
+	  NativeChannelSocket* s = (NativeChannelSocket*) sendSocketPtr;
+	  int numMessages = env->GetArrayLength(messages);
+	  size_t offset = 0;
 
+	  // GetArrayLength crashes on a null message, so check all of them before anything is sent
+	  for (int i = 0; i < numMessages; i++) {
+		  jobject data = env->GetObjectArrayElement(messages, i);
+		  if (data == NULL) {
+			  env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "a message to send is null");
+			  return;
+		  }
+		  env->DeleteLocalRef(data);
+	  }
+
+	  // gather the frames of consecutive small messages into the send buffer and send them together
+	  for (int i = 0; i < numMessages; i++) {
+		  jbyteArray data = (jbyteArray) env->GetObjectArrayElement(messages, i);
+		  int size = env->GetArrayLength(data);
+
+		  if (size > MAX_GATHERED_MESSAGE_SIZE || offset + sizeof(int) + size > MAX_GATHERED_MESSAGE_SIZE) {
+			  if (offset > 0) {
+				  s->sock.Send(s->sendBuf.data(), offset);
+				  offset = 0;
+			  }
+		  }
+
+		  if (size > MAX_GATHERED_MESSAGE_SIZE) {
+			  sendFramed(env, s, data);
+		  } else {
+			  ensureSize(s->sendBuf, offset + sizeof(int) + size);
+			  memcpy(s->sendBuf.data() + offset, &size, sizeof(int));
+			  env->GetByteArrayRegion(data, 0, size, (jbyte*) s->sendBuf.data() + offset + sizeof(int));
+			  offset += sizeof(int) + size;
+		  }
+
+		  env->DeleteLocalRef(data);
+	  }
+
+	  if (offset > 0) {
+		  s->sock.Send(s->sendBuf.data(), offset);
+	  }
+}
 
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_receive
   (JNIEnv *env, jobject, jlong receiveSocketPtr){
 	  
-	  int size;
-	  ((CSocket*)receiveSocketPtr)->Receive((BYTE*) &size, sizeof(int));
-	   
-	  char* buf = new char[size];
-	  ((CSocket*)receiveSocketPtr)->Receive(buf, size*sizeof(char));
-
-	 jbyteArray received = env->NewByteArray(size);
-	  env->SetByteArrayRegion(received, 0, size, (jbyte*)buf);
+	  NativeChannelSocket* s = (NativeChannelSocket*) receiveSocketPtr;
+	  int size = receiveToBuffer(s);
 
-	  delete buf;
+	  jbyteArray received = env->NewByteArray(size);
+	  env->SetByteArrayRegion(received, 0, size, (jbyte*) s->receiveBuf.data());
 
 	  return received;
 
 }
 
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_receiveDirect
+  (JNIEnv *env, jobject, jlong receiveSocketPtr, jobject buffer, jint offset, jint capacity){
+
+	  NativeChannelSocket* s = (NativeChannelSocket*) receiveSocketPtr;
+	  BYTE* dest = (BYTE*) env->GetDirectBufferAddress(buffer) + offset;
+
+	  // a message that did not fit in the previous buffer is already in the receive buffer
+	  if (s->pendingSize >= 0) {
+		  int size = s->pendingSize;
+		  if (size > capacity) {
+			  return -size;
+		  }
+		  memcpy(dest, s->receiveBuf.data(), size);
+		  s->pendingSize = -1;
+		  return size;
+	  }
+
+	  int size;
+	  s->sock.Receive((BYTE*) &size, sizeof(int));
+
+	  // the message is read directly into the caller's buffer
+	  if (size <= capacity) {
+		  s->sock.Receive(dest, size);
+		  return size;
+	  }
+
+	  // the message does not fit, keep it until it is asked for with a large enough buffer
+	  ensureSize(s->receiveBuf, size);
+	  s->sock.Receive(s->receiveBuf.data(), size);
+	  s->pendingSize = size;
+	  return -size;
+}
+
 JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_closeSockets
   (JNIEnv *, jobject, jlong sendSocketPtr, jlong receiveSocketPtr){
-	  ((CSocket*)sendSocketPtr)->Close();
-	  ((CSocket*)receiveSocketPtr)->Close();
+	  ((NativeChannelSocket*)sendSocketPtr)->sock.Close();
+	  ((NativeChannelSocket*)receiveSocketPtr)->sock.Close();
 
-	  delete (CSocket*)sendSocketPtr;
-	  delete (CSocket*)receiveSocketPtr;
+	  delete (NativeChannelSocket*)sendSocketPtr;
+	  delete (NativeChannelSocket*)receiveSocketPtr;
 }
 
 //JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_enableNagle
@@ -109,15 +245,15 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeSocketListene
 		return 0;
 	  }
     
-	  CSocket* sock = new CSocket();
+	  NativeChannelSocket* s = new NativeChannelSocket();
 	  
-	  if(!((CSocket*)serverSocketPtr)->Accept(*sock)) {
-		  delete sock;
+	  if(!((CSocket*)serverSocketPtr)->Accept(s->sock)) {
+		  delete s;
 	      return 0;
 	  }
 
-	  sock->DisableNagle();
-	  return (long) sock;	  
+	  s->sock.DisableNagle();
+	  return (long) s;	  
 	
 }
 
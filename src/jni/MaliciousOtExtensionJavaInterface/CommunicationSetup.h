@@ -33,6 +33,22 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_send
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_receive
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    sendMany
+ * Signature: (J[[B)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_sendMany
+  (JNIEnv *, jobject, jlong, jobjectArray);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    receiveDirect
+ * Signature: (JLjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_receiveDirect
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
 /*
  * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
  * Method:    closeSockets
@@ -0,0 +1,370 @@
+#include "KOSOTExtension.h"
+
+#include <openssl/sha.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#include <string.h>
+
+using namespace maliciousot;
+
+/*
+ * transposes a bit matrix of nrows x ncols (row major, bit i of a row is bit i%8 of byte i/8)
+ * into a matrix of ncols x nrows. nrows must be a multiple of 16 and ncols a multiple of 8.
+ */
+static void transpose(const BYTE* inp, BYTE* out, int nrows, int ncols) {
+    union { __m128i x; BYTE b[16]; } tmp;
+
+    for (int rr = 0; rr <= nrows - 16; rr += 16) {
+	for (int cc = 0; cc < ncols; cc += 8) {
+	    for (int i = 0; i < 16; ++i) {
+		tmp.b[i] = inp[(rr + i) * ncols / 8 + cc / 8];
+	    }
+	    for (int i = 8; --i >= 0; tmp.x = _mm_slli_epi64(tmp.x, 1)) {
+		*(unsigned short*) &out[(cc + i) * nrows / 8 + rr / 8] = (unsigned short) _mm_movemask_epi8(tmp.x);
+	    }
+	}
+    }
+}
+
+/*
+ * carry-less multiplication of two 128-bit values into a 256-bit result (lo, hi).
+ */
+static inline void clmul128(__m128i a, __m128i b, __m128i* lo, __m128i* hi) {
+    __m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t1 = _mm_clmulepi64_si128(a, b, 0x10);
+    __m128i t2 = _mm_clmulepi64_si128(a, b, 0x01);
+    __m128i t3 = _mm_clmulepi64_si128(a, b, 0x11);
+    t1 = _mm_xor_si128(t1, t2);
+    *lo = _mm_xor_si128(t0, _mm_slli_si128(t1, 8));
+    *hi = _mm_xor_si128(t3, _mm_srli_si128(t1, 8));
+}
+
+/*
+ * reduces a 256-bit value modulo x^128 + x^7 + x^2 + x + 1.
+ */
+static inline __m128i gf_reduce(__m128i lo, __m128i hi) {
+    const __m128i poly = _mm_set_epi64x(0, 0x87);
+
+    // fold the upper 64 bits of hi (x^192 = x^64 * (x^7 + x^2 + x + 1))
+    __m128i a = _mm_clmulepi64_si128(hi, poly, 0x01);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(a, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(a, 8));
+
+    // fold the lower 64 bits of hi (x^128 = x^7 + x^2 + x + 1)
+    __m128i b = _mm_clmulepi64_si128(hi, poly, 0x00);
+    return _mm_xor_si128(lo, b);
+}
+
+// --------------------------------------------------------------------------------
+
+KOSOTExtensionCommon::KOSOTExtensionCommon(CSocket& sock, int stat_security_bits) : m_sock(sock) {
+    m_stat_security_bits = stat_security_bits;
+    m_ot_counter = 0;
+    m_zeros = NULL;
+    m_zeros_size = 0;
+}
+
+KOSOTExtensionCommon::~KOSOTExtensionCommon() {
+    delete [] m_zeros;
+}
+
+int KOSOTExtensionCommon::padded_rows(int num_ots) {
+    int rows = num_ots + KOS_KAPPA + m_stat_security_bits;
+    return ((rows + KOS_KAPPA - 1) / KOS_KAPPA) * KOS_KAPPA;
+}
+
+EVP_CIPHER_CTX* KOSOTExtensionCommon::create_prg(const BYTE* seed) {
+    BYTE iv[16];
+    memset(iv, 0, 16);
+
+    EVP_CIPHER_CTX* prg = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit(prg, EVP_aes_128_ctr(), seed, iv);
+    return prg;
+}
+
+void KOSOTExtensionCommon::expand(EVP_CIPHER_CTX* prg, BYTE* out, int num_bytes) {
+    if (m_zeros_size < num_bytes) {
+	delete [] m_zeros;
+	m_zeros = new BYTE[num_bytes];
+	memset(m_zeros, 0, num_bytes);
+	m_zeros_size = num_bytes;
+    }
+
+    // the counter continues from the previous call, so each call gets fresh output
+    int out_len;
+    EVP_EncryptUpdate(prg, out, &out_len, m_zeros, num_bytes);
+}
+
+void KOSOTExtensionCommon::derive_coefficients(const BYTE* seed, BYTE* chi, int rows) {
+    EVP_CIPHER_CTX* prg = create_prg(seed);
+    expand(prg, chi, rows * KOS_KAPPA_BYTES);
+    EVP_CIPHER_CTX_free(prg);
+}
+
+void KOSOTExtensionCommon::linear_combination(const BYTE* rows, const BYTE* chi, int num_rows, BYTE* out) {
+    __m128i acc_lo = _mm_setzero_si128();
+    __m128i acc_hi = _mm_setzero_si128();
+    __m128i lo, hi;
+
+    // accumulate the unreduced products and reduce only once
+    for (int j = 0; j < num_rows; j++) {
+	__m128i row = _mm_loadu_si128((const __m128i*) (rows + j * KOS_KAPPA_BYTES));
+	__m128i c = _mm_loadu_si128((const __m128i*) (chi + j * KOS_KAPPA_BYTES));
+	clmul128(row, c, &lo, &hi);
+	acc_lo = _mm_xor_si128(acc_lo, lo);
+	acc_hi = _mm_xor_si128(acc_hi, hi);
+    }
+
+    _mm_storeu_si128((__m128i*) out, gf_reduce(acc_lo, acc_hi));
+}
+
+void KOSOTExtensionCommon::hash_row(int j, const BYTE* row, BYTE* out, int element_bytes) {
+    BYTE digest[SHA256_DIGEST_LENGTH];
+    long index = m_ot_counter + j;
+
+    // H(index || block || row), with an increasing block number until element_bytes bytes were generated
+    for (int block = 0, done = 0; done < element_bytes; block++, done += SHA256_DIGEST_LENGTH) {
+	SHA256_CTX sha;
+	SHA256_Init(&sha);
+	SHA256_Update(&sha, &index, sizeof(index));
+	SHA256_Update(&sha, &block, sizeof(block));
+	SHA256_Update(&sha, row, KOS_KAPPA_BYTES);
+	SHA256_Final(digest, &sha);
+
+	int size = (element_bytes - done < SHA256_DIGEST_LENGTH) ? element_bytes - done : SHA256_DIGEST_LENGTH;
+	memcpy(out + done, digest, size);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+KOSOTExtensionSender::KOSOTExtensionSender(CSocket& sock, int stat_security_bits, const BYTE* delta, const BYTE* keys) :
+    KOSOTExtensionCommon(sock, stat_security_bits) {
+    memcpy(m_delta, delta, KOS_KAPPA_BYTES);
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	m_prgs[i] = create_prg(keys + i * SHA1_BYTES);
+    }
+}
+
+KOSOTExtensionSender::~KOSOTExtensionSender() {
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	EVP_CIPHER_CTX_free(m_prgs[i]);
+    }
+}
+
+BOOL KOSOTExtensionSender::send(int num_ots, int element_bytes, BYTE* x0, BYTE* x1, const BYTE* delta, BYTE version) {
+    int rows = padded_rows(num_ots);
+    int col_bytes = rows / 8;
+
+    // receive u, column after column
+    BYTE* u = new BYTE[KOS_KAPPA * col_bytes];
+    m_sock.Receive(u, KOS_KAPPA * col_bytes);
+
+    // column i of q is G(k_i^{delta_i}) ^ delta_i * u_i, so row j of q is t_j ^ r_j * delta
+    BYTE* q = new BYTE[KOS_KAPPA * col_bytes];
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	BYTE* q_col = q + i * col_bytes;
+	expand(m_prgs[i], q_col, col_bytes);
+
+	if ((m_delta[i / 8] >> (i % 8)) & 1) {
+	    BYTE* u_col = u + i * col_bytes;
+	    for (int b = 0; b < col_bytes; b++) {
+		q_col[b] ^= u_col[b];
+	    }
+	}
+    }
+    BYTE* q_rows = new BYTE[rows * KOS_KAPPA_BYTES];
+    transpose(q, q_rows, KOS_KAPPA, rows);
+
+    // consistency check: choose the coefficients only after u was received
+    BYTE seed[KOS_KAPPA_BYTES];
+    RAND_bytes(seed, KOS_KAPPA_BYTES);
+    m_sock.Send(seed, KOS_KAPPA_BYTES);
+
+    BYTE* chi = new BYTE[rows * KOS_KAPPA_BYTES];
+    derive_coefficients(seed, chi, rows);
+
+    BYTE proof[2 * KOS_KAPPA_BYTES];
+    m_sock.Receive(proof, 2 * KOS_KAPPA_BYTES);
+
+    BYTE expected[KOS_KAPPA_BYTES], x_delta[KOS_KAPPA_BYTES], q_comb[KOS_KAPPA_BYTES];
+    linear_combination(q_rows, chi, rows, q_comb);
+    linear_combination(proof, m_delta, 1, x_delta);
+    for (int b = 0; b < KOS_KAPPA_BYTES; b++) {
+	expected[b] = proof[KOS_KAPPA_BYTES + b] ^ x_delta[b];
+    }
+
+    BOOL success = (CRYPTO_memcmp(expected, q_comb, KOS_KAPPA_BYTES) == 0);
+
+    // tell the receiver whether the check passed, so that it aborts instead of waiting for y
+    BYTE accept = success ? KOS_ACCEPT : KOS_ABORT;
+    m_sock.Send(&accept, 1);
+
+    if (success) {
+	// the pads of the j'th ot are H(j, q_j) and H(j, q_j ^ delta)
+	BYTE row[KOS_KAPPA_BYTES];
+	BYTE* pad0 = new BYTE[element_bytes];
+	BYTE* pad1 = new BYTE[element_bytes];
+	int num_messages = (version == G_OT) ? 2 : 1;
+	BYTE* y = new BYTE[(long) num_ots * element_bytes * num_messages];
+
+	for (int j = 0; j < num_ots; j++) {
+	    const BYTE* q_row = q_rows + j * KOS_KAPPA_BYTES;
+	    for (int b = 0; b < KOS_KAPPA_BYTES; b++) {
+		row[b] = q_row[b] ^ m_delta[b];
+	    }
+	    hash_row(j, q_row, pad0, element_bytes);
+	    hash_row(j, row, pad1, element_bytes);
+
+	    long offset = (long) j * element_bytes;
+	    for (int b = 0; b < element_bytes; b++) {
+		if (version == G_OT) {
+		    y[2 * offset + b] = x0[offset + b] ^ pad0[b];
+		    y[2 * offset + element_bytes + b] = x1[offset + b] ^ pad1[b];
+		} else if (version == C_OT) {
+		    x0[offset + b] = pad0[b];
+		    x1[offset + b] = pad0[b] ^ delta[offset + b];
+		    y[offset + b] = x1[offset + b] ^ pad1[b];
+		} else {
+		    x0[offset + b] = pad0[b];
+		    x1[offset + b] = pad1[b];
+		}
+	    }
+	}
+
+	if (version != R_OT) {
+	    m_sock.Send(y, (long) num_ots * element_bytes * num_messages);
+	}
+
+	delete [] pad0;
+	delete [] pad1;
+	delete [] y;
+    }
+
+    m_ot_counter += num_ots;
+
+    delete [] u;
+    delete [] q;
+    delete [] q_rows;
+    delete [] chi;
+
+    return success;
+}
+
+// --------------------------------------------------------------------------------
+
+KOSOTExtensionReceiver::KOSOTExtensionReceiver(CSocket& sock, int stat_security_bits, const BYTE* keys) :
+    KOSOTExtensionCommon(sock, stat_security_bits) {
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	m_prgs[i][0] = create_prg(keys + (2 * i) * SHA1_BYTES);
+	m_prgs[i][1] = create_prg(keys + (2 * i + 1) * SHA1_BYTES);
+    }
+}
+
+KOSOTExtensionReceiver::~KOSOTExtensionReceiver() {
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	EVP_CIPHER_CTX_free(m_prgs[i][0]);
+	EVP_CIPHER_CTX_free(m_prgs[i][1]);
+    }
+}
+
+BOOL KOSOTExtensionReceiver::receive(int num_ots, int element_bytes, const BYTE* choices, BYTE* output, BYTE version) {
+    int rows = padded_rows(num_ots);
+    int col_bytes = rows / 8;
+
+    // the choice vector. the extra rows get random choices, which hide the real ones in the check.
+    BYTE* r = new BYTE[col_bytes];
+    RAND_bytes(r, col_bytes);
+    for (int j = 0; j < num_ots; j++) {
+	r[j / 8] = (r[j / 8] & ~(1 << (j % 8))) | ((choices[j] & 1) << (j % 8));
+    }
+
+    // column i of t is G(k_i^0), and u_i = t_i ^ G(k_i^1) ^ r
+    BYTE* t = new BYTE[KOS_KAPPA * col_bytes];
+    BYTE* u = new BYTE[KOS_KAPPA * col_bytes];
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	BYTE* t_col = t + i * col_bytes;
+	BYTE* u_col = u + i * col_bytes;
+
+	expand(m_prgs[i][0], t_col, col_bytes);
+	expand(m_prgs[i][1], u_col, col_bytes);
+	for (int b = 0; b < col_bytes; b++) {
+	    u_col[b] ^= t_col[b] ^ r[b];
+	}
+    }
+    m_sock.Send(u, KOS_KAPPA * col_bytes);
+
+    BYTE* t_rows = new BYTE[rows * KOS_KAPPA_BYTES];
+    transpose(t, t_rows, KOS_KAPPA, rows);
+
+    // consistency check: answer the coefficients of the sender with x = sum(r_j * chi_j) and t = sum(t_j * chi_j)
+    BYTE seed[KOS_KAPPA_BYTES];
+    m_sock.Receive(seed, KOS_KAPPA_BYTES);
+
+    BYTE* chi = new BYTE[rows * KOS_KAPPA_BYTES];
+    derive_coefficients(seed, chi, rows);
+
+    BYTE proof[2 * KOS_KAPPA_BYTES];
+    memset(proof, 0, KOS_KAPPA_BYTES);
+    for (int j = 0; j < rows; j++) {
+	if ((r[j / 8] >> (j % 8)) & 1) {
+	    for (int b = 0; b < KOS_KAPPA_BYTES; b++) {
+		proof[b] ^= chi[j * KOS_KAPPA_BYTES + b];
+	    }
+	}
+    }
+    linear_combination(t_rows, chi, rows, proof + KOS_KAPPA_BYTES);
+    m_sock.Send(proof, 2 * KOS_KAPPA_BYTES);
+
+    // the sender sends nothing more if the check failed
+    BYTE accept;
+    m_sock.Receive(&accept, 1);
+    if (accept != KOS_ACCEPT) {
+	delete [] r;
+	delete [] t;
+	delete [] u;
+	delete [] t_rows;
+	delete [] chi;
+	return FALSE;
+    }
+
+    // the output of the j'th ot is H(j, t_j), unmasking the chosen message if the sender sent any
+    int num_messages = (version == G_OT) ? 2 : 1;
+    BYTE* y = NULL;
+    if (version != R_OT) {
+	y = new BYTE[(long) num_ots * element_bytes * num_messages];
+	m_sock.Receive(y, (long) num_ots * element_bytes * num_messages);
+    }
+
+    for (int j = 0; j < num_ots; j++) {
+	BYTE* out = output + (long) j * element_bytes;
+	hash_row(j, t_rows + j * KOS_KAPPA_BYTES, out, element_bytes);
+
+	int choice = choices[j] & 1;
+	BYTE* masked = NULL;
+	if (version == G_OT) {
+	    masked = y + ((long) 2 * j + choice) * element_bytes;
+	} else if (version == C_OT && choice == 1) {
+	    masked = y + (long) j * element_bytes;
+	}
+
+	if (masked != NULL) {
+	    for (int b = 0; b < element_bytes; b++) {
+		out[b] ^= masked[b];
+	    }
+	}
+    }
+
+    m_ot_counter += num_ots;
+
+    delete [] r;
+    delete [] t;
+    delete [] u;
+    delete [] t_rows;
+    delete [] chi;
+    delete [] y;
+
+    return TRUE;
+}
@@ -0,0 +1,97 @@
+#ifndef _KOS_OT_EXTENSION_H_
+#define _KOS_OT_EXTENSION_H_
+
+#include <MaliciousOTExtension/util/typedefs.h>
+#include <MaliciousOTExtension/util/socket.h>
+#include <MaliciousOTExtension/util/cbitvector.h>
+#include <MaliciousOTExtension/ot/ot-extension-malicious.h>
+
+#include <openssl/evp.h>
+
+namespace maliciousot {
+
+/*
+ * malicious 1-out-of-2 ot extension with the consistency check of:
+ * "M. Keller, E. Orsini and P. Scholl. Actively Secure OT Extension with Optimal Overhead. CRYPTO 2015."
+ *
+ * the extension itself is the iknp extension with k = 128 base ots. instead of checking
+ * hundreds of pairs of base ots (as in ALSZ15), the receiver proves the consistency of the
+ * whole matrix with a single random linear combination over GF(2^128) of its rows:
+ * the sender picks random coefficients chi_j after receiving u, and the receiver answers with
+ * x = sum(r_j * chi_j) and t = sum(t_j * chi_j). the sender accepts iff sum(q_j * chi_j) = t + x * delta.
+ * this costs k + s extra ots (s is the statistical security parameter) and 32 bytes of
+ * communication, no matter how many ots are executed.
+ *
+ * the base ots are given to the constructors (the extension sender is the base ot receiver).
+ */
+
+#define KOS_KAPPA 128
+#define KOS_KAPPA_BYTES (KOS_KAPPA / 8)
+
+// the byte the sender sends after the consistency check
+#define KOS_ACCEPT 1
+#define KOS_ABORT 0
+
+class KOSOTExtensionCommon {
+
+ public:
+    virtual ~KOSOTExtensionCommon();
+
+ protected:
+    KOSOTExtensionCommon(CSocket& sock, int stat_security_bits);
+
+    // number of rows of the extension matrix for num_ots ots, including the k + s extra rows of the check
+    int padded_rows(int num_ots);
+    EVP_CIPHER_CTX* create_prg(const BYTE* seed);
+    void expand(EVP_CIPHER_CTX* prg, BYTE* out, int num_bytes);
+    // the coefficients chi_j of the check, derived from the seed chosen by the sender
+    void derive_coefficients(const BYTE* seed, BYTE* chi, int rows);
+    // computes sum(rows_j * chi_j) in GF(2^128)
+    void linear_combination(const BYTE* rows, const BYTE* chi, int num_rows, BYTE* out);
+    // correlation robust hash of the j'th row into element_bytes bytes
+    void hash_row(int j, const BYTE* row, BYTE* out, int element_bytes);
+
+    CSocket& m_sock;
+    int m_stat_security_bits;
+    long m_ot_counter;
+    BYTE* m_zeros;
+    int m_zeros_size;
+};
+
+class KOSOTExtensionSender : public KOSOTExtensionCommon {
+
+ public:
+    // delta is the choice string of the base ots and keys holds the SHA1_BYTES key of each one of them.
+    KOSOTExtensionSender(CSocket& sock, int stat_security_bits, const BYTE* delta, const BYTE* keys);
+    virtual ~KOSOTExtensionSender();
+
+    /*
+     * runs num_ots ots of element_bytes bytes each. x0 and x1 are inputs in G_OT and outputs in R_OT and C_OT.
+     * in C_OT, x1 = x0 ^ delta_j where delta holds the correlation of each ot.
+     * returns FALSE if the consistency check of the receiver failed, in which case only the abort byte is sent.
+     */
+    BOOL send(int num_ots, int element_bytes, BYTE* x0, BYTE* x1, const BYTE* delta, BYTE version);
+
+ private:
+    BYTE m_delta[KOS_KAPPA_BYTES];
+    EVP_CIPHER_CTX* m_prgs[KOS_KAPPA];
+};
+
+class KOSOTExtensionReceiver : public KOSOTExtensionCommon {
+
+ public:
+    // keys holds the two SHA1_BYTES keys of each base ot, one after the other.
+    KOSOTExtensionReceiver(CSocket& sock, int stat_security_bits, const BYTE* keys);
+    virtual ~KOSOTExtensionReceiver();
+
+    // runs num_ots ots. choices holds a byte (0 or 1) for each ot.
+    // returns FALSE if the sender aborted because the consistency check failed.
+    BOOL receive(int num_ots, int element_bytes, const BYTE* choices, BYTE* output, BYTE version);
+
+ private:
+    EVP_CIPHER_CTX* m_prgs[KOS_KAPPA][2];
+};
+
+}
+
+#endif //_KOS_OT_EXTENSION_H_
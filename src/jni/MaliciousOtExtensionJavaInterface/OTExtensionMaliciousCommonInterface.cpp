@@ -23,16 +23,39 @@ void maliciousot::OtExtensionMaliciousCommonInterface::init_seeds(int role) {
   memcpy(m_sender_seed, seedtmp, AES_BYTES);
 }
 
+/**
+ * maps the symmetric security parameter to the security levels of the library
+ */
+SECLVL maliciousot::OtExtensionMaliciousCommonInterface::get_security_level(int sym_security_bits) {
+    switch (sym_security_bits) {
+    case 80:
+	return ST;
+    case 112:
+	return MT;
+    case 192:
+	return XLT;
+    case 256:
+	return XXLT;
+    default:
+	return LT;
+    }
+}
+
 maliciousot::OtExtensionMaliciousCommonInterface::OtExtensionMaliciousCommonInterface(int role,
 										      int num_base_ots, 
-										      int num_ots) {
+										      int num_ots,
+										      int num_checks,
+										      int sym_security_bits,
+										      int stat_security_bits,
+										      int check_mode) {
     m_num_base_ots = num_base_ots;
     m_num_ots = num_ots;
 
-    // set to a fixed default
     m_counter = 0;
-    m_security_level = LT;
-    m_num_checks = 380;
+    m_security_level = get_security_level(sym_security_bits);
+    m_security_level.statbits = stat_security_bits;
+    m_num_checks = num_checks;
+    m_check_mode = check_mode;
 
     // init seeds
     init_seeds(role);
@@ -16,9 +16,20 @@
 #include <string>
 
 #include "ConnectionManager.h"
+#include "KOSOTExtension.h"
 
 namespace maliciousot {
 
+/*
+ * the consistency check of the ot extension:
+ * PAIRWISE_CHECKS - the checks of the ALSZ15 malicious ot extension (m_num_checks pairs of base ots).
+ * SINGLE_LINEAR_COMBINATION - the KOS15 check, a single random linear combination of the extension matrix (see KOSOTExtension.h).
+ */
+enum CheckMode {
+    PAIRWISE_CHECKS = 0,
+    SINGLE_LINEAR_COMBINATION = 1
+};
+
 /*
  * this class is the gateway class to the ot extension malicious library.
  * the original code used global variables and manipulated them via global functions,
@@ -32,9 +43,22 @@ class OtExtensionMaliciousCommonInterface {
  public:
     static const char* m_initial_seed;
 
-    OtExtensionMaliciousCommonInterface(int role, int num_base_ots, int num_ots);
+    static const int DEFAULT_NUM_CHECKS = 380;
+    static const int DEFAULT_SYM_SECURITY_BITS = 128;
+    static const int DEFAULT_STAT_SECURITY_BITS = 40;
+
+    OtExtensionMaliciousCommonInterface(int role, int num_base_ots, int num_ots,
+					int num_checks = DEFAULT_NUM_CHECKS,
+					int sym_security_bits = DEFAULT_SYM_SECURITY_BITS,
+					int stat_security_bits = DEFAULT_STAT_SECURITY_BITS,
+					int check_mode = PAIRWISE_CHECKS);
     virtual ~OtExtensionMaliciousCommonInterface();
 
+    inline int get_check_mode() { return m_check_mode; };
+
+    // returns the security level matching the given symmetric security (80, 112, 128, 192 or 256 bits)
+    static SECLVL get_security_level(int sym_security_bits);
+
  protected:
     void init_seeds(int role);
 
@@ -55,6 +79,7 @@ class OtExtensionMaliciousCommonInterface {
     int m_num_ots;
     int m_counter;
     int m_num_checks;
+    int m_check_mode;
     SECLVL m_security_level;
     
     // seeds (SHA PRG)
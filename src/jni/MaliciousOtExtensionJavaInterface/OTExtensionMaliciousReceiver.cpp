@@ -13,10 +13,14 @@ using std::endl;
  * 
  * param ipAddress : The ip address of the receiver computer for connection
  * param port : The port to be used for sending/receiving data over the network
+ * param numChecks : The number of pairwise consistency checks (PAIRWISE_CHECKS mode only)
+ * param symSecurity, statSecurity : The symmetric and statistical security parameters in bits
+ * param checkMode : PAIRWISE_CHECKS (ALSZ15) or SINGLE_LINEAR_COMBINATION (KOS15)
  * returns : A pointer to the receiver object that was created and later be used to run the protcol
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_initOtReceiver(
-JNIEnv *env, jobject, jstring ipAddress, jint port, jint numOfthreads, jint nbaseots, jint numOTs) {
+JNIEnv *env, jobject, jstring ipAddress, jint port, jint numOfthreads, jint nbaseots, jint numOTs, 
+jint numChecks, jint symSecurity, jint statSecurity, jint checkMode) {
 
     // get the ip address from java
     const char* address = env->GetStringUTFChars(ipAddress, NULL);
@@ -26,8 +30,13 @@ JNIEnv *env, jobject, jstring ipAddress, jint port, jint numOfthreads, jint nbas
 								   (int) port,
 								   (int) numOfthreads,
 								   (int) nbaseots, 
-								   (int) numOTs);
+								   (int) numOTs,
+								   (int) numChecks,
+								   (int) symSecurity,
+								   (int) statSecurity,
+								   (int) checkMode);
     receiver_interface->init_ot_receiver();
+    env->ReleaseStringUTFChars(ipAddress, address);
 
 
     return (jlong) receiver_interface;
@@ -42,13 +51,14 @@ JNIEnv *env, jobject, jstring ipAddress, jint port, jint numOfthreads, jint nbas
  * param output : An empty array that will be filled with the result of the ot 
  * extension in one dimensional array. That is, 
  * The relevant i'th element x1/x2 will be placed in the position bitLength*sizeof(BYTE).
+ * returns : false if the ot extension failed
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_runOtAsReceiver(
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_runOtAsReceiver(
 JNIEnv *env, jobject, jlong receiver, jbyteArray sigma, jint numOfOts, 
 jint bitLength, jbyteArray output, jstring version) {
 
     if (0 == receiver) {
-	return;
+	return JNI_FALSE;
     }
 
 
@@ -70,6 +80,23 @@ jint bitLength, jbyteArray output, jstring version) {
     } else if(strcmp (str,"random") == 0) {
 	ver = R_OT;
     }
+    env->ReleaseStringUTFChars(version, str);
+
+    OtExtensionMaliciousReceiverInterface * receiver_interface = (OtExtensionMaliciousReceiverInterface *) receiver;
+
+    // the KOS15 extension works directly on the java arrays
+    if (receiver_interface->get_check_mode() == SINGLE_LINEAR_COMBINATION) {
+	jbyte * sigmaArr = env->GetByteArrayElements(sigma, 0);
+	jbyte * out = env->GetByteArrayElements(output, 0);
+
+	BOOL success = receiver_interface->obliviously_receive((BYTE*) sigmaArr, (BYTE*) out, 
+							       numOfOts, bitLength, ver);
+
+	env->ReleaseByteArrayElements(sigma, sigmaArr, JNI_ABORT);
+	env->ReleaseByteArrayElements(output, out, 0);
+
+	return success ? JNI_TRUE : JNI_FALSE;
+    }
   
     //if(ver == C_OT) {
     MaskingFunction * masking_function = new XORMasking(bitLength);
@@ -89,11 +116,8 @@ jint bitLength, jbyteArray output, jstring version) {
     }
 
     //run the ot extension as the receiver
-    OtExtensionMaliciousReceiverInterface * receiver_interface = (OtExtensionMaliciousReceiverInterface *) receiver;
-
-
     cerr << "started receiver_interface->obliviously_receive()" << endl;
-    receiver_interface->obliviously_receive(choices, response, numOfOts, bitLength, ver, masking_function);
+    BOOL success = receiver_interface->obliviously_receive(choices, response, numOfOts, bitLength, ver, masking_function);
     cerr << "ended receiver_interface->obliviously_receive()" << endl;
 
 
@@ -117,7 +141,7 @@ jint bitLength, jbyteArray output, jstring version) {
 	delete masking_function;
     }
 
-
+    return success ? JNI_TRUE : JNI_FALSE;
 }
 
 /*
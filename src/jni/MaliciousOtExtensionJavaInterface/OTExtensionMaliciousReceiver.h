@@ -10,17 +10,17 @@ extern "C" {
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver
  * Method:    initOtReceiver
- * Signature: (Ljava/lang/String;IIII)J
+ * Signature: (Ljava/lang/String;IIIIIIII)J
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_initOtReceiver
-  (JNIEnv *, jobject, jstring, jint, jint, jint, jint);
+  (JNIEnv *, jobject, jstring, jint, jint, jint, jint, jint, jint, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver
  * Method:    runOtAsReceiver
- * Signature: (J[BII[BLjava/lang/String;)V
+ * Signature: (J[BII[BLjava/lang/String;)Z
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_runOtAsReceiver
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousReceiver_runOtAsReceiver
   (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jstring);
 
 /*
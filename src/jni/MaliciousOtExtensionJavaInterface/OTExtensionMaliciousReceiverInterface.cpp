@@ -4,14 +4,30 @@ maliciousot::OtExtensionMaliciousReceiverInterface::OtExtensionMaliciousReceiver
 									     int port,
 									     int num_of_threads,
 									     int num_base_ots, 
-									     int num_ots) : 
+									     int num_ots,
+									     int num_checks,
+									     int sym_security_bits,
+									     int stat_security_bits,
+									     int check_mode) : 
     OtExtensionMaliciousCommonInterface(1,
 					num_base_ots, 
-					num_ots) {
+					num_ots,
+					num_checks,
+					sym_security_bits,
+					stat_security_bits,
+					check_mode) {
     m_connection_manager = new ConnectionManagerClient(1, num_of_threads, address, port);
+    m_sender = NULL;
+    m_receiver = NULL;
+    m_kos_receiver = NULL;
 }
 
 void maliciousot::OtExtensionMaliciousReceiverInterface::init_ot_receiver() {
+    if (m_check_mode == SINGLE_LINEAR_COMBINATION) {
+	init_kos_receiver();
+	return;
+    }
+
     int nSndVals = 2;
     int wdsize = 1 << (CEIL_LOG2(m_num_base_ots));
     int nblocks = CEIL_DIVIDE(m_num_ots, NUMOTBLOCKS * wdsize);
@@ -57,6 +73,24 @@ void maliciousot::OtExtensionMaliciousReceiverInterface::init_ot_receiver() {
 					     m_num_base_ots, s2ots);
 }
 
+/**
+ * runs the KOS15 base ots, where the ot extension receiver plays the base ot sender.
+ */
+void maliciousot::OtExtensionMaliciousReceiverInterface::init_kos_receiver() {
+    int nSndVals = 2;
+    BYTE* pBuf = new BYTE[KOS_KAPPA * nSndVals * SHA1_BYTES];
+
+    // client connect
+    m_connection_manager->setup_connection();
+
+    m_baseot_handler->Sender(nSndVals, KOS_KAPPA, m_connection_manager->get_socket(0), pBuf);
+
+    m_kos_receiver = new KOSOTExtensionReceiver(m_connection_manager->get_socket(0), 
+						m_security_level.statbits, pBuf);
+
+    delete [] pBuf;
+}
+
 /**
  * PrecomputeBaseOTsReceiver
  * (should be a member of a class instead of manipulating globals)
@@ -103,7 +137,19 @@ BOOL maliciousot::OtExtensionMaliciousReceiverInterface::obliviously_receive(CBi
     return success;
 }
 
+/**
+ * ObliviouslyReceive in the SINGLE_LINEAR_COMBINATION check mode.
+ */
+BOOL maliciousot::OtExtensionMaliciousReceiverInterface::obliviously_receive(const BYTE* choices, 
+									     BYTE* ret, 
+									     int numOTs, 
+									     int bitlength, 
+									     BYTE version) {
+    return m_kos_receiver->receive(numOTs, bitlength / 8, choices, ret, version);
+}
+
 maliciousot::OtExtensionMaliciousReceiverInterface::~OtExtensionMaliciousReceiverInterface() {
+    delete m_kos_receiver;
     delete m_connection_manager;
     delete m_sender;
     delete m_receiver;
@@ -30,13 +30,24 @@ namespace maliciousot {
 class OtExtensionMaliciousReceiverInterface : public OtExtensionMaliciousCommonInterface {
  public:
     OtExtensionMaliciousReceiverInterface(const char* address, int port, int num_of_threads, 
-					  int num_base_ots, int num_ots);
+					  int num_base_ots, int num_ots,
+					  int num_checks = DEFAULT_NUM_CHECKS,
+					  int sym_security_bits = DEFAULT_SYM_SECURITY_BITS,
+					  int stat_security_bits = DEFAULT_STAT_SECURITY_BITS,
+					  int check_mode = PAIRWISE_CHECKS);
     virtual ~OtExtensionMaliciousReceiverInterface();
     void init_ot_receiver();
     BOOL precompute_base_ots_receiver();
     BOOL obliviously_receive(CBitVector& choices, CBitVector& ret,
 			     int numOTs, int bitlength, BYTE version,
 			     MaskingFunction * masking_function);
+    // used in the SINGLE_LINEAR_COMBINATION check mode, choices holds a byte for each ot
+    BOOL obliviously_receive(const BYTE* choices, BYTE* ret, int numOTs, int bitlength, BYTE version);
+
+ private:
+    void init_kos_receiver();
+
+    KOSOTExtensionReceiver * m_kos_receiver;
 };
 
 }
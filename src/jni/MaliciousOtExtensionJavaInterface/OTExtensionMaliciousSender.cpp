@@ -10,10 +10,13 @@ using namespace maliciousot;
  * 
  * param ipAddress : The ip address of the sender computer for connection
  * param port : The port to be used for sending/receiving data over the network
+ * param numChecks : The number of pairwise consistency checks (PAIRWISE_CHECKS mode only)
+ * param symSecurity, statSecurity : The symmetric and statistical security parameters in bits
+ * param checkMode : PAIRWISE_CHECKS (ALSZ15) or SINGLE_LINEAR_COMBINATION (KOS15)
  * returns : A pointer to the receiver object that was created and later be used to run the protcol
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_initOtSender(JNIEnv *env, jobject, jstring ipAddress, jint port, 
-jint numOfthreads, jint nbaseots, jint numOTs) {
+jint numOfthreads, jint nbaseots, jint numOTs, jint numChecks, jint symSecurity, jint statSecurity, jint checkMode) {
 
   // get the ip address from java
   const char* address = env->GetStringUTFChars(ipAddress, NULL);
@@ -23,8 +26,13 @@ jint numOfthreads, jint nbaseots, jint numOTs) {
 							     (int) port,
 							     (int) numOfthreads,
 							     (int) nbaseots, 
-							     (int) numOTs);
+							     (int) numOTs,
+							     (int) numChecks,
+							     (int) symSecurity,
+							     (int) statSecurity,
+							     (int) checkMode);
   sender_interface->init_ot_sender();
+  env->ReleaseStringUTFChars(ipAddress, address);
 
   return (jlong) sender_interface;
 }
@@ -39,10 +47,11 @@ jint numOfthreads, jint nbaseots, jint numOTs) {
  * param x2 : The input array that holds all the x2,i for each ot in a one 
  * dimensional array one element after the other
  * param bitLength : The length of each element
+ * returns : false if the receiver failed the consistency check of the ot extension
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_runOtAsSender(JNIEnv *env, jobject, jlong sender, jbyteArray x1, jbyteArray x2, jbyteArray deltaFromJava, jint numOfOts, jint bitLength, jstring version) {
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_runOtAsSender(JNIEnv *env, jobject, jlong sender, jbyteArray x1, jbyteArray x2, jbyteArray deltaFromJava, jint numOfOts, jint bitLength, jstring version) {
     if (0 == sender) {
-	return;
+	return JNI_FALSE;
     }
 
 
@@ -63,6 +72,31 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
     } else if(strcmp (str,"random") == 0) {
 	ver = R_OT;
     }
+    env->ReleaseStringUTFChars(version, str);
+
+    OtExtensionMaliciousSenderInterface * sender_interface = (OtExtensionMaliciousSenderInterface *) sender;
+
+    // the KOS15 extension works directly on the java arrays
+    if (sender_interface->get_check_mode() == SINGLE_LINEAR_COMBINATION) {
+	jbyte * x1Arr = env->GetByteArrayElements(x1, 0);
+	jbyte * x2Arr = env->GetByteArrayElements(x2, 0);
+	jbyte * deltaArr = NULL;
+	if (ver == C_OT) {
+	    deltaArr = env->GetByteArrayElements(deltaFromJava, 0);
+	}
+
+	BOOL success = sender_interface->obliviously_send((BYTE*) x1Arr, (BYTE*) x2Arr, (BYTE*) deltaArr,
+							  numOfOts, bitLength, ver);
+
+	if (ver == C_OT) {
+	    env->ReleaseByteArrayElements(deltaFromJava, deltaArr, JNI_ABORT);
+	}
+	// in the general version the inputs were not changed
+	env->ReleaseByteArrayElements(x1, x1Arr, (ver == G_OT) ? JNI_ABORT : 0);
+	env->ReleaseByteArrayElements(x2, x2Arr, (ver == G_OT) ? JNI_ABORT : 0);
+
+	return success ? JNI_TRUE : JNI_FALSE;
+    }
 
     jbyte * x1Arr = env->GetByteArrayElements(x1, 0);
     jbyte * x2Arr = env->GetByteArrayElements(x2, 0);
@@ -109,9 +143,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
     }
 	
     //run the ot extension as the sender
-    OtExtensionMaliciousSenderInterface * sender_interface = (OtExtensionMaliciousSenderInterface *) sender;
-
-    sender_interface->obliviously_send(X1, X2, numOfOts, bitLength, ver, masking_function); //, delta);
+    BOOL success = sender_interface->obliviously_send(X1, X2, numOfOts, bitLength, ver, masking_function); //, delta);
 
     if(ver != G_OT){ //we need to copy x0 and x1 
 
@@ -136,6 +168,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
     X2.delCBitVector();
     delta.delCBitVector();
 
+    return success ? JNI_TRUE : JNI_FALSE;
 }
 
 /*
@@ -10,17 +10,17 @@ extern "C" {
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender
  * Method:    initOtSender
- * Signature: (Ljava/lang/String;IIII)J
+ * Signature: (Ljava/lang/String;IIIIIIII)J
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_initOtSender
-  (JNIEnv *, jobject, jstring, jint, jint, jint, jint);
+  (JNIEnv *, jobject, jstring, jint, jint, jint, jint, jint, jint, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender
  * Method:    runOtAsSender
- * Signature: (J[B[B[BIILjava/lang/String;)V
+ * Signature: (J[B[B[BIILjava/lang/String;)Z
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_runOtAsSender
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTExtensionMaliciousSender_runOtAsSender
   (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jint, jint, jstring);
 
 /*
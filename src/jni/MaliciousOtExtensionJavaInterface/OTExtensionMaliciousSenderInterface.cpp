@@ -1,17 +1,34 @@
 #include "OTExtensionMaliciousSenderInterface.h"
+#include <openssl/rand.h>
 
 maliciousot::OtExtensionMaliciousSenderInterface::OtExtensionMaliciousSenderInterface(const char* address, 
 										      int port,
 										      int num_of_threads,
 										      int num_base_ots, 
-										      int num_ots) : 
+										      int num_ots,
+										      int num_checks,
+										      int sym_security_bits,
+										      int stat_security_bits,
+										      int check_mode) : 
     OtExtensionMaliciousCommonInterface(1,
 					num_base_ots, 
-					num_ots) {
+					num_ots,
+					num_checks,
+					sym_security_bits,
+					stat_security_bits,
+					check_mode) {
     m_connection_manager = new ConnectionManagerServer(0, num_of_threads, address, port);
+    m_sender = NULL;
+    m_receiver = NULL;
+    m_kos_sender = NULL;
 }
 
 void maliciousot::OtExtensionMaliciousSenderInterface::init_ot_sender() {
+    if (m_check_mode == SINGLE_LINEAR_COMBINATION) {
+	init_kos_sender();
+	return;
+    }
+
     int nSndVals = 2;
     int wdsize = 1 << (CEIL_LOG2(m_num_base_ots));
     int nblocks = CEIL_DIVIDE(m_num_ots, NUMOTBLOCKS * wdsize);
@@ -58,6 +75,34 @@ void maliciousot::OtExtensionMaliciousSenderInterface::init_ot_sender() {
 					 m_num_checks, s2ots, m_sender_seed);
 }
 
+/**
+ * runs the KOS15 base ots, where the ot extension sender plays the base ot receiver
+ * with a random choice string delta.
+ */
+void maliciousot::OtExtensionMaliciousSenderInterface::init_kos_sender() {
+    int nSndVals = 2;
+    BYTE delta[KOS_KAPPA_BYTES];
+    BYTE* pBuf = new BYTE[KOS_KAPPA * SHA1_BYTES];
+
+    // Server listen
+    m_connection_manager->setup_connection();
+
+    RAND_bytes(delta, KOS_KAPPA_BYTES);
+    CBitVector choices;
+    choices.Create(KOS_KAPPA);
+    for (int i = 0; i < KOS_KAPPA; i++) {
+	choices.SetBit(i, (delta[i / 8] >> (i % 8)) & 1);
+    }
+
+    m_baseot_handler->Receiver(nSndVals, KOS_KAPPA, choices, m_connection_manager->get_socket(0), pBuf);
+
+    m_kos_sender = new KOSOTExtensionSender(m_connection_manager->get_socket(0), 
+					    m_security_level.statbits, delta, pBuf);
+
+    choices.delCBitVector();
+    delete [] pBuf;
+}
+
 /**
  * PrecomputeBaseOTsSender
  */
@@ -100,7 +145,21 @@ BOOL maliciousot::OtExtensionMaliciousSenderInterface::obliviously_send(CBitVect
     return success;
 }
 
+/**
+ * ObliviouslySend in the SINGLE_LINEAR_COMBINATION check mode.
+ * returns FALSE if the consistency check of the receiver failed.
+ */
+BOOL maliciousot::OtExtensionMaliciousSenderInterface::obliviously_send(BYTE* x0, 
+									BYTE* x1, 
+									const BYTE* delta,
+									int num_ots, 
+									int bitlength, 
+									BYTE version) {
+    return m_kos_sender->send(num_ots, bitlength / 8, x0, x1, delta, version);
+}
+
 maliciousot::OtExtensionMaliciousSenderInterface::~OtExtensionMaliciousSenderInterface() {
+    delete m_kos_sender;
     delete m_connection_manager;
     delete m_sender;
     delete m_receiver;
@@ -29,11 +29,22 @@ namespace maliciousot {
  */
 class OtExtensionMaliciousSenderInterface : public OtExtensionMaliciousCommonInterface {
  public:
-    OtExtensionMaliciousSenderInterface(const char* address, int port, int num_of_threads, int num_base_ots, int num_ots);
+    OtExtensionMaliciousSenderInterface(const char* address, int port, int num_of_threads, int num_base_ots, int num_ots,
+					int num_checks = DEFAULT_NUM_CHECKS,
+					int sym_security_bits = DEFAULT_SYM_SECURITY_BITS,
+					int stat_security_bits = DEFAULT_STAT_SECURITY_BITS,
+					int check_mode = PAIRWISE_CHECKS);
     virtual ~OtExtensionMaliciousSenderInterface();
     void init_ot_sender();
     BOOL precompute_base_ots_sender();
     BOOL obliviously_send(CBitVector& X1, CBitVector& X2, int numOTs, int bitlength, BYTE version, MaskingFunction * masking_function);
+    // used in the SINGLE_LINEAR_COMBINATION check mode, on plain arrays of numOTs elements
+    BOOL obliviously_send(BYTE* x0, BYTE* x1, const BYTE* delta, int numOTs, int bitlength, BYTE version);
+
+ private:
+    void init_kos_sender();
+
+    KOSOTExtensionSender * m_kos_sender;
 };
 
 }
@@ -1,94 +1,93 @@
 #include "MaliciousYaoUtil.h"
 #include "TedKrovetzAesNiWrapperC.h"
 #include <iostream>
+#include <vector>
+#include <thread>
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include "../OpenSSLJavaInterface/MultiBufferHash.h"
 
 
 using namespace std;
 
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_restoreKeys
-  (JNIEnv *env, jobject, jbyteArray receivedKeysArray, jobjectArray matrixArray, int n, int m, jbyteArray restoredKeysArray){
+/*
+ * The minimal number of decommitments verified by each thread of verifyDecommitments.
+ */
+#define MIN_DECOMMITMENTS_PER_THREAD 64
 
-	  block* receivedKeys = (block *)  _mm_malloc(sizeof(block) * m, 16);
-	  block* restoredKeys = (block *)  _mm_malloc(sizeof(block) * n, 16);
-	  
-	  jbyte *carr = env->GetByteArrayElements(receivedKeysArray, 0);
-	  memcpy(receivedKeys, carr, sizeof(block) * m);
+JNIEXPORT jlong JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_createMatrix
+  (JNIEnv *env, jobject, jobjectArray matrixArray, int n, int m){
 
-	  char* matrix = new char[n*m];
+	  PackedMatrix* matrix = createPackedMatrix(n, m);
+	  char* row = new char[m];
 
+	  //Copy each row once and pack it to bits.
 	  for (int i=0; i<n; i++){
-		  
 		 jbyteArray matrixRowArray = (jbyteArray) env->GetObjectArrayElement(matrixArray, i);
-		 jbyte* matrixRow  = (jbyte*) env->GetByteArrayElements(matrixRowArray, 0);
-		 
-		 memcpy(matrix+i*m, matrixRow, m);
-		   
-		 env->ReleaseByteArrayElements(matrixRowArray,matrixRow,JNI_ABORT);
+		 env->GetByteArrayRegion(matrixRowArray, 0, m, (jbyte*) row);
+		 env->DeleteLocalRef(matrixRowArray);
+
+		 setPackedRow(matrix, i, row);
 	  }
-	  
-	  restoreKeys(receivedKeys, matrix, n, m, restoredKeys);
-	 
-	  env->SetByteArrayRegion(restoredKeysArray, 0, n*SIZE_OF_BLOCK,  (jbyte*)restoredKeys);
 
-	  env->ReleaseByteArrayElements(receivedKeysArray,carr,JNI_ABORT);
-	  _mm_free(receivedKeys);
-	  _mm_free(restoredKeys);
+	  delete [] row;
+	  return (jlong) matrix;
+}
 
-	  delete matrix;
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_deleteMatrix
+  (JNIEnv *, jobject, jlong matrix){
 
+	  deletePackedMatrix((PackedMatrix*) matrix);
 }
 
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_transformKeys
-  (JNIEnv *env, jobject, jbyteArray originalKeysBytes, jbyteArray probeResistantKeysBytes, jbyteArray seedBytes, int n, int m, jobjectArray matrixArray){
-	  
-	  jbyte *originalKeys = env->GetByteArrayElements(originalKeysBytes, 0);
-	  jbyte *probeResistantKeys = env->GetByteArrayElements(probeResistantKeysBytes, 0);
-	  jbyte *seed = env->GetByteArrayElements(seedBytes, 0);
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_restoreKeys
+  (JNIEnv *env, jobject, jlong matrix, jbyteArray receivedKeysArray, jbyteArray restoredKeysArray){
+
+	  //The keys are used in place, without copying them to aligned buffers.
+	  jbyte *receivedKeys = (jbyte*) env->GetPrimitiveArrayCritical(receivedKeysArray, 0);
+	  jbyte *restoredKeys = (jbyte*) env->GetPrimitiveArrayCritical(restoredKeysArray, 0);
+
+	  restoreKeys((PackedMatrix*) matrix, (unsigned char*) receivedKeys, (unsigned char*) restoredKeys);
+
+	  env->ReleasePrimitiveArrayCritical(restoredKeysArray, restoredKeys, 0);
+	  env->ReleasePrimitiveArrayCritical(receivedKeysArray, receivedKeys, JNI_ABORT);
+}
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_transformKeys
+  (JNIEnv *env, jobject, jlong matrixPtr, jbyteArray originalKeysBytes, jbyteArray probeResistantKeysBytes, jbyteArray seedBytes){
+
+	  PackedMatrix* matrix = (PackedMatrix*) matrixPtr;
+	  int n = matrix->n;
 
-	  block* originalKeysb = (block *)  _mm_malloc(sizeof(block) * n * 2, 16);
-	  block* probeResistantKeysb = (block *)  _mm_malloc(sizeof(block) * m * 2, 16);
+	  //The new key of row i is the encryption of i under the seed.
 	  block* newKeysb = (block *)  _mm_malloc(sizeof(block) * n, 16);
 	  block * indexArray = (block *)_mm_malloc(sizeof(block) * n, 16);
-	
 	  for (int i = 0; i < n; i++){
-
 		indexArray[i] = _mm_set_epi32(0, 0, 0, i);
 	  }
 
+	  jbyte seed[SIZE_OF_BLOCK];
+	  env->GetByteArrayRegion(seedBytes, 0, SIZE_OF_BLOCK, seed);
 	  AES_KEY * aesSeedKey = (AES_KEY *)_mm_malloc(sizeof(AES_KEY), 16);
 	  AES_set_encrypt_key((const unsigned char *)seed, 128, aesSeedKey);
 	  AES_ecb_encrypt_chunk_in_out(indexArray, newKeysb, n, aesSeedKey);
 
-	  memcpy(originalKeysb, originalKeys, sizeof(block) *  n * 2);
-	  memcpy(probeResistantKeysb, probeResistantKeys, sizeof(block) *  m * 2);
-	  
-	  char* matrix = new char[n*m];
+	  jbyte *originalKeys = (jbyte*) env->GetPrimitiveArrayCritical(originalKeysBytes, 0);
+	  jbyte *probeResistantKeys = (jbyte*) env->GetPrimitiveArrayCritical(probeResistantKeysBytes, 0);
 
-	  for (int j=0; j<n; j++){
-		  
-		 jbyteArray matrixRowArray = (jbyteArray) env->GetObjectArrayElement(matrixArray, j);
-		 jbyte* matrixRow  = (jbyte*) env->GetByteArrayElements(matrixRowArray, 0);
-		 
-		 memcpy(matrix+j*m, matrixRow, m);
-		   
-		 env->ReleaseByteArrayElements(matrixRowArray,matrixRow,JNI_ABORT);
-	  }
-
-	  transformKeys(originalKeysb, probeResistantKeysb, newKeysb, n, m, matrix);
+	  bool isProbeResistant = transformKeys(matrix, (unsigned char*) originalKeys, (unsigned char*) probeResistantKeys, newKeysb);
 	  
-	  memcpy(probeResistantKeys, (jbyte*)probeResistantKeysb, sizeof(block) *  m * 2);
-	 
-	  env->ReleaseByteArrayElements(probeResistantKeysBytes,probeResistantKeys,0);
-	 env->ReleaseByteArrayElements(originalKeysBytes,originalKeys,0);
-	 env->ReleaseByteArrayElements(seedBytes,seed,0);
+	  env->ReleasePrimitiveArrayCritical(probeResistantKeysBytes, probeResistantKeys, 0);
+	  env->ReleasePrimitiveArrayCritical(originalKeysBytes, originalKeys, JNI_ABORT);
 
-	 _mm_free(originalKeysb);
-	 _mm_free(probeResistantKeysb);
-	 _mm_free(newKeysb);
-	 _mm_free(indexArray);
-	 _mm_free(aesSeedKey);
+	  _mm_free(newKeysb);
+	  _mm_free(indexArray);
+	  _mm_free(aesSeedKey);
 
-	 delete matrix;
+	  return isProbeResistant;
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_allocateKeys
@@ -187,45 +186,124 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProt
 }
 
 
-JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
-	(JNIEnv * env, jobject, jbyteArray commitment, jbyteArray rArray, jbyteArray xArray){
+/*
+ * Returns true if the cpu has the SHA extensions.
+ * OpenSSL uses them for a single SHA-1, which is then faster than the multi-buffer SHA-1 on these short messages.
+ */
+static bool hasShaExtensions(){
+#ifdef _WIN32
+	int info[4];
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 29)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)){
+		return false;
+	}
+	return (ebx & (1 << 29)) != 0;
+#endif
+}
 
-		jbyte *comm = env->GetByteArrayElements(commitment, 0);
-		jbyte *r = env->GetByteArrayElements(rArray, 0);
-		jbyte *x = env->GetByteArrayElements(xArray, 0);
+static const bool useSingleBufferSha1 = hasShaExtensions();
+
+/*
+ * Verifies the decommitments of the indices in [from, to) and writes the result of each index to results.
+ * The commitment on index j is SHA1(r_j || x_j), so r_j and x_j are copied next to each other and all the messages
+ * of the range are hashed together by the multi-buffer SHA-1.
+ */
+static void verifyDecommitmentRange(const unsigned char* comm, const unsigned char* r, const unsigned char* x, int hashSize,
+	int from, int to, jboolean* results){
+
+		if (useSingleBufferSha1){
+			SHA_CTX sha;
+			unsigned char output[SHA_DIGEST_LENGTH];
+			for (int j=from; j<to; j++){
+				SHA1_Init(&sha);
+				SHA1_Update(&sha, r+j*hashSize, hashSize);
+				SHA1_Update(&sha, x+j*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
+				SHA1_Final(output, &sha);
+				results[j] = (memcmp(output, comm+j*hashSize, hashSize) == 0) ? JNI_TRUE : JNI_FALSE;
+			}
+			return;
+		}
+
+		int count = to - from;
+		int messageSize = hashSize + SIZE_OF_BLOCK;
+
+		unsigned char* messages = new unsigned char[count*messageSize];
+		unsigned char* digests = new unsigned char[count*SHA_DIGEST_LENGTH];
+		vector<const unsigned char*> messagePointers(count);
+		vector<unsigned char*> digestPointers(count);
+		vector<int> lengths(count, messageSize);
+
+		for (int j=0; j<count; j++){
+			memcpy(messages + j*messageSize, r + (from+j)*hashSize, hashSize);
+			memcpy(messages + j*messageSize + hashSize, x + (from+j)*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
+			messagePointers[j] = messages + j*messageSize;
+			digestPointers[j] = digests + j*SHA_DIGEST_LENGTH;
+		}
+
+		multiBufferSha1(&messagePointers[0], &lengths[0], &digestPointers[0], count);
+
+		for (int j=0; j<count; j++){
+			results[from+j] = (memcmp(digests + j*SHA_DIGEST_LENGTH, comm + (from+j)*hashSize, hashSize) == 0) ? JNI_TRUE : JNI_FALSE;
+		}
+
+		delete [] messages;
+		delete [] digests;
+}
+
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitments
+	(JNIEnv * env, jobject, jbyteArray commitment, jbyteArray rArray, jbyteArray xArray, jint numThreads){
 
-		SHA_CTX sha;
-		
 		int rounds = env->GetArrayLength(xArray)/SIZE_OF_BLOCK;
+		jbooleanArray resultArray = env->NewBooleanArray(rounds);
+		if (rounds == 0){
+			return resultArray;
+		}
 		int hashSize = env->GetArrayLength(rArray)/rounds;
+		//The commitments are strided by the size of the randoms, so they can not be longer than a SHA1 digest.
+		//Malformed arrays fail all the decommitments (the new array is all false).
+		if (hashSize < 1 || hashSize > SHA_DIGEST_LENGTH || env->GetArrayLength(commitment) < rounds*hashSize){
+			return resultArray;
+		}
+
+		//There is no point in giving a thread less than a few dozens of hashes.
+		int threadCount = (numThreads < 1) ? 1 : numThreads;
+		if (threadCount > rounds/MIN_DECOMMITMENTS_PER_THREAD){
+			threadCount = (rounds/MIN_DECOMMITMENTS_PER_THREAD > 0) ? rounds/MIN_DECOMMITMENTS_PER_THREAD : 1;
+		}
 
-		char* output = new char[hashSize];
-		
-		for (int j=0; j<rounds; j++){
-			SHA1_Init(&sha);
-			SHA1_Update(&sha, r+j*hashSize, hashSize);
-			SHA1_Update(&sha, x+j*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
-			SHA1_Final((unsigned char*) output, &sha);
-			
-			bool equal = true;
-			for (int i=0; i<hashSize; i++){
-				if (output[i] != (comm+j*hashSize)[i]){
-					cout<<"not equal. j = "<<j<< endl;
-					delete output;
-					env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
-					env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
-					env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
-
-					return false;
-				}
+		jboolean* results = new jboolean[rounds];
+
+		//No JNI call is made until the arrays are released (the worker threads only read and write native memory),
+		//so the arrays are accessed directly instead of being copied.
+		unsigned char* comm = (unsigned char*) env->GetPrimitiveArrayCritical(commitment, 0);
+		unsigned char* r = (unsigned char*) env->GetPrimitiveArrayCritical(rArray, 0);
+		unsigned char* x = (unsigned char*) env->GetPrimitiveArrayCritical(xArray, 0);
+
+		if (threadCount == 1){
+			verifyDecommitmentRange(comm, r, x, hashSize, 0, rounds, results);
+		} else {
+			//Each thread gets a contiguous range of indices. The calling thread verifies the last range.
+			vector<thread> threads;
+			int perThread = rounds / threadCount;
+			for (int t=0; t<threadCount-1; t++){
+				threads.push_back(thread(verifyDecommitmentRange, comm, r, x, hashSize, t*perThread, (t+1)*perThread, results));
+			}
+			verifyDecommitmentRange(comm, r, x, hashSize, (threadCount-1)*perThread, rounds, results);
+			for (size_t t=0; t<threads.size(); t++){
+				threads[t].join();
 			}
 		}
 
-		delete output;
-		env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
-		env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
-		env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
+		env->ReleasePrimitiveArrayCritical(xArray, x, JNI_ABORT);
+		env->ReleasePrimitiveArrayCritical(rArray, r, JNI_ABORT);
+		env->ReleasePrimitiveArrayCritical(commitment, comm, JNI_ABORT);
+
+		env->SetBooleanArrayRegion(resultArray, 0, rounds, results);
+		delete [] results;
 
-		return true;
+		return resultArray;
 }
 
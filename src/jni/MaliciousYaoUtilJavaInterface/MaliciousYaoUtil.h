@@ -12,16 +12,37 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*
+ * Class:     edu_biu_protocols_yao_primitives_KProbeResistantMatrix
+ * Method:    createMatrix
+ * Signature: ([[BII)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_createMatrix
+  (JNIEnv *, jobject, jobjectArray, int, int);
+
+/*
+ * Class:     edu_biu_protocols_yao_primitives_KProbeResistantMatrix
+ * Method:    deleteMatrix
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_deleteMatrix
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_protocols_yao_primitives_KProbeResistantMatrix
  * Method:    restoreKeys
- * Signature: ([B)[B
- */                         
+ * Signature: (J[B[B)V
+ */
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_restoreKeys
-  (JNIEnv *, jobject, jbyteArray, jobjectArray, int, int, jbyteArray);
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
 
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_transformKeys
-  (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, int n, int m, jobjectArray);
+/*
+ * Class:     edu_biu_protocols_yao_primitives_KProbeResistantMatrix
+ * Method:    transformKeys
+ * Signature: (J[B[B[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_transformKeys
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray);
 
 
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_allocateKeys
@@ -38,8 +59,13 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProt
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeys
   (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, int);
 
-JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
-	(JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray);
+/*
+ * Class:     edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2
+ * Method:    verifyDecommitments
+ * Signature: ([B[B[BI)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitments
+	(JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, jint);
 
 #ifdef __cplusplus
 }
@@ -6,38 +6,153 @@
 
 using namespace std;
 
-void restoreKeys(block* receivedKeys, char* matrix, int n, int m, block* restoredKeys){
+//The index of the lowest and the highest set bit of a non zero word.
+#ifdef _MSC_VER
+#include <intrin.h>
+static inline int lowestBit(uint64_t word) { unsigned long index; _BitScanForward64(&index, word); return index; }
+static inline int highestBit(uint64_t word) { unsigned long index; _BitScanReverse64(&index, word); return index; }
+#else
+static inline int lowestBit(uint64_t word) { return __builtin_ctzll(word); }
+static inline int highestBit(uint64_t word) { return 63 - __builtin_clzll(word); }
+#endif
 
-	block xorOfShares;
-	for (int i = 0; i < n; i++) {
-		
-		xorOfShares = _mm_setzero_si128();
+PackedMatrix* createPackedMatrix(int n, int m)
+{
+	PackedMatrix* matrix = new PackedMatrix;
+	matrix->n = n;
+	matrix->m = m;
+	matrix->wordsInRow = (m + 63) / 64;
+	matrix->bits = new uint64_t[n * matrix->wordsInRow]();
+	return matrix;
+}
+
+void setPackedRow(PackedMatrix* matrix, int i, const char* row)
+{
+	uint64_t* packedRow = matrix->bits + i * matrix->wordsInRow;
+	for (int j = 0; j < matrix->m; j++) {
+		if (row[j] != 0) {
+			packedRow[j / 64] |= ((uint64_t) 1) << (j % 64);
+		}
+	}
+}
 
-		for (int j = 0; j < m; j++) {
+void deletePackedMatrix(PackedMatrix* matrix)
+{
+	delete [] matrix->bits;
+	delete matrix;
+}
 
-			if (0 == matrix[i*m+j]) {
-				continue; // insignificant share
-			}
+/**
+* Restores the original keys using the matrix from the transformed keys.
+* The original key i is the xor of the received keys of the columns that are set in row i.
+* The set columns are found with a word at a time and the xor is split between two accumulators, 
+* so that the loads of the keys do not wait for each other.
+* @param receivedKeys m keys, one for each column of the matrix.
+* @param restoredKeys n keys, one for each row of the matrix.
+*/
+void restoreKeys(PackedMatrix* matrix, const unsigned char* receivedKeys, unsigned char* restoredKeys){
+
+	for (int i = 0; i < matrix->n; i++) {
+		const uint64_t* row = matrix->bits + i * matrix->wordsInRow;
+		block xorOfShares0 = _mm_setzero_si128();
+		block xorOfShares1 = _mm_setzero_si128();
+
+		for (int w = 0; w < matrix->wordsInRow; w++) {
+			uint64_t word = row[w];
 			
-			xorOfShares =  _mm_xor_si128(xorOfShares, receivedKeys[j]);
+			//Take two shares at a time.
+			while (word != 0) {
+				int j = w * 64 + lowestBit(word);
+				word &= word - 1;
+				xorOfShares0 = _mm_xor_si128(xorOfShares0, _mm_loadu_si128((const block*) (receivedKeys + j * SIZE_OF_BLOCK)));
+				if (word == 0) {
+					break;
+				}
+				j = w * 64 + lowestBit(word);
+				word &= word - 1;
+				xorOfShares1 = _mm_xor_si128(xorOfShares1, _mm_loadu_si128((const block*) (receivedKeys + j * SIZE_OF_BLOCK)));
+			}
 		}
 
-		restoredKeys[i] = xorOfShares;		
-	}	
+		_mm_storeu_si128((block*) (restoredKeys + i * SIZE_OF_BLOCK), _mm_xor_si128(xorOfShares0, xorOfShares1));
+	}
 }
 
 /**
-	* Gets a original keys and transform them into keys that corresponds to the matrix.
-	* @param originalKeys The keys that matched the rows of the matrix.
-	* @param mes used to generate new keys.
-	* @return the transformed keys, that matched the columns of the matrix.
-	*/
-void transformKeys(block* originalKeys, block* probeResistantKeys, block* newKeys, int n, int m, char* matrix) {
+* Gets a original keys and transform them into keys that corresponds to the matrix.
+* For each row i, every column of the row that has no keys yet gets the keys (newKeys[i], newKeys[i]^delta), except for the last one, 
+* that gets the keys that complete the xor of the 0-keys of the row to the 0-key of row i.
+* @param originalKeys The two keys of each row of the matrix.
+* @param probeResistantKeys The two keys of each column of the matrix. Should be zero when the function is called.
+* @param newKeys A new key for each row of the matrix.
+* @return false if some row has no column without keys, that is, the matrix is not probe resistant.
+*/
+bool transformKeys(PackedMatrix* matrix, const unsigned char* originalKeys, unsigned char* probeResistantKeys, const block* newKeys) {
 	
-	//For each pair of original keys allocate new keys and put them in the probeResistantKeys array.
-	for (int i = 0; i < n; i++) {
-		allocateKeys(probeResistantKeys, originalKeys[i*2], originalKeys[i*2+1], i, newKeys[i], m, matrix);
+	int wordsInRow = matrix->wordsInRow;
+	//The columns that already have keys.
+	uint64_t* assigned = new uint64_t[wordsInRow]();
+	bool isProbeResistant = true;
+
+	for (int i = 0; i < matrix->n; i++) {
+		const uint64_t* row = matrix->bits + i * wordsInRow;
+		block originalKey0 = _mm_loadu_si128((const block*) (originalKeys + 2 * i * SIZE_OF_BLOCK));
+		block originalKey1 = _mm_loadu_si128((const block*) (originalKeys + (2 * i + 1) * SIZE_OF_BLOCK));
+		block delta = _mm_xor_si128(originalKey0, originalKey1);
+		block newKey = newKeys[i];
+
+		//The last share is the last column of the row that has no keys yet.
+		int lastShare = -1;
+		for (int w = wordsInRow - 1; w >= 0 && lastShare == -1; w--) {
+			uint64_t unassigned = row[w] & ~assigned[w];
+			if (unassigned != 0) {
+				lastShare = w * 64 + highestBit(unassigned);
+			}
+		}
+		// This might fail if the matrix is not probe resistant, with negligible probability.
+		if (lastShare == -1) {
+			isProbeResistant = false;
+			continue;
+		}
+
+		block xorOfShares = originalKey0;
+		int numOfNewShares = 0;
+		for (int w = 0; w < wordsInRow; w++) {
+			uint64_t unassigned = row[w] & ~assigned[w];
+			uint64_t alreadyAssigned = row[w] & assigned[w];
+			
+			//Shares that already have keys are added to the xor as is.
+			while (alreadyAssigned != 0) {
+				int j = w * 64 + lowestBit(alreadyAssigned);
+				alreadyAssigned &= alreadyAssigned - 1;
+				xorOfShares = _mm_xor_si128(xorOfShares, _mm_loadu_si128((const block*) (probeResistantKeys + 2 * j * SIZE_OF_BLOCK)));
+			}
+
+			//New shares get the new key of the row.
+			while (unassigned != 0) {
+				int j = w * 64 + lowestBit(unassigned);
+				unassigned &= unassigned - 1;
+				if (j != lastShare) {
+					_mm_storeu_si128((block*) (probeResistantKeys + 2 * j * SIZE_OF_BLOCK), newKey);
+					_mm_storeu_si128((block*) (probeResistantKeys + (2 * j + 1) * SIZE_OF_BLOCK), _mm_xor_si128(newKey, delta));
+					numOfNewShares++;
+				}
+			}
+			assigned[w] |= row[w];
+		}
+		
+		//Each new share adds the new key to the xor, so only the parity of their number matters.
+		if (numOfNewShares & 1) {
+			xorOfShares = _mm_xor_si128(xorOfShares, newKey);
+		}
+
+		//The last pair of keys are the xor of all shares and the xor of it with delta.
+		_mm_storeu_si128((block*) (probeResistantKeys + 2 * lastShare * SIZE_OF_BLOCK), xorOfShares);
+		_mm_storeu_si128((block*) (probeResistantKeys + (2 * lastShare + 1) * SIZE_OF_BLOCK), _mm_xor_si128(xorOfShares, delta));
 	}
+
+	delete [] assigned;
+	return isProbeResistant;
 }
 
 void allocateKeys(block* probeResistantKeys, block originalKey0, block originalKey1, int i, block newKey, int m, char* matrix){
@@ -1,17 +1,39 @@
+#pragma once
 #include <emmintrin.h>
+#include <stdint.h>
 
 
 typedef __m128i block;
 
 #define SIZE_OF_BLOCK 16//size in bytes
 
-void restoreKeys(block* receivedKeys, char* matrix, int n, int m, block* restoredKeys);
+/*
+ * The K probe-resistant matrix, packed to a bit per entry and 64 columns in a word.
+ * The matrix is packed once and kept by the java KProbeResistantMatrix, instead of being copied row by row in every call.
+ */
+struct PackedMatrix {
+	int n;				//Number of rows.
+	int m;				//Number of columns.
+	int wordsInRow;
+	uint64_t* bits;		//The rows, one after the other.
+};
+
+PackedMatrix* createPackedMatrix(int n, int m);
+
+//Sets row i of the matrix from an array of m bytes, each one is 0 or 1.
+void setPackedRow(PackedMatrix* matrix, int i, const char* row);
+
+void deletePackedMatrix(PackedMatrix* matrix);
+
+//The keys are arrays of SIZE_OF_BLOCK bytes keys, not necessarily aligned.
+void restoreKeys(PackedMatrix* matrix, const unsigned char* receivedKeys, unsigned char* restoredKeys);
+
+bool transformKeys(PackedMatrix* matrix, const unsigned char* originalKeys, unsigned char* probeResistantKeys, const block* newKeys);
 
 void xorKeysWithMask(block* keys, block mask, int size);
 
 void xorKeys(block* keys1, block* keys2, block* output);
 
-void transformKeys(block* originalKeys, block* probeResistantKeys, block* newKeys, int n, int m, char* matrix);
 
 void allocateKeys(block* probeResistantKeys, block originalKey0, block originalKey1, int i, block newKey, int m, char* matrix);
 
@@ -0,0 +1,97 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+#include "stdafx.h"
+#include "ClmulEvaluationHashFunction.h"
+#include <string.h>
+
+//The low part of f(x), that is x^64 mod f(x) = x^4 + x^3 + x + 1.
+#define EVAL_HASH_POLY 0x1BULL
+
+ClmulEvaluationHashFunction::ClmulEvaluationHashFunction(const unsigned char* key)
+{
+	memcpy(&keyPowers[0], key, 8);
+	for (int i = 1; i < 4; i++)
+	{
+		keyPowers[i] = multiply(keyPowers[i-1], keyPowers[0]);
+	}
+}
+
+unsigned long long ClmulEvaluationHashFunction::reduce(__m128i product)
+{
+	const __m128i poly = _mm_cvtsi64_si128(EVAL_HASH_POLY);
+
+	//product = high*x^64 + low = high*(x^4 + x^3 + x + 1) + low.
+	//high*(x^4 + x^3 + x + 1) has degree at most 67, so its 4 high bits are folded once more.
+	__m128i fold = _mm_clmulepi64_si128(product, poly, 0x01);
+	__m128i fold2 = _mm_clmulepi64_si128(fold, poly, 0x01);
+
+	return _mm_cvtsi128_si64(product) ^ _mm_cvtsi128_si64(fold) ^ _mm_cvtsi128_si64(fold2);
+}
+
+unsigned long long ClmulEvaluationHashFunction::multiply(unsigned long long x, unsigned long long y)
+{
+	return reduce(_mm_clmulepi64_si128(_mm_cvtsi64_si128(x), _mm_cvtsi64_si128(y), 0x00));
+}
+
+unsigned long long ClmulEvaluationHashFunction::horner(unsigned long long h, const unsigned char* input, int numBlocks)
+{
+	unsigned long long m[4];
+	const __m128i a1 = _mm_cvtsi64_si128(keyPowers[0]);
+	const __m128i a2 = _mm_cvtsi64_si128(keyPowers[1]);
+	const __m128i a3 = _mm_cvtsi64_si128(keyPowers[2]);
+	const __m128i a4 = _mm_cvtsi64_si128(keyPowers[3]);
+
+	//The blocks that do not fill a group of four are the last ones, so they are processed first, one by one.
+	int i = numBlocks;
+	while (i % 4 != 0)
+	{
+		i--;
+		memcpy(m, input + 8*i, 8);
+		h = multiply(h ^ m[0], keyPowers[0]);
+	}
+
+	//h = (h + M_(j+3))*a^4 + M_(j+2)*a^3 + M_(j+1)*a^2 + M_j*a
+	while (i > 0)
+	{
+		i -= 4;
+		memcpy(m, input + 8*i, 32);
+		__m128i sum = _mm_clmulepi64_si128(_mm_cvtsi64_si128(h ^ m[3]), a4, 0x00);
+		sum = _mm_xor_si128(sum, _mm_clmulepi64_si128(_mm_cvtsi64_si128(m[2]), a3, 0x00));
+		sum = _mm_xor_si128(sum, _mm_clmulepi64_si128(_mm_cvtsi64_si128(m[1]), a2, 0x00));
+		sum = _mm_xor_si128(sum, _mm_clmulepi64_si128(_mm_cvtsi64_si128(m[0]), a1, 0x00));
+		h = reduce(sum);
+	}
+
+	return h;
+}
+
+void ClmulEvaluationHashFunction::computeFunction(const unsigned char* input, int inLen, const unsigned char* tail, int tailLen, unsigned char* output)
+{
+	//The tail holds the last coefficients of M(x), so it is processed first.
+	unsigned long long h = horner(0, tail, tailLen/8);
+	h = horner(h, input, inLen/8);
+
+	memcpy(output, &h, 8);
+}
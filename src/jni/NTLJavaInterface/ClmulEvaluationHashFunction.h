@@ -0,0 +1,76 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#pragma once
+
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+/********************************************************************
+	purpose:	This class implements the same 64 bits evaluation hash function as EvaluationHashFunction, 
+				without NTL, using the carry-less multiplication instruction (PCLMULQDQ).
+				
+				The field GF(2^64) is GF(2)[x]/f(x) with f(x) = x^64 + x^4 + x^3 + x + 1, and every 8 bytes of the input 
+				are read as an element in the same way NTL does: byte i holds the coefficients of x^(8i) ... x^(8i+7), 
+				so on a little endian machine an element is just the 64 bit word at that place.
+
+				computeFunction computes M(a)*a = M_0*a + M_1*a^2 + ... + M_(t-1)*a^t by Horner's rule from the last coefficient down,
+				four coefficients at a time: h = (h + M_(j+3))*a^4 + M_(j+2)*a^3 + M_(j+1)*a^2 + M_j*a.
+				The four products are added unreduced and reduced once, so four coefficients cost four multiplications and a single reduction.
+
+				All the state is in the object (the key and its powers), so different instances can be used concurrently,
+				unlike the NTL implementation that works in the process wide field of GF2E::init.
+*********************************************************************/
+class ClmulEvaluationHashFunction
+{
+private:
+
+	//a, a^2, a^3 and a^4, where a is the key.
+	unsigned long long keyPowers[4];
+
+	//Returns the product of the given elements, reduced modulo f(x).
+	static unsigned long long multiply(unsigned long long x, unsigned long long y);
+
+	//Reduces a product of degree at most 126 modulo f(x).
+	static unsigned long long reduce(__m128i product);
+
+public:
+
+	//creates the object with the first 8 bytes of the given key as the element a.
+	ClmulEvaluationHashFunction(const unsigned char* key);
+
+	/*
+	 * Continues Horner's rule with the numBlocks elements of the given input, from the last one to the first one.
+	 * Starting with h = 0 and calling the function with the blocks of the input from the last block to the first one
+	 * (in as many calls as needed) gives the value of the hash.
+	 */
+	unsigned long long horner(unsigned long long h, const unsigned char* input, int numBlocks);
+
+	/*
+	 * Computes the hash of the input followed by the given tail (that holds the padding), and writes the 8 bytes of the result to output.
+	 * inLen and tailLen are multiples of 8.
+	 */
+	void computeFunction(const unsigned char* input, int inLen, const unsigned char* tail, int tailLen, unsigned char* output);
+};
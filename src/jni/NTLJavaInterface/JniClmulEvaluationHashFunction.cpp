@@ -0,0 +1,68 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+#include "stdafx.h"
+#include "JniClmulEvaluationHashFunction.h"
+#include "ClmulEvaluationHashFunction.h"
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_universalHash_ClmulEvaluationHashFunction_initHash
+  (JNIEnv *env, jobject, jbyteArray key){
+
+	  //the first 8 bytes of the key are the element a
+	  jbyte keyBytes[8];
+	  env->GetByteArrayRegion(key, 0, 8, keyBytes);
+
+	  //return the created dynamic allocation of the evaluation hash object
+	  return (jlong) new ClmulEvaluationHashFunction((unsigned char *)keyBytes);
+}
+
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_universalHash_ClmulEvaluationHashFunction_computeFunction
+  (JNIEnv *env, jobject, jlong evalHashObjectPtr, jbyteArray in, jint inOffset, jint inLen, jbyteArray tail, jbyteArray out, jint outOffset){
+
+	  //cast the ClmulEvaluationHashFunction object
+	  ClmulEvaluationHashFunction* evalHashPtr = (ClmulEvaluationHashFunction *)evalHashObjectPtr;
+
+	  int tailLen = env->GetArrayLength(tail);
+
+	  //the input is read in place, without copying it or padding it. The padding is in the tail.
+	  jbyte* carrIn = (jbyte*) env->GetPrimitiveArrayCritical(in, 0);
+	  jbyte* carrTail = (jbyte*) env->GetPrimitiveArrayCritical(tail, 0);
+
+	  jbyte result[8];
+	  evalHashPtr->computeFunction((unsigned char *)carrIn + inOffset, inLen, (unsigned char *)carrTail, tailLen, (unsigned char *)result);
+
+	  //the arrays were only read, so there is nothing to copy back
+	  env->ReleasePrimitiveArrayCritical(tail, carrTail, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(in, carrIn, JNI_ABORT);
+
+	  env->SetByteArrayRegion(out, outOffset, 8, result);
+}
+
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_universalHash_ClmulEvaluationHashFunction_deleteHash
+  (JNIEnv *, jobject, jlong evalHashObjectPtr){
+
+	  delete (ClmulEvaluationHashFunction *)evalHashObjectPtr;
+}
@@ -0,0 +1,165 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "AesCtr.h"
+#include <openssl/evp.h>
+#include <string.h>
+
+/*
+ * The native AES-CTR prg.
+ * The output stream is AES(key, 1), AES(key, 2), ... where the counters are 128 bit big endian numbers, that is,
+ * the same stream ScPrgFromPrf generates with AES, but computed by OpenSSL's AES-CTR in a single call.
+ * The position in the stream is given by the java side in every call. As long as the stream is read sequentially
+ * the cipher just continues, otherwise it is moved to the requested position before generating.
+ */
+typedef struct AesCtrPrg {
+	EVP_CIPHER_CTX* ctx;
+	long long position;		//The position of the cipher in the stream, in bytes.
+} AesCtrPrg;
+
+/*
+ * Moves the cipher to the given byte of the stream.
+ */
+static void seek(AesCtrPrg* prg, long long position) {
+	//The counter block of the block that contains the position is 1 + position/16, as a 128 bit big endian number.
+	unsigned char counter[16];
+	unsigned long long block = (unsigned long long) position / 16 + 1;
+	memset(counter, 0, 8);
+	for (int i = 15; i >= 8; i--) {
+		counter[i] = (unsigned char) block;
+		block >>= 8;
+	}
+
+	//Keep the key and set the counter.
+	EVP_EncryptInit_ex(prg->ctx, NULL, NULL, NULL, counter);
+
+	//Skip the bytes of the block that precede the position.
+	int skip = (int) (position % 16);
+	if (skip > 0) {
+		unsigned char zeros[16] = { 0 };
+		int len;
+		EVP_EncryptUpdate(prg->ctx, zeros, &len, zeros, skip);
+	}
+	prg->position = position;
+}
+
+/*
+ * Fills the given memory with the bytes of the stream from the given position.
+ */
+static void generate(AesCtrPrg* prg, long long position, unsigned char* out, int outLen) {
+	if (position != prg->position) {
+		seek(prg, position);
+	}
+
+	//The output is the encryption of zeros, computed in place.
+	int len;
+	memset(out, 0, outLen);
+	EVP_EncryptUpdate(prg->ctx, out, &len, out, outLen);
+	prg->position += outLen;
+}
+
+/* 
+ * function createAesCtr	: Creates a native AES-CTR prg.
+ * return					: Pointer to the created prg.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtr_createAesCtr
+  (JNIEnv *, jobject){
+	  AesCtrPrg* prg = new AesCtrPrg;
+	  prg->ctx = EVP_CIPHER_CTX_new();
+	  prg->position = 0;
+
+	  return (jlong) prg;
+}
+
+/* 
+ * function initAesCtr		: Sets the given key to the prg and moves it to the beginning of the stream.
+ * param prgPtr				: Pointer to the native prg.
+ * param key				: The key that should be set. Should be 16, 24 or 32 bytes long.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtr_initAesCtr
+  (JNIEnv *env, jobject, jlong prgPtr, jbyteArray key){
+	  AesCtrPrg* prg = (AesCtrPrg*) prgPtr;
+
+	  int keySize = env->GetArrayLength(key);
+	  jbyte* keyBytes = env->GetByteArrayElements(key, 0);
+
+	  const EVP_CIPHER* cipher;
+	  if (keySize == 16) {
+		  cipher = EVP_aes_128_ctr();
+	  } else if (keySize == 24) {
+		  cipher = EVP_aes_192_ctr();
+	  } else {
+		  cipher = EVP_aes_256_ctr();
+	  }
+	  EVP_EncryptInit_ex(prg->ctx, cipher, NULL, (unsigned char*) keyBytes, NULL);
+	  seek(prg, 0);
+
+	  env->ReleaseByteArrayElements(key, keyBytes, JNI_ABORT);
+}
+
+/* 
+ * function generateBytes	: Generates bytes of the stream from the given position into a java array.
+ * param prgPtr				: Pointer to the native prg.
+ * param position			: The position in the stream of the first byte to generate.
+ * param out				: The output array that should be filled with pseudo random bytes.
+ * param outOffset			: The offset within the output array to fill the bytes from.
+ * param outLen				: The number of bytes to generate.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtr_generateBytes
+  (JNIEnv *env, jobject, jlong prgPtr, jlong position, jbyteArray out, jint outOffset, jint outLen){
+	  
+	  //The bytes are generated directly into the java array, without copying.
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+	  generate((AesCtrPrg*) prgPtr, position, output + outOffset, outLen);
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+}
+
+/* 
+ * function generateBytesDirect	: Generates bytes of the stream from the given position into a direct buffer.
+ * param prgPtr					: Pointer to the native prg.
+ * param position				: The position in the stream of the first byte to generate.
+ * param out					: The direct buffer that should be filled with pseudo random bytes.
+ * param outOffset				: The offset within the buffer to fill the bytes from.
+ * param outLen					: The number of bytes to generate.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtr_generateBytesDirect
+  (JNIEnv *env, jobject, jlong prgPtr, jlong position, jobject out, jint outOffset, jint outLen){
+	  
+	  unsigned char* output = (unsigned char*) env->GetDirectBufferAddress(out);
+	  generate((AesCtrPrg*) prgPtr, position, output + outOffset, outLen);
+}
+
+/* 
+ * function deleteNative		: Deletes the native prg.
+ * param prgPtr					: Pointer to the native prg.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtr_deleteNative
+  (JNIEnv *, jobject, jlong prgPtr){
+	  AesCtrPrg* prg = (AesCtrPrg*) prgPtr;
+	  EVP_CIPHER_CTX_free(prg->ctx);
+	  delete prg;
+}
@@ -28,10 +28,259 @@
 #include "DSA.h"
 #include <openssl/dsa.h>
 #include <openssl/rand.h>
+#include <openssl/bn.h>
 #include <iostream>
+#include <string.h>
+#include <vector>
 
 using namespace std;
 
+/*
+ * The number of exponent bits handled by each window of a fixed-base table.
+ */
+#define FIXED_BASE_WINDOW 4
+#define FIXED_BASE_ENTRIES ((1 << FIXED_BASE_WINDOW) - 1)
+
+/*
+ * Precomputed powers of a fixed base modulo p, in Montgomery form:
+ * powers[i*FIXED_BASE_ENTRIES + d - 1] = base^(d * 2^(i*FIXED_BASE_WINDOW)) for every window i and digit d in [1, 2^FIXED_BASE_WINDOW).
+ * Raising the base to an exponent of at most numWindows*FIXED_BASE_WINDOW bits then costs one multiplication per non zero window
+ * and no squarings.
+ */
+struct FixedBaseTable {
+	BIGNUM* base;
+	int numWindows;
+	vector<BIGNUM*> powers;
+};
+
+/*
+ * The native state of the batch functions of a DSA object.
+ * The Montgomery context of p and the tables of g and of the public key y are built by the first batch verification
+ * and kept as long as the public key does not change.
+ * The nonces are pairs of (k^-1, r = (g^k mod p) mod q) computed ahead of time by precomputeNonces, each one is used for one signature.
+ */
+struct DSABatchContext {
+	BN_MONT_CTX* mont;
+	FixedBaseTable* gTable;
+	FixedBaseTable* yTable;
+	vector<BIGNUM*> kinvs;
+	vector<BIGNUM*> rs;
+};
+
+static void deleteFixedBaseTable(FixedBaseTable* table){
+	if (table == NULL){
+		return;
+	}
+	BN_free(table->base);
+	for (size_t i = 0; i < table->powers.size(); i++){
+		BN_free(table->powers[i]);
+	}
+	delete table;
+}
+
+/*
+ * Builds the table of the given base for exponents of up to exponentBits bits.
+ */
+static FixedBaseTable* createFixedBaseTable(const BIGNUM* base, int exponentBits, BN_MONT_CTX* mont, BN_CTX* ctx){
+	FixedBaseTable* table = new FixedBaseTable;
+	table->base = BN_dup(base);
+	table->numWindows = (exponentBits + FIXED_BASE_WINDOW - 1) / FIXED_BASE_WINDOW;
+	table->powers.resize(table->numWindows * FIXED_BASE_ENTRIES);
+	bool ok = (table->base != NULL);
+
+	for (int i = 0; i < table->numWindows && ok; i++){
+		BIGNUM** window = &table->powers[i * FIXED_BASE_ENTRIES];
+		for (int d = 0; d < FIXED_BASE_ENTRIES; d++){
+			window[d] = BN_new();
+		}
+		//The first entry of each window is the last entry of the previous window multiplied by its first entry,
+		//that is base^(2^(i*FIXED_BASE_WINDOW)).
+		if (i == 0){
+			ok = BN_to_montgomery(window[0], base, mont, ctx);
+		} else {
+			BIGNUM** previous = window - FIXED_BASE_ENTRIES;
+			ok = BN_mod_mul_montgomery(window[0], previous[FIXED_BASE_ENTRIES - 1], previous[0], mont, ctx);
+		}
+		for (int d = 1; d < FIXED_BASE_ENTRIES && ok; d++){
+			ok = BN_mod_mul_montgomery(window[d], window[d - 1], window[0], mont, ctx);
+		}
+	}
+
+	if (!ok){
+		deleteFixedBaseTable(table);
+		return NULL;
+	}
+	return table;
+}
+
+/*
+ * Multiplies acc (in Montgomery form) by base^exponent using the table of the base.
+ */
+static bool fixedBaseMultiply(BIGNUM* acc, const FixedBaseTable* table, const BIGNUM* exponent, BN_MONT_CTX* mont, BN_CTX* ctx){
+	int bits = BN_num_bits(exponent);
+	if (bits > table->numWindows * FIXED_BASE_WINDOW){
+		return false;
+	}
+	for (int i = 0; i * FIXED_BASE_WINDOW < bits; i++){
+		int d = 0;
+		for (int b = FIXED_BASE_WINDOW - 1; b >= 0; b--){
+			d = (d << 1) | BN_is_bit_set(exponent, i * FIXED_BASE_WINDOW + b);
+		}
+		if (d != 0 && !BN_mod_mul_montgomery(acc, acc, table->powers[i * FIXED_BASE_ENTRIES + d - 1], mont, ctx)){
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Makes sure that the Montgomery context of p and the tables of g and of the current public key are built.
+ */
+static bool prepareTables(DSA* dsa, DSABatchContext* batch, BN_CTX* ctx){
+	if (batch->mont == NULL){
+		batch->mont = BN_MONT_CTX_new();
+		if (!BN_MONT_CTX_set(batch->mont, dsa->p, ctx)){
+			BN_MONT_CTX_free(batch->mont);
+			batch->mont = NULL;
+			return false;
+		}
+	}
+	int qBits = BN_num_bits(dsa->q);
+	if (batch->gTable == NULL){
+		batch->gTable = createFixedBaseTable(dsa->g, qBits, batch->mont, ctx);
+	}
+	if (batch->yTable != NULL && BN_cmp(batch->yTable->base, dsa->pub_key) != 0){
+		deleteFixedBaseTable(batch->yTable);
+		batch->yTable = NULL;
+	}
+	if (batch->yTable == NULL){
+		batch->yTable = createFixedBaseTable(dsa->pub_key, qBits, batch->mont, ctx);
+	}
+	return batch->gTable != NULL && batch->yTable != NULL;
+}
+
+/*
+ * Verifies num signatures (r[i], s[i]) of the digests m[i] (already truncated to the size of q).
+ * results[i] should be true for the signatures that were parsed, they are set to false if the signature is not valid.
+ * The inverses of all the s values are computed together with a single modular inversion (Montgomery's trick), then 
+ * g^u1 * y^u2 is computed with the fixed-base tables of g and y, sharing one accumulator for both exponents.
+ * If stopOnFailure is true the function returns at the first invalid signature and the results of the signatures that were not
+ * checked yet are meaningless.
+ * return	: true if all the signatures are valid.
+ */
+static bool verifySignatures(DSA* dsa, DSABatchContext* batch, int num, BIGNUM** r, BIGNUM** s, BIGNUM** m, jboolean* results, 
+							 bool stopOnFailure, BN_CTX* ctx){
+	const BIGNUM* q = dsa->q;
+
+	//r and s should be in [1, q).
+	for (int i = 0; i < num; i++){
+		if (results[i] && (BN_is_zero(r[i]) || BN_is_negative(r[i]) || BN_ucmp(r[i], q) >= 0 || 
+			BN_is_zero(s[i]) || BN_is_negative(s[i]) || BN_ucmp(s[i], q) >= 0)){
+			results[i] = false;
+		}
+		if (!results[i] && stopOnFailure){
+			return false;
+		}
+	}
+
+	if (!prepareTables(dsa, batch, ctx)){
+		for (int i = 0; i < num; i++){
+			results[i] = false;
+		}
+		return false;
+	}
+
+	BN_CTX_start(ctx);
+	BIGNUM* inverse = BN_CTX_get(ctx);
+	BIGNUM* w = BN_CTX_get(ctx);
+	BIGNUM* u1 = BN_CTX_get(ctx);
+	BIGNUM* u2 = BN_CTX_get(ctx);
+	BIGNUM* acc = BN_CTX_get(ctx);
+	vector<BIGNUM*> prefix(num, (BIGNUM*) NULL);
+	bool ok = (acc != NULL);
+
+	//prefix[i] holds the product of the s values of all the valid signatures up to i.
+	int last = -1;
+	for (int i = 0; i < num && ok; i++){
+		if (results[i]){
+			prefix[i] = BN_new();
+			ok = (last == -1) ? (BN_copy(prefix[i], s[i]) != NULL) : BN_mod_mul(prefix[i], prefix[last], s[i], q, ctx);
+			last = i;
+		}
+	}
+	if (ok && last != -1){
+		ok = (BN_mod_inverse(inverse, prefix[last], q, ctx) != NULL);
+	}
+
+	//Go over the signatures from the last one, so that inverse is always the inverse of prefix[i].
+	for (int i = last; i >= 0 && ok; i--){
+		if (!results[i]){
+			continue;
+		}
+		int previous = i - 1;
+		while (previous >= 0 && !results[previous]){
+			previous--;
+		}
+		//w = s[i]^-1 and inverse becomes the inverse of prefix[previous].
+		if (previous >= 0){
+			ok = BN_mod_mul(w, inverse, prefix[previous], q, ctx) && BN_mod_mul(inverse, inverse, s[i], q, ctx);
+		} else {
+			ok = (BN_copy(w, inverse) != NULL);
+		}
+
+		//v = ((g^(m*w) * y^(r*w)) mod p) mod q should be equal to r.
+		ok = ok && BN_mod_mul(u1, m[i], w, q, ctx) && BN_mod_mul(u2, r[i], w, q, ctx) &&
+			BN_to_montgomery(acc, BN_value_one(), batch->mont, ctx) && 
+			fixedBaseMultiply(acc, batch->gTable, u1, batch->mont, ctx) && fixedBaseMultiply(acc, batch->yTable, u2, batch->mont, ctx) &&
+			BN_from_montgomery(acc, acc, batch->mont, ctx) && BN_mod(acc, acc, q, ctx);
+		if (ok && BN_ucmp(acc, r[i]) != 0){
+			results[i] = false;
+			if (stopOnFailure){
+				break;
+			}
+		}
+	}
+
+	//In case of an internal error none of the signatures is accepted.
+	bool allValid = true;
+	for (int i = 0; i < num; i++){
+		BN_free(prefix[i]);
+		results[i] = results[i] && ok;
+		allValid = allValid && results[i];
+	}
+	BN_CTX_end(ctx);
+	return allValid;
+}
+
+/*
+ * Takes the next precomputed nonce, if there is one, and sets it to the DSA object so that the next call to DSA_sign uses it
+ * instead of computing a new one. DSA_sign takes the ownership of the nonce and clears it from the DSA object.
+ */
+static void usePrecomputedNonce(DSA* dsa, DSABatchContext* batch){
+	if (!batch->kinvs.empty()){
+		dsa->kinv = batch->kinvs.back();
+		dsa->r = batch->rs.back();
+		batch->kinvs.pop_back();
+		batch->rs.pop_back();
+	}
+}
+
+/*
+ * Signs the given message into sig (of DSA_size bytes) and returns the signature bytes, or NULL if the signing failed.
+ */
+static jbyteArray signMessage(JNIEnv* env, DSA* dsa, DSABatchContext* batch, const unsigned char* message, int len, unsigned char* sig){
+	usePrecomputedNonce(dsa, batch);
+	unsigned int siglen;
+	if (!DSA_sign(0, message, len, sig, &siglen, dsa)){
+		return NULL;
+	}
+
+	//The DER encoding of the signature can be shorter than DSA_size, return only its bytes.
+	jbyteArray result = env->NewByteArray(siglen);
+	env->SetByteArrayRegion(result, 0, siglen, (jbyte*)sig);
+	return result;
+}
+
 /* 
  * function createDSA		: This function creates a DSA object that computes the DSA scheme.
  * return					: a pointer to the created object.
@@ -105,15 +354,16 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSigna
 }
 
 /*
- * function sign				: Signs the given message.
+ * function sign				: Signs the given message, using a precomputed nonce if there is one.
  * param dsa					: A pointer to the DSA object.
+ * param batch					: A pointer to the batch context that keeps the precomputed nonces.
  * param msg					: The message to sign.
  * param offset					: The offset within the message to take the bytes from.
  * param len					: The length of the message to sign.
- * return jbyteArray			: The signature bytes.
+ * return jbyteArray			: The signature bytes, or null if the signing failed.
  */
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_sign
-  (JNIEnv * env, jobject, jlong dsa, jbyteArray msg, jint offset, jint len){
+  (JNIEnv * env, jobject, jlong dsa, jlong batch, jbyteArray msg, jint offset, jint len){
 	  //Convert the given data into c++ notation.
 	  jbyte* message  = (jbyte*) env->GetByteArrayElements(msg, 0);
 	  
@@ -124,21 +374,14 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digita
 	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
 #endif
 
-	  //Allocate a new byte array to hold the output.
-	  int size = DSA_size((DSA *) dsa);
-	  unsigned char* sig = new unsigned char[size]; 
-	  unsigned int siglen;
+	  //Allocate a buffer of the maximal signature size to hold the output.
+	  vector<unsigned char> sig(DSA_size((DSA *) dsa));
 
 	  //Sign the message.
-	  DSA_sign(0, (unsigned char*) message + offset, len, sig, &siglen, (DSA*) dsa);
-
-	  //Build jbyteArray from the byteArray.
-	  jbyteArray result = env ->NewByteArray(size);
-	  env->SetByteArrayRegion(result, 0, size, (jbyte*)sig);
+	  jbyteArray result = signMessage(env, (DSA*) dsa, (DSABatchContext*) batch, (unsigned char*) message + offset, len, &sig[0]);
 	 
 	  //Release the allocated memory.
-	  env->ReleaseByteArrayElements(msg, message, 0);
-	  delete sig;
+	  env->ReleaseByteArrayElements(msg, message, JNI_ABORT);
 
 	  return result;
 }
@@ -168,6 +411,201 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalS
 	  return result;
 }
 
+/*
+ * function createBatchContext	: Creates the native state of the batch functions. 
+ *								  The fixed-base tables are built by the first batch verification and the nonces by precomputeNonces.
+ * return						: a pointer to the created object.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_createBatchContext
+  (JNIEnv *, jobject){
+	  DSABatchContext* batch = new DSABatchContext;
+	  batch->mont = NULL;
+	  batch->gTable = NULL;
+	  batch->yTable = NULL;
+	  return (jlong) batch;
+}
+
+/*
+ * function precomputeNonces	: Computes nonces for the following signatures: for each one a random k, k^-1 mod q and r = (g^k mod p) mod q.
+ *								  This is the part of the signing that does not depend on the message, so it can be done ahead of time.
+ * param dsa					: A pointer to the DSA object.
+ * param batch					: A pointer to the batch context that keeps the nonces.
+ * param count					: The number of nonces to compute.
+ * return jboolean				: True, if all the nonces were computed. False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_precomputeNonces
+  (JNIEnv *, jobject, jlong dsa, jlong batch, jint count){
+	  DSABatchContext* context = (DSABatchContext*) batch;
+
+	  //Seed the random geneartor.
+#ifdef _WIN32
+	  RAND_screen(); // only defined for windows, reseeds from screen contents
+#else
+	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
+#endif
+
+	  BN_CTX* ctx = BN_CTX_new();
+	  bool ok = (ctx != NULL);
+	  for (int i = 0; i < count && ok; i++){
+		  BIGNUM* kinv = NULL;
+		  BIGNUM* r = NULL;
+		  ok = DSA_sign_setup((DSA*) dsa, ctx, &kinv, &r);
+		  if (ok){
+			  context->kinvs.push_back(kinv);
+			  context->rs.push_back(r);
+		  }
+	  }
+	  BN_CTX_free(ctx);
+	  return ok;
+}
+
+/*
+ * function getNumOfNonces		: Returns the number of precomputed nonces that were not used yet.
+ * param batch					: A pointer to the batch context.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_getNumOfNonces
+  (JNIEnv *, jobject, jlong batch){
+	  return (jint) ((DSABatchContext*) batch)->kinvs.size();
+}
+
+/*
+ * function signBatch			: Signs each one of the given messages, using the precomputed nonces while there are any.
+ * param dsa					: A pointer to the DSA object.
+ * param batch					: A pointer to the batch context.
+ * param msgs					: The messages to sign.
+ * return jobjectArray			: The signature bytes of each message, or null if one of the signings failed.
+ */
+JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_signBatch
+  (JNIEnv *env, jobject, jlong dsa, jlong batch, jobjectArray msgs){
+	  int num = env->GetArrayLength(msgs);
+	  jclass byteClass = env->FindClass("[B");
+	  jobjectArray signatures = env->NewObjectArray(num, byteClass, NULL);
+
+	  //Seed the random geneartor, in case there are not enough precomputed nonces.
+	  if ((int) ((DSABatchContext*) batch)->kinvs.size() < num){
+#ifdef _WIN32
+		  RAND_screen(); // only defined for windows, reseeds from screen contents
+#else
+		  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
+#endif
+	  }
+
+	  vector<unsigned char> sig(DSA_size((DSA*) dsa));
+	  vector<unsigned char> message;
+	  for (int i = 0; i < num; i++){
+		  //Copy the message, so that the signing does not run while the java array is pinned.
+		  jbyteArray msg = (jbyteArray) env->GetObjectArrayElement(msgs, i);
+		  int len = env->GetArrayLength(msg);
+		  message.resize(len + 1);
+		  env->GetByteArrayRegion(msg, 0, len, (jbyte*) &message[0]);
+		  env->DeleteLocalRef(msg);
+
+		  jbyteArray signature = signMessage(env, (DSA*) dsa, (DSABatchContext*) batch, &message[0], len, &sig[0]);
+		  if (signature == NULL){
+			  return NULL;
+		  }
+		  env->SetObjectArrayElement(signatures, i, signature);
+		  env->DeleteLocalRef(signature);
+	  }
+	  return signatures;
+}
+
+/*
+ * function verifyBatch			: Verifies each one of the given signatures with the matching message.
+ *								  All the signatures are verified together: the inverses of the s values are computed with a single 
+ *								  modular inversion and g^u1*y^u2 uses precomputed fixed-base tables of g and of the public key.
+ * param dsa					: A pointer to the DSA object.
+ * param batch					: A pointer to the batch context that keeps the fixed-base tables.
+ * param signatures				: The signatures to verify.
+ * param msgs					: The signed messages.
+ * param results				: Filled with the result of each signature. May be null, if only the aggregate result is needed.
+ * param stopOnFailure			: If true, the verification stops at the first invalid signature and results is not filled.
+ * return jboolean				: True, if all the signatures are valid. False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_verifyBatch
+  (JNIEnv *env, jobject, jlong dsa, jlong batch, jobjectArray signatures, jobjectArray msgs, jbooleanArray results, jboolean stopOnFailure){
+	  DSA* key = (DSA*) dsa;
+	  int num = env->GetArrayLength(signatures);
+	  //The digest is truncated to the size of q, as in DSA_verify.
+	  int digestSize = BN_num_bits(key->q) / 8;
+
+	  vector<DSA_SIG*> sigs(num, (DSA_SIG*) NULL);
+	  vector<BIGNUM*> r(num, (BIGNUM*) NULL), s(num, (BIGNUM*) NULL), m(num, (BIGNUM*) NULL);
+	  vector<jboolean> valid(num, (jboolean) true);
+	  vector<unsigned char> bytes;
+	  for (int i = 0; i < num; i++){
+		  jbyteArray signature = (jbyteArray) env->GetObjectArrayElement(signatures, i);
+		  int len = env->GetArrayLength(signature);
+		  bytes.resize(len + 1);
+		  env->GetByteArrayRegion(signature, 0, len, (jbyte*) &bytes[0]);
+		  env->DeleteLocalRef(signature);
+
+		  //Parse the signature. As in DSA_verify, only the DER encoding without trailing bytes is accepted.
+		  const unsigned char* p = &bytes[0];
+		  sigs[i] = d2i_DSA_SIG(NULL, &p, len);
+		  unsigned char* der = NULL;
+		  int derLen = (sigs[i] == NULL) ? -1 : i2d_DSA_SIG(sigs[i], &der);
+		  if (derLen != len || memcmp(&bytes[0], der, len) != 0){
+			  valid[i] = false;
+		  } else {
+			  r[i] = sigs[i]->r;
+			  s[i] = sigs[i]->s;
+		  }
+		  OPENSSL_free(der);
+
+		  jbyteArray msg = (jbyteArray) env->GetObjectArrayElement(msgs, i);
+		  len = env->GetArrayLength(msg);
+		  if (len > digestSize){
+			  len = digestSize;
+		  }
+		  bytes.resize(len + 1);
+		  env->GetByteArrayRegion(msg, 0, len, (jbyte*) &bytes[0]);
+		  env->DeleteLocalRef(msg);
+		  m[i] = BN_bin2bn(&bytes[0], len, NULL);
+		  if (m[i] == NULL){
+			  valid[i] = false;
+		  }
+	  }
+
+	  BN_CTX* ctx = BN_CTX_new();
+	  bool allValid = (ctx != NULL) && 
+		  verifySignatures(key, (DSABatchContext*) batch, num, &r[0], &s[0], &m[0], &valid[0], stopOnFailure != 0, ctx);
+	  
+	  if (results != NULL && !stopOnFailure){
+		  if (ctx == NULL){
+			  valid.assign(num, (jboolean) false);
+		  }
+		  env->SetBooleanArrayRegion(results, 0, num, &valid[0]);
+	  }
+
+	  //Release the allocated memory.
+	  for (int i = 0; i < num; i++){
+		  DSA_SIG_free(sigs[i]);
+		  BN_free(m[i]);
+	  }
+	  BN_CTX_free(ctx);
+	  return allValid;
+}
+
+/*
+ * function deleteBatchContext	: Deletes the native state of the batch functions, clearing the unused nonces.
+ * param batch					: A pointer to the batch context.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_deleteBatchContext
+  (JNIEnv *, jobject, jlong batch){
+	  DSABatchContext* context = (DSABatchContext*) batch;
+	  for (size_t i = 0; i < context->kinvs.size(); i++){
+		  BN_clear_free(context->kinvs[i]);
+		  BN_clear_free(context->rs[i]);
+	  }
+	  deleteFixedBaseTable(context->gTable);
+	  deleteFixedBaseTable(context->yTable);
+	  if (context->mont != NULL){
+		  BN_MONT_CTX_free(context->mont);
+	  }
+	  delete context;
+}
+
 /*
  * function generateKey		: Generates public and private key to a DSA scheme.
  * param dsa				: A pointer to a DSA object.
@@ -59,10 +59,10 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSigna
 /*
  * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
  * Method:    sign
- * Signature: (J[BII)[B
+ * Signature: (JJ[BII)[B
  */
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_sign
-  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
@@ -72,6 +72,54 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digita
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_verify
   (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
 
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    createBatchContext
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_createBatchContext
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    precomputeNonces
+ * Signature: (JJI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_precomputeNonces
+  (JNIEnv *, jobject, jlong, jlong, jint);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    getNumOfNonces
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_getNumOfNonces
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    signBatch
+ * Signature: (JJ[[B)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_signBatch
+  (JNIEnv *, jobject, jlong, jlong, jobjectArray);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    verifyBatch
+ * Signature: (JJ[[B[[B[ZZ)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_verifyBatch
+  (JNIEnv *, jobject, jlong, jlong, jobjectArray, jobjectArray, jbooleanArray, jboolean);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
+ * Method:    deleteBatchContext
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_deleteBatchContext
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA
  * Method:    generateKey
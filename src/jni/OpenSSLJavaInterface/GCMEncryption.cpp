@@ -0,0 +1,182 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "GCMEncryption.h"
+#include <openssl/evp.h>
+#include <openssl/crypto.h>
+#include <string.h>
+
+/*
+ * AES-GCM authenticated encryption.
+ * The encryption and the authentication are done in a single pass over the data and a single JNI call,
+ * instead of an encryption followed by a separate mac of the ciphertext.
+ * The ciphertext is written as the encrypted data followed by a tag of GCM_TAG_SIZE bytes.
+ */
+
+#define GCM_TAG_SIZE 16
+
+/* 
+ * function createEncryption		: Creates an EVP_CIPHER_CTX object that perform the encryption.
+ * return							: a pointer to the created object.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_createEncryption
+  (JNIEnv *, jobject){
+	  return (long) EVP_CIPHER_CTX_new();
+}
+
+/* 
+ * function createDecryption		: Creates an EVP_CIPHER_CTX object that perform the decryption.
+ * return							: a pointer to the created object.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_createDecryption
+  (JNIEnv *, jobject){
+	  return (long) EVP_CIPHER_CTX_new();
+}
+
+/* 
+ * function setKey			: Initializes the encryption and decryption objects with AES-GCM and the given key.
+ *							  The AES variant is chosen by the key size.
+ * param enc				: A pointer to the native object that does the encryption.
+ * param dec				: A pointer to the native object that does the decryption.
+ * param key				: The bytes of the key to initialize the objects with.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_setKey
+  (JNIEnv *env, jobject, jlong enc, jlong dec, jbyteArray key){
+	  unsigned char keyBytes[32];
+	  int len = env->GetArrayLength(key);
+	  env->GetByteArrayRegion(key, 0, len, (jbyte*) keyBytes);
+
+	  const EVP_CIPHER* cipher;
+	  switch(len*8)  {
+			case 128: cipher = EVP_aes_128_gcm();
+							   break;
+			case 192: cipher = EVP_aes_192_gcm();
+							   break;
+			default:  cipher = EVP_aes_256_gcm();
+							   break;
+	  }
+
+	  //The key schedule is computed once here. Every message afterwards only sets a new iv.
+	  EVP_EncryptInit_ex((EVP_CIPHER_CTX *)enc, cipher, NULL, keyBytes, NULL);
+	  EVP_DecryptInit_ex((EVP_CIPHER_CTX *)dec, cipher, NULL, keyBytes, NULL);
+
+	  OPENSSL_cleanse(keyBytes, sizeof(keyBytes));
+}
+
+/* 
+ * function encrypt			: Encrypts and authenticates the given region of the plaintext array using the given iv.
+ *							  The ciphertext and the tag are written to the output array, that can be the input array itself.
+ * param enc				: A pointer to the native object that does the encryption.
+ * return					: The number of bytes written, that is len + GCM_TAG_SIZE, or -1 if the encryption failed.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_encrypt
+  (JNIEnv *env, jobject, jlong enc, jbyteArray in, jint inOffset, jint len, jbyteArray ivBytes, jbyteArray out, jint outOffset){
+	  EVP_CIPHER_CTX* ctx = (EVP_CIPHER_CTX*) enc;
+
+	  //The iv is copied before entering the critical regions, no other JNI call is allowed inside them.
+	  unsigned char iv[EVP_MAX_IV_LENGTH];
+	  env->GetByteArrayRegion(ivBytes, 0, env->GetArrayLength(ivBytes), (jbyte*) iv);
+
+	  bool inPlace = env->IsSameObject(in, out);
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, NULL);
+	  unsigned char* output = inPlace ? input : (unsigned char*) env->GetPrimitiveArrayCritical(out, NULL);
+	  unsigned char* cipher = output + outOffset;
+
+	  int size, rem;
+	  int result = -1;
+	  if (EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv) &&
+		  EVP_EncryptUpdate(ctx, cipher, &size, input + inOffset, len) &&
+		  EVP_EncryptFinal_ex(ctx, cipher + size, &rem) &&
+		  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, cipher + size + rem)){
+		  result = size + rem + GCM_TAG_SIZE;
+	  }
+
+	  if (!inPlace){
+		  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  }
+	  env->ReleasePrimitiveArrayCritical(in, input, inPlace ? 0 : JNI_ABORT);
+
+	  return result;
+}
+
+/* 
+ * function decrypt			: Verifies and decrypts the given region of the ciphertext array (the encrypted data followed by the tag) using the given iv.
+ *							  The plaintext is written to the output array, that can be the input array itself.
+ * param dec				: A pointer to the native object that does the decryption.
+ * return					: The number of bytes written, or -1 if the tag is not valid. In that case the output is zeroed.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_decrypt
+  (JNIEnv *env, jobject, jlong dec, jbyteArray in, jint inOffset, jint len, jbyteArray ivBytes, jbyteArray out, jint outOffset){
+	  EVP_CIPHER_CTX* ctx = (EVP_CIPHER_CTX*) dec;
+	  int dataSize = len - GCM_TAG_SIZE;
+	  if (dataSize < 0){
+		  return -1;
+	  }
+
+	  unsigned char iv[EVP_MAX_IV_LENGTH];
+	  env->GetByteArrayRegion(ivBytes, 0, env->GetArrayLength(ivBytes), (jbyte*) iv);
+
+	  bool inPlace = env->IsSameObject(in, out);
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, NULL);
+	  unsigned char* output = inPlace ? input : (unsigned char*) env->GetPrimitiveArrayCritical(out, NULL);
+
+	  //The tag is copied aside since an in place decryption may overwrite it.
+	  unsigned char tag[GCM_TAG_SIZE];
+	  memcpy(tag, input + inOffset + dataSize, GCM_TAG_SIZE);
+
+	  int size, rem;
+	  int result = -1;
+	  if (EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv) &&
+		  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, tag) &&
+		  EVP_DecryptUpdate(ctx, output + outOffset, &size, input + inOffset, dataSize)){
+		  //The final call checks the tag.
+		  if (EVP_DecryptFinal_ex(ctx, output + outOffset + size, &rem) > 0){
+			  result = size + rem;
+		  } else {
+			  //Do not leave unauthenticated plaintext in the output.
+			  OPENSSL_cleanse(output + outOffset, dataSize);
+		  }
+	  }
+
+	  if (!inPlace){
+		  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  }
+	  env->ReleasePrimitiveArrayCritical(in, input, inPlace ? 0 : JNI_ABORT);
+
+	  return result;
+}
+
+/* 
+ * function deleteNative		: Deletes the native objects and frees the allocated memory.
+ * param enc					: A pointer to the native object that does the encryption.
+ * param dec					: A pointer to the native object that does the decryption.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEnc_deleteNative
+  (JNIEnv *, jobject, jlong enc, jlong dec){
+	  EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*)enc);
+	  EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*)dec);
+}
@@ -28,6 +28,8 @@
 #include "Hash.h"
 #include <openssl/evp.h>
 #include <iostream>
+#include <vector>
+#include "MultiBufferHash.h"
 
 using namespace std;
 
@@ -120,6 +122,70 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_fi
 	  delete ret;
 }
 
+/*
+ * Messages up to this length are hashed by the multi-buffer implementation, longer messages by OpenSSL.
+ */
+#define MAX_MULTI_BUFFER_LENGTH 192
+
+/* 
+ * function batchHash	: Hashes many independent messages in one call. The state of the given hash is not changed.
+ *						  Short SHA-1 and SHA-256 messages are hashed together by the multi-buffer implementation,
+ *						  other messages are hashed one after the other by OpenSSL, without returning to java in between.
+ * param hash			: Pointer to the native hash.
+ * param in				: The array that contains all the messages.
+ * param offsets		: The offset of each message in the input array.
+ * param lengths		: The length of each message.
+ * param numMessages	: The number of messages.
+ * param out			: The array to put the digests in, one after the other.
+ * param outOffset		: The offset in the output array of the first digest.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_batchHash
+  (JNIEnv *env, jobject, jlong hash, jbyteArray in, jintArray offsets, jintArray lengths, jint numMessages, jbyteArray out, jint outOffset){
+	  
+	  const EVP_MD* md = EVP_MD_CTX_md((EVP_MD_CTX *) hash);
+	  int size = EVP_MD_size(md);
+	  int type = EVP_MD_type(md);
+	  bool multiBuffer = (type == NID_sha1 || type == NID_sha256);
+
+	  jint* offs = env->GetIntArrayElements(offsets, 0);
+	  jint* lens = env->GetIntArrayElements(lengths, 0);
+
+	  //No JNI call is made until the arrays are released, so the arrays are accessed directly instead of being copied.
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0) + outOffset;
+
+	  vector<const unsigned char*> shortMessages;
+	  vector<int> shortLengths;
+	  vector<unsigned char*> shortDigests;
+	  EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+
+	  for (int i = 0; i < numMessages; i++) {
+		  if (multiBuffer && lens[i] <= MAX_MULTI_BUFFER_LENGTH) {
+			  shortMessages.push_back(input + offs[i]);
+			  shortLengths.push_back(lens[i]);
+			  shortDigests.push_back(output + i*size);
+		  } else {
+			  EVP_DigestInit_ex(ctx, md, NULL);
+			  EVP_DigestUpdate(ctx, input + offs[i], lens[i]);
+			  EVP_DigestFinal_ex(ctx, output + i*size, NULL);
+		  }
+	  }
+	  EVP_MD_CTX_destroy(ctx);
+
+	  if (!shortMessages.empty()) {
+		  if (type == NID_sha1) {
+			  multiBufferSha1(&shortMessages[0], &shortLengths[0], &shortDigests[0], (int) shortMessages.size());
+		  } else {
+			  multiBufferSha256(&shortMessages[0], &shortLengths[0], &shortDigests[0], (int) shortMessages.size());
+		  }
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, output - outOffset, 0);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+	  env->ReleaseIntArrayElements(lengths, lens, JNI_ABORT);
+	  env->ReleaseIntArrayElements(offsets, offs, JNI_ABORT);
+}
+
 /* 
  * function getDigestSize	: Returns the length of the hashed message.
  */
@@ -64,6 +64,14 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_up
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_finalHash
   (JNIEnv *, jobject, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
+ * Method:    batchHash
+ * Signature: (J[B[I[II[BI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_batchHash
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray, jintArray, jint, jbyteArray, jint);
+
 /*
  * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
  * Method:    getDigestSize
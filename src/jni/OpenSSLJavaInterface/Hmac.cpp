@@ -27,6 +27,7 @@
 #include <jni.h>
 #include "Hmac.h"
 #include <openssl/hmac.h>
+#include <openssl/crypto.h>
 #include <iostream>
 
 using namespace std;
@@ -68,10 +69,12 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_set
 	  jbyte* keyBytes  = (jbyte*) env->GetByteArrayElements(key, 0);
 	  
 	  //Initialize the Hmac object with the given key.
+	  //This hashes the inner and outer padded keys once. The resulting midstates are kept in the context, and every 
+	  //following mac starts from them instead of hashing the key again.
 	  HMAC_Init_ex((HMAC_CTX *)hmac, keyBytes, env->GetArrayLength(key),  NULL, NULL);
 	
 	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(key, keyBytes, 0);
+	  env->ReleaseByteArrayElements(key, keyBytes, JNI_ABORT);
 }
 
 /* 
@@ -112,8 +115,8 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 	  //Update the Hmac object.
 	  HMAC_Update((HMAC_CTX*)hmac, (const unsigned char*)(input+inOffset), len);
 
-	  //Release the allocated memory.
-	  env->ReleaseByteArrayElements(in, input, 0);
+	  //Release the allocated memory. The input was not changed, so there is no need to copy it back.
+	  env->ReleaseByteArrayElements(in, input, JNI_ABORT);
 }
 
 /* 
@@ -126,25 +129,108 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
   (JNIEnv *env, jobject, jlong hmac, jbyteArray out, jint outOffset){
 	  
 	  int size = EVP_MD_size(((HMAC_CTX *)hmac)->md); //Get the size of the hash output.
-	  unsigned char* output = new unsigned char[size];//Create a char array to hold the result.
+	  unsigned char output[EVP_MAX_MD_SIZE];		  //A char array to hold the result.
 	  
 	  //Compute the final function and copy the output the the given output array
-	  if (0 == (HMAC_Final((HMAC_CTX *)hmac, output, NULL))){
-		  delete output;
-	  }
-
+	  HMAC_Final((HMAC_CTX *)hmac, output, NULL);
 	  env->SetByteArrayRegion(out, outOffset, size, (jbyte*)output); 
 
-	  //initialize the Hmac again in order to enable repeated calls.
-	  const EVP_MD *md = ((HMAC_CTX *)hmac)->md;
-	  unsigned char* key = ((HMAC_CTX *)hmac)->key;
-	  int keyLen =  ((HMAC_CTX *)hmac)->key_length;
-	  if (0 == (HMAC_Init_ex((HMAC_CTX *)hmac, key, keyLen,  md, NULL))){
-		  delete(output);
+	  //Initialize the Hmac again in order to enable repeated calls.
+	  //Passing no key restarts from the inner midstate computed in setKey, so the key is not hashed again.
+	  HMAC_Init_ex((HMAC_CTX *)hmac, NULL, 0, NULL, NULL);
+}
+
+/*
+ * Computes the macs of the given messages one after the other, using a copy of the given Hmac object so that a message
+ * that is being updated in it is not affected. Each mac starts from the midstates of the key.
+ * The mac of message i is written to tags + i * mac size.
+ */
+static void macMessages(HMAC_CTX* hmac, const unsigned char* input, const jint* offsets, const jint* lengths, int numMessages, unsigned char* tags) {
+	HMAC_CTX ctx;
+	HMAC_CTX_init(&ctx);
+	HMAC_CTX_copy(&ctx, hmac);
+	int size = EVP_MD_size(hmac->md);
+
+	for (int i = 0; i < numMessages; i++) {
+		HMAC_Init_ex(&ctx, NULL, 0, NULL, NULL);
+		HMAC_Update(&ctx, input + offsets[i], lengths[i]);
+		HMAC_Final(&ctx, tags + i*size, NULL);
+	}
+
+	HMAC_CTX_cleanup(&ctx);
+}
+
+/* 
+ * function macMany			: Computes the macs of many messages under the key of the given Hmac.
+ * param hmac				: Pointer to the native Hmac object.
+ * param in					: The array that contains all the messages.
+ * param offsets			: The offset of each message in the input array.
+ * param lengths			: The length of each message.
+ * param numMessages		: The number of messages.
+ * param out				: The array to put the tags in, one after the other.
+ * param outOffset			: The offset in the output array of the first tag.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_macMany
+  (JNIEnv *env, jobject, jlong hmac, jbyteArray in, jintArray offsets, jintArray lengths, jint numMessages, jbyteArray out, jint outOffset){
+
+	  jint* offs = env->GetIntArrayElements(offsets, 0);
+	  jint* lens = env->GetIntArrayElements(lengths, 0);
+
+	  //No JNI call is made until the arrays are released, so the arrays are accessed directly instead of being copied.
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  macMessages((HMAC_CTX*) hmac, input, offs, lens, numMessages, output + outOffset);
+
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+	  env->ReleaseIntArrayElements(lengths, lens, JNI_ABORT);
+	  env->ReleaseIntArrayElements(offsets, offs, JNI_ABORT);
+}
+
+/* 
+ * function verifyMany		: Verifies the tags of many messages under the key of the given Hmac.
+ *							  The tags are compared in constant time, and all the tags are checked even if some of them are wrong.
+ * param hmac				: Pointer to the native Hmac object.
+ * param in					: The array that contains all the messages.
+ * param offsets			: The offset of each message in the input array.
+ * param lengths			: The length of each message.
+ * param numMessages		: The number of messages.
+ * param tags				: The array that contains the tags to verify, one after the other.
+ * param tagsOffset			: The offset in the tags array of the first tag.
+ * param results			: Filled with the result of each verification.
+ * return					: True if all the tags are valid.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_verifyMany
+  (JNIEnv *env, jobject, jlong hmac, jbyteArray in, jintArray offsets, jintArray lengths, jint numMessages, jbyteArray tags, jint tagsOffset, jbooleanArray results){
+
+	  int size = EVP_MD_size(((HMAC_CTX *)hmac)->md);
+	  unsigned char* computed = new unsigned char[numMessages*size];
+	  
+	  jint* offs = env->GetIntArrayElements(offsets, 0);
+	  jint* lens = env->GetIntArrayElements(lengths, 0);
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  macMessages((HMAC_CTX*) hmac, input, offs, lens, numMessages, computed);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+	  env->ReleaseIntArrayElements(lengths, lens, JNI_ABORT);
+	  env->ReleaseIntArrayElements(offsets, offs, JNI_ABORT);
+
+	  jboolean* res = env->GetBooleanArrayElements(results, 0);
+	  unsigned char* expected = (unsigned char*) env->GetPrimitiveArrayCritical(tags, 0) + tagsOffset;
+	  int allEqual = 1;
+	  for (int i = 0; i < numMessages; i++) {
+		  //CRYPTO_memcmp takes the same time wherever the tags differ.
+		  int equal = (CRYPTO_memcmp(computed + i*size, expected + i*size, size) == 0);
+		  res[i] = (jboolean) equal;
+		  allEqual &= equal;
 	  }
+	  env->ReleasePrimitiveArrayCritical(tags, expected - tagsOffset, JNI_ABORT);
+	  env->ReleaseBooleanArrayElements(results, res, 0);
 
-	  //Release the allocated memory.
-	  delete output;
+	  OPENSSL_cleanse(computed, numMessages*size);
+	  delete [] computed;
+
+	  return (jboolean) allEqual;
 }
 
 /* 
@@ -153,4 +239,5 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_deleteNative
   (JNIEnv *, jobject, jlong hmac){
 	  HMAC_CTX_cleanup((HMAC_CTX*)hmac);
+	  delete (HMAC_CTX*)hmac;
 }
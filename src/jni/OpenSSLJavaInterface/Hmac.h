@@ -74,6 +74,22 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal
   (JNIEnv *, jobject, jlong, jbyteArray, jint);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+ * Method:    macMany
+ * Signature: (J[B[I[II[BI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_macMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray, jintArray, jint, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+ * Method:    verifyMany
+ * Signature: (J[B[I[II[BI[Z)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_verifyMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray, jintArray, jint, jbyteArray, jint, jbooleanArray);
+
 /*
  * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
  * Method:    deleteNative
@@ -0,0 +1,69 @@
+#include "StdAfx.h"
+#include "MultiBufferHash.h"
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+//The 4 lanes of SSE2, that every x64 cpu has.
+#define MB_NAMESPACE mbSse2
+#include "MultiBufferHashLanes.h"
+
+//The 8 lanes of AVX2, compiled separately with -mavx2 in MultiBufferHashAvx2.cpp.
+namespace mbAvx2 {
+	void sha1(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages);
+	void sha256(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages);
+}
+
+/*
+ * Returns true if the cpu has AVX2 and the operating system saves the ymm registers.
+ */
+static bool hasAvx2(){
+#ifdef _WIN32
+	int info[4];
+	__cpuid(info, 1);
+	//OSXSAVE and AVX.
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0){
+		return false;
+	}
+	if ((_xgetbv(0) & 6) != 6){
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & (1 << 27)) == 0 || (ecx & (1 << 28)) == 0){
+		return false;
+	}
+	//xgetbv is encoded directly, so this file does not need -mxsave.
+	unsigned int xcr0, xcr0High;
+	__asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0), "=d" (xcr0High) : "c" (0));
+	if ((xcr0 & 6) != 6){
+		return false;
+	}
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)){
+		return false;
+	}
+	return (ebx & (1 << 5)) != 0;
+#endif
+}
+
+static const bool useAvx2 = hasAvx2();
+
+void multiBufferSha1(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages) {
+	if (useAvx2) {
+		mbAvx2::sha1(messages, lengths, digests, numMessages);
+	} else {
+		mbSse2::sha1(messages, lengths, digests, numMessages);
+	}
+}
+
+void multiBufferSha256(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages) {
+	if (useAvx2) {
+		mbAvx2::sha256(messages, lengths, digests, numMessages);
+	} else {
+		mbSse2::sha256(messages, lengths, digests, numMessages);
+	}
+}
@@ -0,0 +1,21 @@
+#ifndef _MULTI_BUFFER_HASH_H_
+#define _MULTI_BUFFER_HASH_H_
+
+/*
+ * Multi-buffer SHA-1 and SHA-256.
+ *
+ * Hashing many short independent messages one by one is bound by the latency of the dependency chain inside each
+ * compression function. Here the compression functions of several messages run together, one message in each 32 bit lane
+ * of a vector register: 8 lanes with AVX2, or 4 lanes with SSE2 on cpus without AVX2. The AVX2 lanes are compiled separately
+ * with -mavx2 and chosen at runtime by CPUID, so the library runs on both.
+ * Each lane moves to the next message as soon as its current message is done, so the messages can be of any length.
+ *
+ * messages[i] points to the i'th message of lengths[i] bytes, and its digest is written to digests[i].
+ *
+ * The lanes gain over a single buffer implementation mostly for short messages, where the per message overhead and 
+ * the latency of the compression function dominate. For long messages the SHA extensions used by OpenSSL are faster.
+ */
+void multiBufferSha1(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages);
+void multiBufferSha256(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages);
+
+#endif //_MULTI_BUFFER_HASH_H_
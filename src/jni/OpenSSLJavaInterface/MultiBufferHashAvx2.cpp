@@ -0,0 +1,10 @@
+#include "StdAfx.h"
+
+//This file is compiled with -mavx2 and its functions are called only if the cpu has AVX2 (see MultiBufferHash.cpp).
+#ifndef __AVX2__
+#error "MultiBufferHashAvx2.cpp should be compiled with -mavx2"
+#endif
+
+#define MB_AVX2
+#define MB_NAMESPACE mbAvx2
+#include "MultiBufferHashLanes.h"
@@ -0,0 +1,296 @@
+#ifndef _MULTI_BUFFER_HASH_LANES_H_
+#define _MULTI_BUFFER_HASH_LANES_H_
+
+/*
+ * The lanes of the multi-buffer SHA-1 and SHA-256, included by the file of each instruction set.
+ * The including file defines MB_NAMESPACE, the namespace of its sha1 and sha256 functions, and MB_AVX2 for the 8 lanes of AVX2
+ * (the file should then be compiled with -mavx2). Otherwise the 4 lanes of SSE2 are used.
+ */
+
+#include <string.h>
+
+#ifdef MB_AVX2
+#include <immintrin.h>
+
+#define MB_LANES 8
+typedef __m256i mbvec;
+#define MB_ADD(a, b)	_mm256_add_epi32(a, b)
+#define MB_XOR(a, b)	_mm256_xor_si256(a, b)
+#define MB_AND(a, b)	_mm256_and_si256(a, b)
+#define MB_OR(a, b)		_mm256_or_si256(a, b)
+#define MB_ANDNOT(a, b)	_mm256_andnot_si256(a, b)
+#define MB_SHL(a, n)	_mm256_slli_epi32(a, n)
+#define MB_SHR(a, n)	_mm256_srli_epi32(a, n)
+#define MB_SET1(x)		_mm256_set1_epi32((int) (x))
+#define MB_LOAD(p)		_mm256_load_si256((const mbvec*) (p))
+#define MB_STORE(p, a)	_mm256_store_si256((mbvec*) (p), a)
+#define MB_ALIGN		32
+
+#else
+#include <emmintrin.h>
+
+#define MB_LANES 4
+typedef __m128i mbvec;
+#define MB_ADD(a, b)	_mm_add_epi32(a, b)
+#define MB_XOR(a, b)	_mm_xor_si128(a, b)
+#define MB_AND(a, b)	_mm_and_si128(a, b)
+#define MB_OR(a, b)		_mm_or_si128(a, b)
+#define MB_ANDNOT(a, b)	_mm_andnot_si128(a, b)
+#define MB_SHL(a, n)	_mm_slli_epi32(a, n)
+#define MB_SHR(a, n)	_mm_srli_epi32(a, n)
+#define MB_SET1(x)		_mm_set1_epi32((int) (x))
+#define MB_LOAD(p)		_mm_load_si128((const mbvec*) (p))
+#define MB_STORE(p, a)	_mm_store_si128((mbvec*) (p), a)
+#define MB_ALIGN		16
+#endif
+
+#ifdef _WIN32
+#define MB_ALIGNED(x) __declspec(align(MB_ALIGN)) x
+#else
+#define MB_ALIGNED(x) x __attribute__((aligned(MB_ALIGN)))
+#endif
+
+#define MB_ROTL(a, n)	MB_OR(MB_SHL(a, n), MB_SHR(a, 32 - (n)))
+#define MB_ROTR(a, n)	MB_OR(MB_SHR(a, n), MB_SHL(a, 32 - (n)))
+
+#define MB_BLOCK_SIZE 64
+
+static inline unsigned int loadBigEndian(const unsigned char* p) {
+	return ((unsigned int) p[0] << 24) | ((unsigned int) p[1] << 16) | ((unsigned int) p[2] << 8) | (unsigned int) p[3];
+}
+
+static inline void storeBigEndian(unsigned char* p, unsigned int x) {
+	p[0] = (unsigned char) (x >> 24);
+	p[1] = (unsigned char) (x >> 16);
+	p[2] = (unsigned char) (x >> 8);
+	p[3] = (unsigned char) x;
+}
+
+/*
+ * The compression functions. state holds the chaining words and w the 16 words of the block, one lane per message.
+ */
+static void sha1Compress(mbvec* state, mbvec* w) {
+	mbvec a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+	mbvec W[16];
+	for (int t = 0; t < 16; t++) {
+		W[t] = w[t];
+	}
+
+	for (int t = 0; t < 80; t++) {
+		if (t >= 16) {
+			mbvec x = MB_XOR(MB_XOR(W[(t - 3) & 15], W[(t - 8) & 15]), MB_XOR(W[(t - 14) & 15], W[t & 15]));
+			W[t & 15] = MB_ROTL(x, 1);
+		}
+
+		mbvec f, k;
+		if (t < 20) {
+			f = MB_XOR(MB_AND(b, c), MB_ANDNOT(b, d));
+			k = MB_SET1(0x5a827999);
+		} else if (t < 40) {
+			f = MB_XOR(MB_XOR(b, c), d);
+			k = MB_SET1(0x6ed9eba1);
+		} else if (t < 60) {
+			f = MB_OR(MB_AND(b, c), MB_AND(d, MB_OR(b, c)));
+			k = MB_SET1(0x8f1bbcdc);
+		} else {
+			f = MB_XOR(MB_XOR(b, c), d);
+			k = MB_SET1(0xca62c1d6);
+		}
+
+		mbvec temp = MB_ADD(MB_ADD(MB_ROTL(a, 5), f), MB_ADD(MB_ADD(e, k), W[t & 15]));
+		e = d;
+		d = c;
+		c = MB_ROTL(b, 30);
+		b = a;
+		a = temp;
+	}
+
+	state[0] = MB_ADD(state[0], a);
+	state[1] = MB_ADD(state[1], b);
+	state[2] = MB_ADD(state[2], c);
+	state[3] = MB_ADD(state[3], d);
+	state[4] = MB_ADD(state[4], e);
+}
+
+static const unsigned int SHA256_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void sha256Compress(mbvec* state, mbvec* w) {
+	mbvec a = state[0], b = state[1], c = state[2], d = state[3];
+	mbvec e = state[4], f = state[5], g = state[6], h = state[7];
+	mbvec W[16];
+	for (int t = 0; t < 16; t++) {
+		W[t] = w[t];
+	}
+
+	for (int t = 0; t < 64; t++) {
+		if (t >= 16) {
+			mbvec w15 = W[(t - 15) & 15];
+			mbvec w2 = W[(t - 2) & 15];
+			mbvec s0 = MB_XOR(MB_XOR(MB_ROTR(w15, 7), MB_ROTR(w15, 18)), MB_SHR(w15, 3));
+			mbvec s1 = MB_XOR(MB_XOR(MB_ROTR(w2, 17), MB_ROTR(w2, 19)), MB_SHR(w2, 10));
+			W[t & 15] = MB_ADD(MB_ADD(W[t & 15], s0), MB_ADD(W[(t - 7) & 15], s1));
+		}
+
+		mbvec S1 = MB_XOR(MB_XOR(MB_ROTR(e, 6), MB_ROTR(e, 11)), MB_ROTR(e, 25));
+		mbvec ch = MB_XOR(MB_AND(e, f), MB_ANDNOT(e, g));
+		mbvec temp1 = MB_ADD(MB_ADD(h, S1), MB_ADD(ch, MB_ADD(MB_SET1(SHA256_K[t]), W[t & 15])));
+		mbvec S0 = MB_XOR(MB_XOR(MB_ROTR(a, 2), MB_ROTR(a, 13)), MB_ROTR(a, 22));
+		mbvec maj = MB_OR(MB_AND(a, b), MB_AND(c, MB_OR(a, b)));
+		mbvec temp2 = MB_ADD(S0, maj);
+
+		h = g;
+		g = f;
+		f = e;
+		e = MB_ADD(d, temp1);
+		d = c;
+		c = b;
+		b = a;
+		a = MB_ADD(temp1, temp2);
+	}
+
+	state[0] = MB_ADD(state[0], a);
+	state[1] = MB_ADD(state[1], b);
+	state[2] = MB_ADD(state[2], c);
+	state[3] = MB_ADD(state[3], d);
+	state[4] = MB_ADD(state[4], e);
+	state[5] = MB_ADD(state[5], f);
+	state[6] = MB_ADD(state[6], g);
+	state[7] = MB_ADD(state[7], h);
+}
+
+/*
+ * The message that a lane is hashing.
+ * The full blocks are read from the message itself, and the last one or two blocks (the rest of the message and the 
+ * padding) from the tail buffer.
+ */
+typedef struct MBLane {
+	const unsigned char* message;
+	int index;			//The index of the message, or -1 if the lane is idle.
+	long fullBlocks;	//The number of full blocks in the message.
+	long numBlocks;		//The number of blocks including the padding.
+	long nextBlock;
+	unsigned char tail[2 * MB_BLOCK_SIZE];
+} MBLane;
+
+static void startMessage(MBLane* lane, const unsigned char* message, int length, int index) {
+	lane->message = message;
+	lane->index = index;
+	lane->fullBlocks = length / MB_BLOCK_SIZE;
+	lane->numBlocks = (length + 8) / MB_BLOCK_SIZE + 1;
+	lane->nextBlock = 0;
+
+	//Build the padding: the rest of the message, the 0x80 byte, zeros and the length in bits as a big endian 64 bit number.
+	int rest = length % MB_BLOCK_SIZE;
+	int tailSize = (int) (lane->numBlocks - lane->fullBlocks) * MB_BLOCK_SIZE;
+	memset(lane->tail, 0, tailSize);
+	memcpy(lane->tail, message + lane->fullBlocks * MB_BLOCK_SIZE, rest);
+	lane->tail[rest] = 0x80;
+	unsigned long long bits = (unsigned long long) length * 8;
+	for (int i = 1; i <= 8; i++) {
+		lane->tail[tailSize - i] = (unsigned char) bits;
+		bits >>= 8;
+	}
+}
+
+/*
+ * Hashes all the messages, keeping every lane busy with the next message that is not hashed yet.
+ */
+static void multiBufferHash(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages,
+		int stateWords, const unsigned int* iv, void (*compress)(mbvec*, mbvec*)) {
+
+	MBLane lanes[MB_LANES];
+	MB_ALIGNED(unsigned int state[8][MB_LANES]);
+	MB_ALIGNED(unsigned int words[16][MB_LANES]);
+	mbvec stateVec[8];
+	mbvec wordsVec[16];
+
+	int nextMessage = 0;
+	int activeLanes = 0;
+	for (int j = 0; j < MB_LANES; j++) {
+		if (nextMessage < numMessages) {
+			startMessage(&lanes[j], messages[nextMessage], lengths[nextMessage], nextMessage);
+			nextMessage++;
+			activeLanes++;
+		} else {
+			lanes[j].index = -1;
+		}
+		for (int i = 0; i < stateWords; i++) {
+			state[i][j] = iv[i];
+		}
+	}
+	memset(words, 0, sizeof(words));
+
+	while (activeLanes > 0) {
+		//Transpose the next block of each lane into the words.
+		for (int j = 0; j < MB_LANES; j++) {
+			MBLane* lane = &lanes[j];
+			if (lane->index < 0) {
+				continue;
+			}
+			const unsigned char* block = (lane->nextBlock < lane->fullBlocks) ? 
+				lane->message + lane->nextBlock * MB_BLOCK_SIZE : lane->tail + (lane->nextBlock - lane->fullBlocks) * MB_BLOCK_SIZE;
+			for (int t = 0; t < 16; t++) {
+				words[t][j] = loadBigEndian(block + 4 * t);
+			}
+		}
+
+		for (int i = 0; i < stateWords; i++) {
+			stateVec[i] = MB_LOAD(state[i]);
+		}
+		for (int t = 0; t < 16; t++) {
+			wordsVec[t] = MB_LOAD(words[t]);
+		}
+		compress(stateVec, wordsVec);
+		for (int i = 0; i < stateWords; i++) {
+			MB_STORE(state[i], stateVec[i]);
+		}
+
+		//Output the digests of the messages that are done, and start the next messages in their lanes.
+		for (int j = 0; j < MB_LANES; j++) {
+			MBLane* lane = &lanes[j];
+			if (lane->index < 0 || ++lane->nextBlock < lane->numBlocks) {
+				continue;
+			}
+			unsigned char* digest = digests[lane->index];
+			for (int i = 0; i < stateWords; i++) {
+				storeBigEndian(digest + 4 * i, state[i][j]);
+				state[i][j] = iv[i];
+			}
+			if (nextMessage < numMessages) {
+				startMessage(lane, messages[nextMessage], lengths[nextMessage], nextMessage);
+				nextMessage++;
+			} else {
+				lane->index = -1;
+				activeLanes--;
+			}
+		}
+	}
+}
+
+static const unsigned int SHA1_IV[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+static const unsigned int SHA256_IV[8] = { 
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 
+};
+
+namespace MB_NAMESPACE {
+
+void sha1(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages) {
+	multiBufferHash(messages, lengths, digests, numMessages, 5, SHA1_IV, sha1Compress);
+}
+
+void sha256(const unsigned char** messages, const int* lengths, unsigned char** digests, int numMessages) {
+	multiBufferHash(messages, lengths, digests, numMessages, 8, SHA256_IV, sha256Compress);
+}
+
+}
+
+#endif //_MULTI_BUFFER_HASH_LANES_H_
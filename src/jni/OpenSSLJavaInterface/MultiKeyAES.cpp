@@ -0,0 +1,257 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "MultiKeyAES.h"
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#include <xmmintrin.h>
+#include <string.h>
+
+/*
+ * Batch AES encryption with AES-NI under many expanded keys at once.
+ *
+ * The EVP objects of OpenSSLAES hold a single key and process one array per call. Here all the keys are expanded once,
+ * and a single call encrypts any number of blocks, each one under its own key. The blocks are processed in groups of
+ * AES_PARALLEL_BLOCKS, so that the aesenc instructions of the group are pipelined instead of waiting for each other.
+ */
+
+#define AES_PARALLEL_BLOCKS 8
+#define AES_MAX_ROUNDS 14
+
+typedef struct MultiKeyAES {
+	int numKeys;
+	int rounds;
+	__m128i* roundKeys;	//(rounds + 1) round keys for each key, one key after the other.
+} MultiKeyAES;
+
+/*
+ * Applies the AES s-box to each byte of the given word, using the s-box of the aeskeygenassist instruction.
+ */
+static inline unsigned int subWord(unsigned int word) {
+	__m128i tmp = _mm_aeskeygenassist_si128(_mm_set_epi32(0, 0, (int) word, 0), 0);
+	return (unsigned int) _mm_cvtsi128_si32(tmp);
+}
+
+/*
+ * The key expansion of FIPS-197 for 128, 192 and 256 bit keys.
+ * The round keys are written in the byte order used by the AES-NI instructions.
+ */
+static void expandKey(const unsigned char* key, int keySize, __m128i* roundKeys, int rounds) {
+	static const unsigned char rcon[] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36 };
+	unsigned int w[4 * (AES_MAX_ROUNDS + 1)];
+	int nk = keySize / 4;
+	int totalWords = 4 * (rounds + 1);
+
+	memcpy(w, key, keySize);
+	for (int i = nk; i < totalWords; i++) {
+		unsigned int temp = w[i - 1];
+		if (i % nk == 0) {
+			//RotWord on the little endian word, then SubWord and Rcon on its first byte.
+			temp = subWord((temp >> 8) | (temp << 24)) ^ rcon[i / nk - 1];
+		} else if (nk > 6 && i % nk == 4) {
+			temp = subWord(temp);
+		}
+		w[i] = w[i - nk] ^ temp;
+	}
+
+	for (int r = 0; r <= rounds; r++) {
+		roundKeys[r] = _mm_loadu_si128((__m128i*) (w + 4 * r));
+	}
+}
+
+/*
+ * Encrypts numBlocks <= AES_PARALLEL_BLOCKS blocks in place, block j under the round keys keys[j].
+ * All the rounds of the blocks are interleaved so the latency of each aesenc is hidden by the others.
+ */
+static inline void encryptParallel(__m128i* blocks, const __m128i** keys, int numBlocks, int rounds) {
+	for (int j = 0; j < numBlocks; j++) {
+		blocks[j] = _mm_xor_si128(blocks[j], keys[j][0]);
+	}
+	for (int r = 1; r < rounds; r++) {
+		for (int j = 0; j < numBlocks; j++) {
+			blocks[j] = _mm_aesenc_si128(blocks[j], keys[j][r]);
+		}
+	}
+	for (int j = 0; j < numBlocks; j++) {
+		blocks[j] = _mm_aesenclast_si128(blocks[j], keys[j][rounds]);
+	}
+}
+
+/*
+ * Writes the 128 bit big endian counter block iv + counter.
+ */
+static inline void counterBlock(const unsigned char* iv, unsigned long long counter, unsigned char* out) {
+	unsigned int carry = 0;
+	for (int i = 15; i >= 0; i--) {
+		unsigned int sum = iv[i] + (unsigned int) (counter & 0xff) + carry;
+		out[i] = (unsigned char) sum;
+		carry = sum >> 8;
+		counter >>= 8;
+	}
+}
+
+/* 
+ * function createKeys		: Expands all the given keys.
+ * param keys				: The keys, one after the other.
+ * param numKeys			: The number of keys.
+ * param keySize			: The size of each key in bytes (16, 24 or 32).
+ * return					: A pointer to the expanded keys.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLMultiKeyAES_createKeys
+  (JNIEnv *env, jobject, jbyteArray keys, jint numKeys, jint keySize){
+	  
+	  MultiKeyAES* aes = new MultiKeyAES;
+	  aes->numKeys = numKeys;
+	  aes->rounds = keySize / 4 + 6;
+	  aes->roundKeys = (__m128i*) _mm_malloc(sizeof(__m128i) * numKeys * (aes->rounds + 1), 16);
+
+	  jbyte* keyBytes = env->GetByteArrayElements(keys, 0);
+	  for (int k = 0; k < numKeys; k++) {
+		  expandKey((unsigned char*) keyBytes + k*keySize, keySize, aes->roundKeys + k*(aes->rounds + 1), aes->rounds);
+	  }
+	  
+	  //The keys are secret, make sure they are not left in the copied array.
+	  memset(keyBytes, 0, numKeys*keySize);
+	  env->ReleaseByteArrayElements(keys, keyBytes, JNI_ABORT);
+
+	  return (jlong) aes;
+}
+
+/* 
+ * function computeBlocks	: Encrypts numBlocks blocks in ECB mode. Block i is encrypted under key keyIndices[i],
+ *							  or under key i % numKeys if keyIndices is null.
+ * param aesPtr				: Pointer to the expanded keys.
+ * param in, inOffset		: The input blocks.
+ * param out, outOffset		: The array to put the encrypted blocks in.
+ * param numBlocks			: The number of blocks to encrypt.
+ * param keyIndices			: The index of the key of each block. May be null.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLMultiKeyAES_computeBlocks
+  (JNIEnv *env, jobject, jlong aesPtr, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint numBlocks, jintArray keyIndices){
+	  
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+	  int keyStride = aes->rounds + 1;
+
+	  //No JNI call is made until the arrays are released, so the arrays are accessed directly instead of being copied.
+	  jint* indices = (keyIndices == NULL) ? NULL : (jint*) env->GetPrimitiveArrayCritical(keyIndices, 0);
+	  unsigned char* inBytes = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* outBytes = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+	  
+	  __m128i blocks[AES_PARALLEL_BLOCKS];
+	  const __m128i* keys[AES_PARALLEL_BLOCKS];
+
+	  for (int i = 0; i < numBlocks; i += AES_PARALLEL_BLOCKS) {
+		  int count = (numBlocks - i < AES_PARALLEL_BLOCKS) ? numBlocks - i : AES_PARALLEL_BLOCKS;
+
+		  for (int j = 0; j < count; j++) {
+			  int keyIndex = (indices == NULL) ? (i + j) % aes->numKeys : indices[i + j];
+			  keys[j] = aes->roundKeys + keyIndex*keyStride;
+			  blocks[j] = _mm_loadu_si128((__m128i*) (inBytes + inOffset + (i + j)*16));
+		  }
+
+		  encryptParallel(blocks, keys, count, aes->rounds);
+
+		  for (int j = 0; j < count; j++) {
+			  _mm_storeu_si128((__m128i*) (outBytes + outOffset + (i + j)*16), blocks[j]);
+		  }
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, outBytes, 0);
+	  env->ReleasePrimitiveArrayCritical(in, inBytes, JNI_ABORT);
+	  if (indices != NULL) {
+		  env->ReleasePrimitiveArrayCritical(keyIndices, indices, JNI_ABORT);
+	  }
+}
+
+/* 
+ * function ctr				: Computes numBlocks blocks of the CTR mode keystream of the given key, starting from the counter 
+ *							  iv + counterOffset (as a 128 bit big endian number), and xors it with the input if given.
+ *							  Since the counter is given explicitly, any part of the keystream can be computed directly.
+ * param aesPtr				: Pointer to the expanded keys.
+ * param keyIndex			: The index of the key to use.
+ * param iv					: The initial counter block.
+ * param counterOffset		: The index of the first block of the keystream to compute.
+ * param in, inOffset		: The input to xor with the keystream. If in is null, the keystream itself is written to out.
+ * param out, outOffset		: The array to put the result in.
+ * param numBlocks			: The number of blocks to compute.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLMultiKeyAES_ctr
+  (JNIEnv *env, jobject, jlong aesPtr, jint keyIndex, jbyteArray iv, jlong counterOffset, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint numBlocks){
+
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+	  
+	  unsigned char ivBytes[16];
+	  env->GetByteArrayRegion(iv, 0, 16, (jbyte*) ivBytes);
+
+	  unsigned char* inBytes = (in == NULL) ? NULL : (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* outBytes = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  __m128i blocks[AES_PARALLEL_BLOCKS];
+	  const __m128i* keys[AES_PARALLEL_BLOCKS];
+	  unsigned char counter[16];
+	  for (int j = 0; j < AES_PARALLEL_BLOCKS; j++) {
+		  keys[j] = aes->roundKeys + keyIndex*(aes->rounds + 1);
+	  }
+
+	  for (int i = 0; i < numBlocks; i += AES_PARALLEL_BLOCKS) {
+		  int count = (numBlocks - i < AES_PARALLEL_BLOCKS) ? numBlocks - i : AES_PARALLEL_BLOCKS;
+
+		  for (int j = 0; j < count; j++) {
+			  counterBlock(ivBytes, (unsigned long long) counterOffset + i + j, counter);
+			  blocks[j] = _mm_loadu_si128((__m128i*) counter);
+		  }
+
+		  encryptParallel(blocks, keys, count, aes->rounds);
+
+		  for (int j = 0; j < count; j++) {
+			  __m128i* dest = (__m128i*) (outBytes + outOffset + (i + j)*16);
+			  if (inBytes != NULL) {
+				  blocks[j] = _mm_xor_si128(blocks[j], _mm_loadu_si128((__m128i*) (inBytes + inOffset + (i + j)*16)));
+			  }
+			  _mm_storeu_si128(dest, blocks[j]);
+		  }
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, outBytes, 0);
+	  if (inBytes != NULL) {
+		  env->ReleasePrimitiveArrayCritical(in, inBytes, JNI_ABORT);
+	  }
+}
+
+/* 
+ * function deleteKeys		: Deletes the expanded keys.
+ * param aesPtr				: Pointer to the expanded keys.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLMultiKeyAES_deleteKeys
+  (JNIEnv *, jobject, jlong aesPtr){
+	  MultiKeyAES* aes = (MultiKeyAES*) aesPtr;
+
+	  //Clean the round keys before releasing them.
+	  memset(aes->roundKeys, 0, sizeof(__m128i) * aes->numKeys * (aes->rounds + 1));
+	  _mm_free(aes->roundKeys);
+	  delete aes;
+}
@@ -30,6 +30,10 @@
 #include <openssl/rand.h>
 #include <iostream>
 #include <openssl/err.h>
+#include <openssl/bn.h>
+#include <string.h>
+#include <vector>
+#include <thread>
 
 using namespace std;
 
@@ -230,6 +234,272 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
 	  return result;
 }
 
+/*
+ * The minimal number of elements given to each thread of a batch.
+ */
+#define MIN_RSA_ELEMENTS_PER_THREAD 16
+
+/*
+ * The parameters of a batch of RSA operations.
+ * The Montgomery contexts of n, p and q are computed once for the whole batch and only read by the threads.
+ */
+struct RSABatch {
+	const BIGNUM *n, *e, *d, *p, *q, *dmp1, *dmq1, *iqmp;
+	BN_MONT_CTX *montN, *montP, *montQ;
+	int size;
+};
+
+/*
+ * Fills the batch parameters of the given RSA object. 
+ * The Montgomery contexts of p and q are created only for a private CRT key that is going to be used to invert.
+ */
+static bool initBatch(RSA* rsa, RSABatch* batch, bool invert, BN_CTX* ctx){
+	batch->n = rsa->n;
+	batch->e = rsa->e;
+	batch->d = rsa->d;
+	batch->p = rsa->p;
+	batch->q = rsa->q;
+	batch->dmp1 = rsa->dmp1;
+	batch->dmq1 = rsa->dmq1;
+	batch->iqmp = rsa->iqmp;
+	batch->size = RSA_size(rsa);
+	batch->montN = BN_MONT_CTX_new();
+	batch->montP = NULL;
+	batch->montQ = NULL;
+	if (!BN_MONT_CTX_set(batch->montN, batch->n, ctx)){
+		return false;
+	}
+
+	if (invert && (batch->p != NULL) && (batch->q != NULL) && (batch->dmp1 != NULL) && (batch->dmq1 != NULL) && (batch->iqmp != NULL)){
+		batch->montP = BN_MONT_CTX_new();
+		batch->montQ = BN_MONT_CTX_new();
+		if (!BN_MONT_CTX_set(batch->montP, batch->p, ctx) || !BN_MONT_CTX_set(batch->montQ, batch->q, ctx)){
+			return false;
+		}
+	}
+	return true;
+}
+
+static void freeBatch(RSABatch* batch){
+	BN_MONT_CTX_free(batch->montN);
+	if (batch->montP != NULL){
+		BN_MONT_CTX_free(batch->montP);
+		BN_MONT_CTX_free(batch->montQ);
+	}
+}
+
+/*
+ * Writes the given number to out as a big endian number of exactly size bytes.
+ */
+static void toFixedSize(const BIGNUM* num, unsigned char* out, int size){
+	int numBytes = BN_num_bytes(num);
+	memset(out, 0, size - numBytes);
+	BN_bn2bin(num, out + size - numBytes);
+}
+
+/*
+ * Computes y = x^e mod n on the elements in [from, to). 
+ * valid is set to false if one of the elements is not smaller than n.
+ */
+static void computeRange(const RSABatch* batch, const unsigned char* in, unsigned char* out, int from, int to, bool* valid){
+	BN_CTX* ctx = BN_CTX_new();
+	BIGNUM* x = BN_new();
+	BIGNUM* y = BN_new();
+	int size = batch->size;
+
+	for (int i=from; i<to; i++){
+		BN_bin2bn(in + i*size, size, x);
+		if (BN_ucmp(x, batch->n) >= 0 || !BN_mod_exp_mont(y, x, batch->e, batch->n, ctx, batch->montN)){
+			*valid = false;
+			BN_zero(y);
+		}
+		toFixedSize(y, out + i*size, size);
+	}
+
+	BN_free(y);
+	BN_free(x);
+	BN_CTX_free(ctx);
+}
+
+/*
+ * Computes x = y^d mod n on the elements in [from, to), using the CRT parameters if the key has them.
+ * The result of the CRT is checked against y, and recomputed with d if the check fails.
+ * Each element is blinded by the given blinding, that is squared between elements instead of being recreated.
+ * valid is set to false if one of the elements is not smaller than n.
+ */
+static void invertRange(const RSABatch* batch, BN_BLINDING* blinding, const unsigned char* in, unsigned char* out, int from, int to, bool* valid){
+	BN_CTX* ctx = BN_CTX_new();
+	BIGNUM* y = BN_new();
+	BIGNUM* x = BN_new();
+	BIGNUM* unblind = BN_new();
+	BIGNUM* r = BN_new();
+	BIGNUM* m1 = BN_new();
+	BIGNUM* m2 = BN_new();
+	int size = batch->size;
+
+	for (int i=from; i<to; i++){
+		BN_bin2bn(in + i*size, size, y);
+		bool ok = (BN_ucmp(y, batch->n) < 0) && BN_BLINDING_convert_ex(y, unblind, blinding, ctx);
+
+		if (ok && batch->montP != NULL){
+			//m1 = y^dp mod p, m2 = y^dq mod q and x = m2 + q*((m1 - m2)*qInv mod p).
+			ok = BN_mod(r, y, batch->p, ctx) && BN_mod_exp_mont_consttime(m1, r, batch->dmp1, batch->p, ctx, batch->montP) &&
+				BN_mod(r, y, batch->q, ctx) && BN_mod_exp_mont_consttime(m2, r, batch->dmq1, batch->q, ctx, batch->montQ) &&
+				BN_sub(r, m1, m2) && BN_nnmod(r, r, batch->p, ctx) && BN_mod_mul(r, r, batch->iqmp, batch->p, ctx) &&
+				BN_mul(r, r, batch->q, ctx) && BN_add(x, r, m2);
+
+			//A fault in one of the half exponentiations would reveal p or q (the Bellcore attack), so check that x^e = y mod n
+			//before x leaves, as RSA_eay_mod_exp does, and recompute x without the CRT if it is not.
+			if (ok && !(BN_mod_exp_mont(r, x, batch->e, batch->n, ctx, batch->montN) && BN_cmp(r, y) == 0)){
+				ok = (batch->d != NULL) && BN_mod_exp_mont_consttime(x, y, batch->d, batch->n, ctx, batch->montN);
+			}
+		} else if (ok){
+			ok = (batch->d != NULL) && BN_mod_exp_mont_consttime(x, y, batch->d, batch->n, ctx, batch->montN);
+		}
+
+		if (ok){
+			ok = BN_BLINDING_invert_ex(x, unblind, blinding, ctx);
+		}
+		if (!ok){
+			*valid = false;
+			BN_zero(x);
+		}
+		toFixedSize(x, out + i*size, size);
+	}
+
+	BN_free(m2);
+	BN_free(m1);
+	BN_free(r);
+	BN_free(unblind);
+	BN_free(x);
+	BN_free(y);
+	BN_CTX_free(ctx);
+}
+
+/*
+ * Returns the number of threads to split numElements elements between.
+ */
+static int getThreadCount(int numThreads, int numElements){
+	int threadCount = (numThreads < 1) ? 1 : numThreads;
+	int maxThreads = numElements / MIN_RSA_ELEMENTS_PER_THREAD;
+	if (threadCount > maxThreads){
+		threadCount = (maxThreads > 0) ? maxThreads : 1;
+	}
+	return threadCount;
+}
+
+/*
+ * Runs the RSA permutation, or its inverse, on a batch of elements.
+ * The elements are copied from java once, split to contiguous ranges and each range is computed by a different thread.
+ * The calling thread computes the last range.
+ */
+static jboolean runBatch(JNIEnv *env, RSA* rsa, bool invert, jbyteArray elements, jint numElements, jbyteArray results, jint numThreads){
+	if (numElements <= 0){
+		return true;
+	}
+
+	BN_CTX* ctx = BN_CTX_new();
+	RSABatch batch;
+	if (!initBatch(rsa, &batch, invert, ctx)){
+		freeBatch(&batch);
+		BN_CTX_free(ctx);
+		return false;
+	}
+
+	int size = batch.size;
+	int threadCount = getThreadCount(numThreads, numElements);
+	unsigned char* in = new unsigned char[numElements*size];
+	unsigned char* out = new unsigned char[numElements*size];
+	env->GetByteArrayRegion(elements, 0, numElements*size, (jbyte*) in);
+
+	bool* valid = new bool[threadCount];
+	BN_BLINDING** blindings = new BN_BLINDING*[threadCount];
+	bool ok = true;
+	for (int t=0; t<threadCount; t++){
+		valid[t] = true;
+		blindings[t] = NULL;
+		//The blindings use the random generator of OpenSSL, so all of them are created here, before the threads start.
+		if (invert){
+			blindings[t] = BN_BLINDING_create_param(NULL, batch.e, (BIGNUM*) batch.n, ctx, BN_mod_exp_mont, batch.montN);
+			if (blindings[t] == NULL){
+				ok = false;
+			} else {
+				BN_BLINDING_set_flags(blindings[t], BN_BLINDING_NO_RECREATE);
+			}
+		}
+	}
+
+	if (ok){
+		vector<thread> threads;
+		int perThread = numElements / threadCount;
+		for (int t=0; t<threadCount; t++){
+			int from = t*perThread;
+			int to = (t == threadCount - 1) ? numElements : (t+1)*perThread;
+			if (t < threadCount - 1){
+				if (invert){
+					threads.push_back(thread(invertRange, &batch, blindings[t], in, out, from, to, &valid[t]));
+				} else {
+					threads.push_back(thread(computeRange, &batch, in, out, from, to, &valid[t]));
+				}
+			} else if (invert){
+				invertRange(&batch, blindings[t], in, out, from, to, &valid[t]);
+			} else {
+				computeRange(&batch, in, out, from, to, &valid[t]);
+			}
+		}
+		for (size_t t=0; t<threads.size(); t++){
+			threads[t].join();
+		}
+		for (int t=0; t<threadCount; t++){
+			ok = ok && valid[t];
+		}
+	}
+
+	env->SetByteArrayRegion(results, 0, numElements*size, (jbyte*) out);
+
+	for (int t=0; t<threadCount; t++){
+		if (blindings[t] != NULL){
+			BN_BLINDING_free(blindings[t]);
+		}
+	}
+	delete [] blindings;
+	delete [] valid;
+	delete [] in;
+	delete [] out;
+	freeBatch(&batch);
+	BN_CTX_free(ctx);
+
+	return ok;
+}
+
+/*
+ * function computeRSABatch	: Computes the RSA permutation on a batch of elements.
+ * param rsa				: Pointer to the native RSA object.
+ * param elements			: The elements, each one of them as a big endian number of RSA_size bytes.
+ * param numElements		: The number of elements.
+ * param results			: The array to put the results in, in the same format as the elements.
+ * param numThreads			: The number of threads to split the batch between.
+ * return jboolean			: false if one of the elements is not smaller than the modulus; true, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_computeRSABatch
+  (JNIEnv *env, jobject, jlong rsa, jbyteArray elements, jint numElements, jbyteArray results, jint numThreads){
+	  return runBatch(env, (RSA*) rsa, false, elements, numElements, results, numThreads);
+}
+
+/*
+ * function invertRSABatch	: Inverts the RSA permutation on a batch of elements.
+ * param rsa				: Pointer to the native RSA object.
+ * param elements			: The elements, each one of them as a big endian number of RSA_size bytes.
+ * param numElements		: The number of elements.
+ * param results			: The array to put the results in, in the same format as the elements.
+ * param numThreads			: The number of threads to split the batch between.
+ * return jboolean			: false if one of the elements is not smaller than the modulus; true, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_invertRSABatch
+  (JNIEnv *env, jobject, jlong rsa, jbyteArray elements, jint numElements, jbyteArray results, jint numThreads){
+	  return runBatch(env, (RSA*) rsa, true, elements, numElements, results, numThreads);
+}
+
 /*
  * function deleteRSA		: Deletes the native RSA object. 
  * param rsa				: Pointer to the native RSA object.
@@ -66,6 +66,54 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_Op
 	  return EVP_CIPHER_CTX_iv_length((EVP_CIPHER_CTX *)enc);
 }
 
+/*
+ * function runCipher		: Encrypts or decrypts len bytes of in into out, using the key that was set in the given context and the given iv.
+ *							  The context is not re-created, only its iv is reset, so the key schedule of the last call to setKey is reused.
+ * param ctx				: A pointer to the native object that does the encryption or the decryption.
+ * param isEncrypt			: 1 to encrypt, 0 to decrypt.
+ * return					: The number of bytes written to out, or -1 in case of an error (for example, bad padding).
+ */
+static int runCipher(EVP_CIPHER_CTX* ctx, int isEncrypt, const unsigned char* iv, const unsigned char* in, int len, unsigned char* out){
+	int size, rem;
+
+	if (0 == EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv, isEncrypt)){
+		return -1;
+	}
+	if (0 == EVP_CipherUpdate(ctx, out, &size, in, len)){
+		return -1;
+	}
+	if (0 == EVP_CipherFinal_ex(ctx, out+size, &rem)){
+		return -1;
+	}
+	return size + rem;
+}
+
+/*
+ * function cipherInto		: Encrypts or decrypts a region of one array into a region of another array without allocating any memory.
+ *							  in and out may be the same array, in which case the data is processed in place.
+ * return					: The number of bytes written to out, or -1 in case of an error.
+ */
+static jint cipherInto(JNIEnv *env, jlong ctx, int isEncrypt, jbyteArray in, jint inOffset, jint len, jbyteArray ivBytes, jbyteArray out, jint outOffset){
+	//The iv is copied before entering the critical regions, no other JNI call is allowed inside them.
+	unsigned char iv[EVP_MAX_IV_LENGTH];
+	env->GetByteArrayRegion(ivBytes, 0, env->GetArrayLength(ivBytes), (jbyte*) iv);
+
+	bool inPlace = env->IsSameObject(in, out);
+	unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, NULL);
+	unsigned char* output = inPlace ? input : (unsigned char*) env->GetPrimitiveArrayCritical(out, NULL);
+
+	int size = runCipher((EVP_CIPHER_CTX*) ctx, isEncrypt, iv, input + inOffset, len, output + outOffset);
+
+	//The input is not changed unless the operation was done in place.
+	if (!inPlace){
+		env->ReleasePrimitiveArrayCritical(out, output, 0);
+	}
+	env->ReleasePrimitiveArrayCritical(in, input, inPlace ? 0 : JNI_ABORT);
+
+	return size;
+}
+
+
 /* 
  * function encrypt			: Encrypts the given plaintext using the given iv.
  * param enc				: A pointer to the native object that does the encryption.
@@ -75,104 +123,99 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_Op
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt
   (JNIEnv *env, jobject, jlong enc, jbyteArray plaintextBytes, jbyteArray ivBytes){
 	  
-	  //Convert the given data into c++ notation.
-	  jbyte* plaintext  = (jbyte*) env->GetByteArrayElements(plaintextBytes, 0);
-	  jbyte* iv  = (jbyte*) env->GetByteArrayElements(ivBytes, 0);
-	  
-	  //Initialize the encryption objects with the key.
-	  if (0 == (EVP_EncryptInit ((EVP_CIPHER_CTX *)enc, NULL, NULL, (unsigned char*) iv))){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  return 0;
-	  }
-	  
 	  int blockSize = EVP_CIPHER_CTX_block_size((EVP_CIPHER_CTX *)enc);
 	  int plaintextSize = env->GetArrayLength(plaintextBytes);  
 
-	  //Before the encryption, tha plaintext should be padded.
-	  //The padding scheme aligns the plaintext to size blockSize (and if the plaintext already aligned, it add an entire blockSize bytes.
-	  //As a result, the size of the ciphertext should be at most of size plaintextSize + blockSize.
-	  unsigned char* out  = new unsigned char[plaintextSize+blockSize];
+	  //The size of the ciphertext is known in advance, so the encryption is done directly into the returned array.
+	  //In CBC mode the padding scheme aligns the plaintext to size blockSize (and if the plaintext already aligned, it add an entire blockSize bytes).
+	  //In CTR mode the block size is 1 and the ciphertext is as long as the plaintext.
+	  int cipherSize = (blockSize == 1) ? plaintextSize : (plaintextSize / blockSize + 1) * blockSize;
+	  jbyteArray result = env->NewByteArray(cipherSize);
 
-	  int size, rem;
-	  
-	  //Encrypt the plaintext.
-	  if (0 == (EVP_EncryptUpdate ((EVP_CIPHER_CTX*)enc, out, &size, (unsigned char*)plaintext, plaintextSize))){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete (out);
+	  if (-1 == cipherInto(env, enc, 1, plaintextBytes, 0, plaintextSize, ivBytes, result, 0)){
 		  return 0;
 	  }
-	  if(0 == EVP_EncryptFinal_ex((EVP_CIPHER_CTX*)enc, out+size, &rem)){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete (out);
-		  return 0;
-	  }
-		 
-	  //Create a jbyteArray that contains the encrypted data.
-	  jbyteArray result = env ->NewByteArray(size+rem);
-	  env->SetByteArrayRegion(result, 0, size+rem, (jbyte*)out);
-	 
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-	  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-	  delete (out);
 
 	  return result;
 }
 
 /* 
- * function decrypt			: Encrypts the given plaintext using the given iv.
+ * function decrypt			: Decrypts the given ciphertext using the given iv.
  * param dec				: A pointer to the native object that does the decryption.
  * param cipherBytes		: The bytes of the ciphertext that should be decrypted.
  * return					: The decrypted data.
  */
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
   (JNIEnv *env, jobject, jlong dec, jbyteArray cipherBytes, jbyteArray ivBytes){	  
-	  //Convert the given data into c++ notation.
-	  jbyte* cipher  = (jbyte*) env->GetByteArrayElements(cipherBytes, 0);
-	  jbyte* iv  = (jbyte*) env->GetByteArrayElements(ivBytes, 0);
-	  
-	   //Initialize the encryption object with the key.
-	  if (0 == EVP_DecryptInit ((EVP_CIPHER_CTX *)dec, NULL, NULL, (unsigned char*) iv)){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  return 0;
-	  }
 	  
+	  int blockSize = EVP_CIPHER_CTX_block_size((EVP_CIPHER_CTX *)dec);
 	  int cipherSize = env->GetArrayLength(cipherBytes);  
-	  //Allocate a new byte array of size cipherSize.
+
+	  //In CTR mode the plaintext is as long as the ciphertext and can be decrypted directly into the returned array.
+	  if (blockSize == 1){
+		  jbyteArray result = env->NewByteArray(cipherSize);
+		  if (-1 == cipherInto(env, dec, 0, cipherBytes, 0, cipherSize, ivBytes, result, 0)){
+			  return 0;
+		  }
+		  return result;
+	  }
+
+	  //In CBC mode the size of the plaintext is known only after the padding is removed.
+	  //Decrypt into a temporary buffer and copy the plaintext to a new array.
 	  unsigned char* out = new unsigned char[cipherSize];
+	  unsigned char iv[EVP_MAX_IV_LENGTH];
+	  env->GetByteArrayRegion(ivBytes, 0, env->GetArrayLength(ivBytes), (jbyte*) iv);
 	  
-	  int size, rem;
-	  
-	  //Decrypt the ciphertext.
-	  if (0 == (EVP_DecryptUpdate ((EVP_CIPHER_CTX*)dec, out, &size, (unsigned char*)cipher, cipherSize))){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete(out);
-		  return 0;
-	  }
-	  if (0 == (EVP_DecryptFinal_ex((EVP_CIPHER_CTX*)dec, out+size, &rem))){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete(out);
+	  jbyte* cipher = (jbyte*) env->GetPrimitiveArrayCritical(cipherBytes, NULL);
+	  int size = runCipher((EVP_CIPHER_CTX*) dec, 0, iv, (unsigned char*) cipher, cipherSize, out);
+	  env->ReleasePrimitiveArrayCritical(cipherBytes, cipher, JNI_ABORT);
+
+	  if (-1 == size){
+		  delete [] out;
 		  return 0;
 	  }
 		 
 	  //Create a jbyteArray that contains the decrypted data.
-	  jbyteArray result = env ->NewByteArray(size+rem);
-	  env->SetByteArrayRegion(result, 0, size+rem, (jbyte*)out);
+	  jbyteArray result = env ->NewByteArray(size);
+	  env->SetByteArrayRegion(result, 0, size, (jbyte*)out);
 	 
 	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-	  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-	  delete (out);
+	  delete [] out;
 
 	  return result;
 }
 
+/* 
+ * function getBlockSize	: Returns the block size of the current encryption, which is 1 in case of a stream mode such as CTR.
+ * return					: the block size.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getBlockSize
+  (JNIEnv *, jobject, jlong enc){
+	  return EVP_CIPHER_CTX_block_size((EVP_CIPHER_CTX *)enc);
+}
+
+/* 
+ * function encryptInto		: Encrypts the plaintext in the given region of the input array into the given output array, using the given iv.
+ *							  The output array can be the input array itself, in which case the encryption is done in place.
+ * param enc				: A pointer to the native object that does the encryption.
+ * return					: The number of bytes written to the output array, or -1 if the encryption failed.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encryptInto
+  (JNIEnv *env, jobject, jlong enc, jbyteArray plaintext, jint inOffset, jint len, jbyteArray iv, jbyteArray out, jint outOffset){
+	  return cipherInto(env, enc, 1, plaintext, inOffset, len, iv, out, outOffset);
+}
+
+/* 
+ * function decryptInto		: Decrypts the ciphertext in the given region of the input array into the given output array, using the given iv.
+ *							  The output array can be the input array itself, in which case the decryption is done in place.
+ * param dec				: A pointer to the native object that does the decryption.
+ * return					: The number of bytes written to the output array, or -1 if the decryption failed.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decryptInto
+  (JNIEnv *env, jobject, jlong dec, jbyteArray cipher, jint inOffset, jint len, jbyteArray iv, jbyteArray out, jint outOffset){
+	  return cipherInto(env, dec, 0, cipher, inOffset, len, iv, out, outOffset);
+}
+
 /* 
  * function deleteNative		: Deletes the native objects and frees the allocated memory.
  * param enc					: A pointer to the native object that does the encryption.
@@ -72,6 +72,30 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encrypt
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
   (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
+ * Method:    getBlockSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getBlockSize
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
+ * Method:    encryptInto
+ * Signature: (J[BII[B[BI)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encryptInto
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
+ * Method:    decryptInto
+ * Signature: (J[BII[B[BI)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decryptInto
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jbyteArray, jint);
+
 /*
  * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
  * Method:    deleteNative
@@ -23,6 +23,30 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_runOtAsReceiver
   (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jstring);
 
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver
+ * Method:    runOneOutOfNOtAsReceiver
+ * Signature: (J[BIII[BLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_runOneOutOfNOtAsReceiver
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jint, jbyteArray, jstring);
+
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver
+ * Method:    getMetrics
+ * Signature: (J)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_getMetrics
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver
+ * Method:    resetMetrics
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_resetMetrics
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver
  * Method:    deleteReceiver
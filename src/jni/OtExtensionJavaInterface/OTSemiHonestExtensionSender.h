@@ -23,6 +23,38 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runOtAsSender
   (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jint, jint, jstring);
 
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender
+ * Method:    runFixedDeltaOtAsSender
+ * Signature: (J[B[BII)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runFixedDeltaOtAsSender
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender
+ * Method:    runOneOutOfNOtAsSender
+ * Signature: (J[BIIILjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runOneOutOfNOtAsSender
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jint, jstring);
+
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender
+ * Method:    getMetrics
+ * Signature: (J)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_getMetrics
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender
+ * Method:    resetMetrics
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_resetMetrics
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender
  * Method:    deleteSender
@@ -0,0 +1,349 @@
+#include "OneOutOfNOtExtension.h"
+
+#include <openssl/sha.h>
+#include <openssl/rand.h>
+#include <emmintrin.h>
+#include <string.h>
+
+/*
+ * Transposes a bit matrix of nrows x ncols (row major, bit i of a row is bit i%8 of byte i/8) into a matrix of ncols x nrows.
+ * nrows must be a multiple of 16 and ncols a multiple of 8.
+ */
+static void transpose(const BYTE* inp, BYTE* out, int nrows, int ncols)
+{
+	union { __m128i x; BYTE b[16]; } tmp;
+
+	for (int rr = 0; rr <= nrows - 16; rr += 16) {
+		for (int cc = 0; cc < ncols; cc += 8) {
+			for (int i = 0; i < 16; ++i)
+				tmp.b[i] = inp[(rr + i)*ncols/8 + cc/8];
+			for (int i = 8; --i >= 0; tmp.x = _mm_slli_epi64(tmp.x, 1))
+				*(unsigned short*) &out[(cc + i)*nrows/8 + rr/8] = (unsigned short) _mm_movemask_epi8(tmp.x);
+		}
+	}
+}
+
+//The number of rows in the extension matrix, padded to whole AES blocks.
+static int paddedRows(int numOTs)
+{
+	return ((numOTs + 127) / 128) * 128;
+}
+
+NOTExtensionCommon::NOTExtensionCommon(CSocket& sock, OTMetrics* metrics) : m_sock(sock), m_metrics(metrics)
+{
+	m_otCounter = 0;
+	m_zeros = NULL;
+	m_zerosSize = 0;
+
+	//The Walsh-Hadamard codeword of v: bit i is the inner product of the bits of v and i.
+	memset(m_codewords, 0, sizeof(m_codewords));
+	for (int v = 0; v < NOT_MAX_N; v++) {
+		for (int i = 0; i < NOT_CODE_BITS; i++) {
+			if (__builtin_parity(v & i))
+				m_codewords[v][i/8] |= (BYTE) (1 << (i%8));
+		}
+	}
+}
+
+NOTExtensionCommon::~NOTExtensionCommon()
+{
+	delete [] m_zeros;
+}
+
+EVP_CIPHER_CTX* NOTExtensionCommon::createPrg(const BYTE* seed)
+{
+	BYTE iv[16];
+	memset(iv, 0, 16);
+
+	EVP_CIPHER_CTX* prg = EVP_CIPHER_CTX_new();
+	EVP_EncryptInit(prg, EVP_aes_128_ctr(), seed, iv);
+	return prg;
+}
+
+void NOTExtensionCommon::expand(EVP_CIPHER_CTX* prg, BYTE* out, int numBytes)
+{
+	if (m_zerosSize < numBytes) {
+		delete [] m_zeros;
+		m_zeros = new BYTE[numBytes];
+		memset(m_zeros, 0, numBytes);
+		m_zerosSize = numBytes;
+	}
+
+	OTScopedTimer timer(m_metrics, OTMetrics::PRG_MILLIS);
+
+	//The counter of the cipher continues from the previous call, so each call gets fresh output of the prg.
+	int outLen;
+	EVP_EncryptUpdate(prg, out, &outLen, m_zeros, numBytes);
+}
+
+void NOTExtensionCommon::hashRow(int j, const BYTE* row, BYTE* out, int elementBytes)
+{
+	BYTE digest[SHA256_DIGEST_LENGTH];
+	long index = m_otCounter + j;
+
+	//H(index || block || row), repeated with an increasing block number until elementBytes bytes were generated.
+	for (int block = 0, done = 0; done < elementBytes; block++, done += SHA256_DIGEST_LENGTH) {
+		SHA256_CTX sha;
+		SHA256_Init(&sha);
+		SHA256_Update(&sha, &index, sizeof(index));
+		SHA256_Update(&sha, &block, sizeof(block));
+		SHA256_Update(&sha, row, NOT_CODE_BYTES);
+		SHA256_Final(digest, &sha);
+
+		int size = (elementBytes - done < SHA256_DIGEST_LENGTH) ? elementBytes - done : SHA256_DIGEST_LENGTH;
+		memcpy(out + done, digest, size);
+	}
+}
+
+void NOTExtensionCommon::sendData(const BYTE* buf, long size)
+{
+	OTScopedTimer timer(m_metrics, OTMetrics::NETWORK_WAIT_MILLIS);
+	m_sock.Send(buf, size);
+
+	//The extension runs on the socket of the first thread.
+	if (m_metrics != NULL) {
+		m_metrics->addBytes(0, size, 0);
+	}
+}
+
+void NOTExtensionCommon::receiveData(BYTE* buf, long size)
+{
+	OTScopedTimer timer(m_metrics, OTMetrics::NETWORK_WAIT_MILLIS);
+	m_sock.Receive(buf, size);
+
+	if (m_metrics != NULL) {
+		m_metrics->addBytes(0, 0, size);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------------//
+//---------------------------------------------- Sender -----------------------------------------------//
+//-----------------------------------------------------------------------------------------------------//
+
+NOTExtensionSender::NOTExtensionSender(CSocket& sock, BaseOT* baseOT, OTMetrics* metrics) : NOTExtensionCommon(sock, metrics)
+{
+	int nSndVals = 2;
+
+	//Choose the secret string s, which is the choice string of the base OTs.
+	RAND_bytes(m_s, NOT_CODE_BYTES);
+
+	CBitVector choices;
+	choices.Create(NOT_CODE_BITS);
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		choices.SetBit(i, (m_s[i/8] >> (i%8)) & 1);
+	}
+
+	//Run the base OTs and obtain the key of each column according to s.
+	BYTE* pBuf = new BYTE[NOT_CODE_BITS * SHA1_BYTES];
+	baseOT->Receiver(nSndVals, NOT_CODE_BITS, choices, m_sock, pBuf);
+
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		m_prgs[i] = createPrg(pBuf + i*SHA1_BYTES);
+	}
+
+	delete [] pBuf;
+	choices.delCBitVector();
+}
+
+NOTExtensionSender::~NOTExtensionSender()
+{
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		EVP_CIPHER_CTX_free(m_prgs[i]);
+	}
+}
+
+BOOL NOTExtensionSender::send(int numOTs, int n, int elementBytes, BYTE* x, bool isRandom)
+{
+	if (n < 2 || n > NOT_MAX_N) {
+		return FALSE;
+	}
+
+	int rows = paddedRows(numOTs);
+	int colBytes = rows / 8;
+
+	//Receive the matrix u from the receiver, column after column.
+	BYTE* u = new BYTE[NOT_CODE_BITS * colBytes];
+	receiveData(u, NOT_CODE_BITS * colBytes);
+
+	//Column i of q is G(k_i^{s_i}) ^ s_i*u_i, which is t_i ^ s_i*c_i.
+	BYTE* q = new BYTE[NOT_CODE_BITS * colBytes];
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		BYTE* qCol = q + i*colBytes;
+		expand(m_prgs[i], qCol, colBytes);
+
+		if ((m_s[i/8] >> (i%8)) & 1) {
+			BYTE* uCol = u + i*colBytes;
+			for (int b = 0; b < colBytes; b++) {
+				qCol[b] ^= uCol[b];
+			}
+		}
+	}
+
+	//Row j of q is t_j ^ (C(r_j) & s).
+	BYTE* qRows = new BYTE[rows * NOT_CODE_BYTES];
+	{
+		OTScopedTimer timer(m_metrics, OTMetrics::TRANSPOSE_MILLIS);
+		transpose(q, qRows, NOT_CODE_BITS, rows);
+	}
+
+	//Precompute C(v) & s for each one of the n values.
+	BYTE* maskedCodewords = new BYTE[n * NOT_CODE_BYTES];
+	for (int v = 0; v < n; v++) {
+		for (int b = 0; b < NOT_CODE_BYTES; b++) {
+			maskedCodewords[v*NOT_CODE_BYTES + b] = m_codewords[v][b] & m_s[b];
+		}
+	}
+
+	//The pad of value v in the j'th OT is H(j, q_j ^ (C(v) & s)), which equals the receiver's H(j, t_j) exactly when v = r_j.
+	BYTE row[NOT_CODE_BYTES];
+	BYTE* pad = new BYTE[elementBytes];
+	{
+		OTScopedTimer timer(m_metrics, OTMetrics::HASH_MILLIS);
+		for (int j = 0; j < numOTs; j++) {
+			BYTE* qRow = qRows + j*NOT_CODE_BYTES;
+			for (int v = 0; v < n; v++) {
+				for (int b = 0; b < NOT_CODE_BYTES; b++) {
+					row[b] = qRow[b] ^ maskedCodewords[v*NOT_CODE_BYTES + b];
+				}
+
+				BYTE* value = x + ((long) j*n + v)*elementBytes;
+				if (isRandom) {
+					hashRow(j, row, value, elementBytes);
+				} else {
+					hashRow(j, row, pad, elementBytes);
+					for (int b = 0; b < elementBytes; b++) {
+						value[b] ^= pad[b];
+					}
+				}
+			}
+		}
+	}
+
+	//In the general version, x now holds the masked values that should be sent to the receiver.
+	if (!isRandom) {
+		sendData(x, (long) numOTs*n*elementBytes);
+	}
+
+	m_otCounter += numOTs;
+
+	delete [] u;
+	delete [] q;
+	delete [] qRows;
+	delete [] maskedCodewords;
+	delete [] pad;
+
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------------------------------//
+//--------------------------------------------- Receiver ----------------------------------------------//
+//-----------------------------------------------------------------------------------------------------//
+
+NOTExtensionReceiver::NOTExtensionReceiver(CSocket& sock, BaseOT* baseOT, OTMetrics* metrics) : NOTExtensionCommon(sock, metrics)
+{
+	int nSndVals = 2;
+
+	//Run the base OTs and obtain both keys of each column.
+	BYTE* pBuf = new BYTE[NOT_CODE_BITS * nSndVals * SHA1_BYTES];
+	baseOT->Sender(nSndVals, NOT_CODE_BITS, m_sock, pBuf);
+
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		m_prgs[i][0] = createPrg(pBuf + (2*i)*SHA1_BYTES);
+		m_prgs[i][1] = createPrg(pBuf + (2*i + 1)*SHA1_BYTES);
+	}
+
+	delete [] pBuf;
+}
+
+NOTExtensionReceiver::~NOTExtensionReceiver()
+{
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		EVP_CIPHER_CTX_free(m_prgs[i][0]);
+		EVP_CIPHER_CTX_free(m_prgs[i][1]);
+	}
+}
+
+BOOL NOTExtensionReceiver::receive(int numOTs, int n, int elementBytes, const BYTE* choices, BYTE* output, bool isRandom)
+{
+	if (n < 2 || n > NOT_MAX_N) {
+		return FALSE;
+	}
+
+	int rows = paddedRows(numOTs);
+	int colBytes = rows / 8;
+
+	for (int j = 0; j < numOTs; j++) {
+		if (choices[j] >= n) {
+			return FALSE;
+		}
+	}
+
+	//Row j of the code matrix is the codeword of the j'th choice. The padding rows hold the codeword of 0.
+	BYTE* codeRows = new BYTE[rows * NOT_CODE_BYTES];
+	memset(codeRows, 0, rows * NOT_CODE_BYTES);
+	for (int j = 0; j < numOTs; j++) {
+		memcpy(codeRows + j*NOT_CODE_BYTES, m_codewords[choices[j]], NOT_CODE_BYTES);
+	}
+	BYTE* codeCols = new BYTE[NOT_CODE_BITS * colBytes];
+	{
+		OTScopedTimer timer(m_metrics, OTMetrics::TRANSPOSE_MILLIS);
+		transpose(codeRows, codeCols, rows, NOT_CODE_BITS);
+	}
+
+	//Column i of t is G(k_i^0), and u_i = t_i ^ G(k_i^1) ^ c_i.
+	BYTE* t = new BYTE[NOT_CODE_BITS * colBytes];
+	BYTE* u = new BYTE[NOT_CODE_BITS * colBytes];
+	for (int i = 0; i < NOT_CODE_BITS; i++) {
+		BYTE* tCol = t + i*colBytes;
+		BYTE* uCol = u + i*colBytes;
+		BYTE* cCol = codeCols + i*colBytes;
+
+		expand(m_prgs[i][0], tCol, colBytes);
+		expand(m_prgs[i][1], uCol, colBytes);
+		for (int b = 0; b < colBytes; b++) {
+			uCol[b] ^= tCol[b] ^ cCol[b];
+		}
+	}
+
+	//Send all the columns of u in a single message.
+	sendData(u, NOT_CODE_BITS * colBytes);
+
+	BYTE* tRows = new BYTE[rows * NOT_CODE_BYTES];
+	{
+		OTScopedTimer timer(m_metrics, OTMetrics::TRANSPOSE_MILLIS);
+		transpose(t, tRows, NOT_CODE_BITS, rows);
+	}
+
+	//The output of the j'th OT is H(j, t_j), unmasking the chosen value in the general version.
+	BYTE* masked = NULL;
+	if (!isRandom) {
+		masked = new BYTE[(long) numOTs*n*elementBytes];
+		receiveData(masked, (long) numOTs*n*elementBytes);
+	}
+
+	{
+		OTScopedTimer timer(m_metrics, OTMetrics::HASH_MILLIS);
+		for (int j = 0; j < numOTs; j++) {
+			BYTE* out = output + (long) j*elementBytes;
+			hashRow(j, tRows + j*NOT_CODE_BYTES, out, elementBytes);
+
+			if (!isRandom) {
+				BYTE* value = masked + ((long) j*n + choices[j])*elementBytes;
+				for (int b = 0; b < elementBytes; b++) {
+					out[b] ^= value[b];
+				}
+			}
+		}
+	}
+
+	m_otCounter += numOTs;
+
+	delete [] codeRows;
+	delete [] codeCols;
+	delete [] t;
+	delete [] u;
+	delete [] tRows;
+	delete [] masked;
+
+	return TRUE;
+}
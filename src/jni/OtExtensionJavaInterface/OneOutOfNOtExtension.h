@@ -0,0 +1,111 @@
+#ifndef _ONE_OUT_OF_N_OT_EXTENSION_H_
+#define _ONE_OUT_OF_N_OT_EXTENSION_H_
+
+#ifdef _WIN32
+#include "../util/typedefs.h"
+#include "../util/socket.h"
+#include "../util/cbitvector.h"
+#include "../ot/naor-pinkas.h"
+#else
+#include <OTExtension/util/typedefs.h>
+#include <OTExtension/util/socket.h>
+#include <OTExtension/util/cbitvector.h>
+#include <OTExtension/ot/naor-pinkas.h>
+#endif
+
+#include <openssl/evp.h>
+
+#include "OtExtensionMetrics.h"
+
+using namespace semihonestot;
+
+/*
+ * 1-out-of-N OT extension for N <= 256, following:
+ * "V. Kolesnikov and R. Kumaresan. Improved OT Extension for Transferring Short Secrets. CRYPTO 2013."
+ *
+ * The 1-out-of-2 extension of the IKNP family uses the repetition code, i.e. a choice bit r is encoded as 0^k or 1^k.
+ * Here a choice r in [0,N) is encoded by the Walsh-Hadamard codeword C(r) of length 256 (minimum distance 128),
+ * so each 1-out-of-N OT costs a single 256-bit row of the extension matrix instead of log2(N) 128-bit rows
+ * and the extra rounds of combining 1-out-of-2 OTs.
+ *
+ * Roles of the base OTs are swapped with respect to the extension: the extension sender plays the base-OT receiver
+ * with a secret random choice string s, the extension receiver plays the base-OT sender.
+ * The base OTs are executed once, in the constructor. Every call to send/receive afterwards is symmetric-key only.
+ */
+
+#define NOT_CODE_BITS 256
+#define NOT_CODE_BYTES (NOT_CODE_BITS/8)
+#define NOT_MAX_N 256
+
+class NOTExtensionCommon {
+
+ public:
+    virtual ~NOTExtensionCommon();
+
+ protected:
+    NOTExtensionCommon(CSocket& sock, OTMetrics* metrics);
+
+    //Expands the given column of the PRG into the next numBytes bytes of its stream.
+    void expand(EVP_CIPHER_CTX* prg, BYTE* out, int numBytes);
+
+    //Hashes row j of the matrix (after it was xored with the relevant codeword) into elementBytes bytes.
+    void hashRow(int j, const BYTE* row, BYTE* out, int elementBytes);
+
+    //Initializes an AES-CTR prg keyed by the given seed.
+    EVP_CIPHER_CTX* createPrg(const BYTE* seed);
+
+    //Send and receive on the socket, counting the bytes and the time waiting on the network.
+    void sendData(const BYTE* buf, long size);
+    void receiveData(BYTE* buf, long size);
+
+    CSocket& m_sock;
+
+    //The metrics of the session. May be NULL.
+    OTMetrics* m_metrics;
+
+    //Holds the Walsh-Hadamard codeword of each value in [0,256).
+    BYTE m_codewords[NOT_MAX_N][NOT_CODE_BYTES];
+
+    //Counts the OTs executed so far, so that the hash inputs are never repeated between calls.
+    long m_otCounter;
+    BYTE* m_zeros;
+    int m_zerosSize;
+};
+
+class NOTExtensionSender : public NOTExtensionCommon {
+
+ public:
+    //Runs the 256 base OTs as the base-OT receiver.
+    NOTExtensionSender(CSocket& sock, BaseOT* baseOT, OTMetrics* metrics = NULL);
+    virtual ~NOTExtensionSender();
+
+    /*
+     * Runs numOTs 1-out-of-n OTs.
+     * In the general version, x holds n values of elementBytes bytes for each OT serially and the receiver learns one of them.
+     * In the random version, x is filled with n random values for each OT.
+     */
+    BOOL send(int numOTs, int n, int elementBytes, BYTE* x, bool isRandom);
+
+ private:
+    BYTE m_s[NOT_CODE_BYTES];
+    EVP_CIPHER_CTX* m_prgs[NOT_CODE_BITS];
+};
+
+class NOTExtensionReceiver : public NOTExtensionCommon {
+
+ public:
+    //Runs the 256 base OTs as the base-OT sender.
+    NOTExtensionReceiver(CSocket& sock, BaseOT* baseOT, OTMetrics* metrics = NULL);
+    virtual ~NOTExtensionReceiver();
+
+    /*
+     * Runs numOTs 1-out-of-n OTs. choices holds one value in [0,n) for each OT.
+     * output is filled with elementBytes bytes for each OT serially.
+     */
+    BOOL receive(int numOTs, int n, int elementBytes, const BYTE* choices, BYTE* output, bool isRandom);
+
+ private:
+    EVP_CIPHER_CTX* m_prgs[NOT_CODE_BITS][2];
+};
+
+#endif //_ONE_OUT_OF_N_OT_EXTENSION_H_
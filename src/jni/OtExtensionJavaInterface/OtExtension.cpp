@@ -6,63 +6,89 @@
 
 
 
-//#define OTTiming
+OTExtensionSession::OTExtensionSession(const char* address, int port, int koblitzOrZpSize, int numOfThreads)
+	: m_sAddr(address), m_nPort((USHORT) port), m_nPID(0), m_nSecParam(163), m_bUseECC(true), bot(NULL), vKeySeeds(NULL), vKeySeedMtx(NULL),
+	  m_nNumOTThreads(numOfThreads), m_pSender(NULL), m_pReceiver(NULL), m_pNSender(NULL), m_pNReceiver(NULL), m_nCounter(0)
+{
+	//use ECC koblitz
+	if(koblitzOrZpSize==163 || koblitzOrZpSize==233 || koblitzOrZpSize==283){
+
+		m_bUseECC = true;
+		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
+		m_nSecParam = koblitzOrZpSize;
+	}
+	//use Zp
+	else if(koblitzOrZpSize==1024 || koblitzOrZpSize==2048 || koblitzOrZpSize==3072){
+
+		m_bUseECC = false;
+		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
+		m_nSecParam = koblitzOrZpSize;
+	}
+}
 
-BOOL Init(int numOfThreads)
+OTExtensionSession::~OTExtensionSession()
+{
+	delete m_pSender;
+	delete m_pReceiver;
+	delete m_pNSender;
+	delete m_pNReceiver;
+	delete bot;
+	free(vKeySeeds);
+	free(vKeySeedMtx);
+	U.delCBitVector();
+
+	for(int i = 0; i < (int) m_vSockets.size(); i++)
+	{
+		m_vSockets[i].Close();
+	}
+}
+
+BOOL Init(OTExtensionSession* session)
 {
 	// Random numbers
 	SHA_CTX sha;
 	OTEXT_HASH_INIT(&sha);
-	OTEXT_HASH_UPDATE(&sha, (BYTE*) &m_nPID, sizeof(m_nPID));
+	OTEXT_HASH_UPDATE(&sha, (BYTE*) &session->m_nPID, sizeof(session->m_nPID));
 	OTEXT_HASH_UPDATE(&sha, (BYTE*) m_nSeed, sizeof(m_nSeed));
-	OTEXT_HASH_FINAL(&sha, m_aSeed);
-
-	m_nCounter = 0;
+	OTEXT_HASH_FINAL(&sha, session->m_aSeed);
 
-	//Number of threads that will be used in OT extension
-	m_nNumOTThreads = numOfThreads;
+	session->m_nCounter = 0;
 
-	m_vSockets.resize(m_nNumOTThreads);
+	//The number of threads that will be used in OT extension is the number of sockets
+	session->m_vSockets.resize(session->m_nNumOTThreads);
+	session->m_metrics.reset(session->m_nNumOTThreads);
 
-	bot = new NaorPinkas(m_nSecParam, m_aSeed, m_bUseECC);
+	session->bot = new NaorPinkas(session->m_nSecParam, session->m_aSeed, session->m_bUseECC);
 
 	return TRUE;
 }
 
-BOOL Cleanup()
-{
-	for(int i = 0; i < m_nNumOTThreads; i++)
-	{
-		m_vSockets[i].Close();
-	}
-	return true;
-}
 
-
-BOOL Connect()
+BOOL Connect(OTExtensionSession* session)
 {
 	BOOL bFail = FALSE;
 	LONG lTO = CONNECT_TIMEO_MILISEC;
+	vector<CSocket>& sockets = session->m_vSockets;
 
 #ifndef BATCH
-	//cerr << "Connecting to party "<< !m_nPID << ": " << m_nAddr << ", " << m_nPort << endl;
+	//cerr << "Connecting to party "<< !session->m_nPID << ": " << session->m_sAddr << ", " << session->m_nPort << endl;
 #endif
-	for(int k = m_nNumOTThreads-1; k >= 0 ; k--)
+	for(int k = session->m_nNumOTThreads-1; k >= 0 ; k--)
 	{
 		for( int i=0; i<RETRY_CONNECT; i++ )
 		{
-			if( !m_vSockets[k].Socket() ) 
+			if( !sockets[k].Socket() ) 
 			{	
 				printf("Socket failure: ");
 				goto connect_failure; 
 			}
 			
-			if( m_vSockets[k].Connect( m_nAddr, m_nPort, lTO))
+			if( sockets[k].Connect( session->m_sAddr.c_str(), session->m_nPort, lTO))
 			{
 				// send pid when connected
-				m_vSockets[k].Send( &k, sizeof(int) );
+				sockets[k].Send( &k, sizeof(int) );
 		#ifndef BATCH
-			//	cerr << " (" << !m_nPID << ") (" << k << ") connected" << endl;
+			//	cerr << " (" << !session->m_nPID << ") (" << k << ") connected" << endl;
 		#endif
 				if(k == 0) 
 				{
@@ -74,7 +100,7 @@ BOOL Connect()
 					break;
 				}
 				SleepMiliSec(10);
-				m_vSockets[k].Close();
+				sockets[k].Close();
 			}
 			SleepMiliSec(20);
 			if(i+1 == RETRY_CONNECT)
@@ -84,31 +110,32 @@ BOOL Connect()
 server_not_available:
 	printf("Server not available: ");
 connect_failure:
-	cerr << " (" << !m_nPID << ") connection failed" << endl;
+	cerr << " (" << !session->m_nPID << ") connection failed" << endl;
 	return FALSE;
 }
 
 
 
-BOOL Listen()
+BOOL Listen(OTExtensionSession* session)
 {
+	vector<CSocket>& sockets = session->m_vSockets;
 #ifndef BATCH
-	//cerr << "Listening: " << m_nAddr << ":" << m_nPort << ", with size: " << m_nNumOTThreads << endl;
+	//cerr << "Listening: " << session->m_sAddr << ":" << session->m_nPort << ", with size: " << session->m_nNumOTThreads << endl;
 #endif
-	if( !m_vSockets[0].Socket() ) 
+	if( !sockets[0].Socket() ) 
 	{
 		goto listen_failure;
 	}
-	if( !m_vSockets[0].Bind(m_nPort, m_nAddr) )
+	if( !sockets[0].Bind(session->m_nPort, session->m_sAddr.c_str()) )
 		goto listen_failure;
-	if( !m_vSockets[0].Listen() )
+	if( !sockets[0].Listen() )
 		goto listen_failure;
 
-	for( int i = 0; i<m_nNumOTThreads; i++ ) //twice the actual number, due to double sockets for OT
+	for( int i = 0; i<session->m_nNumOTThreads; i++ ) //twice the actual number, due to double sockets for OT
 	{
 		CSocket sock;
 		//cerr << "New round! " << endl;
-		if( !m_vSockets[0].Accept(sock) )
+		if( !sockets[0].Accept(sock) )
 		{
 			cerr << "Error in accept" << endl;
 			goto listen_failure;
@@ -117,7 +144,7 @@ BOOL Listen()
 		UINT threadID;
 		sock.Receive(&threadID, sizeof(int));
 
-		if( threadID >= m_nNumOTThreads )
+		if( threadID >= session->m_nNumOTThreads )
 		{
 			sock.Close();
 			i--;
@@ -125,10 +152,10 @@ BOOL Listen()
 		}
 
 	#ifndef BATCH
-		//cerr <<  " (" << m_nPID <<") (" << threadID << ") connection accepted" << endl;
+		//cerr <<  " (" << session->m_nPID <<") (" << threadID << ") connection accepted" << endl;
 	#endif
 		// locate the socket appropriately
-		m_vSockets[threadID].AttachFrom(sock);
+		sockets[threadID].AttachFrom(sock);
 		sock.Detach();
 	}
 
@@ -145,80 +172,64 @@ listen_failure:
 
 
 
-OTExtensionSender* InitOTSender(const char* address, int port, int numOfThreads)
+OTExtensionSession* InitOTSender(const char* address, int port, int koblitzOrZpSize, int numOfThreads)
 {
 	int nSndVals = 2;
-#ifdef OTTiming
-	timeval np_begin, np_end;
-#endif
-	m_nPort = (USHORT) port;
-	m_nAddr = address;
-	vKeySeeds = (BYTE*) malloc(AES_KEY_BYTES*NUM_EXECS_NAOR_PINKAS);
+	OTExtensionSession* session = new OTExtensionSession(address, port, koblitzOrZpSize, numOfThreads);
+	session->vKeySeeds = (BYTE*) malloc(AES_KEY_BYTES*NUM_EXECS_NAOR_PINKAS);
 	
 	//Initialize values
-	Init(numOfThreads);
+	Init(session);
 	
 	//Server listen
-	Listen();
+	Listen(session);
 	
-#ifdef OTTiming
-	gettimeofday(&np_begin, NULL);
-#endif	
-
-	PrecomputeNaorPinkasSender();
-
-#ifdef OTTiming
-	gettimeofday(&np_end, NULL);
-	printf("Time for performing the NP base-OTs: %f seconds\n", getMillies(np_begin, np_end));
-#endif	
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::BASE_OT_MILLIS);
+		PrecomputeNaorPinkasSender(session);
+	}
 
-	return new OTExtensionSender (nSndVals, m_vSockets.data(), U, vKeySeeds);
+	session->m_pSender = new OTExtensionSender (nSndVals, session->m_vSockets.data(), session->U, session->vKeySeeds);
+	return session;
 }
 
-OTExtensionReceiver* InitOTReceiver(const char* address, int port, int numOfThreads)
+OTExtensionSession* InitOTReceiver(const char* address, int port, int koblitzOrZpSize, int numOfThreads)
 {
 	int nSndVals = 2;
-	timeval np_begin, np_end;
-	m_nPort = (USHORT) port;
-	m_nAddr = address;
+	OTExtensionSession* session = new OTExtensionSession(address, port, koblitzOrZpSize, numOfThreads);
 	//vKeySeedMtx = (AES_KEY*) malloc(sizeof(AES_KEY)*NUM_EXECS_NAOR_PINKAS * nSndVals);
-	vKeySeedMtx = (BYTE*) malloc(AES_KEY_BYTES*NUM_EXECS_NAOR_PINKAS * nSndVals);
+	session->vKeySeedMtx = (BYTE*) malloc(AES_KEY_BYTES*NUM_EXECS_NAOR_PINKAS * nSndVals);
 	//Initialize values
-	Init(numOfThreads);
+	Init(session);
 	
 	//Client connect
-	Connect();
-	
-#ifdef OTTiming
-	gettimeofday(&np_begin, NULL);
-#endif
+	Connect(session);
 	
-	PrecomputeNaorPinkasReceiver();
-	
-#ifdef OTTiming
-	gettimeofday(&np_end, NULL);
-	printf("Time for performing the NP base-OTs: %f seconds\n", getMillies(np_begin, np_end));
-#endif	
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::BASE_OT_MILLIS);
+		PrecomputeNaorPinkasReceiver(session);
+	}
 
-	return new OTExtensionReceiver(nSndVals, m_vSockets.data(), vKeySeedMtx, m_aSeed);
+	session->m_pReceiver = new OTExtensionReceiver(nSndVals, session->m_vSockets.data(), session->vKeySeedMtx, session->m_aSeed);
+	return session;
 }
 
-BOOL PrecomputeNaorPinkasSender()
+BOOL PrecomputeNaorPinkasSender(OTExtensionSession* session)
 {
 
 	int nSndVals = 2;
 	BYTE* pBuf = new BYTE[NUM_EXECS_NAOR_PINKAS * SHA1_BYTES]; 
 	int log_nVals = (int) ceil(log((double)nSndVals)/log(2.0)), cnt = 0;
 	
-	U.Create(NUM_EXECS_NAOR_PINKAS*log_nVals, m_aSeed, cnt);
+	session->U.Create(NUM_EXECS_NAOR_PINKAS*log_nVals, session->m_aSeed, cnt);
 	
-	bot->Receiver(nSndVals, NUM_EXECS_NAOR_PINKAS, U, m_vSockets[0], pBuf);
+	session->bot->Receiver(nSndVals, NUM_EXECS_NAOR_PINKAS, session->U, session->m_vSockets[0], pBuf);
 	
 	//Key expansion
 	BYTE* pBufIdx = pBuf;
 	for(int i=0; i<NUM_EXECS_NAOR_PINKAS; i++ ) //80 HF calls for the Naor Pinkas protocol
 	{
-		memcpy(vKeySeeds + i * AES_KEY_BYTES, pBufIdx, AES_KEY_BYTES);
+		memcpy(session->vKeySeeds + i * AES_KEY_BYTES, pBufIdx, AES_KEY_BYTES);
 		pBufIdx+=SHA1_BYTES;
 	} 
  	delete [] pBuf;	
@@ -226,7 +237,7 @@ BOOL PrecomputeNaorPinkasSender()
  	return true;
 }
 
-BOOL PrecomputeNaorPinkasReceiver()
+BOOL PrecomputeNaorPinkasReceiver(OTExtensionSession* session)
 {
 	int nSndVals = 2;
 	
@@ -235,13 +246,13 @@ BOOL PrecomputeNaorPinkasReceiver()
 	
 	//=================================================	
 	// N-P sender: send: C0 (=g^r), C1, C2, C3 
-	bot->Sender(nSndVals, NUM_EXECS_NAOR_PINKAS, m_vSockets[0], pBuf);
+	session->bot->Sender(nSndVals, NUM_EXECS_NAOR_PINKAS, session->m_vSockets[0], pBuf);
 	
 	//Key expansion
 	BYTE* pBufIdx = pBuf;
 	for(int i=0; i<NUM_EXECS_NAOR_PINKAS * nSndVals; i++ )
 	{
-		memcpy(vKeySeedMtx + i * AES_KEY_BYTES, pBufIdx, AES_KEY_BYTES);
+		memcpy(session->vKeySeedMtx + i * AES_KEY_BYTES, pBufIdx, AES_KEY_BYTES);
 		pBufIdx += SHA1_BYTES;
 	}
 	
@@ -251,47 +262,66 @@ BOOL PrecomputeNaorPinkasReceiver()
 }
 
 
-BOOL ObliviouslySend(OTExtensionSender* sender, CBitVector& X1, CBitVector& X2, int numOTs, int bitlength, BYTE version, CBitVector& delta)
+BOOL ObliviouslySend(OTExtensionSession* session, CBitVector& X1, CBitVector& X2, int numOTs, int bitlength, BYTE version, CBitVector& delta, MaskingFunction* maskFct)
 {
 	bool success = FALSE;
 	int nSndVals = 2; //Perform 1-out-of-2 OT
-#ifdef OTTiming
-	timeval ot_begin, ot_end;
-#endif
 
-	
-#ifdef OTTiming
-	gettimeofday(&ot_begin, NULL);
-#endif
-	// Execute OT sender routine 	
-	success = sender->send(numOTs, bitlength, X1, X2, delta, version, m_nNumOTThreads, m_fMaskFct);
-	
-#ifdef OTTiming
-	gettimeofday(&ot_end, NULL);
-	printf("%f\n", getMillies(ot_begin, ot_end) + rndgentime);
-#endif
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::EXTENSION_MILLIS);
+		// Execute OT sender routine 	
+		success = session->m_pSender->send(numOTs, bitlength, X1, X2, delta, version, session->m_nNumOTThreads, maskFct);
+	}
+
+	session->m_metrics.addCall(numOTs);
+	AddExtensionBytes(session, numOTs, bitlength, version, true);
 	return success;
 }
 
-BOOL ObliviouslyReceive(OTExtensionReceiver* receiver, CBitVector& choices, CBitVector& ret, int numOTs, int bitlength, BYTE version)
+BOOL ObliviouslyReceive(OTExtensionSession* session, CBitVector& choices, CBitVector& ret, int numOTs, int bitlength, BYTE version, MaskingFunction* maskFct)
 {
 	bool success = FALSE;
 
-#ifdef OTTiming
-	timeval ot_begin, ot_end;
-	gettimeofday(&ot_begin, NULL);
-#endif
-	// Execute OT receiver routine 	
-	success = receiver->receive(numOTs, bitlength, choices, ret, version, m_nNumOTThreads, m_fMaskFct);
-	
-#ifdef OTTiming
-	gettimeofday(&ot_end, NULL);
-	printf("%f\n", getMillies(ot_begin, ot_end) + rndgentime);
-#endif
-	
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::EXTENSION_MILLIS);
+		// Execute OT receiver routine 	
+		success = session->m_pReceiver->receive(numOTs, bitlength, choices, ret, version, session->m_nNumOTThreads, maskFct);
+	}
+
+	session->m_metrics.addCall(numOTs);
+	AddExtensionBytes(session, numOTs, bitlength, version, false);
 	return success;
 }
 
+/*
+ * Adds the estimated bytes of a 1-out-of-2 extension of numOTs ots to the metrics of each thread.
+ * The OTExtension library does not report its traffic, so the bytes are computed from the messages of the protocol:
+ * the receiver sends a column of NUM_EXECS_NAOR_PINKAS bits for each ot, and the sender sends back both masked values
+ * in the general version and a single one in the correlated version. The ots are split evenly between the threads.
+ */
+void AddExtensionBytes(OTExtensionSession* session, int numOTs, int bitlength, BYTE version, bool isSender)
+{
+	int sndValsToSend = (version == G_OT) ? 2 : (version == C_OT) ? 1 : 0;
+	int numThreads = session->m_nNumOTThreads;
+	int otsPerThread = (numOTs + numThreads - 1) / numThreads;
+	session->m_metrics.setBytesEstimated();
+
+	for(int i = 0; i < numThreads; i++)
+	{
+		int threadOTs = (numOTs - i*otsPerThread < otsPerThread) ? numOTs - i*otsPerThread : otsPerThread;
+		if(threadOTs <= 0)
+			break;
+
+		double matrixBytes = (double) threadOTs * NUM_EXECS_NAOR_PINKAS / 8;
+		double valuesBytes = (double) threadOTs * sndValsToSend * bitlength / 8;
+
+		if(isSender)
+			session->m_metrics.addBytes(i, valuesBytes, matrixBytes);
+		else
+			session->m_metrics.addBytes(i, matrixBytes, valuesBytes);
+	}
+}
+
 
 
 //-----------------------------------------------------------------------------------------------------//
@@ -309,23 +339,11 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
   (JNIEnv *env, jobject, jstring ipAddress, jint port, jint koblitzOrZpSize, jint numOfthreads){
 
 
-	  //use ECC koblitz
-	if(koblitzOrZpSize==163 || koblitzOrZpSize==233 || koblitzOrZpSize==283){
-
-		m_bUseECC = true;
-		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
-		m_nSecParam = koblitzOrZpSize;
-	}
-	//use Zp
-	else if(koblitzOrZpSize==1024 || koblitzOrZpSize==2048 || koblitzOrZpSize==3072){
-
-		m_bUseECC = false;
-		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
-		m_nSecParam = koblitzOrZpSize;
-	}
-	  //get the string from java
+	//get the string from java. The session keeps its own copy of the address.
 	const char* adrr = env->GetStringUTFChars( ipAddress, NULL );
-	return (jlong) InitOTReceiver(adrr, port, numOfthreads);
+	OTExtensionSession* session = InitOTReceiver(adrr, port, koblitzOrZpSize, numOfthreads);
+	env->ReleaseStringUTFChars(ipAddress, adrr);
+	return (jlong) session;
 
 }
 
@@ -341,7 +359,10 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_runOtAsReceiver
   (JNIEnv *env, jobject, jlong receiver, jbyteArray sigma, jint numOfOts, jint bitLength, jbyteArray output, jstring version){
 
-	  BYTE ver;
+	OTExtensionSession* session = (OTExtensionSession*) receiver;
+	BYTE ver;
+	//The masking function of the correlated version. It is created for each call, since several sessions may run concurrently.
+	MaskingFunction* maskFct = NULL;
 	//get the string from java
 	const char* str = env->GetStringUTFChars( version, NULL );
 
@@ -350,7 +371,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 		ver = G_OT;
 	if(strcmp (str,"correlated") == 0){
 		ver = C_OT;
-		m_fMaskFct = new XORMasking(bitLength);
+		maskFct = new XORMasking(bitLength);
 	}
 	if(strcmp (str,"random") == 0)
 		ver = R_OT;
@@ -368,20 +389,26 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 	response.Create(numOfOts, bitLength);
 
 	//copy the sigma values received from java
-	for(int i=0; i<numOfOts;i++){
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::COPY_MILLIS);
+		for(int i=0; i<numOfOts;i++){
 
-		choices.SetBit((i/8)*8 + 7-(i%8), sigmaArr[i]);
-		//choices.SetBit(i, sigmaArr[i]);
+			choices.SetBit((i/8)*8 + 7-(i%8), sigmaArr[i]);
+			//choices.SetBit(i, sigmaArr[i]);
+		}
 	}
 
 		//run the ot extension as the receiver
-	ObliviouslyReceive((OTExtensionReceiver*) receiver , choices, response, numOfOts, bitLength, ver);
+	ObliviouslyReceive(session, choices, response, numOfOts, bitLength, ver, maskFct);
 
 		//prepare the out array
-	for(int i = 0; i < numOfOts*bitLength/8; i++)
 	{
-		//copy each byte result to out
-		out[i] = response.GetByte(i);
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::COPY_MILLIS);
+		for(int i = 0; i < numOfOts*bitLength/8; i++)
+		{
+			//copy each byte result to out
+			out[i] = response.GetByte(i);
+		}
 	}
 
 	//make sure to release the memory created in c++. The JVM will not release it automatically.
@@ -392,9 +419,46 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 	choices.delCBitVector();
 	response.delCBitVector();
 
-	if(ver == C_OT){
-		delete m_fMaskFct;
+	delete maskFct;
+}
+
+
+/*
+ * Function runOneOutOfNOtAsReceiver : This function runs the 1-out-of-N ot extension as the receiver.
+ *									   The base OTs of the 1-out-of-N extension are executed in the first call.
+ * 
+ * param sigma : The input array that holds the receiver choice for each ot, each choice is a value in [0,n).
+ * param n : The number of values in each ot. Must be between 2 and 256.
+ * param bitLength : The length of each element
+ * param output : An empty array that will be filled with the chosen value of each ot in one dimensional array.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_runOneOutOfNOtAsReceiver
+  (JNIEnv *env, jobject, jlong receiver, jbyteArray sigma, jint numOfOts, jint n, jint bitLength, jbyteArray output, jstring version){
+
+	//get the string from java
+	const char* str = env->GetStringUTFChars( version, NULL );
+	bool isRandom = (strcmp (str,"random") == 0);
+	env->ReleaseStringUTFChars(version, str);
+
+	OTExtensionSession* session = (OTExtensionSession*) receiver;
+	if(session->m_pNReceiver == NULL){
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::BASE_OT_MILLIS);
+		session->m_pNReceiver = new NOTExtensionReceiver(session->m_vSockets[0], session->bot, &session->m_metrics);
+	}
+
+	jbyte *sigmaArr = env->GetByteArrayElements(sigma, 0);
+	jbyte *out = env->GetByteArrayElements(output, 0);
+
+	//run the ot extension as the receiver
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::EXTENSION_MILLIS);
+		session->m_pNReceiver->receive(numOfOts, n, bitLength/8, (BYTE*) sigmaArr, (BYTE*) out, isRandom);
 	}
+	session->m_metrics.addCall(numOfOts);
+
+	//make sure to release the memory created in c++. The JVM will not release it automatically.
+	env->ReleaseByteArrayElements(sigma, sigmaArr, JNI_ABORT);
+	env->ReleaseByteArrayElements(output, out, 0);
 }
 
 
@@ -408,23 +472,11 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_initOtSender
   (JNIEnv *env, jobject,jstring ipAddress, jint port, jint koblitzOrZpSize, jint numOfThreads){
 
-	  //use ECC koblitz
-	if(koblitzOrZpSize==163 || koblitzOrZpSize==233 || koblitzOrZpSize==283){
-
-		m_bUseECC = true;
-		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
-		m_nSecParam = koblitzOrZpSize;
-	}
-	//use Zp
-	else if(koblitzOrZpSize==1024 || koblitzOrZpSize==2048 || koblitzOrZpSize==3072){
-
-		m_bUseECC = false;
-		//The security parameter (163,233,283 for ECC or 1024, 2048, 3072 for FFC)
-		m_nSecParam = koblitzOrZpSize;
-	}
-	  //get the string from java
+	//get the string from java. The session keeps its own copy of the address.
 	const char* adrr = env->GetStringUTFChars( ipAddress, NULL );
-	return (jlong) InitOTSender(adrr, port, numOfThreads);
+	OTExtensionSession* session = InitOTSender(adrr, port, koblitzOrZpSize, numOfThreads);
+	env->ReleaseStringUTFChars(ipAddress, adrr);
+	return (jlong) session;
 
 }
 
@@ -438,7 +490,10 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runOtAsSender
   (JNIEnv *env, jobject, jlong sender, jbyteArray x1, jbyteArray x2, jbyteArray deltaFromJava, jint numOfOts, jint bitLength, jstring version){
 
-	//The masking function with which the values that are sent in the last communication step are processed
+	OTExtensionSession* session = (OTExtensionSession*) sender;
+	//The masking function with which the values that are sent in the last communication step are processed.
+	//It is created for each call, since several sessions may run concurrently.
+	MaskingFunction* maskFct = NULL;
 	//Choose OT extension version: G_OT, C_OT or R_OT
 	BYTE ver;
 
@@ -470,7 +525,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 
 	if(ver ==G_OT){
 		
-		
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::COPY_MILLIS);
 
 		//copy the values given from java
 		for(int i = 0; i < numOfOts*bitLength/8; i++)
@@ -488,7 +543,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 
 		deltaArr = env->GetByteArrayElements(deltaFromJava, 0);
 
-		m_fMaskFct = new XORMasking(bitLength);
+		maskFct = new XORMasking(bitLength);
 
 		delta.Create(numOfOts, bitLength);
 
@@ -506,10 +561,12 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 	//else if(ver==R_OT){} no need to set any values. There is no input for x0 and x1 and no input for delta
 	
 	//run the ot extension as the sender
-	ObliviouslySend((OTExtensionSender*) sender, X1, X2, numOfOts, bitLength, ver, delta);
+	ObliviouslySend(session, X1, X2, numOfOts, bitLength, ver, delta, maskFct);
 
 	if(ver != G_OT){//we need to copy x0 and x1 
 
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::COPY_MILLIS);
+
 		//get the values from the ot and copy them to x1Arr, x2Arr wich later on will be copied to the java values x1 and x2
 		for(int i = 0; i < numOfOts*bitLength/8; i++)
 		{
@@ -522,7 +579,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 		if(ver==C_OT){
 			env->ReleaseByteArrayElements(deltaFromJava,deltaArr,0);
 
-			delete m_fMaskFct;
+			delete maskFct;
 		}
 	}
 
@@ -536,12 +593,128 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 
 }
 
+/*
+ * Function runFixedDeltaOtAsSender : This function runs the correlated ot extension as the sender where all the OTs share the same delta.
+ *									  This is the typical case of Free-XOR garbled circuit input transfer, where x1 = x0^delta for a global offset delta.
+ * 
+ * param x0 : An empty array that will be filled with all the x0,i for each ot in a one dimensional array one element after the other.
+ *			  The x1,i values are not returned since x1,i = x0,i^delta.
+ * param delta : The single delta shared by all the ots. The size of this array is bitLength/8 bytes.
+ * param bitLength : The length of each element
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runFixedDeltaOtAsSender
+  (JNIEnv *env, jobject, jlong sender, jbyteArray x0, jbyteArray deltaFromJava, jint numOfOts, jint bitLength){
+
+	int elementSize = bitLength/8;
+
+	CBitVector delta, X1, X2;
+	//Create X1 and X2 as two arrays with "numOTs" entries of "bitlength" bit-values
+	X1.Create(numOfOts, bitLength);
+	X2.Create(numOfOts, bitLength);
+	delta.Create(numOfOts, bitLength);
+
+	//Replicate the single delta into all the entries of the delta vector, there is no need to get a per-ot delta from java.
+	BYTE* deltaVec = delta.GetArr();
+	env->GetByteArrayRegion(deltaFromJava, 0, elementSize, (jbyte*) deltaVec);
+	for(int i = 1; i < numOfOts; i++)
+	{
+		memcpy(deltaVec + i*elementSize, deltaVec, elementSize);
+	}
+
+	MaskingFunction* maskFct = new XORMasking(bitLength);
+
+	//run the ot extension as the sender
+	ObliviouslySend((OTExtensionSession*) sender, X1, X2, numOfOts, bitLength, C_OT, delta, maskFct);
+
+	//Copy only x0 to java. x1 is implied by x0 and delta.
+	env->SetByteArrayRegion(x0, 0, numOfOts*elementSize, (jbyte*) X1.GetArr());
+
+	delete maskFct;
+
+	X1.delCBitVector();
+	X2.delCBitVector();
+	delta.delCBitVector();
+}
+
+/*
+ * Function runOneOutOfNOtAsSender : This function runs the 1-out-of-N ot extension as the sender.
+ *									 The base OTs of the 1-out-of-N extension are executed in the first call.
+ * 
+ * param x : In the general version, the input array that holds the n values of each ot serially, one ot after the other.
+ *			 In the random version, an empty array that will be filled with the n random values of each ot.
+ * param n : The number of values in each ot. Must be between 2 and 256.
+ * param bitLength : The length of each element
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_runOneOutOfNOtAsSender
+  (JNIEnv *env, jobject, jlong sender, jbyteArray x, jint numOfOts, jint n, jint bitLength, jstring version){
+
+	//get the string from java
+	const char* str = env->GetStringUTFChars( version, NULL );
+	bool isRandom = (strcmp (str,"random") == 0);
+	env->ReleaseStringUTFChars(version, str);
+
+	OTExtensionSession* session = (OTExtensionSession*) sender;
+	if(session->m_pNSender == NULL){
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::BASE_OT_MILLIS);
+		session->m_pNSender = new NOTExtensionSender(session->m_vSockets[0], session->bot, &session->m_metrics);
+	}
+
+	jbyte *xArr = env->GetByteArrayElements(x, 0);
+
+	//run the ot extension as the sender. x is masked in place in the general version, and filled in the random version.
+	{
+		OTScopedTimer timer(&session->m_metrics, OTMetrics::EXTENSION_MILLIS);
+		session->m_pNSender->send(numOfOts, n, bitLength/8, (BYTE*) xArr, isRandom);
+	}
+	session->m_metrics.addCall(numOfOts);
+
+	//In the general version the masked values should not be copied back to java.
+	env->ReleaseByteArrayElements(x, xArr, isRandom ? 0 : JNI_ABORT);
+}
+
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_deleteSender
   (JNIEnv *, jobject, jlong sender){
-	  delete (OTExtensionSender*) sender;
+	  //Deletes the 1-out-of-2 and 1-out-of-N senders and closes the sockets of the session.
+	  delete (OTExtensionSession*) sender;
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_deleteReceiver
   (JNIEnv *, jobject, jlong receiver){
-	  delete (OTExtensionReceiver*) receiver;
+	  //Deletes the 1-out-of-2 and 1-out-of-N receivers and closes the sockets of the session.
+	  delete (OTExtensionSession*) receiver;
+}
+
+/*
+ * Function getMetrics : returns the metrics of the session, accumulated since the initialization or the last reset.
+ *						 The array holds the fields of OTMetrics followed by the bytes sent and the bytes received by each thread.
+ */
+static jdoubleArray GetMetrics(JNIEnv *env, OTExtensionSession* session)
+{
+	OTMetrics& metrics = session->m_metrics;
+	jdoubleArray result = env->NewDoubleArray(metrics.size());
+	double* values = new double[metrics.size()];
+	metrics.toArray(values);
+	env->SetDoubleArrayRegion(result, 0, metrics.size(), values);
+	delete [] values;
+	return result;
+}
+
+JNIEXPORT jdoubleArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_getMetrics
+  (JNIEnv *env, jobject, jlong sender){
+	  return GetMetrics(env, (OTExtensionSession*) sender);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_resetMetrics
+  (JNIEnv *, jobject, jlong sender){
+	  ((OTExtensionSession*) sender)->m_metrics.reset();
+}
+
+JNIEXPORT jdoubleArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_getMetrics
+  (JNIEnv *env, jobject, jlong receiver){
+	  return GetMetrics(env, (OTExtensionSession*) receiver);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_resetMetrics
+  (JNIEnv *, jobject, jlong receiver){
+	  ((OTExtensionSession*) receiver)->m_metrics.reset();
 }
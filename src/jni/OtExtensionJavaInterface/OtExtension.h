@@ -19,6 +19,9 @@
 #include <OTExtension/ot/xormasking.h>
 #endif
 
+#include "OneOutOfNOtExtension.h"
+#include "OtExtensionMetrics.h"
+
 #include <vector>
 #include <time.h>
 
@@ -31,44 +34,61 @@ using namespace semihonestot;
 
 static const char* m_nSeed = "437398417012387813714564100";
 
-USHORT		m_nPort = 7766;
-const char* m_nAddr ;// = "localhost";
-
-BOOL Init();
-BOOL Cleanup();
-BOOL Connect();
-BOOL Listen();
-
-OTExtensionSender* InitOTSender(const char* address, int port);
-OTExtensionReceiver* InitOTReceiver(const char* address, int port);
-
-BOOL PrecomputeNaorPinkasSender();
-BOOL PrecomputeNaorPinkasReceiver();
-BOOL ObliviouslyReceive(OTExtensionReceiver* receiver, CBitVector& choices, CBitVector& ret, int numOTs, int bitlength, BYTE version);
-BOOL ObliviouslySend(OTExtensionSender* sender, CBitVector& X1, CBitVector& X2, int numOTs, int bitlength, BYTE version, CBitVector& delta);
-
-// Network Communication
-vector<CSocket> m_vSockets;
-int m_nPID; // thread id
-int m_nSecParam; 
-bool m_bUseECC;
-int m_nBitLength;
-int m_nMod;
-MaskingFunction* m_fMaskFct;
-
-// Naor-Pinkas OT
-BaseOT* bot;
-
-CBitVector U; 
-BYTE *vKeySeeds;
-BYTE *vKeySeedMtx;
-
-int m_nNumOTThreads;
-
-// SHA PRG
-BYTE				m_aSeed[SHA1_BYTES];
-int			m_nCounter;
-double			rndgentime;
+/*
+ * The state of a single OT extension sender or receiver: its sockets, base OTs and metrics.
+ * Each java object holds a pointer to its own session, so several senders and receivers can live in the same process
+ * (for example one towards each of the other parties) and be created and used concurrently.
+ */
+struct OTExtensionSession
+{
+	OTExtensionSession(const char* address, int port, int koblitzOrZpSize, int numOfThreads);
+	~OTExtensionSession();
+
+	// Network Communication
+	string m_sAddr;
+	USHORT m_nPort;
+	vector<CSocket> m_vSockets;
+	int m_nPID;
+	int m_nSecParam;
+	bool m_bUseECC;
+
+	// Naor-Pinkas OT
+	BaseOT* bot;
+
+	CBitVector U;
+	BYTE *vKeySeeds;
+	BYTE *vKeySeedMtx;
+
+	int m_nNumOTThreads;
+
+	// 1-out-of-2 OT extension, created after the base OTs by InitOTSender/InitOTReceiver
+	OTExtensionSender* m_pSender;
+	OTExtensionReceiver* m_pReceiver;
+
+	// 1-out-of-N OT extension, created on the first 1-out-of-N call since it requires its own base OTs
+	NOTExtensionSender* m_pNSender;
+	NOTExtensionReceiver* m_pNReceiver;
+
+	// Metrics of the session, accumulated over all the calls until reset from java
+	OTMetrics m_metrics;
+
+	// SHA PRG
+	BYTE m_aSeed[SHA1_BYTES];
+	int m_nCounter;
+};
+
+BOOL Init(OTExtensionSession* session);
+BOOL Connect(OTExtensionSession* session);
+BOOL Listen(OTExtensionSession* session);
+
+OTExtensionSession* InitOTSender(const char* address, int port, int koblitzOrZpSize, int numOfThreads);
+OTExtensionSession* InitOTReceiver(const char* address, int port, int koblitzOrZpSize, int numOfThreads);
+
+BOOL PrecomputeNaorPinkasSender(OTExtensionSession* session);
+BOOL PrecomputeNaorPinkasReceiver(OTExtensionSession* session);
+BOOL ObliviouslyReceive(OTExtensionSession* session, CBitVector& choices, CBitVector& ret, int numOTs, int bitlength, BYTE version, MaskingFunction* maskFct);
+BOOL ObliviouslySend(OTExtensionSession* session, CBitVector& X1, CBitVector& X2, int numOTs, int bitlength, BYTE version, CBitVector& delta, MaskingFunction* maskFct);
+void AddExtensionBytes(OTExtensionSession* session, int numOTs, int bitlength, BYTE version, bool isSender);
 
 
 #endif //_MPC_H_
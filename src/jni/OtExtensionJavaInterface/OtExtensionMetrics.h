@@ -0,0 +1,116 @@
+#ifndef _OT_EXTENSION_METRICS_H_
+#define _OT_EXTENSION_METRICS_H_
+
+#include <chrono>
+#include <vector>
+
+/*
+ * Runtime metrics of an OT extension session, replacing the compile time OTTiming printfs.
+ *
+ * The metrics accumulate over all the calls to the OT extension until they are reset, and are read from java
+ * (see OTExtensionMetrics.java) as a flat array of doubles in the order of the enum below, followed by the bytes
+ * sent and received by each thread.
+ *
+ * The base OTs, the whole extension and the copying between java and the native vectors are timed for every OT type.
+ * The inner phases (transpose, PRG, hash and the time waiting on the network) are timed by the code that runs them,
+ * that is, the 1-out-of-N extension. The 1-out-of-2 extension is implemented by the OTExtension library that does not
+ * report its phases, so for it the bytes of each thread are estimated from the sizes of the messages of the protocol,
+ * and the BYTES_ESTIMATED field is set.
+ */
+class OTMetrics {
+
+ public:
+	enum {
+		BASE_OT_MILLIS = 0,
+		EXTENSION_MILLIS,
+		COPY_MILLIS,
+		TRANSPOSE_MILLIS,
+		PRG_MILLIS,
+		HASH_MILLIS,
+		NETWORK_WAIT_MILLIS,
+		NUM_OF_OTS,
+		NUM_OF_CALLS,
+		NUM_OF_THREADS,
+		BYTES_ESTIMATED,
+		NUM_OF_FIELDS
+	};
+
+	OTMetrics() { reset(1); }
+
+	//Clears all the counters, keeping a byte counter for each one of the given number of threads.
+	void reset(int numOfThreads) {
+		for (int i = 0; i < NUM_OF_FIELDS; i++) {
+			m_values[i] = 0;
+		}
+		m_values[NUM_OF_THREADS] = numOfThreads;
+		m_bytesSent.assign(numOfThreads, 0);
+		m_bytesReceived.assign(numOfThreads, 0);
+	}
+
+	//Clears all the counters of the current number of threads.
+	void reset() { reset((int) m_values[NUM_OF_THREADS]); }
+
+	void add(int field, double value) { m_values[field] += value; }
+
+	void addCall(int numOfOts) {
+		m_values[NUM_OF_OTS] += numOfOts;
+		m_values[NUM_OF_CALLS]++;
+	}
+
+	void addBytes(int thread, double sent, double received) {
+		m_bytesSent[thread] += sent;
+		m_bytesReceived[thread] += received;
+	}
+
+	//Marks the byte counts as estimates rather than the bytes that passed through the socket.
+	void setBytesEstimated() { m_values[BYTES_ESTIMATED] = 1; }
+
+	int numOfThreads() { return (int) m_values[NUM_OF_THREADS]; }
+
+	//The size of the array filled by toArray.
+	int size() { return NUM_OF_FIELDS + 2*numOfThreads(); }
+
+	void toArray(double* out) {
+		int numOfThreads = this->numOfThreads();
+		for (int i = 0; i < NUM_OF_FIELDS; i++) {
+			out[i] = m_values[i];
+		}
+		for (int i = 0; i < numOfThreads; i++) {
+			out[NUM_OF_FIELDS + i] = m_bytesSent[i];
+			out[NUM_OF_FIELDS + numOfThreads + i] = m_bytesReceived[i];
+		}
+	}
+
+ private:
+	double m_values[NUM_OF_FIELDS];
+	std::vector<double> m_bytesSent;
+	std::vector<double> m_bytesReceived;
+};
+
+/*
+ * Adds the time from its construction to its destruction to the given field of the metrics.
+ * A NULL metrics object disables the timer.
+ */
+class OTScopedTimer {
+
+ public:
+	OTScopedTimer(OTMetrics* metrics, int field) : m_metrics(metrics), m_field(field) {
+		if (m_metrics != NULL) {
+			m_begin = std::chrono::steady_clock::now();
+		}
+	}
+
+	~OTScopedTimer() {
+		if (m_metrics != NULL) {
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_begin;
+			m_metrics->add(m_field, elapsed.count());
+		}
+	}
+
+ private:
+	OTMetrics* m_metrics;
+	int m_field;
+	std::chrono::steady_clock::time_point m_begin;
+};
+
+#endif //_OT_EXTENSION_METRICS_H_
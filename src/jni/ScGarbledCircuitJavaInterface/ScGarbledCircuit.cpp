@@ -14,10 +14,34 @@
 #include "FreeXorGarbledBooleanCircuit.h"
 #include "HalfGatesGarbledBooleanCircuit.h"
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 using namespace std;
 
 
+/* function getGarbledTablesSize : This function returns the size in bytes of the garbled tables of the given circuit.
+ */
+static int getGarbledTablesSize(GarbledBooleanCircuit * garbledCircuit){
+
+	int mult = 4;//for a regular circuit we have 4 blocks for each gate
+
+	if(garbledCircuit->getIsRowReduction()==true){
+
+		mult = 3;//in row reduction we only have 3 rows
+	}
+	else if (garbledCircuit->getIsTwoRows() == true){
+		mult = 2; //half gates only use 2 rows for AND gates
+	}
+
+	if (garbledCircuit->getIsNonXorOutputsRequired()){
+		return ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit->getNumberOfOutputs()) * 16;
+	}
+	return (garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16;
+}
+
+
 /* function createGarbledcircuit : This function creates a new circuit and returns a pointer to the created circuit. 
  * return			   : A pointer to the created circuit.
  */
@@ -194,28 +218,11 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGa
 	  //get the garbled circuit
 	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
 
-	  int mult = 4;//for a regular circuit we have 4 blocks for each gate
-
-	  if(garbledCircuit->getIsRowReduction()==true){
-
-		  mult = 3;//in row reduction we only have 3 rows
-	  }
-	  else if (garbledCircuit->getIsTwoRows() == true){
-		  mult = 2; //half gates only use 2 rows for AND gates
-	  }
-
 	   //get the garbled table as an array of jbyte
 	  jbyte *carr = env->GetByteArrayElements(garbledTables, 0);
 
-	  if (garbledCircuit->getIsNonXorOutputsRequired()){
-		  //copy the garbled table to the native circuit
-		  memcpy(garbledCircuit->getGarbledTables(), carr, ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit ->getNumberOfOutputs())* 16);
-	  }
-	  else{
-		  //copy the garbled table to the native circuit
-		  memcpy(garbledCircuit->getGarbledTables(), carr, (garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16);
-
-	  }
+	  //copy the garbled table to the native circuit
+	  memcpy(garbledCircuit->getGarbledTables(), carr, getGarbledTablesSize(garbledCircuit));
 	   
 	  //free the memory of jbyte array
 	  env->ReleaseByteArrayElements(garbledTables,carr,JNI_ABORT);
@@ -229,24 +236,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	 //get the garbled circuit
 	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
 
-	int mult = 4;//for a regular circuit we have 4 blocks for each gate
-
-	if(garbledCircuit->getIsRowReduction()==true){
-
-		mult = 3;//in row reduction we only have 3 rows
-	}
-	else if (garbledCircuit->getIsTwoRows() == true){
-		mult = 2; //half gates only use 2 rows for AND gates
-	}
-
 	//get the size of the garbled table
-	int size;
-	if (garbledCircuit->getIsNonXorOutputsRequired()){
-		size = (((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit->getNumberOfOutputs()) * 16);
-	}
-	else{
-		size = ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16);
-	}
+	int size = getGarbledTablesSize(garbledCircuit);
 	
 
 	 //create a jbyteArray with the size of the garbled table
@@ -558,6 +549,131 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 }
 
 
+//the size of the parts in which the received garbled tables are compared to the generated ones
+#define COMPARE_CHUNK_SIZE (64 * 1024)
+
+/* function verifyGarbledCircuit : This function garbles the given circuit with the given seed and checks that the generated garbled tables 
+ * and translation table are equal to the given ones. The generated keys are written to the given arrays of the input and output keys.
+ * The received tables are compared part by part through the given buffer, so they are not copied as a whole to the native memory.
+ * return			: true if both tables are equal to the generated ones.
+ */
+static bool verifyGarbledCircuit(JNIEnv *env, GarbledBooleanCircuit * garbledCircuit, jbyteArray seed, jbyteArray garbledTables,
+	jbyteArray translationTable, jbyteArray allInputWireValues, jbyteArray allOutputWireValues, vector<unsigned char> & buffer){
+
+	jbyte jseed[16];
+	env->GetByteArrayRegion(seed, 0, 16, jseed);
+	block seedBlock = _mm_set_epi8(jseed[15],jseed[14],jseed[13],jseed[12],jseed[11],jseed[10],jseed[9],jseed[8],jseed[7],jseed[6],jseed[5],jseed[4],jseed[3],jseed[2],jseed[1],jseed[0]);
+
+	int numInputs = garbledCircuit->getNumberOfInputs();
+	int numOutputs = garbledCircuit->getNumberOfOutputs();
+
+	//allocate memory for the input keys, the output keys and the translation table that will be filled by the native garble call
+	block *inputs = (block *) _aligned_malloc(sizeof(block) * 2 * numInputs, 16);
+	block *outputs = (block *) _aligned_malloc(sizeof(block) * 2 * numOutputs, 16);
+	vector<unsigned char> generatedTranslation(numOutputs);
+
+	garbledCircuit->garble(inputs, outputs, generatedTranslation.data(), seedBlock);
+
+	int tablesSize = getGarbledTablesSize(garbledCircuit);
+	bool isVerified = (translationTable != NULL) && (garbledTables != NULL) &&
+		(env->GetArrayLength(translationTable) == numOutputs) && (env->GetArrayLength(garbledTables) == tablesSize);
+
+	//compare the translation table
+	if (isVerified){
+		env->GetByteArrayRegion(translationTable, 0, numOutputs, (jbyte*)buffer.data());
+		isVerified = (memcmp(buffer.data(), generatedTranslation.data(), numOutputs) == 0);
+	}
+
+	//compare the garbled tables
+	unsigned char *generatedTables = (unsigned char *)garbledCircuit->getGarbledTables();
+	for (int offset = 0; isVerified && offset < tablesSize; offset += COMPARE_CHUNK_SIZE){
+		int size = (tablesSize - offset < COMPARE_CHUNK_SIZE) ? tablesSize - offset : COMPARE_CHUNK_SIZE;
+		env->GetByteArrayRegion(garbledTables, offset, size, (jbyte*)buffer.data());
+		isVerified = (memcmp(buffer.data(), generatedTables + offset, size) == 0);
+	}
+
+	//set the generated keys to the given arrays
+	env->SetByteArrayRegion(allInputWireValues, 0, 2 * numInputs * SIZE_OF_BLOCK, (jbyte*)inputs);
+	env->SetByteArrayRegion(allOutputWireValues, 0, 2 * numOutputs * SIZE_OF_BLOCK, (jbyte*)outputs);
+
+	_aligned_free(inputs);
+	_aligned_free(outputs);
+
+	return isVerified;
+}
+
+/* function verifyGarbledCircuits : This function verifies a batch of circuits of the cut and choose in a single call.
+ * Each given native circuit (all built from the same circuit file) is used by its own thread. The threads take the seeds one after
+ * the other, garble their circuit with the seed and compare the result to the received tables of this seed (see verifyGarbledCircuit).
+ * The threads other than the calling thread are attached to the JVM in order to access the java arrays.
+ * return			: An array that holds for each seed whether the received tables match it.
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyGarbledCircuits
+  (JNIEnv *env, jclass, jlongArray gbcPtrs, jobjectArray seeds, jobjectArray garbledTables, jobjectArray translationTables,
+  jobjectArray allInputWireValues, jobjectArray allOutputWireValues){
+
+	int numCircuits = env->GetArrayLength(seeds);
+	int numThreads = env->GetArrayLength(gbcPtrs);
+	if (numThreads > numCircuits){
+		numThreads = numCircuits;
+	}
+
+	vector<jlong> circuits(env->GetArrayLength(gbcPtrs));
+	env->GetLongArrayRegion(gbcPtrs, 0, circuits.size(), circuits.data());
+
+	vector<jboolean> results(numCircuits, JNI_FALSE);
+	atomic<int> next(0);
+	JavaVM *vm;
+	env->GetJavaVM(&vm);
+
+	auto work = [&](int thread){
+		JNIEnv *threadEnv = env;
+		if (thread > 0){
+			vm->AttachCurrentThread((void **)&threadEnv, NULL);
+		}
+
+		GarbledBooleanCircuit * garbledCircuit = (GarbledBooleanCircuit *)circuits[thread];
+		vector<unsigned char> buffer(max(COMPARE_CHUNK_SIZE, garbledCircuit->getNumberOfOutputs()));
+
+		for (int i = next++; i < numCircuits; i = next++){
+			jbyteArray seed = (jbyteArray)threadEnv->GetObjectArrayElement(seeds, i);
+			jbyteArray tables = (jbyteArray)threadEnv->GetObjectArrayElement(garbledTables, i);
+			jbyteArray translation = (jbyteArray)threadEnv->GetObjectArrayElement(translationTables, i);
+			jbyteArray inputKeys = (jbyteArray)threadEnv->GetObjectArrayElement(allInputWireValues, i);
+			jbyteArray outputKeys = (jbyteArray)threadEnv->GetObjectArrayElement(allOutputWireValues, i);
+
+			results[i] = verifyGarbledCircuit(threadEnv, garbledCircuit, seed, tables, translation, inputKeys, outputKeys, buffer);
+
+			threadEnv->DeleteLocalRef(seed);
+			threadEnv->DeleteLocalRef(tables);
+			threadEnv->DeleteLocalRef(translation);
+			threadEnv->DeleteLocalRef(inputKeys);
+			threadEnv->DeleteLocalRef(outputKeys);
+		}
+
+		if (thread > 0){
+			vm->DetachCurrentThread();
+		}
+	};
+
+	//the calling thread verifies too
+	vector<std::thread> threads;
+	for (int t = 1; t < numThreads; t++){
+		threads.push_back(std::thread(work, t));
+	}
+	if (numThreads > 0){
+		work(0);
+	}
+	for (size_t t = 0; t < threads.size(); t++){
+		threads[t].join();
+	}
+
+	jbooleanArray result = env->NewBooleanArray(numCircuits);
+	env->SetBooleanArrayRegion(result, 0, numCircuits, results.data());
+	return result;
+}
+
+
 JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_deleteCircuit
   (JNIEnv *, jobject, jlong gbcPtr ){
 
@@ -129,6 +129,14 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyTranslationTable
   (JNIEnv *, jobject, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit
+ * Method:    verifyGarbledCircuits
+ * Signature: ([J[[B[[B[[B[[B[[B)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyGarbledCircuits
+  (JNIEnv *, jclass, jlongArray, jobjectArray, jobjectArray, jobjectArray, jobjectArray, jobjectArray);
+
 /*
  * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit
  * Method:    deleteCircuit